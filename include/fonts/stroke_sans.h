@@ -0,0 +1,188 @@
+#ifndef FONT_STROKE_SANS_H
+#define FONT_STROKE_SANS_H
+
+#include "ssd1306_fonts.h"
+
+
+/**
+ * @file stroke_sans.h
+ * @brief Simple single-stroke sans serif font (ASCII 0x20-0x7E) in the style of the
+ * Hershey simplex fonts.
+ *
+ * Glyphs are drawn on a grid with capitals 12 units tall (rows 0 to 12, baseline at
+ * row 12), lowercase bodies from row 5 and descenders down to row 15. The whole set
+ * takes 665 bytes of points and 380 bytes of glyph descriptors at every size.
+ */
+static const uint8_t stroke_sans_Points[] = {
+  0x10, 0x18, 0xFF, 0x1B, 0x1C, 0x10, 0x13, 0xFF, 0x40, 0x43, 0x30, 0x2C,
+  0xFF, 0x60, 0x5C, 0xFF, 0x04, 0x84, 0xFF, 0x08, 0x88, 0x82, 0x60, 0x20,
+  0x02, 0x04, 0x26, 0x66, 0x88, 0x8A, 0x6C, 0x2C, 0x0A, 0xFF, 0x40, 0x4C,
+  0x0C, 0x80, 0xFF, 0x10, 0x21, 0x12, 0x01, 0x10, 0xFF, 0x7A, 0x8B, 0x7C,
+  0x6B, 0x7A, 0x8C, 0x24, 0x21, 0x30, 0x50, 0x61, 0x63, 0x08, 0x0A, 0x2C,
+  0x5C, 0x88, 0x10, 0x13, 0x30, 0x13, 0x19, 0x3C, 0x00, 0x23, 0x29, 0x0C,
+  0x43, 0x49, 0xFF, 0x14, 0x78, 0xFF, 0x18, 0x74, 0x43, 0x4B, 0xFF, 0x07,
+  0x87, 0x2B, 0x2C, 0x1E, 0x07, 0x67, 0x1B, 0x1C, 0x0C, 0x80, 0x20, 0x60,
+  0x82, 0x8A, 0x6C, 0x2C, 0x0A, 0x02, 0x20, 0x12, 0x40, 0x4C, 0xFF, 0x1C,
+  0x7C, 0x02, 0x20, 0x60, 0x82, 0x84, 0x0C, 0x8C, 0x01, 0x20, 0x60, 0x82,
+  0x84, 0x66, 0x36, 0xFF, 0x66, 0x88, 0x8A, 0x6C, 0x2C, 0x0B, 0x6C, 0x60,
+  0x08, 0x88, 0x80, 0x10, 0x05, 0x55, 0x87, 0x8A, 0x6C, 0x2C, 0x0B, 0x70,
+  0x40, 0x13, 0x06, 0x0A, 0x2C, 0x6C, 0x8A, 0x88, 0x66, 0x26, 0x08, 0x00,
+  0x80, 0x3C, 0x20, 0x60, 0x82, 0x84, 0x66, 0x26, 0x04, 0x02, 0x20, 0xFF,
+  0x26, 0x08, 0x0A, 0x2C, 0x6C, 0x8A, 0x88, 0x66, 0x84, 0x66, 0x26, 0x04,
+  0x02, 0x20, 0x60, 0x82, 0x86, 0x79, 0x4C, 0x1C, 0x14, 0x15, 0xFF, 0x1B,
+  0x1C, 0x14, 0x15, 0xFF, 0x1B, 0x1C, 0x0E, 0x73, 0x07, 0x7B, 0x05, 0x85,
+  0xFF, 0x09, 0x89, 0x03, 0x77, 0x0B, 0x02, 0x20, 0x60, 0x82, 0x84, 0x47,
+  0x48, 0xFF, 0x4B, 0x4C, 0x68, 0x64, 0x43, 0x24, 0x27, 0x38, 0x68, 0x86,
+  0x82, 0x60, 0x20, 0x02, 0x0A, 0x2C, 0x7C, 0x0C, 0x40, 0x8C, 0xFF, 0x27,
+  0x67, 0x00, 0x0C, 0x6C, 0x8A, 0x88, 0x66, 0x06, 0xFF, 0x00, 0x50, 0x72,
+  0x74, 0x56, 0x82, 0x60, 0x20, 0x02, 0x0A, 0x2C, 0x6C, 0x8A, 0x00, 0x0C,
+  0x5C, 0x89, 0x83, 0x50, 0x00, 0x80, 0x00, 0x0C, 0x8C, 0xFF, 0x06, 0x56,
+  0x80, 0x00, 0x0C, 0xFF, 0x06, 0x56, 0x82, 0x60, 0x20, 0x02, 0x0A, 0x2C,
+  0x6C, 0x8A, 0x87, 0x57, 0x00, 0x0C, 0xFF, 0x80, 0x8C, 0xFF, 0x06, 0x86,
+  0x10, 0x50, 0xFF, 0x30, 0x3C, 0xFF, 0x1C, 0x5C, 0x70, 0x7A, 0x5C, 0x2C,
+  0x0A, 0x00, 0x0C, 0xFF, 0x80, 0x08, 0xFF, 0x35, 0x8C, 0x00, 0x0C, 0x7C,
+  0x0C, 0x00, 0x58, 0xA0, 0xAC, 0x0C, 0x00, 0x8C, 0x80, 0x20, 0x60, 0x82,
+  0x8A, 0x6C, 0x2C, 0x0A, 0x02, 0x20, 0x0C, 0x00, 0x60, 0x82, 0x84, 0x66,
+  0x06, 0x20, 0x60, 0x82, 0x8A, 0x6C, 0x2C, 0x0A, 0x02, 0x20, 0xFF, 0x59,
+  0x9D, 0x0C, 0x00, 0x60, 0x82, 0x84, 0x66, 0x06, 0xFF, 0x46, 0x8C, 0x82,
+  0x60, 0x20, 0x02, 0x04, 0x26, 0x66, 0x88, 0x8A, 0x6C, 0x2C, 0x0A, 0x00,
+  0x80, 0xFF, 0x40, 0x4C, 0x00, 0x0A, 0x2C, 0x6C, 0x8A, 0x80, 0x00, 0x4C,
+  0x80, 0x00, 0x2C, 0x54, 0x8C, 0xA0, 0x00, 0x8C, 0xFF, 0x80, 0x0C, 0x00,
+  0x46, 0x80, 0xFF, 0x46, 0x4C, 0x00, 0x80, 0x0C, 0x8C, 0x30, 0x00, 0x0C,
+  0x3C, 0x00, 0x8C, 0x00, 0x30, 0x3C, 0x0C, 0x04, 0x40, 0x84, 0x0E, 0x8E,
+  0x00, 0x22, 0x75, 0x7C, 0xFF, 0x77, 0x55, 0x25, 0x07, 0x0A, 0x2C, 0x5C,
+  0x7A, 0x00, 0x0C, 0xFF, 0x07, 0x25, 0x55, 0x77, 0x7A, 0x5C, 0x2C, 0x0A,
+  0x76, 0x65, 0x25, 0x07, 0x0A, 0x2C, 0x6C, 0x7B, 0x70, 0x7C, 0xFF, 0x77,
+  0x55, 0x25, 0x07, 0x0A, 0x2C, 0x5C, 0x7A, 0x09, 0x79, 0x77, 0x55, 0x25,
+  0x07, 0x0A, 0x2C, 0x6C, 0x7B, 0x50, 0x30, 0x21, 0x2C, 0xFF, 0x05, 0x55,
+  0x75, 0x7D, 0x5F, 0x1F, 0xFF, 0x77, 0x55, 0x25, 0x07, 0x0A, 0x2C, 0x5C,
+  0x7A, 0x00, 0x0C, 0xFF, 0x07, 0x25, 0x55, 0x77, 0x7C, 0x12, 0x13, 0xFF,
+  0x15, 0x1C, 0x32, 0x33, 0xFF, 0x35, 0x3D, 0x1F, 0x0F, 0x00, 0x0C, 0xFF,
+  0x65, 0x0A, 0xFF, 0x28, 0x6C, 0x10, 0x1C, 0x0C, 0x05, 0xFF, 0x07, 0x15,
+  0x35, 0x47, 0x4C, 0xFF, 0x47, 0x55, 0x75, 0x87, 0x8C, 0x0C, 0x05, 0xFF,
+  0x07, 0x25, 0x55, 0x77, 0x7C, 0x25, 0x55, 0x77, 0x7A, 0x5C, 0x2C, 0x0A,
+  0x07, 0x25, 0x05, 0x0F, 0xFF, 0x07, 0x25, 0x55, 0x77, 0x7A, 0x5C, 0x2C,
+  0x0A, 0x75, 0x7F, 0xFF, 0x77, 0x55, 0x25, 0x07, 0x0A, 0x2C, 0x5C, 0x7A,
+  0x0C, 0x05, 0xFF, 0x08, 0x35, 0x65, 0x76, 0x65, 0x15, 0x06, 0x07, 0x18,
+  0x69, 0x7A, 0x7B, 0x6C, 0x1C, 0x0B, 0x21, 0x2A, 0x4C, 0x6C, 0xFF, 0x05,
+  0x55, 0x05, 0x0A, 0x2C, 0x5C, 0x7A, 0xFF, 0x75, 0x7C, 0x05, 0x4C, 0x85,
+  0x05, 0x2C, 0x47, 0x6C, 0x85, 0x05, 0x7C, 0xFF, 0x75, 0x0C, 0x05, 0x4C,
+  0xFF, 0x85, 0x4C, 0x2F, 0x0F, 0x05, 0x75, 0x0C, 0x7C, 0x40, 0x22, 0x25,
+  0x06, 0x27, 0x2A, 0x4C, 0x10, 0x1E, 0x00, 0x22, 0x25, 0x46, 0x27, 0x2A,
+  0x0C, 0x07, 0x25, 0x58, 0x76,
+};
+
+static const StrokeGlyph stroke_sans_Glyphs[] = {
+  {    0,  0,  6 }, // 0x20 ' '
+  {    0,  5,  4 }, // 0x21 '!'
+  {    5,  5,  7 }, // 0x22 '"'
+  {   10, 11, 11 }, // 0x23 '#'
+  {   21, 15, 11 }, // 0x24 '$'
+  {   36, 14, 11 }, // 0x25 '%'
+  {   50, 12, 11 }, // 0x26 '&'
+  {   62,  2,  4 }, // 0x27 '''
+  {   64,  4,  6 }, // 0x28 '('
+  {   68,  4,  5 }, // 0x29 ')'
+  {   72,  8, 10 }, // 0x2A '*'
+  {   80,  5, 11 }, // 0x2B '+'
+  {   85,  3,  5 }, // 0x2C ','
+  {   88,  2,  9 }, // 0x2D '-'
+  {   90,  2,  4 }, // 0x2E '.'
+  {   92,  2, 11 }, // 0x2F '/'
+  {   94,  9, 11 }, // 0x30 '0'
+  {  103,  6, 10 }, // 0x31 '1'
+  {  109,  7, 11 }, // 0x32 '2'
+  {  116, 14, 11 }, // 0x33 '3'
+  {  130,  4, 11 }, // 0x34 '4'
+  {  134,  9, 11 }, // 0x35 '5'
+  {  143, 12, 11 }, // 0x36 '6'
+  {  155,  3, 11 }, // 0x37 '7'
+  {  158, 18, 11 }, // 0x38 '8'
+  {  176, 12, 11 }, // 0x39 '9'
+  {  188,  5,  4 }, // 0x3A ':'
+  {  193,  6,  4 }, // 0x3B ';'
+  {  199,  3, 10 }, // 0x3C '<'
+  {  202,  5, 11 }, // 0x3D '='
+  {  207,  3, 10 }, // 0x3E '>'
+  {  210, 10, 11 }, // 0x3F '?'
+  {  220, 15, 11 }, // 0x40 '@'
+  {  235,  6, 11 }, // 0x41 'A'
+  {  241, 13, 11 }, // 0x42 'B'
+  {  254,  8, 11 }, // 0x43 'C'
+  {  262,  7, 11 }, // 0x44 'D'
+  {  269,  7, 11 }, // 0x45 'E'
+  {  276,  6, 11 }, // 0x46 'F'
+  {  282, 10, 11 }, // 0x47 'G'
+  {  292,  8, 11 }, // 0x48 'H'
+  {  300,  8,  8 }, // 0x49 'I'
+  {  308,  5, 10 }, // 0x4A 'J'
+  {  313,  8, 11 }, // 0x4B 'K'
+  {  321,  3, 10 }, // 0x4C 'L'
+  {  324,  5, 13 }, // 0x4D 'M'
+  {  329,  4, 11 }, // 0x4E 'N'
+  {  333,  9, 11 }, // 0x4F 'O'
+  {  342,  7, 11 }, // 0x50 'P'
+  {  349, 12, 12 }, // 0x51 'Q'
+  {  361, 10, 11 }, // 0x52 'R'
+  {  371, 12, 11 }, // 0x53 'S'
+  {  383,  5, 11 }, // 0x54 'T'
+  {  388,  6, 11 }, // 0x55 'U'
+  {  394,  3, 11 }, // 0x56 'V'
+  {  397,  5, 13 }, // 0x57 'W'
+  {  402,  5, 11 }, // 0x58 'X'
+  {  407,  6, 11 }, // 0x59 'Y'
+  {  413,  4, 11 }, // 0x5A 'Z'
+  {  417,  4,  6 }, // 0x5B '['
+  {  421,  2, 11 }, // 0x5C 'backslash'
+  {  423,  4,  6 }, // 0x5D ']'
+  {  427,  3, 11 }, // 0x5E '^'
+  {  430,  2, 11 }, // 0x5F '_'
+  {  432,  2,  5 }, // 0x60 '`'
+  {  434, 11, 10 }, // 0x61 'a'
+  {  445, 11, 10 }, // 0x62 'b'
+  {  456,  8, 10 }, // 0x63 'c'
+  {  464, 11, 10 }, // 0x64 'd'
+  {  475, 10, 10 }, // 0x65 'e'
+  {  485,  7,  8 }, // 0x66 'f'
+  {  492, 13, 10 }, // 0x67 'g'
+  {  505,  8, 10 }, // 0x68 'h'
+  {  513,  5,  4 }, // 0x69 'i'
+  {  518,  7,  6 }, // 0x6A 'j'
+  {  525,  8,  9 }, // 0x6B 'k'
+  {  533,  2,  4 }, // 0x6C 'l'
+  {  535, 14, 11 }, // 0x6D 'm'
+  {  549,  8, 10 }, // 0x6E 'n'
+  {  557,  9, 10 }, // 0x6F 'o'
+  {  566, 11, 10 }, // 0x70 'p'
+  {  577, 11, 10 }, // 0x71 'q'
+  {  588,  6,  9 }, // 0x72 'r'
+  {  594, 12, 10 }, // 0x73 's'
+  {  606,  7,  9 }, // 0x74 't'
+  {  613,  8, 10 }, // 0x75 'u'
+  {  621,  3, 11 }, // 0x76 'v'
+  {  624,  5, 11 }, // 0x77 'w'
+  {  629,  5, 10 }, // 0x78 'x'
+  {  634,  7, 11 }, // 0x79 'y'
+  {  641,  4, 10 }, // 0x7A 'z'
+  {  645,  7,  7 }, // 0x7B '{'
+  {  652,  2,  4 }, // 0x7C '|'
+  {  654,  7,  7 }, // 0x7D '}'
+  {  661,  4, 10 }, // 0x7E '~'
+};
+
+/**
+ * @brief Stroke font descriptor.
+ */
+static const StrokeFont stroke_sans_Font = {
+    .points = stroke_sans_Points,
+    .glyph = stroke_sans_Glyphs,
+    .first = 0x20, .last = 0x7E, .baseline = 12, .yAdvance = 18
+};
+
+
+static const ssd1306_font_handle_t FONT_STROKE_SANS = {
+    .type = FONT_TYPE_STROKE,
+    .font_data = &stroke_sans_Font
+};
+
+#endif
@@ -26,6 +26,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "ssd1306_fonts.h"
+#include "ssd1306_arena.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -62,8 +63,144 @@ typedef struct {
     int screen_width;            ///< Display width in pixels (e.g., 128).
     int screen_height;           ///< Display height in pixels (e.g., 64).
     gpio_num_t rst_pin;          ///< GPIO pin number for reset (use -1 if not used).
+    bool fast_boot;              ///< Minimize time to first pixel: datasheet-minimum reset pulse, and the init
+                                 ///< sequence, first frame and display-on sent as one I2C transaction.
+    const uint8_t *boot_frame;   ///< Optional first frame (e.g. a splash image) in framebuffer layout
+                                 ///< (width * height / 8 bytes, page-major). NULL shows a blank screen.
+    bool no_framebuffer;         ///< Immediate mode: allocate no framebuffer and draw only with the
+                                 ///< page-aligned `ssd1306_direct_*` functions.
+    ssd1306_arena_handle_t arena; ///< Optional arena for all of the driver's buffers, the first framebuffer
+                                 ///< included (see `ssd1306_set_arena`; not owned). NULL uses the heap.
 } ssd1306_config_t;
 
+/**
+ * @brief Hardware scroll direction.
+ */
+typedef enum {
+    SSD1306_SCROLL_RIGHT = 0,      ///< Horizontal scroll to the right.
+    SSD1306_SCROLL_LEFT,           ///< Horizontal scroll to the left.
+    SSD1306_SCROLL_VERTICAL_RIGHT, ///< Vertical and right horizontal (diagonal) scroll.
+    SSD1306_SCROLL_VERTICAL_LEFT,  ///< Vertical and left horizontal (diagonal) scroll.
+} ssd1306_scroll_dir_t;
+
+/**
+ * @brief Hardware scroll step interval, in frames per step.
+ *
+ * The values are the raw SSD1306 interval codes, which are not ordered by speed.
+ */
+typedef enum {
+    SSD1306_SCROLL_FRAMES_5 = 0,   ///< One step every 5 frames.
+    SSD1306_SCROLL_FRAMES_64 = 1,  ///< One step every 64 frames.
+    SSD1306_SCROLL_FRAMES_128 = 2, ///< One step every 128 frames.
+    SSD1306_SCROLL_FRAMES_256 = 3, ///< One step every 256 frames (slowest).
+    SSD1306_SCROLL_FRAMES_3 = 4,   ///< One step every 3 frames.
+    SSD1306_SCROLL_FRAMES_4 = 5,   ///< One step every 4 frames.
+    SSD1306_SCROLL_FRAMES_25 = 6,  ///< One step every 25 frames.
+    SSD1306_SCROLL_FRAMES_2 = 7,   ///< One step every 2 frames (fastest).
+} ssd1306_scroll_speed_t;
+
+/**
+ * @brief Hardware scroll configuration.
+ *
+ * @see ssd1306_scroll_start
+ */
+typedef struct {
+    ssd1306_scroll_dir_t direction; ///< Scroll direction.
+    uint8_t start_page;             ///< First scrolled page (0-7).
+    uint8_t end_page;               ///< Last scrolled page (0-7, >= start_page).
+    uint8_t start_col;              ///< First scrolled column (horizontal scroll only).
+    uint8_t end_col;                ///< Last scrolled column (horizontal scroll only). A full-width range is
+                                    ///< sent as the classic dummy bytes for controllers without column support.
+    ssd1306_scroll_speed_t speed;   ///< Step interval.
+    uint8_t vertical_offset;        ///< Rows moved per step for the vertical variants (1 to height-1).
+} ssd1306_scroll_config_t;
+
+/**
+ * @brief Hardware scroll state.
+ */
+typedef enum {
+    SSD1306_SCROLL_STATE_STOPPED = 0, ///< No scroll is running.
+    SSD1306_SCROLL_STATE_PENDING,     ///< A scroll start is queued or waiting for its settle time.
+    SSD1306_SCROLL_STATE_ACTIVE,      ///< The controller is scrolling.
+} ssd1306_scroll_state_t;
+
+/**
+ * @brief Bus statistics of a display (or of one panel of a tiled display).
+ *
+ * @see ssd1306_get_stats
+ */
+typedef struct {
+    uint32_t transactions; ///< I2C transactions issued.
+    uint32_t bytes;        ///< Bytes written, including address and control bytes.
+    uint32_t errors;       ///< Failed transactions (each retry counts).
+    uint64_t busy_us;      ///< Time spent inside I2C transactions.
+    uint64_t elapsed_us;   ///< Time since creation or the last `ssd1306_reset_stats`.
+    uint8_t utilization;   ///< Bus busy time in percent of elapsed time (busiest bus for a tiled display).
+    uint32_t cache_hits;   ///< Primitives replayed from the raster cache (display statistics only).
+    uint32_t cache_misses; ///< Cacheable primitives that had to be rasterized (display statistics only).
+    uint8_t cache_hit_rate; ///< Raster cache hits in percent of lookups.
+    uint32_t cache_bytes;  ///< Bytes of rasters held by the raster cache.
+} ssd1306_stats_t;
+
+/**
+ * @brief Configuration of a logical display made of a grid of SSD1306 panels.
+ *
+ * The panels must share the same resolution. Panels may share an I2C port (with distinct
+ * addresses) or use separate ports; panels on separate ports are flushed in parallel.
+ *
+ * @see ssd1306_create_tiled
+ */
+typedef struct {
+    uint8_t cols;                     ///< Panels per row.
+    uint8_t rows;                     ///< Panel rows.
+    const ssd1306_config_t *panels;   ///< `cols * rows` panel configurations, row-major from the top left.
+    uint32_t flush_task_stack;        ///< Stack size of the per-port flush tasks (0 = 3072).
+    uint8_t flush_task_priority;      ///< Priority of the per-port flush tasks (0 = 5).
+} ssd1306_tiled_config_t;
+
+/**
+ * @brief Boot latency measurement of a display instance.
+ *
+ * Timestamps are `esp_timer_get_time()` values, i.e. microseconds since chip boot,
+ * so `first_pixel_us` is the boot-to-first-pixel time of the application.
+ *
+ * @see ssd1306_get_boot_timing
+ */
+typedef struct {
+    int64_t create_start_us;           ///< Time at which `ssd1306_create` was entered.
+    int64_t first_pixel_us;            ///< Time at which the first frame had been sent to the panel.
+    uint32_t create_to_first_pixel_us; ///< Time spent by the driver between the two.
+} ssd1306_boot_timing_t;
+
+/**
+ * @brief What happens to the framebuffer while the display is off.
+ *
+ * @see ssd1306_set_suspend_mode
+ */
+typedef enum {
+    SSD1306_SUSPEND_NONE = 0, ///< Keep the framebuffer allocated (default).
+    SSD1306_SUSPEND_COMPRESS, ///< Replace it with a run-length compressed copy; restored exactly on next use.
+    SSD1306_SUSPEND_DISCARD,  ///< Free it; on next use it restarts blank and the whole panel is rewritten.
+} ssd1306_suspend_mode_t;
+
+/**
+ * @brief Page-format image, usually generated by the asset compiler (`tools/asset_compiler`).
+ *
+ * Each frame is `width` columns by `(height + 7) / 8` pages in framebuffer layout (bit 0
+ * on top), stored raw or run-length compressed. Sprite sheets hold several frames of
+ * the same size.
+ *
+ * @see ssd1306_draw_asset
+ */
+typedef struct {
+    uint16_t width;          ///< Frame width in pixels.
+    uint16_t height;         ///< Frame height in pixels.
+    uint16_t frames;         ///< Number of frames.
+    bool rle;                ///< Frames are run-length compressed.
+    const uint8_t *data;     ///< Frame data, back to back.
+    const uint32_t *offsets; ///< Start of each frame in `data`, plus the end of the last one (`frames + 1` entries).
+} ssd1306_asset_t;
+
 /**
  * @brief Opaque handle for an SSD1306 display instance.
  *
@@ -74,6 +211,20 @@ typedef struct {
  */
 typedef struct ssd1306_dev_t* ssd1306_handle_t;
 
+/**
+ * @brief Callback invoked when a display command fails to reach the panel.
+ *
+ * Setters such as `ssd1306_set_contrast` have no return value, so transmission
+ * errors of their commands are reported through this callback.
+ *
+ * @param handle Display instance handle.
+ * @param err Error code of the failed transmission.
+ * @param user_ctx User context given at registration.
+ *
+ * @see ssd1306_set_cmd_error_callback
+ */
+typedef void (*ssd1306_cmd_error_cb_t)(ssd1306_handle_t handle, esp_err_t err, void *user_ctx);
+
 
 /**
  * @brief Creates a new SSD1306 driver instance.
@@ -86,6 +237,9 @@ typedef struct ssd1306_dev_t* ssd1306_handle_t;
  * @return esp_err_t Operation status (ESP_OK on success, otherwise error code).
  *
  * @note Ensure I2C pins and address are correctly configured before calling this function.
+ * @note The display shows `config->boot_frame` (or a blank screen) on return. With
+ * `config->fast_boot`, the panel is only switched on together with that frame, so no
+ * power-on garbage or intermediate blank frame is ever visible.
  */
 esp_err_t ssd1306_create(const ssd1306_config_t *config, ssd1306_handle_t *out_handle);
 
@@ -99,16 +253,370 @@ esp_err_t ssd1306_create(const ssd1306_config_t *config, ssd1306_handle_t *out_h
  */
 esp_err_t ssd1306_delete(ssd1306_handle_t *handle);
 
+/**
+ * @brief Gets the boot latency measured while the display was created.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[out] out Pointer to store the measurement.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments.
+ */
+esp_err_t ssd1306_get_boot_timing(ssd1306_handle_t handle, ssd1306_boot_timing_t *out);
+
+/**
+ * @brief Gets a buffer size that always holds a snapshot of this display.
+ *
+ * Typical snapshots are much smaller, since the framebuffer is run-length compressed.
+ *
+ * @param[in] handle Display instance handle.
+ * @return size_t Worst-case snapshot size in bytes.
+ */
+size_t ssd1306_snapshot_max_size(ssd1306_handle_t handle);
+
+/**
+ * @brief Saves the framebuffer and the panel state into a compact snapshot.
+ *
+ * The snapshot holds the compressed framebuffer, the pending dirty area and the register
+ * values the panel currently holds (contrast, inversion, orientation, start line, power).
+ * Store it where it survives deep sleep, e.g. an `RTC_NOINIT_ATTR` buffer, and pass it to
+ * `ssd1306_attach` after wake-up.
+ *
+ * @note Queued deferred commands must be flushed and hardware scrolling stopped first.
+ * When the panel has a reset pin, keep it high during sleep (e.g. with `gpio_hold_en`).
+ *
+ * @param[in] handle Display instance handle.
+ * @param[out] buf Destination buffer.
+ * @param[in] buf_size Size of `buf`.
+ * @param[out] out_len Optional pointer to store the snapshot length.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_SIZE if `buf` is too small,
+ *         ESP_ERR_INVALID_STATE if commands are queued or a scroll is running,
+ *         ESP_ERR_NOT_SUPPORTED without a framebuffer, ESP_ERR_NO_MEM if a suspended
+ *         framebuffer cannot be restored.
+ */
+esp_err_t ssd1306_save_snapshot(ssd1306_handle_t handle, void *buf, size_t buf_size, size_t *out_len);
+
+/**
+ * @brief Attaches a new driver instance to a panel that kept running (warm attach).
+ *
+ * Use this after deep sleep while the panel stayed powered and kept its GDDRAM. The
+ * handle is rebuilt from a snapshot saved by `ssd1306_save_snapshot`: no reset, init
+ * sequence or clear frame is sent, and the first `ssd1306_update_screen` only sends
+ * what changed since the snapshot.
+ *
+ * @param[in] config Pointer to the SSD1306 configuration structure (same panel as the snapshot).
+ * @param[in] snapshot Snapshot data.
+ * @param[in] len Length of the snapshot data.
+ * @param[out] out_handle Pointer to store the display instance handle.
+ * @return esp_err_t ESP_OK on success; ESP_ERR_INVALID_STATE or ESP_ERR_INVALID_CRC if the
+ *         snapshot is missing, corrupted or belongs to another panel. In that case fall back
+ *         to `ssd1306_create`.
+ */
+esp_err_t ssd1306_attach(const ssd1306_config_t *config, const void *snapshot, size_t len, ssd1306_handle_t *out_handle);
+
+/**
+ * @brief Creates a logical display spanning a grid of SSD1306 panels.
+ *
+ * The returned handle behaves like a single display of `cols * width` by `rows * height`
+ * pixels with one framebuffer. `ssd1306_update_screen` splits the dirty area into each
+ * panel's span; panels untouched by a change are not written. When the panels use more
+ * than one I2C port, one flush task per port writes them concurrently and the update
+ * returns once every bus is done.
+ *
+ * @note Hardware scrolling and page flipping are not available on tiled displays.
+ *
+ * @param[in] config Pointer to the tiled display configuration.
+ * @param[out] out_handle Pointer to store the created display instance handle.
+ * @return esp_err_t Operation status (ESP_OK on success, otherwise error code).
+ *         ESP_ERR_INVALID_ARG if two panels share an I2C port and address.
+ */
+esp_err_t ssd1306_create_tiled(const ssd1306_tiled_config_t *config, ssd1306_handle_t *out_handle);
+
+/**
+ * @brief Gets the number of physical panels driven by a display handle.
+ *
+ * @param[in] handle Display instance handle.
+ * @return uint8_t Panel count (1 for a display created with `ssd1306_create`).
+ */
+uint8_t ssd1306_get_panel_count(ssd1306_handle_t handle);
+
+/**
+ * @brief Gets the bus statistics of a display, summed over all of its panels.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[out] out Pointer to store the statistics.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments.
+ */
+esp_err_t ssd1306_get_stats(ssd1306_handle_t handle, ssd1306_stats_t *out);
+
+/**
+ * @brief Gets the bus statistics of one panel.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] panel Panel index (row-major; 0 for a plain display).
+ * @param[out] out Pointer to store the statistics.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments.
+ */
+esp_err_t ssd1306_get_panel_stats(ssd1306_handle_t handle, uint8_t panel, ssd1306_stats_t *out);
+
+/**
+ * @brief Resets the bus statistics of all panels and restarts the measurement window.
+ *
+ * @param[in] handle Display instance handle.
+ */
+void ssd1306_reset_stats(ssd1306_handle_t handle);
+
 /**
  * @brief Updates the display with the contents of the internal buffer.
  *
  * Transmits the internal buffer data to the SSD1306 display via I2C for rendering.
+ * In immediate mode there is nothing to transmit; queued commands go out with the
+ * next `ssd1306_direct_*` call instead.
  *
  * @param[in] handle Display instance handle.
- * @return esp_err_t Operation status (ESP_OK on success).
+ * @return esp_err_t Operation status (ESP_OK on success), ESP_ERR_NOT_SUPPORTED without
+ *         a framebuffer, ESP_ERR_NO_MEM if a suspended framebuffer cannot be restored.
  */
 esp_err_t ssd1306_update_screen(ssd1306_handle_t handle);
 
+/**
+ * @defgroup SSD1306_Direct Immediate mode
+ * @brief Page-aligned drawing straight into panel RAM, for handles created with
+ * `no_framebuffer`.
+ *
+ * Every call sends one I2C transaction with a column/page window and its data. Positions
+ * are given in columns and pages (8-row units); areas outside the page grid are rejected.
+ * The framebuffer-based drawing functions have no effect in this mode.
+ * @{
+ */
+
+/**
+ * @brief Fills whole pages of a column range with a byte pattern.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] col First column.
+ * @param[in] page First page.
+ * @param[in] w Width in columns.
+ * @param[in] pages Height in pages.
+ * @param[in] pattern Byte written to every column (bit 0 is the top row; 0x00 clears).
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG for an area outside the display,
+ *         ESP_ERR_INVALID_STATE if the handle has a framebuffer.
+ */
+esp_err_t ssd1306_direct_fill(ssd1306_handle_t handle, uint8_t col, uint8_t page, uint8_t w, uint8_t pages, uint8_t pattern);
+
+/**
+ * @brief Draws a bitmap in page layout at a page-aligned position.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] col First column.
+ * @param[in] page First page.
+ * @param[in] bitmap `pages` rows of `w` bytes; each byte is a vertical strip of 8 pixels (bit 0 on top).
+ * @param[in] w Width in columns.
+ * @param[in] pages Height in pages.
+ * @return esp_err_t Operation status (ESP_OK on success).
+ */
+esp_err_t ssd1306_direct_draw_bitmap(ssd1306_handle_t handle, uint8_t col, uint8_t page, const uint8_t *bitmap, uint8_t w, uint8_t pages);
+
+/**
+ * @brief Prints text into a row of character cells one page high, using the current font.
+ *
+ * Cells are overwritten completely, so no erase is needed when text changes. Fonts taller
+ * than 8 pixels (`yAdvance > 8`) are not supported.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] col First column.
+ * @param[in] page Text row (page).
+ * @param[in] text String to print; text past the right edge is cut off.
+ * @param[in] color `OLED_COLOR_WHITE` for lit text, `OLED_COLOR_BLACK` for inverted cells.
+ * @return esp_err_t Operation status (ESP_OK on success).
+ */
+esp_err_t ssd1306_direct_print(ssd1306_handle_t handle, uint8_t col, uint8_t page, const char *text, ssd1306_color_t color);
+
+/**
+ * @brief Draws a horizontal bar one page high, with end caps and an outlined empty part.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] col First column.
+ * @param[in] page Bar row (page).
+ * @param[in] w Bar width in columns.
+ * @param[in] filled Number of filled columns.
+ * @return esp_err_t Operation status (ESP_OK on success).
+ */
+esp_err_t ssd1306_direct_draw_hbar(ssd1306_handle_t handle, uint8_t col, uint8_t page, uint8_t w, uint8_t filled);
+
+/**
+ * @brief Draws a vertical bar that grows from the bottom of a page range.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] col First column.
+ * @param[in] w Bar width in columns.
+ * @param[in] page Top page of the bar area.
+ * @param[in] pages Height of the bar area in pages.
+ * @param[in] level Lit rows, counted from the bottom of the area.
+ * @return esp_err_t Operation status (ESP_OK on success).
+ */
+esp_err_t ssd1306_direct_draw_vbar(ssd1306_handle_t handle, uint8_t col, uint8_t w, uint8_t page, uint8_t pages, uint16_t level);
+
+/**
+ * @brief Gets the bus cost of the last immediate-mode call.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[out] out Transactions, bytes, errors and bus time of that call
+ *                 (`elapsed_us` and `utilization` are zero).
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments.
+ */
+esp_err_t ssd1306_direct_get_last_cost(ssd1306_handle_t handle, ssd1306_stats_t *out);
+
+/** @} */
+
+/**
+ * @brief Enables or disables GDDRAM page flipping (hardware double buffering).
+ *
+ * Panels with at most 32 rows use only half of the controller's 64-row GDDRAM. In this
+ * mode each `ssd1306_update_screen` writes into the hidden half and then presents it by
+ * changing the display start line in the same transaction, so a frame never appears
+ * half-written. The dirty area written is the union of the current and the previous
+ * update, because the hidden half is one frame behind. No RAM copy is needed.
+ *
+ * Disabling takes effect on the bus with the next `ssd1306_update_screen`: if the upper
+ * half is shown, that update writes the whole frame into the lower half and switches
+ * back to it in the same transaction, and until then the current frame stays on screen.
+ *
+ * @note While enabled, the display start line is owned by the driver and
+ * `ssd1306_set_display_start_line` is ignored.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] enable True to enable page flipping, false to return to single buffering.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_SUPPORTED for panels taller than 32 rows
+ *         or tiled displays.
+ */
+esp_err_t ssd1306_set_page_flip(ssd1306_handle_t handle, bool enable);
+
+/**
+ * @brief Selects what happens to the framebuffer while the display is off.
+ *
+ * The panel keeps showing (or, once switched on again, shows) its GDDRAM content, so
+ * the framebuffer is only needed to draw. With a suspend mode set, `ssd1306_display_off`
+ * compresses or frees the framebuffer, and it is rebuilt on the first drawing call or
+ * update after that. In compress mode the rebuilt framebuffer matches the panel, so no
+ * resend is needed. Nothing is released while a hardware scroll is running.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] mode Suspend mode. Applies immediately if the display is already off;
+ *                 `SSD1306_SUSPEND_NONE` restores a suspended framebuffer right away.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM if the framebuffer cannot be restored.
+ */
+esp_err_t ssd1306_set_suspend_mode(ssd1306_handle_t handle, ssd1306_suspend_mode_t mode);
+
+/**
+ * @brief Enables or disables deferred command mode.
+ *
+ * In deferred mode, `ssd1306_set_contrast`, `ssd1306_invert_display`,
+ * `ssd1306_set_display_start_line`, `ssd1306_set_orientation` and the scroll functions
+ * do not touch the bus. Their commands are queued, deduplicated (the last value of each
+ * kind wins) and sent in the same I2C transaction as the next `ssd1306_update_screen`
+ * (in immediate mode, the next `ssd1306_direct_*` call).
+ * Scroll activation is placed after the framebuffer data, as the controller requires.
+ * Errors are returned by `ssd1306_update_screen` and also reported to the command
+ * error callback.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] enable True to queue commands, false to send them immediately (any queued
+ *                   commands are flushed right away).
+ * @return esp_err_t Operation status (ESP_OK on success).
+ */
+esp_err_t ssd1306_set_deferred_commands(ssd1306_handle_t handle, bool enable);
+
+/**
+ * @brief Enables the raster cache for repeated complex primitives.
+ *
+ * `ssd1306_draw_circle`, `ssd1306_fill_circle`, `ssd1306_draw_round_rect`,
+ * `ssd1306_fill_round_rect` and `ssd1306_print` (single-line text with a transparent
+ * background, see `ssd1306_set_text_color`) then keep their result as a page-format
+ * mask, keyed by the primitive and its parameters but not by its position. Drawing the
+ * same primitive again at any x, and at any y with the same row offset within a page,
+ * replays the mask as a byte-wise blit instead of rasterizing it. Glyphs of
+ * `ssd1306_print_rotated` are kept too, at any position. Rasters live in a pool
+ * of `pool_bytes`; the least recently used ones are evicted when it is full.
+ *
+ * Only white and black drawing is cached, and a raster is only recorded from a shape
+ * that lies entirely on screen. Hits, misses and the bytes held are reported by
+ * `ssd1306_get_stats`.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] pool_bytes Pool size in bytes, or 0 to disable the cache. Any cached
+ *                       rasters are dropped.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM if the pool cannot be allocated,
+ *         ESP_ERR_NOT_SUPPORTED without a framebuffer.
+ */
+esp_err_t ssd1306_set_raster_cache(ssd1306_handle_t handle, size_t pool_bytes);
+
+/**
+ * @brief Takes the driver's buffers from an arena instead of the heap.
+ *
+ * The framebuffer (including when it is restored after a suspend), the compressed copy
+ * kept while suspended, the raster cache, large temporary buffers and canvases from
+ * `ssd1306_alloc_canvas` or `ssd1306_alloc_buffer` then come from `arena`. Buffers that
+ * already exist are moved into it; if they do not all fit, nothing changes. One arena
+ * can serve several displays. With a block size equal to the screen width, a
+ * framebuffer takes exactly one block per page. To keep even the first framebuffer off
+ * the heap, pass the arena in `ssd1306_config_t::arena` instead.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] arena Arena, or NULL to go back to the heap.
+ * @param[in] take_ownership True to delete the arena in `ssd1306_delete`, after the
+ *            display's buffers have been returned to it.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on an invalid handle,
+ *         ESP_ERR_INVALID_STATE while canvases or buffers from the current arena are
+ *         still allocated, ESP_ERR_NO_MEM if the buffers do not fit.
+ * @see ssd1306_arena_create, ssd1306_arena_get_stats
+ */
+esp_err_t ssd1306_set_arena(ssd1306_handle_t handle, ssd1306_arena_handle_t arena, bool take_ownership);
+
+/**
+ * @brief Allocates a buffer the way the driver allocates its own: from the display's
+ * arena when one is attached, otherwise from the heap. Used by the add-on modules for
+ * their temporary buffers.
+ *
+ * @param[in] handle Display instance handle, or NULL for the heap.
+ * @param[in] len Bytes needed.
+ * @return void* Buffer, or NULL if out of memory.
+ */
+void *ssd1306_alloc_buffer(ssd1306_handle_t handle, size_t len);
+
+/**
+ * @brief Frees a buffer from `ssd1306_alloc_buffer`.
+ *
+ * @param[in] handle Display instance handle the buffer was allocated with (or NULL).
+ * @param[in] buf Buffer, or NULL.
+ */
+void ssd1306_free_buffer(ssd1306_handle_t handle, void *buf);
+
+/**
+ * @brief Allocates a blank canvas in framebuffer layout (`width * height / 8` bytes),
+ * e.g. a screen for `ssd1306_transition_begin` or `ssd1306_image_load`. It comes from
+ * the display's arena when one is attached.
+ *
+ * @param[in] handle Display instance handle.
+ * @return uint8_t* Canvas, or NULL if out of memory.
+ */
+uint8_t *ssd1306_alloc_canvas(ssd1306_handle_t handle);
+
+/**
+ * @brief Frees a canvas from `ssd1306_alloc_canvas`.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] canvas Canvas, or NULL.
+ */
+void ssd1306_free_canvas(ssd1306_handle_t handle, uint8_t *canvas);
+
+/**
+ * @brief Registers a callback for display command failures.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] cb Callback function, or NULL to remove it.
+ * @param[in] user_ctx User context passed to the callback.
+ */
+void ssd1306_set_cmd_error_callback(ssd1306_handle_t handle, ssd1306_cmd_error_cb_t cb, void *user_ctx);
+
 /**
  * @brief Clears the internal display buffer.
  *
@@ -153,6 +661,20 @@ void ssd1306_set_text_size(ssd1306_handle_t handle, uint8_t size);
  */
 void ssd1306_set_text_size_custom(ssd1306_handle_t handle, uint8_t size_x, uint8_t size_y);
 
+/**
+ * @brief Sets the size and pen width of stroke fonts (`FONT_TYPE_STROKE`).
+ *
+ * Stroke glyphs are polylines scaled in fixed point, so any capital height can be
+ * drawn from the same small glyph set. Without a height, the text size sets the scale
+ * (one pixel per grid unit at size 1). Stroke text has a transparent background, and
+ * since strokes overlap at their joints, OLED_COLOR_INVERT is not recommended.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] height Capital height in pixels, or 0 to follow `ssd1306_set_text_size`.
+ * @param[in] thickness Pen width in pixels (1 = default).
+ */
+void ssd1306_set_stroke_style(ssd1306_handle_t handle, uint16_t height, uint8_t thickness);
+
 /**
  * @brief Sets the font for text rendering.
  *
@@ -163,6 +685,16 @@ void ssd1306_set_text_size_custom(ssd1306_handle_t handle, uint8_t size_x, uint8
  */
 void ssd1306_set_font(ssd1306_handle_t handle, const ssd1306_font_handle_t *font_handle);
 
+/**
+ * @brief Gets the font used for text rendering.
+ *
+ * Lets a component that draws with its own font restore the caller's afterwards.
+ *
+ * @param[in] handle Display instance handle.
+ * @return const ssd1306_font_handle_t* Current font, or NULL for an invalid handle.
+ */
+const ssd1306_font_handle_t *ssd1306_get_font(ssd1306_handle_t handle);
+
 /**
  * @brief Sets the text cursor position.
  *
@@ -205,6 +737,43 @@ void ssd1306_set_text_color_bg(ssd1306_handle_t handle, ssd1306_color_t color, s
  */
 void ssd1306_set_text_wrap(ssd1306_handle_t handle, bool wrap);
 
+/**
+ * @brief Restricts all drawing to a rectangle.
+ *
+ * Drawing functions leave pixels outside the rectangle untouched, so partially visible
+ * content (e.g. a list row at the edge of its viewport) can be drawn without
+ * damaging its surroundings. The rectangle is limited to the screen.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] x Top-left x-coordinate.
+ * @param[in] y Top-left y-coordinate.
+ * @param[in] w Width.
+ * @param[in] h Height.
+ */
+void ssd1306_set_clip_rect(ssd1306_handle_t handle, int16_t x, int16_t y, int16_t w, int16_t h);
+
+/**
+ * @brief Resets the clip rectangle to the whole screen (the default).
+ *
+ * @param[in] handle Display instance handle.
+ */
+void ssd1306_reset_clip_rect(ssd1306_handle_t handle);
+
+/**
+ * @brief Gets the current clip rectangle.
+ *
+ * Passing the result to `ssd1306_set_clip_rect` restores it exactly, so a component
+ * can clip its own drawing and hand back the caller's rectangle afterwards.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[out] x Top-left x-coordinate (may be NULL).
+ * @param[out] y Top-left y-coordinate (may be NULL).
+ * @param[out] w Width (may be NULL).
+ * @param[out] h Height (may be NULL).
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG for an invalid handle.
+ */
+esp_err_t ssd1306_get_clip_rect(ssd1306_handle_t handle, int16_t *x, int16_t *y, int16_t *w, int16_t *h);
+
 /**
  * @brief Gets the current x-coordinate of the text cursor.
  *
@@ -262,6 +831,26 @@ size_t ssd1306_write(ssd1306_handle_t handle, uint8_t c);
  */
 size_t ssd1306_print(ssd1306_handle_t handle, const char* str);
 
+/**
+ * @brief Prints a string rotated clockwise by 90, 180 or 270 degrees (0 is allowed).
+ *
+ * The text is laid out around its baseline origin (x, y) and rotated about it: at 90
+ * degrees it runs down the screen with the glyph tops facing right, at 270 it runs up.
+ * Glyphs are rendered directly in page format and blitted byte-wise, and are kept in
+ * the raster cache when it is enabled. Uses the current GFX font at text size 1 and the
+ * current text colors; the cursor is not moved.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] x Baseline origin x.
+ * @param[in] y Baseline origin y.
+ * @param[in] str Null-terminated string; '\n' starts the next line in text direction.
+ * @param[in] angle Rotation in degrees: 0, 90, 180 or 270.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG for an invalid angle,
+ *         ESP_ERR_NOT_SUPPORTED for stroke fonts, glyphs larger than 64x64 without a cache
+ *         or a handle without framebuffer.
+ */
+esp_err_t ssd1306_print_rotated(ssd1306_handle_t handle, int16_t x, int16_t y, const char *str, uint16_t angle);
+
 /**
  * @brief Draws a single character at a specified position.
  *
@@ -306,6 +895,16 @@ void ssd1306_get_text_bounds(ssd1306_handle_t handle, const char* str, int16_t x
  */
 void ssd1306_draw_pixel(ssd1306_handle_t handle, int16_t x, int16_t y, ssd1306_color_t color);
 
+/**
+ * @brief Reads a single pixel from the internal buffer.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] x X-coordinate of the pixel.
+ * @param[in] y Y-coordinate of the pixel.
+ * @return bool True if the pixel is set; false if it is clear, off-screen, or there is no framebuffer.
+ */
+bool ssd1306_get_pixel(ssd1306_handle_t handle, int16_t x, int16_t y);
+
 /**
  * @brief Draws a straight line.
  *
@@ -508,6 +1107,27 @@ void ssd1306_draw_bitmap_bg(ssd1306_handle_t handle, int16_t x, int16_t y, const
  */
 void ssd1306_draw_xbitmap(ssd1306_handle_t handle, int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, ssd1306_color_t color);
 
+/**
+ * @brief Draws a frame of a page-format asset.
+ *
+ * The frame is blitted byte-wise at any position, clipped to the clip rectangle, with
+ * no per-pixel transposition. Compressed frames are expanded into a temporary buffer
+ * first.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] x Top-left x-coordinate.
+ * @param[in] y Top-left y-coordinate.
+ * @param[in] asset Asset.
+ * @param[in] frame Frame index.
+ * @param[in] color Color for set pixels.
+ * @param[in] bg_color Color for clear pixels, or the same as `color` to leave them untouched.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments,
+ *         ESP_ERR_INVALID_SIZE for a corrupt compressed frame, ESP_ERR_NOT_SUPPORTED
+ *         without a framebuffer, ESP_ERR_NO_MEM.
+ */
+esp_err_t ssd1306_draw_asset(ssd1306_handle_t handle, int16_t x, int16_t y, const ssd1306_asset_t *asset, uint16_t frame,
+                             ssd1306_color_t color, ssd1306_color_t bg_color);
+
 
 /**
  * @brief Sets the display inversion mode.
@@ -534,6 +1154,10 @@ void ssd1306_set_contrast(ssd1306_handle_t handle, uint8_t contrast);
  *
  * Activates a horizontal scrolling animation to the right for a specified page range.
  *
+ * @note In immediate mode, a start issued within the settle time of a stop that ended
+ *       a running scroll waits out the remainder of that time before returning. In
+ *       deferred mode it is sent with the next `ssd1306_update_screen`.
+ *
  * @param[in] handle Display instance handle.
  * @param[in] start_page Starting page for scrolling (0-7).
  * @param[in] end_page Ending page for scrolling (0-7).
@@ -545,6 +1169,10 @@ void ssd1306_start_scroll_right(ssd1306_handle_t handle, uint8_t start_page, uin
  *
  * Activates a horizontal scrolling animation to the left for a specified page range.
  *
+ * @note In immediate mode, a start issued within the settle time of a stop that ended
+ *       a running scroll waits out the remainder of that time before returning. In
+ *       deferred mode it is sent with the next `ssd1306_update_screen`.
+ *
  * @param[in] handle Display instance handle.
  * @param[in] start_page Starting page for scrolling (0-7).
  * @param[in] end_page Ending page for scrolling (0-7).
@@ -560,10 +1188,114 @@ void ssd1306_start_scroll_left(ssd1306_handle_t handle, uint8_t start_page, uint
  */
 void ssd1306_stop_scroll(ssd1306_handle_t handle);
 
+/**
+ * @brief Starts a hardware scroll without blocking.
+ *
+ * Stop, setup and activation are sent as a single command batch. The controller needs
+ * a settle time between scroll changes; instead of sleeping, a start issued too soon
+ * after the previous change sends the stop at once and parks only the setup and
+ * activation, which `ssd1306_scroll_poll` or the next `ssd1306_update_screen` send once
+ * the time has elapsed. In deferred command mode the batch is always sent with the next
+ * flush. Restarting a running scroll ends its run when the batch's stop reaches the
+ * panel, so the framebuffer and `ssd1306_scroll_get_elapsed_steps` account for it before
+ * the new run begins.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] cfg Scroll configuration (direction, page and column range, speed).
+ * @return esp_err_t ESP_OK if sent or queued, ESP_ERR_NOT_FINISHED if parked,
+ *         ESP_ERR_INVALID_ARG for an invalid configuration, ESP_ERR_NOT_SUPPORTED on
+ *         tiled displays and without a framebuffer.
+ */
+esp_err_t ssd1306_scroll_start(ssd1306_handle_t handle, const ssd1306_scroll_config_t *cfg);
+
+/**
+ * @brief Sends a parked scroll start once its settle time has elapsed.
+ *
+ * Call periodically (e.g., from the render loop) after `ssd1306_scroll_start`
+ * returned ESP_ERR_NOT_FINISHED.
+ *
+ * @param[in] handle Display instance handle.
+ * @return esp_err_t ESP_OK if nothing is parked or it was sent, ESP_ERR_NOT_FINISHED
+ *         if it is still waiting.
+ */
+esp_err_t ssd1306_scroll_poll(ssd1306_handle_t handle);
+
+/**
+ * @brief Gets the current hardware scroll state.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[out] cfg Pointer to store the last requested configuration (may be NULL).
+ * @return ssd1306_scroll_state_t Current scroll state.
+ */
+ssd1306_scroll_state_t ssd1306_scroll_get_state(ssd1306_handle_t handle, ssd1306_scroll_config_t *cfg);
+
+/**
+ * @brief Corrects the framebuffer after a scroll run with an exact step count.
+ *
+ * A horizontal scroll rotates GDDRAM, so after it is stopped the panel no longer matches
+ * the framebuffer. When the deactivation reaches the panel, the driver estimates the
+ * elapsed steps from the run time, the scroll speed and the frame period, and rotates
+ * the framebuffer by the same amount (without marking it dirty). Partial updates stay
+ * valid without a full resend. If the exact count is known (e.g., the application
+ * counted frames), this function replaces the estimate.
+ *
+ * @note Only the horizontal component moves GDDRAM. The vertical offset of the diagonal
+ * scrolls is a display mapping and needs no framebuffer change.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] steps Number of steps the controller actually performed.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE if no scroll run has ended,
+ *         ESP_ERR_NOT_SUPPORTED without a framebuffer.
+ */
+esp_err_t ssd1306_scroll_resync(ssd1306_handle_t handle, uint32_t steps);
+
+/**
+ * @brief Gets the number of steps applied to the framebuffer for the last scroll run.
+ *
+ * @param[in] handle Display instance handle.
+ * @return uint32_t Step count (estimated, or the value given to `ssd1306_scroll_resync`).
+ */
+uint32_t ssd1306_scroll_get_elapsed_steps(ssd1306_handle_t handle);
+
+/**
+ * @brief Sets the panel frame period used to estimate scroll steps.
+ *
+ * The default is derived from the init settings and the typical oscillator frequency
+ * (about 11.4 ms for 64 rows). Measure the real value for exact tracking.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] frame_period_us Frame period in microseconds.
+ */
+void ssd1306_scroll_set_frame_period(ssd1306_handle_t handle, uint32_t frame_period_us);
+
+/**
+ * @brief Gets the duration of one hardware scroll step (one column of movement).
+ *
+ * Derived from the frame period (see `ssd1306_scroll_set_frame_period`).
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] speed Scroll speed.
+ * @return uint32_t Step duration in microseconds, or 0 for invalid arguments.
+ */
+uint32_t ssd1306_scroll_get_step_period(ssd1306_handle_t handle, ssd1306_scroll_speed_t speed);
+
+/**
+ * @brief Gets the horizontal scroll direction that moves content left or right on screen.
+ *
+ * The controller's left and right refer to GDDRAM columns, so a mirrored mount (see
+ * `ssd1306_set_orientation`) reverses them.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] left True for content moving towards x = 0, false for the other way.
+ * @return ssd1306_scroll_dir_t `SSD1306_SCROLL_LEFT` or `SSD1306_SCROLL_RIGHT`.
+ */
+ssd1306_scroll_dir_t ssd1306_scroll_get_screen_dir(ssd1306_handle_t handle, bool left);
+
 /**
  * @brief Turns the display on.
  *
- * Activates the OLED display to show content.
+ * Activates the OLED display to show content. A suspended framebuffer is not restored
+ * here but by the first drawing call or update that needs it.
  *
  * @param[in] handle Display instance handle.
  * @return esp_err_t Operation status (ESP_OK on success).
@@ -574,6 +1306,8 @@ esp_err_t ssd1306_display_on(ssd1306_handle_t handle);
  * @brief Turns the display off.
  *
  * Deactivates the OLED display while preserving the internal buffer contents.
+ * With a suspend mode set (see `ssd1306_set_suspend_mode`), the framebuffer memory is
+ * compressed or released until it is used again.
  *
  * @param[in] handle Display instance handle.
  * @return esp_err_t Operation status (ESP_OK on success).
@@ -633,6 +1367,52 @@ void ssd1306_set_orientation(ssd1306_handle_t handle, uint8_t rotation);
  */
 void ssd1306_shift_framebuffer(ssd1306_handle_t handle, int16_t dx, int16_t dy, bool wrap);
 
+/**
+ * @brief Shifts the contents of a rectangle horizontally.
+ *
+ * Works page by page with block moves, so shifting a plot area by one column costs
+ * about one byte copy per column and page. Vacated columns are cleared and pixels
+ * outside the rectangle are left untouched. Only the rectangle is marked for update.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] x Top-left x-coordinate.
+ * @param[in] y Top-left y-coordinate.
+ * @param[in] w Width.
+ * @param[in] h Height.
+ * @param[in] dx Horizontal shift (positive = right, negative = left).
+ */
+void ssd1306_shift_rect(ssd1306_handle_t handle, int16_t x, int16_t y, int16_t w, int16_t h, int16_t dx);
+
+/**
+ * @brief Copies a run of framebuffer bytes of one page.
+ *
+ * Each byte holds 8 vertically stacked pixels (bit 0 on top), as in the framebuffer.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] x First column.
+ * @param[in] page Page (row of 8 pixels).
+ * @param[out] dst Destination of `w` bytes. Off-screen columns read as 0.
+ * @param[in] w Number of columns.
+ */
+void ssd1306_read_page(ssd1306_handle_t handle, int16_t x, uint8_t page, uint8_t *dst, int16_t w);
+
+/**
+ * @brief Writes a run of framebuffer bytes of one page.
+ *
+ * Bits set in `mask` are taken from `src`, the others are kept. Only the columns whose
+ * byte actually changes are marked for update, so rewriting a whole page row with
+ * mostly identical content costs no bus traffic for the unchanged part. The clip
+ * rectangle is not applied.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] x First column.
+ * @param[in] page Page (row of 8 pixels).
+ * @param[in] src Source of `w` bytes.
+ * @param[in] w Number of columns.
+ * @param[in] mask Rows of the page to write (0xFF for all).
+ */
+void ssd1306_write_page(ssd1306_handle_t handle, int16_t x, uint8_t page, const uint8_t *src, int16_t w, uint8_t mask);
+
 /**
  * @brief Sets the display start line in RAM.
  *
@@ -650,11 +1430,15 @@ void ssd1306_set_display_start_line(ssd1306_handle_t handle, uint8_t line);
  * Activates a diagonal scrolling animation to the right and downward for a specified
  * page range.
  *
+ * @note In immediate mode, a start issued within the settle time of a stop that ended
+ *       a running scroll waits out the remainder of that time before returning. In
+ *       deferred mode it is sent with the next `ssd1306_update_screen`.
+ *
  * @param[in] handle Display instance handle.
  * @param[in] start_page Starting page for scrolling (0-7).
  * @param[in] end_page Ending page for scrolling (0-7).
  * @param[in] offset Number of lines to move downward per scroll step (1-63).
- * @param[in] speed Horizontal scroll speed (0 = fastest, 7 = slowest).
+ * @param[in] speed Scroll step interval code (see ssd1306_scroll_speed_t).
  */
 void ssd1306_start_scroll_diag_right_down(ssd1306_handle_t handle, uint8_t start_page, uint8_t end_page, uint8_t offset, uint8_t speed);
 
@@ -664,11 +1448,15 @@ void ssd1306_start_scroll_diag_right_down(ssd1306_handle_t handle, uint8_t start
  * Activates a diagonal scrolling animation to the left and upward for a specified
  * page range.
  *
+ * @note In immediate mode, a start issued within the settle time of a stop that ended
+ *       a running scroll waits out the remainder of that time before returning. In
+ *       deferred mode it is sent with the next `ssd1306_update_screen`.
+ *
  * @param[in] handle Display instance handle.
  * @param[in] start_page Starting page for scrolling (0-7).
  * @param[in] end_page Ending page for scrolling (0-7).
  * @param[in] offset Number of lines to move upward per scroll step (1-63).
- * @param[in] speed Horizontal scroll speed (0 = fastest, 7 = slowest).
+ * @param[in] speed Scroll step interval code (see ssd1306_scroll_speed_t).
  */
 void ssd1306_start_scroll_diag_left_up(ssd1306_handle_t handle, uint8_t start_page, uint8_t end_page, uint8_t offset, uint8_t speed);
 
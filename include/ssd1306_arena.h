@@ -0,0 +1,122 @@
+/**
+ * @file      ssd1306_arena.h
+ * @brief     Fixed-block arena for the driver's buffers.
+ * @version   1.0
+ *
+ * @details
+ * An arena hands out runs of fixed-size blocks from one region of memory, reserved once
+ * at creation or provided by the caller (e.g. a static array). Buffers that come and go
+ * over the life of a device (framebuffers released while the display is off, compressed
+ * copies, raster caches, canvases) then never touch the heap, so they cannot fragment
+ * it, and the memory they may use is bounded up front.
+ *
+ * Every allocation starts on a block boundary and takes whole blocks. With the block
+ * size set to the display width, a block is exactly one framebuffer page. Allocation is
+ * a first-fit scan of a block bitmap: its cost is bounded by the block count and does
+ * not depend on the allocation history, and a free only clears bits. The arena is
+ * protected by a critical section, so it can be shared by displays driven from
+ * different tasks.
+ *
+ * Attach an arena to a display with `ssd1306_set_arena`.
+ */
+
+#ifndef SSD1306_ARENA_H
+#define SSD1306_ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSD1306_ARENA_DEFAULT_BLOCK 128 ///< Block size used when the configuration leaves it at 0 (one page of a 128-pixel-wide display).
+
+/**
+ * @brief Opaque arena handle.
+ */
+typedef struct ssd1306_arena_t *ssd1306_arena_handle_t;
+
+/**
+ * @brief Arena configuration.
+ */
+typedef struct {
+    size_t size;         ///< Bytes to manage, rounded down to whole blocks (the size of `backing` if given).
+    uint16_t block_size; ///< Block size in bytes, a multiple of 4 (0 = SSD1306_ARENA_DEFAULT_BLOCK).
+    void *backing;       ///< Caller-provided 4-byte aligned region, or NULL to allocate `size` bytes at creation.
+} ssd1306_arena_config_t;
+
+/**
+ * @brief Arena usage.
+ */
+typedef struct {
+    uint16_t block_size;    ///< Block size in bytes.
+    uint16_t blocks;        ///< Blocks in the arena.
+    uint16_t used;          ///< Blocks in use.
+    uint16_t high_water;    ///< Most blocks ever in use at once.
+    uint16_t largest_free;  ///< Longest run of free blocks (the largest allocation that would succeed).
+    uint32_t allocs;        ///< Successful allocations.
+    uint32_t failures;      ///< Allocations that found no room.
+} ssd1306_arena_stats_t;
+
+/**
+ * @brief Creates an arena.
+ *
+ * @param[in] cfg Configuration.
+ * @param[out] out Arena handle.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments,
+ *         ESP_ERR_NO_MEM if the region or the block table cannot be allocated.
+ */
+esp_err_t ssd1306_arena_create(const ssd1306_arena_config_t *cfg, ssd1306_arena_handle_t *out);
+
+/**
+ * @brief Deletes an arena. Memory it handed out becomes invalid; a caller-provided
+ * region is not freed.
+ *
+ * @param[in] arena Arena.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG for a NULL arena.
+ */
+esp_err_t ssd1306_arena_delete(ssd1306_arena_handle_t arena);
+
+/**
+ * @brief Allocates a run of blocks.
+ *
+ * @param[in] arena Arena.
+ * @param[in] bytes Bytes needed (at least one block is taken).
+ * @return void* Block-aligned memory, or NULL if no run of free blocks is long enough.
+ */
+void *ssd1306_arena_alloc(ssd1306_arena_handle_t arena, size_t bytes);
+
+/**
+ * @brief Returns memory from `ssd1306_arena_alloc` to the arena. NULL is ignored.
+ *
+ * @param[in] arena Arena.
+ * @param[in] ptr Memory to release.
+ */
+void ssd1306_arena_free(ssd1306_arena_handle_t arena, void *ptr);
+
+/**
+ * @brief Tells whether memory lies inside an arena's region.
+ *
+ * @param[in] arena Arena (may be NULL).
+ * @param[in] ptr Pointer.
+ * @return true if `ptr` points into the arena.
+ */
+bool ssd1306_arena_owns(ssd1306_arena_handle_t arena, const void *ptr);
+
+/**
+ * @brief Gets the arena usage, including the high-water mark.
+ *
+ * @param[in] arena Arena.
+ * @param[out] out Usage.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments.
+ */
+esp_err_t ssd1306_arena_get_stats(ssd1306_arena_handle_t arena, ssd1306_arena_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_ARENA_H
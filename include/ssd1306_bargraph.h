@@ -0,0 +1,96 @@
+/**
+ * @file      ssd1306_bargraph.h
+ * @brief     Incremental bar graph / spectrum widget with peak hold.
+ * @version   1.0
+ *
+ * @details
+ * The widget remembers the height of every bar and only paints the difference when a
+ * bar grows or shrinks: a page-masked fill of the rows that changed. Peak markers hold
+ * the highest recent level for a number of frames and then fall at a configurable rate.
+ *
+ * Damage is tracked per run of neighbouring bars that changed. With `flush` enabled
+ * each run is sent on its own as soon as it is painted, so the bus traffic of a frame
+ * follows how much the bars actually moved instead of the size of the graph.
+ */
+
+#ifndef SSD1306_BARGRAPH_H
+#define SSD1306_BARGRAPH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief State of one bar.
+ */
+typedef struct {
+    uint8_t level; ///< Painted bar height in pixels.
+    uint8_t peak;  ///< Painted peak height in pixels (marker shown if above `level`).
+    uint8_t hold;  ///< Frames left before the peak starts falling.
+} ssd1306_bar_t;
+
+/**
+ * @brief Bar graph configuration.
+ */
+typedef struct {
+    int16_t x, y;             ///< Top-left corner.
+    int16_t h;                ///< Height in pixels (at most 255).
+    uint16_t count;           ///< Number of bars.
+    uint8_t bar_w;            ///< Bar width in pixels.
+    uint8_t gap;              ///< Gap between bars in pixels.
+    uint16_t max;             ///< Value of a full-height bar.
+    bool peak_hold;           ///< Show peak markers.
+    uint8_t peak_hold_frames; ///< Frames a peak stays before falling.
+    uint8_t peak_fall;        ///< Pixels a peak falls per frame (at least 1 with peak hold).
+    ssd1306_bar_t *bars;      ///< Storage for `count` bars.
+} ssd1306_bargraph_config_t;
+
+/**
+ * @brief Bar graph state. Treat as read-only.
+ */
+typedef struct {
+    ssd1306_handle_t disp;         ///< Target display.
+    ssd1306_bargraph_config_t cfg; ///< Configuration.
+    uint16_t last_runs;            ///< Damaged runs of bars in the last frame.
+    uint16_t last_rows;            ///< Bar rows repainted in the last frame.
+} ssd1306_bargraph_t;
+
+/**
+ * @brief Initializes a bar graph with all bars empty and clears its area.
+ *
+ * @param[out] bg Bar graph state.
+ * @param[in] disp Target display.
+ * @param[in] cfg Configuration (copied).
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments.
+ */
+esp_err_t ssd1306_bargraph_init(ssd1306_bargraph_t *bg, ssd1306_handle_t disp, const ssd1306_bargraph_config_t *cfg);
+
+/**
+ * @brief Sets the values of all bars (one frame) and paints what changed.
+ *
+ * @param[in] bg Bar graph.
+ * @param[in] values One value per bar (clamped to `max`).
+ * @param[in] flush True to send every damaged run right after painting it. With false
+ *                  the changes are only drawn, and the next `ssd1306_update_screen`
+ *                  sends their bounding area.
+ * @return esp_err_t ESP_OK on success, or the first screen update error.
+ */
+esp_err_t ssd1306_bargraph_set(ssd1306_bargraph_t *bg, const uint16_t *values, bool flush);
+
+/**
+ * @brief Repaints the whole graph from the stored bar state.
+ *
+ * @param[in] bg Bar graph.
+ */
+void ssd1306_bargraph_redraw(ssd1306_bargraph_t *bg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_BARGRAPH_H
@@ -0,0 +1,126 @@
+/**
+ * @file      ssd1306_chart.h
+ * @brief     Incremental strip chart for sensor trends.
+ * @version   1.0
+ *
+ * @details
+ * The chart keeps its samples in a caller-provided ring buffer with one entry per plot
+ * column. Once the plot is full, a new column shifts the plot area one column to the
+ * left (`ssd1306_shift_rect`) and only the new column segment is drawn, so neither the
+ * rest of the screen nor the old samples are redrawn and the next `ssd1306_update_screen`
+ * only sends the plot rectangle.
+ *
+ * Several traces can share one plot. In envelope mode every column summarizes a number
+ * of samples as a vertical min/max bar. With autoscaling the range follows the samples
+ * on screen; the plot is redrawn from the ring buffer only when that range changes.
+ */
+
+#ifndef SSD1306_CHART_H
+#define SSD1306_CHART_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSD1306_CHART_MAX_TRACES 4 ///< Maximum number of traces per chart.
+
+/**
+ * @brief Number of `int16_t` entries the sample buffer of a chart needs.
+ *
+ * @param width Plot width in pixels.
+ * @param traces Number of traces.
+ */
+#define SSD1306_CHART_BUF_LEN(width, traces) ((width) * (traces) * 2)
+
+/**
+ * @brief How a column represents its samples.
+ */
+typedef enum {
+    SSD1306_CHART_LINE,     ///< One sample per column, consecutive samples joined by a line.
+    SSD1306_CHART_ENVELOPE, ///< `samples_per_column` samples per column, drawn as a min/max bar.
+} ssd1306_chart_mode_t;
+
+/**
+ * @brief Chart configuration.
+ */
+typedef struct {
+    int16_t x, y, w, h;          ///< Plot rectangle.
+    uint8_t traces;              ///< Number of traces (1 to SSD1306_CHART_MAX_TRACES).
+    ssd1306_chart_mode_t mode;   ///< Column representation.
+    uint16_t samples_per_column; ///< Samples summarized per column in envelope mode.
+    bool autoscale;              ///< Fit the range to the samples on screen.
+    int16_t min, max;            ///< Fixed range (ignored with autoscale).
+    int16_t *buffer;             ///< Sample storage of SSD1306_CHART_BUF_LEN(w, traces) entries.
+} ssd1306_chart_config_t;
+
+/**
+ * @brief Chart state. Treat as read-only.
+ */
+typedef struct {
+    ssd1306_handle_t disp;                      ///< Target display.
+    ssd1306_chart_config_t cfg;                 ///< Configuration.
+    uint16_t head;                              ///< Ring slot of the oldest column.
+    uint16_t columns;                           ///< Columns stored (up to the plot width).
+    int16_t min, max;                           ///< Current range.
+    uint16_t pending;                           ///< Samples collected for the next envelope column.
+    int16_t acc_lo[SSD1306_CHART_MAX_TRACES];   ///< Running minimum of the next envelope column.
+    int16_t acc_hi[SSD1306_CHART_MAX_TRACES];   ///< Running maximum of the next envelope column.
+    uint32_t redraws;                           ///< Full redraws caused by range changes.
+} ssd1306_chart_t;
+
+/**
+ * @brief Initializes a chart and clears its plot rectangle.
+ *
+ * @param[out] chart Chart state.
+ * @param[in] disp Target display.
+ * @param[in] cfg Configuration (copied).
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments.
+ */
+esp_err_t ssd1306_chart_init(ssd1306_chart_t *chart, ssd1306_handle_t disp, const ssd1306_chart_config_t *cfg);
+
+/**
+ * @brief Adds one sample per trace.
+ *
+ * Draws the new column into the framebuffer once it is complete (every sample in line
+ * mode, every `samples_per_column` samples in envelope mode). Call `ssd1306_update_screen`
+ * afterwards.
+ *
+ * @param[in] chart Chart.
+ * @param[in] values One value per trace.
+ * @return bool True if the framebuffer changed.
+ */
+bool ssd1306_chart_push(ssd1306_chart_t *chart, const int16_t *values);
+
+/**
+ * @brief Changes the fixed range and redraws the plot. Turns autoscaling off.
+ *
+ * @param[in] chart Chart.
+ * @param[in] min Value at the bottom edge.
+ * @param[in] max Value at the top edge (greater than `min`).
+ */
+void ssd1306_chart_set_range(ssd1306_chart_t *chart, int16_t min, int16_t max);
+
+/**
+ * @brief Redraws the whole plot from the ring buffer.
+ *
+ * @param[in] chart Chart.
+ */
+void ssd1306_chart_redraw(ssd1306_chart_t *chart);
+
+/**
+ * @brief Removes all samples and clears the plot.
+ *
+ * @param[in] chart Chart.
+ */
+void ssd1306_chart_clear(ssd1306_chart_t *chart);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_CHART_H
@@ -53,6 +53,37 @@ typedef struct {
     uint8_t         yAdvance; ///< Total line height in pixels; vertical distance to the next baseline.
 } GFXfont;
 
+/**
+ * @struct StrokeGlyph
+ * @brief  Defines a single character of a stroke font as a list of polylines.
+ *
+ * Each point is one byte of the font's point array: the high nibble is the grid x,
+ * the low nibble the grid y (row 0 at the top). The byte 0xFF lifts the pen and
+ * starts a new polyline.
+ */
+typedef struct {
+    uint16_t offset;   ///< Index of the glyph's first point byte.
+    uint8_t  count;    ///< Number of point bytes, pen lifts included.
+    uint8_t  xAdvance; ///< Horizontal distance to the next character in grid units.
+} StrokeGlyph;
+
+/**
+ * @struct StrokeFont
+ * @brief  Main structure defining a stroke (vector) font.
+ *
+ * Glyph coordinates are scaled at draw time, so one glyph set serves every text size.
+ */
+typedef struct {
+    const uint8_t* points;     ///< Pointer to the packed points of all glyphs.
+    const StrokeGlyph* glyph;  ///< Pointer to the array of StrokeGlyph descriptors for each character.
+    uint8_t first;             ///< ASCII value of the first supported character.
+    uint8_t last;              ///< ASCII value of the last supported character.
+    uint8_t baseline;          ///< Grid row of the baseline; also the capital height in grid units.
+    uint8_t yAdvance;          ///< Line height in grid units.
+} StrokeFont;
+
+#define STROKE_PEN_UP 0xFF /**< Point byte that separates the polylines of a stroke glyph. */
+
 /**
  * @enum ssd1306_font_type_t
  * @brief Identifies the base format of a font.
@@ -61,7 +92,8 @@ typedef struct {
  * added without altering the main API.
  */
 typedef enum {
-    FONT_TYPE_GFX, ///< Indicates a font using the GFXfont structure.
+    FONT_TYPE_GFX,    ///< Indicates a font using the GFXfont structure.
+    FONT_TYPE_STROKE, ///< Indicates a font using the StrokeFont structure.
 } ssd1306_font_type_t;
 
 /**
@@ -90,6 +122,7 @@ typedef struct {
 #include "fonts/font5x7.h"
 #include "fonts/FreeMono12pt7b.h"
 #include "fonts/FreeSans9pt7b.h"
+#include "fonts/stroke_sans.h"
 
 
 #ifdef __cplusplus
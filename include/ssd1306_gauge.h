@@ -0,0 +1,100 @@
+/**
+ * @file      ssd1306_gauge.h
+ * @brief     Analog gauge widget with a cached dial and fixed-point needle geometry.
+ * @version   1.0
+ *
+ * @details
+ * The dial (arc, tick marks and hub) is rasterized once and kept in a caller-provided
+ * canvas. Needle endpoints come from a fixed-point sine table, so no floating point is
+ * used after initialization. A value change restores the pixels under the old needle
+ * from the canvas and draws the new needle, which costs a few hundred pixel operations
+ * and leaves a damage rectangle that only spans the two needle positions.
+ *
+ * Angles are in degrees with 0 at 3 o'clock, increasing clockwise (as in
+ * `ssd1306_draw_arc`).
+ */
+
+#ifndef SSD1306_GAUGE_H
+#define SSD1306_GAUGE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number of bytes the dial canvas of a gauge needs.
+ *
+ * @param radius Dial radius in pixels.
+ */
+#define SSD1306_GAUGE_CANVAS_LEN(radius) ((2 * (radius) + 1) * ((2 * (radius) + 8) / 8))
+
+/**
+ * @brief Gauge configuration.
+ */
+typedef struct {
+    int16_t cx, cy;          ///< Center of the dial.
+    uint8_t radius;          ///< Dial radius in pixels.
+    int16_t start_angle;     ///< Angle of the minimum value.
+    int16_t sweep;           ///< Angle from the minimum to the maximum value (1 to 360).
+    int32_t min, max;        ///< Value range.
+    bool arc;                ///< Draw the dial arc.
+    uint8_t major_ticks;     ///< Number of major tick marks (0 for none, otherwise at least 2).
+    uint8_t minor_ticks;     ///< Minor tick marks between two major ones.
+    uint8_t major_len;       ///< Length of major tick marks, measured inwards from the rim.
+    uint8_t minor_len;       ///< Length of minor tick marks.
+    uint8_t hub_radius;      ///< Radius of the filled hub (0 for none).
+    uint8_t needle_start;    ///< Distance from the center at which the needle starts.
+    uint8_t needle_len;      ///< Distance from the center at which the needle ends (at most `radius`).
+    uint8_t needle_width;    ///< Needle width in pixels (1 to 3).
+    uint8_t *canvas;         ///< Dial cache of SSD1306_GAUGE_CANVAS_LEN(radius) bytes.
+} ssd1306_gauge_config_t;
+
+/**
+ * @brief Gauge state. Treat as read-only.
+ */
+typedef struct {
+    ssd1306_handle_t disp;      ///< Target display.
+    ssd1306_gauge_config_t cfg; ///< Configuration.
+    int32_t value;              ///< Current value.
+    int16_t angle;              ///< Current needle angle.
+    uint16_t last_pixels;       ///< Pixels touched by the last update.
+} ssd1306_gauge_t;
+
+/**
+ * @brief Initializes a gauge: clears its square, draws and caches the dial, and draws
+ * the needle.
+ *
+ * @param[out] gauge Gauge state.
+ * @param[in] disp Target display (needs a framebuffer).
+ * @param[in] cfg Configuration (copied).
+ * @param[in] value Initial value.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments.
+ */
+esp_err_t ssd1306_gauge_init(ssd1306_gauge_t *gauge, ssd1306_handle_t disp, const ssd1306_gauge_config_t *cfg, int32_t value);
+
+/**
+ * @brief Moves the needle to a new value.
+ *
+ * @param[in] gauge Gauge.
+ * @param[in] value New value (clamped to the range).
+ * @return bool True if the needle moved (call `ssd1306_update_screen`).
+ */
+bool ssd1306_gauge_set(ssd1306_gauge_t *gauge, int32_t value);
+
+/**
+ * @brief Repaints the dial from the canvas and the needle, e.g. after drawing over it.
+ *
+ * @param[in] gauge Gauge.
+ */
+void ssd1306_gauge_redraw(ssd1306_gauge_t *gauge);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_GAUGE_H
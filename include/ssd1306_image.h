@@ -0,0 +1,91 @@
+/**
+ * @file      ssd1306_image.h
+ * @brief     Streaming 1bpp image loader (PBM P4 and XBM) from files.
+ * @version   1.0
+ *
+ * @details
+ * Images are read from any path the C library can open: SPIFFS, LittleFS or FAT
+ * mounted through the VFS on the target, or a regular file on a host build. The file is
+ * never held in RAM: the loader reads the image rows that land on one display page
+ * (at most 8), transposes them 8x8 pixels at a time into page bytes and writes the page
+ * before reading on. Rows above the target are skipped, and reading stops after the
+ * last visible page, so only the visible part of a tall image costs bus and CPU time.
+ *
+ * Formats:
+ * - PBM P4 (binary portable bitmap): rows padded to whole bytes, most significant bit on
+ *   the left, 1 = black.
+ * - XBM (X BitMap C source, as written by GIMP or ImageMagick): `#define ..._width`,
+ *   `#define ..._height`, then the hex byte array, least significant bit on the left.
+ *
+ * Set bits (black in PBM, foreground in XBM) become lit pixels unless `invert` is set.
+ * The image replaces what is under it, clear bits included, and is clipped to the
+ * target. The target is the framebuffer (written with `ssd1306_write_page`, so only the
+ * columns that change are marked dirty) or a canvas in framebuffer layout, e.g. one
+ * screen of a transition.
+ */
+
+#ifndef SSD1306_IMAGE_H
+#define SSD1306_IMAGE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSD1306_IMAGE_MAX_SIDE 4096 ///< Largest image width or height accepted.
+
+/**
+ * @brief Image file format.
+ */
+typedef enum {
+    SSD1306_IMAGE_PBM = 0, ///< Binary portable bitmap (magic "P4").
+    SSD1306_IMAGE_XBM,     ///< X BitMap C source.
+} ssd1306_image_format_t;
+
+/**
+ * @brief Placement options.
+ */
+typedef struct {
+    int16_t x, y;           ///< Target position of the image's top-left corner (may be negative).
+    bool invert;            ///< Light the pixels that are clear in the file instead.
+    uint8_t *canvas;        ///< Canvas in framebuffer layout to draw into, or NULL for the framebuffer.
+    int16_t canvas_w;       ///< Canvas width in pixels.
+    int16_t canvas_h;       ///< Canvas height in pixels (a multiple of 8).
+} ssd1306_image_opts_t;
+
+/**
+ * @brief Result of a load.
+ */
+typedef struct {
+    ssd1306_image_format_t format; ///< Detected format.
+    uint16_t width;                ///< Image width in pixels.
+    uint16_t height;               ///< Image height in pixels.
+    uint32_t file_bytes;           ///< Bytes read from the file.
+    uint16_t pages;                ///< Target pages written.
+    uint32_t load_us;              ///< Time from opening the file to the last page write.
+} ssd1306_image_info_t;
+
+/**
+ * @brief Loads a PBM (P4) or XBM image from a file into the framebuffer or a canvas.
+ * The format is detected from the file content.
+ *
+ * @param[in] disp Display whose framebuffer is the target (may be NULL with a canvas).
+ * @param[in] path File path.
+ * @param[in] opts Placement, or NULL for the framebuffer at (0, 0).
+ * @param[out] info Image size and throughput figures, or NULL.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments,
+ *         ESP_ERR_NOT_FOUND if the file cannot be opened, ESP_ERR_INVALID_RESPONSE
+ *         for a malformed or truncated file, ESP_ERR_NOT_SUPPORTED for another format
+ *         or ESP_ERR_NO_MEM.
+ */
+esp_err_t ssd1306_image_load(ssd1306_handle_t disp, const char *path, const ssd1306_image_opts_t *opts, ssd1306_image_info_t *info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_IMAGE_H
@@ -0,0 +1,126 @@
+/**
+ * @file      ssd1306_marquee.h
+ * @brief     Marquee text animated by the controller's horizontal scroll.
+ * @version   1.0
+ *
+ * @details
+ * The text is drawn once into a field of whole pages, and a column-range hardware
+ * scroll moves it, so the panel does the animation without bus traffic. The scroll
+ * rotates the field, so columns that leave on the left come back on the right:
+ *
+ * - A text that fits in the field (with the gap) is padded to the field width and
+ *   loops with no CPU or bus work at all.
+ * - A longer text is advanced in chunks. Before each run the first `chunk` columns of
+ *   the field are blanked, so only blank columns wrap around. After `chunk` steps the
+ *   scroll is stopped, the driver resyncs the framebuffer, and only the wrapped-in
+ *   columns are refilled with the next part of the text.
+ *
+ * `ssd1306_marquee_get_stats` reports the CPU time and bus bytes spent per scrolled
+ * pixel.
+ *
+ * @note The marquee needs a plain (not tiled) display and a GFX font. Do not draw into
+ *       the field or start other scrolls while it runs.
+ */
+
+#ifndef SSD1306_MARQUEE_H
+#define SSD1306_MARQUEE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Marquee configuration.
+ */
+typedef struct {
+    uint8_t x;                    ///< First column of the field.
+    uint8_t w;                    ///< Field width in columns.
+    uint8_t page;                 ///< First page of the field.
+    uint8_t pages;                ///< Field height in pages.
+    uint8_t gap;                  ///< Blank columns between the end of the text and its next repetition.
+    uint8_t chunk;                ///< Columns per refill for texts longer than the field (0 = 8).
+    ssd1306_scroll_speed_t speed; ///< Scroll speed.
+} ssd1306_marquee_config_t;
+
+/**
+ * @brief Cost counters of a marquee.
+ */
+typedef struct {
+    uint32_t steps;        ///< Scroll steps performed, i.e. pixels the text moved.
+    uint32_t refills;      ///< Refills of wrapped-in columns.
+    uint64_t cpu_us;       ///< Time spent in marquee calls (including blocking bus transfers).
+    uint32_t bus_bytes;    ///< Bytes the marquee calls sent to the panel.
+} ssd1306_marquee_stats_t;
+
+/**
+ * @brief Marquee state. Treat as read-only.
+ */
+typedef struct {
+    ssd1306_handle_t disp;              ///< Target display.
+    ssd1306_marquee_config_t cfg;       ///< Configuration.
+    const ssd1306_font_handle_t *font;  ///< Font.
+    const char *text;                   ///< Text (not copied).
+    int8_t ascent;                      ///< Baseline offset from the top of the field.
+    uint16_t period;                    ///< Columns before the text repeats (text, gap and padding).
+    uint16_t offset;                    ///< Position of the field's first column in the repeating text.
+    bool looping;                       ///< True if the text fits and the scroll loops without refills.
+    bool running;                       ///< True while a scroll run is started or active.
+    int64_t run_since_us;               ///< Time the current run was seen active (0 while pending).
+    ssd1306_marquee_stats_t stats;      ///< Cost counters.
+} ssd1306_marquee_t;
+
+/**
+ * @brief Draws a text into its field and starts scrolling it.
+ *
+ * @param[out] m Marquee state.
+ * @param[in] disp Target display.
+ * @param[in] cfg Configuration (copied).
+ * @param[in] font GFX font.
+ * @param[in] text Text. It must stay valid while the marquee runs.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments, or the
+ *         error of the first update or the scroll start.
+ */
+esp_err_t ssd1306_marquee_start(ssd1306_marquee_t *m, ssd1306_handle_t disp, const ssd1306_marquee_config_t *cfg,
+                                const ssd1306_font_handle_t *font, const char *text);
+
+/**
+ * @brief Drives the marquee: sends a parked scroll start and, for long texts, refills
+ * the field when a chunk has scrolled through.
+ *
+ * Call from the render loop, at least once per chunk duration
+ * (`chunk * ssd1306_scroll_get_step_period()`).
+ *
+ * @param[in] m Marquee.
+ * @return esp_err_t ESP_OK on success, or the error of a bus transfer.
+ */
+esp_err_t ssd1306_marquee_poll(ssd1306_marquee_t *m);
+
+/**
+ * @brief Stops the marquee. The field keeps the text where it stopped and the
+ * framebuffer matches the panel.
+ *
+ * @param[in] m Marquee.
+ * @return esp_err_t ESP_OK on success, or the error of a bus transfer.
+ */
+esp_err_t ssd1306_marquee_stop(ssd1306_marquee_t *m);
+
+/**
+ * @brief Gets the cost counters. The steps of a looping marquee are counted when it is
+ * stopped, so stop it before comparing costs.
+ *
+ * @param[in] m Marquee.
+ * @param[out] out Counters.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments.
+ */
+esp_err_t ssd1306_marquee_get_stats(const ssd1306_marquee_t *m, ssd1306_marquee_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_MARQUEE_H
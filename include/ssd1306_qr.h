@@ -0,0 +1,114 @@
+/**
+ * @file      ssd1306_qr.h
+ * @brief     QR code encoder (versions 1 to 6) rendering straight into the framebuffer.
+ * @version   1.0
+ *
+ * @details
+ * The encoder works in the fixed buffers of `ssd1306_qr_t` and allocates nothing, so a
+ * code can be built with the heap exhausted or before it is set up. Data is encoded
+ * in byte mode; the smallest version from 1 to 6 (21x21 to 41x41 modules) that holds
+ * it is chosen, and the mask is picked by the standard penalty rules.
+ *
+ * `ssd1306_draw_qr` blits the modules at an integer scale into the page bytes of the
+ * framebuffer (one byte write per column and page) and marks the dirty area once.
+ * Encode and render times are kept in the code object, so both steps can be
+ * benchmarked on their own.
+ */
+
+#ifndef SSD1306_QR_H
+#define SSD1306_QR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSD1306_QR_MAX_VERSION 6                                    ///< Largest supported version.
+#define SSD1306_QR_MAX_SIZE (SSD1306_QR_MAX_VERSION * 4 + 17)       ///< Side of the largest symbol in modules.
+#define SSD1306_QR_MAX_CODEWORDS 172                                ///< Codewords of the largest symbol.
+
+/**
+ * @brief Error correction level.
+ */
+typedef enum {
+    SSD1306_QR_ECC_L = 0, ///< Recovers about 7% of the codewords.
+    SSD1306_QR_ECC_M,     ///< About 15%.
+    SSD1306_QR_ECC_Q,     ///< About 25%.
+    SSD1306_QR_ECC_H,     ///< About 30%.
+} ssd1306_qr_ecc_t;
+
+/**
+ * @brief An encoded QR code and its working buffers. Treat as read-only.
+ */
+typedef struct {
+    uint8_t version;       ///< Symbol version (1 to 6).
+    uint8_t size;          ///< Side in modules (4 * version + 17).
+    ssd1306_qr_ecc_t ecc;  ///< Error correction level.
+    uint8_t mask;          ///< Mask pattern (0 to 7).
+    uint8_t modules[(SSD1306_QR_MAX_SIZE * SSD1306_QR_MAX_SIZE + 7) / 8]; ///< Row-major bit per module (1 = dark).
+    uint8_t data[SSD1306_QR_MAX_CODEWORDS];      ///< Working buffer: data codewords and error correction.
+    uint8_t codewords[SSD1306_QR_MAX_CODEWORDS]; ///< Working buffer: interleaved codewords.
+    uint32_t encode_us;    ///< Duration of the last `ssd1306_qr_encode`.
+    uint32_t render_us;    ///< Duration of the last `ssd1306_draw_qr`.
+} ssd1306_qr_t;
+
+/**
+ * @brief Encodes bytes into a QR code.
+ *
+ * @param[out] qr Code object.
+ * @param[in] data Payload (e.g. a URL or a Wi-Fi provisioning string).
+ * @param[in] len Payload length in bytes.
+ * @param[in] ecc Minimum error correction level. It is raised if that fits in the same version.
+ * @param[in] min_version Smallest version to use (1 to 6), e.g. to keep the size stable.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments,
+ *         ESP_ERR_INVALID_SIZE if the data does not fit in version 6.
+ */
+esp_err_t ssd1306_qr_encode(ssd1306_qr_t *qr, const void *data, size_t len, ssd1306_qr_ecc_t ecc, uint8_t min_version);
+
+/**
+ * @brief Reads one module of an encoded code.
+ *
+ * @param[in] qr Code object.
+ * @param[in] x Module column.
+ * @param[in] y Module row.
+ * @return bool True for a dark module; false for light modules and outside the symbol.
+ */
+bool ssd1306_qr_get_module(const ssd1306_qr_t *qr, int16_t x, int16_t y);
+
+/**
+ * @brief Returns the rendered side length of a code in pixels.
+ *
+ * @param[in] qr Code object.
+ * @param[in] scale Pixels per module.
+ * @param[in] quiet Quiet zone width in modules (the standard asks for 4, most readers accept 2).
+ * @return int16_t Side length in pixels.
+ */
+int16_t ssd1306_qr_get_pixel_size(const ssd1306_qr_t *qr, uint8_t scale, uint8_t quiet);
+
+/**
+ * @brief Draws an encoded code into the framebuffer.
+ *
+ * Dark modules are drawn black and light modules and the quiet zone white, as readers
+ * expect. The clip rectangle is honoured.
+ *
+ * @param[in] handle Display instance handle.
+ * @param[in] x Left edge (of the quiet zone).
+ * @param[in] y Top edge (of the quiet zone).
+ * @param[in,out] qr Code object (`render_us` is updated).
+ * @param[in] scale Pixels per module (at least 1).
+ * @param[in] quiet Quiet zone width in modules.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments,
+ *         ESP_ERR_NOT_SUPPORTED if the handle has no framebuffer.
+ */
+esp_err_t ssd1306_draw_qr(ssd1306_handle_t handle, int16_t x, int16_t y, ssd1306_qr_t *qr, uint8_t scale, uint8_t quiet);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_QR_H
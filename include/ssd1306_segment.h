@@ -0,0 +1,112 @@
+/**
+ * @file      ssd1306_segment.h
+ * @brief     Large seven- and fourteen-segment numeric display widget.
+ * @version   1.0
+ *
+ * @details
+ * Digits are built from tapered segments. Every segment is drawn as a run of vertical
+ * spans, so it costs one masked byte write per column and page. The widget keeps the
+ * segment bitmask of every cell and, on a new value, only draws the segments that were
+ * switched on and erases the ones that were switched off. Segments never share pixels,
+ * so erasing one cannot damage its neighbours.
+ *
+ * Segment bits: A (top) = 0, B (top right) = 1, C (bottom right) = 2, D (bottom) = 3,
+ * E (bottom left) = 4, F (top left) = 5, G1/G (middle left, or the whole middle bar in
+ * seven-segment mode) = 6, G2 (middle right) = 7, H (diagonal to the top left) = 8,
+ * I (top center) = 9, J (diagonal to the top right) = 10, K (diagonal to the bottom
+ * left) = 11, L (bottom center) = 12, M (diagonal to the bottom right) = 13 and the
+ * decimal point = 14.
+ */
+
+#ifndef SSD1306_SEGMENT_H
+#define SSD1306_SEGMENT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSD1306_SEG_MAX_CELLS 12 ///< Maximum number of character cells.
+
+/**
+ * @brief Segment layout.
+ */
+typedef enum {
+    SSD1306_SEG_7,  ///< Seven segments: digits, A-F and a few letters.
+    SSD1306_SEG_14, ///< Fourteen segments: digits, A-Z and - + / \ * _.
+} ssd1306_seg_style_t;
+
+/**
+ * @brief Segment display configuration.
+ */
+typedef struct {
+    int16_t x, y;              ///< Top-left corner.
+    uint8_t digit_w, digit_h;  ///< Size of one character cell.
+    uint8_t thickness;         ///< Segment thickness (rounded up to an odd number).
+    uint8_t spacing;           ///< Space between cells. The decimal point is drawn in it.
+    ssd1306_seg_style_t style; ///< Segment layout.
+} ssd1306_seg_config_t;
+
+/**
+ * @brief Segment display state. Treat as read-only.
+ */
+typedef struct {
+    ssd1306_handle_t disp;                 ///< Target display.
+    ssd1306_seg_config_t cfg;              ///< Configuration.
+    uint8_t cells;                         ///< Number of cells currently shown.
+    bool colon[SSD1306_SEG_MAX_CELLS];     ///< True for colon cells.
+    uint16_t mask[SSD1306_SEG_MAX_CELLS];  ///< Lit segments per cell.
+    uint16_t last_toggled;                 ///< Segments drawn or erased by the last update.
+} ssd1306_seg_display_t;
+
+/**
+ * @brief Initializes an empty segment display.
+ *
+ * @param[out] seg Segment display state.
+ * @param[in] disp Target display.
+ * @param[in] cfg Configuration (copied).
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments.
+ */
+esp_err_t ssd1306_seg_init(ssd1306_seg_display_t *seg, ssd1306_handle_t disp, const ssd1306_seg_config_t *cfg);
+
+/**
+ * @brief Shows a text.
+ *
+ * Every character takes a cell, except '.' which lights the decimal point of the
+ * previous cell. ':' makes a narrow colon cell; ';' is a colon cell with the dots off
+ * (for blinking). Unsupported characters are blank. If the cell layout is unchanged
+ * only toggled segments are redrawn; otherwise the widget is repainted.
+ *
+ * @param[in] seg Segment display.
+ * @param[in] text Text to show (at most SSD1306_SEG_MAX_CELLS cells).
+ * @return uint16_t Number of segments drawn or erased.
+ */
+uint16_t ssd1306_seg_set_text(ssd1306_seg_display_t *seg, const char *text);
+
+/**
+ * @brief Shows a fixed-point number, right-aligned in `cells` cells.
+ *
+ * @param[in] seg Segment display.
+ * @param[in] value Value in units of 10^-decimals.
+ * @param[in] decimals Number of digits after the decimal point.
+ * @param[in] cells Number of digit cells (the decimal point takes no cell).
+ * @return uint16_t Number of segments drawn or erased.
+ */
+uint16_t ssd1306_seg_set_number(ssd1306_seg_display_t *seg, int32_t value, uint8_t decimals, uint8_t cells);
+
+/**
+ * @brief Repaints all cells, e.g. after drawing over them.
+ *
+ * @param[in] seg Segment display.
+ */
+void ssd1306_seg_redraw(ssd1306_seg_display_t *seg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_SEGMENT_H
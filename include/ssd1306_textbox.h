@@ -0,0 +1,142 @@
+/**
+ * @file      ssd1306_textbox.h
+ * @brief     Word-wrapped text box with cached line breaks.
+ * @version   1.0
+ *
+ * @details
+ * A text box lays a paragraph out into lines once: breaks go after spaces, at explicit
+ * newlines, and inside a word only if the word alone is wider than the box. The line
+ * table (start, length and width of each line) is kept with the box and is reused as
+ * long as the text, the font and the box width stay the same, so scrolling and
+ * redrawing never measure the text again.
+ *
+ * Drawing clears the box and renders only the lines that intersect it at the current
+ * scroll offset, aligned left, centered or right. With ellipsis enabled, the layout
+ * stops at the lines that fit in the box and the last one ends in "..." if text was
+ * cut off.
+ *
+ * The line table lives in the box (SSD1306_TEXTBOX_MAX_LINES entries) unless the
+ * configuration provides one of any size. Text that does not fit in the table is cut
+ * off after its last line, which then ends in "...", and `ssd1306_textbox_set_text`
+ * reports it.
+ *
+ * @note The text box uses a GFX font at text size 1 and does not copy the text.
+ */
+
+#ifndef SSD1306_TEXTBOX_H
+#define SSD1306_TEXTBOX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSD1306_TEXTBOX_MAX_LINES 32 ///< Entries of the built-in line table.
+
+/**
+ * @brief Horizontal alignment of the lines.
+ */
+typedef enum {
+    SSD1306_TEXT_ALIGN_LEFT = 0, ///< Flush with the left edge.
+    SSD1306_TEXT_ALIGN_CENTER,   ///< Centered in the box.
+    SSD1306_TEXT_ALIGN_RIGHT,    ///< Flush with the right edge.
+} ssd1306_text_align_t;
+
+/**
+ * @brief A laid-out line.
+ */
+typedef struct {
+    uint16_t start;  ///< Offset of the first character in the text.
+    uint16_t len;    ///< Number of characters shown (trailing spaces excluded).
+    uint16_t width;  ///< Width in pixels, ellipsis included.
+    bool ellipsis;   ///< The line ends in "...".
+} ssd1306_textbox_line_t;
+
+/**
+ * @brief Text box configuration.
+ */
+typedef struct {
+    int16_t x, y, w, h;             ///< Bounds on screen.
+    ssd1306_text_align_t align;     ///< Line alignment.
+    bool ellipsis;                  ///< Keep only the lines that fit and end the last one in "..." if text is cut off.
+    ssd1306_textbox_line_t *lines;  ///< Caller-provided line table, or NULL for the built-in one.
+    uint16_t max_lines;             ///< Entries in `lines`.
+} ssd1306_textbox_config_t;
+
+/**
+ * @brief Text box state. Treat as read-only.
+ */
+typedef struct {
+    ssd1306_handle_t disp;                                ///< Target display.
+    ssd1306_textbox_config_t cfg;                         ///< Configuration.
+    const ssd1306_font_handle_t *font;                    ///< Font.
+    const char *text;                                     ///< Text (not copied).
+    uint16_t text_len;                                    ///< Length of the laid-out text.
+    uint32_t text_hash;                                   ///< Hash of the laid-out text, to detect changes in place.
+    int8_t ascent;                                        ///< Baseline offset from the top of a line.
+    uint8_t line_h;                                       ///< Line height in pixels.
+    ssd1306_textbox_line_t line_buf[SSD1306_TEXTBOX_MAX_LINES]; ///< Built-in line table.
+    uint16_t line_count;                                  ///< Lines in the table.
+    bool truncated;                                       ///< Text did not fit in the line table or the box.
+    int16_t scroll;                                       ///< Vertical scroll offset in pixels.
+    uint32_t layouts;                                     ///< Number of layout passes, for profiling.
+} ssd1306_textbox_t;
+
+/**
+ * @brief Prepares an empty text box.
+ *
+ * @param[out] tb Text box state.
+ * @param[in] disp Target display.
+ * @param[in] cfg Configuration (copied; a caller-provided line table must outlive the box).
+ * @param[in] font GFX font.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments.
+ */
+esp_err_t ssd1306_textbox_init(ssd1306_textbox_t *tb, ssd1306_handle_t disp, const ssd1306_textbox_config_t *cfg, const ssd1306_font_handle_t *font);
+
+/**
+ * @brief Sets the text. The layout is redone only if the text differs from the one
+ * laid out last (by pointer, length and content hash); the scroll offset is reset
+ * when it is.
+ *
+ * @param[in] tb Text box.
+ * @param[in] text Text, up to 65535 characters. It must stay valid while the box is used.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments,
+ *         ESP_ERR_INVALID_SIZE if the text needs more lines than the line table holds
+ *         (the lines that fit are kept and the box can still be drawn).
+ */
+esp_err_t ssd1306_textbox_set_text(ssd1306_textbox_t *tb, const char *text);
+
+/**
+ * @brief Sets the vertical scroll offset without touching the layout.
+ *
+ * @param[in] tb Text box.
+ * @param[in] offset Offset in pixels, clamped to the scrollable range.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments.
+ */
+esp_err_t ssd1306_textbox_set_scroll(ssd1306_textbox_t *tb, int16_t offset);
+
+/**
+ * @brief Gets the height of the laid-out text.
+ *
+ * @param[in] tb Text box.
+ * @return int16_t Content height in pixels (0 for an invalid box).
+ */
+int16_t ssd1306_textbox_get_content_height(const ssd1306_textbox_t *tb);
+
+/**
+ * @brief Clears the box and draws the visible lines into the framebuffer.
+ *
+ * @param[in] tb Text box.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments.
+ */
+esp_err_t ssd1306_textbox_draw(ssd1306_textbox_t *tb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_TEXTBOX_H
@@ -0,0 +1,129 @@
+/**
+ * @file      ssd1306_transition.h
+ * @brief     Screen transitions between two canvases with per-frame budgets.
+ * @version   1.0
+ *
+ * @details
+ * A transition animates the display from one full-screen canvas to another. Canvases
+ * use the framebuffer layout (`width * height / 8` bytes, page by page); fill them with
+ * `ssd1306_read_page` after drawing a screen. Every frame is composed page row by page
+ * row from block copies and row masks and written with `ssd1306_write_page`, which
+ * only marks the columns that really changed.
+ *
+ * Effects:
+ * - Slide: the new screen moves in over the old one.
+ * - Push: the new screen moves in and pushes the old one out. A vertical push on a
+ *   plain display moves the display start line instead and writes only the newly
+ *   revealed rows.
+ * - Wipe: an edge sweeps across and reveals the new screen in place.
+ * - Dissolve: a 4x4 ordered dither threshold sweeps from the old to the new screen.
+ * - Curtain: the new screen opens from the center line towards both edges; each half
+ *   is sent on its own, so the unchanged middle is never resent.
+ *
+ * Budgets: effects whose cost grows with the distance covered (wipe, curtain and the
+ * start-line push) advance by at most what fits in the byte budget, so they slow down
+ * instead of exceeding it. Effects that repaint the whole area every frame keep their
+ * timing and drop frames: after an expensive frame the next steps are skipped until
+ * the average bytes and CPU time per step are back within budget.
+ *
+ * @note The start-line push is used on single 128x64 panels only; elsewhere the push is
+ *       composed in software. Do not draw or change the start line while a transition
+ *       runs.
+ */
+
+#ifndef SSD1306_TRANSITION_H
+#define SSD1306_TRANSITION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Transition effect.
+ */
+typedef enum {
+    SSD1306_TRANSITION_SLIDE = 0, ///< New screen slides in over the old one.
+    SSD1306_TRANSITION_PUSH,      ///< New screen pushes the old one out.
+    SSD1306_TRANSITION_WIPE,      ///< Moving edge reveals the new screen in place.
+    SSD1306_TRANSITION_DISSOLVE,  ///< Ordered dither threshold sweep.
+    SSD1306_TRANSITION_CURTAIN,   ///< New screen opens from the center line.
+} ssd1306_transition_effect_t;
+
+/**
+ * @brief Direction in which the new screen (or the wipe edge) moves.
+ *
+ * For the curtain, left/right open from a vertical center line and up/down from a
+ * horizontal one. The dissolve ignores it.
+ */
+typedef enum {
+    SSD1306_TRANSITION_LEFT = 0, ///< Towards x = 0 (enters from the right edge).
+    SSD1306_TRANSITION_RIGHT,    ///< Towards the right edge.
+    SSD1306_TRANSITION_UP,       ///< Towards y = 0 (enters from the bottom edge).
+    SSD1306_TRANSITION_DOWN,     ///< Towards the bottom edge.
+} ssd1306_transition_dir_t;
+
+/**
+ * @brief Transition configuration.
+ */
+typedef struct {
+    ssd1306_transition_effect_t effect; ///< Effect.
+    ssd1306_transition_dir_t dir;       ///< Direction.
+    uint16_t steps;                     ///< Number of `ssd1306_transition_step` calls the transition should take.
+    uint32_t frame_bytes;               ///< Bus budget per step in bytes (0 = unlimited).
+    uint32_t frame_us;                  ///< CPU budget per step in microseconds (0 = unlimited).
+    const uint8_t *from;                ///< Old screen (framebuffer layout).
+    const uint8_t *to;                  ///< New screen (framebuffer layout).
+} ssd1306_transition_config_t;
+
+/**
+ * @brief Transition state. Treat as read-only.
+ */
+typedef struct {
+    ssd1306_handle_t disp;           ///< Target display.
+    ssd1306_transition_config_t cfg; ///< Configuration.
+    uint16_t extent;                 ///< Progress units of the effect (columns, rows or dither levels).
+    uint16_t pos;                    ///< Progress shown on the display (0 to `extent`).
+    uint16_t tick;                   ///< Steps taken.
+    uint16_t skip;                   ///< Steps still to skip to stay within budget.
+    bool start_line;                 ///< True if the push uses the display start line.
+    uint16_t frames;                 ///< Frames sent.
+    uint32_t last_bytes;             ///< Bus bytes of the last frame.
+    uint32_t last_us;                ///< Duration of the last frame, flush included.
+    uint32_t total_bytes;            ///< Bus bytes of all frames.
+} ssd1306_transition_t;
+
+/**
+ * @brief Prepares a transition.
+ *
+ * The display is expected to show `from`. If the framebuffer was drawn over since (e.g.
+ * to render `to`), it is restored, and the first frame also resends what was drawn.
+ *
+ * @param[out] tr Transition state.
+ * @param[in] disp Target display.
+ * @param[in] cfg Configuration (copied; the canvases must stay valid until the end).
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments.
+ */
+esp_err_t ssd1306_transition_begin(ssd1306_transition_t *tr, ssd1306_handle_t disp, const ssd1306_transition_config_t *cfg);
+
+/**
+ * @brief Advances a transition by one step and sends the changed area.
+ *
+ * Call once per animation tick. When it returns ESP_OK the display and the framebuffer
+ * show `to` and the display start line is 0.
+ *
+ * @param[in] tr Transition.
+ * @return esp_err_t ESP_ERR_NOT_FINISHED while running, ESP_OK when done, or the error
+ *         of a bus transfer.
+ */
+esp_err_t ssd1306_transition_step(ssd1306_transition_t *tr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_TRANSITION_H
@@ -0,0 +1,147 @@
+/**
+ * @file      ssd1306_vlist.h
+ * @brief     Virtualized, pixel-smooth scrolling list for long menus.
+ * @version   1.0
+ *
+ * @details
+ * The list never holds its items. Rows are produced on demand by a draw callback, and
+ * only the rows that are on screen are ever rasterized. Scrolling moves the picture in
+ * hardware through the display start line, so a scroll step only rasterizes and sends
+ * the newly revealed pixel rows. Panels whose height does not allow this (less than the
+ * 64 rows of display RAM) shift the framebuffer instead; that step also sends the whole
+ * screen.
+ *
+ * Item heights are cached in caller-provided storage and the list tracks the items at
+ * the top and bottom edge of the screen, so the cost of a scroll step depends on the
+ * step size only, never on the number of items.
+ *
+ * The list takes over the whole screen. While it is active the display start line
+ * belongs to the list; page flipping must be off.
+ */
+
+#ifndef SSD1306_VLIST_H
+#define SSD1306_VLIST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Draws one item.
+ *
+ * The area (0, y, w, h) has been cleared and the clip rectangle is set to the part of
+ * it that is being repainted, so the callback can always draw the whole item.
+ *
+ * @param disp Display to draw on.
+ * @param index Item index.
+ * @param y Top edge of the item in framebuffer coordinates.
+ * @param w Item width (the screen width).
+ * @param h Item height.
+ * @param selected True if the item is the selected one.
+ * @param user_ctx User context from the configuration.
+ */
+typedef void (*ssd1306_vlist_draw_cb_t)(ssd1306_handle_t disp, uint16_t index, int16_t y, int16_t w, int16_t h,
+                                        bool selected, void *user_ctx);
+
+/**
+ * @brief Returns the height of one item in pixels (1-255).
+ *
+ * @param index Item index.
+ * @param user_ctx User context from the configuration.
+ */
+typedef uint8_t (*ssd1306_vlist_height_cb_t)(uint16_t index, void *user_ctx);
+
+/**
+ * @brief List configuration.
+ */
+typedef struct {
+    uint16_t count;                      ///< Number of items.
+    uint8_t row_height;                  ///< Height of every item when `height_cb` is NULL.
+    ssd1306_vlist_height_cb_t height_cb; ///< Optional per-item height. Called once per item.
+    uint8_t *height_cache;               ///< `count` bytes caching `height_cb` results (required with `height_cb`).
+    ssd1306_vlist_draw_cb_t draw_cb;     ///< Item renderer.
+    void *user_ctx;                      ///< Passed to the callbacks.
+} ssd1306_vlist_config_t;
+
+/**
+ * @brief List state. Treat as read-only.
+ */
+typedef struct {
+    ssd1306_handle_t disp;      ///< Target display.
+    ssd1306_vlist_config_t cfg; ///< Configuration.
+    int16_t width, height;      ///< Screen size.
+    bool ring;                  ///< True if scrolling uses the display start line.
+    int32_t scroll;             ///< List row shown at the top of the screen.
+    uint16_t top;               ///< Item at the top edge of the screen.
+    int32_t top_y;              ///< List row of the top item's first row.
+    uint16_t bottom;            ///< Item at (or before) the bottom edge of the screen.
+    int32_t bottom_y;           ///< List row of the bottom item's first row.
+    uint16_t selected;          ///< Selected item.
+    int32_t selected_y;         ///< List row of the selected item's first row.
+    uint16_t last_rows;         ///< Pixel rows rasterized by the last call.
+} ssd1306_vlist_t;
+
+/**
+ * @brief Initializes a list, shows its first items and selects item 0.
+ *
+ * @param[out] list List state.
+ * @param[in] disp Display to take over.
+ * @param[in] cfg Configuration (copied; the height cache is cleared).
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments,
+ *         or the error of the first screen update.
+ */
+esp_err_t ssd1306_vlist_init(ssd1306_vlist_t *list, ssd1306_handle_t disp, const ssd1306_vlist_config_t *cfg);
+
+/**
+ * @brief Scrolls the list by a number of pixels and updates the screen.
+ *
+ * Only the revealed rows are rasterized. Scrolling stops at both ends of the list.
+ *
+ * @param[in] list List.
+ * @param[in] dy Pixels to scroll (positive moves the content up, towards later items).
+ * @return int16_t Pixels actually scrolled.
+ */
+int16_t ssd1306_vlist_scroll(ssd1306_vlist_t *list, int16_t dy);
+
+/**
+ * @brief Selects an item and repaints the visible parts of the old and new selection.
+ *
+ * The list does not scroll; use `ssd1306_vlist_follow` to bring the selection into view.
+ * The cost grows with the distance to the previous selection only.
+ *
+ * @param[in] list List.
+ * @param[in] index Item to select (clamped to the item count).
+ * @return esp_err_t ESP_OK on success, or the error of the screen update.
+ */
+esp_err_t ssd1306_vlist_select(ssd1306_vlist_t *list, uint16_t index);
+
+/**
+ * @brief Scrolls at most `max_step` pixels towards the selected item.
+ *
+ * Call repeatedly (e.g. once per frame) until it returns 0 for a smooth animation.
+ *
+ * @param[in] list List.
+ * @param[in] max_step Largest step in pixels.
+ * @return int16_t Pixels scrolled; 0 once the selected item is fully visible.
+ */
+int16_t ssd1306_vlist_follow(ssd1306_vlist_t *list, int16_t max_step);
+
+/**
+ * @brief Repaints an item whose content changed, if it is visible.
+ *
+ * @param[in] list List.
+ * @param[in] index Item to repaint. Its height must not change.
+ * @return esp_err_t ESP_OK on success, or the error of the screen update.
+ */
+esp_err_t ssd1306_vlist_refresh_item(ssd1306_vlist_t *list, uint16_t index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_VLIST_H
@@ -0,0 +1,249 @@
+/**
+ * @file      ssd1306_widgets.h
+ * @brief     Retained widget toolkit on top of the SSD1306 framebuffer API.
+ * @version   1.0
+ *
+ * @details
+ * Widgets (label, value field, progress bar, list and icon) keep their own state and
+ * bounds. Setters only invalidate the part of a widget that actually changed, and
+ * `ssd1306_ui_render` repaints just those areas. Since the driver tracks the damaged
+ * area of the framebuffer, the following `ssd1306_update_screen` only sends what was
+ * repainted; moving a list selection, for example, costs two row repaints.
+ *
+ * Widgets are plain structures owned by the caller (static or stack storage), so the
+ * toolkit allocates no memory. Layout (bounds, baselines, list rows) is computed once
+ * when a widget is added.
+ */
+
+#ifndef SSD1306_WIDGETS_H
+#define SSD1306_WIDGETS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSD1306_WIDGET_TEXT_MAX 24 ///< Maximum text length of labels and value fields, including the terminator.
+
+/**
+ * @brief Widget kinds.
+ */
+typedef enum {
+    SSD1306_WIDGET_LABEL,    ///< Static or changing text.
+    SSD1306_WIDGET_VALUE,    ///< Integer value formatted with a printf format.
+    SSD1306_WIDGET_PROGRESS, ///< Horizontal progress bar.
+    SSD1306_WIDGET_LIST,     ///< Selectable list of text items.
+    SSD1306_WIDGET_ICON,     ///< Monochrome bitmap.
+} ssd1306_widget_type_t;
+
+/**
+ * @brief A retained widget. Fill it in with one of the `ssd1306_ui_add_*` functions
+ * and treat the fields as read-only afterwards.
+ */
+typedef struct ssd1306_widget_t {
+    ssd1306_widget_type_t type;       ///< Widget kind.
+    int16_t x, y, w, h;               ///< Bounds on screen.
+    int16_t inv_x0, inv_y0;           ///< Top-left corner of the area to repaint.
+    int16_t inv_x1, inv_y1;           ///< Bottom-right corner of the area to repaint (empty if inv_x0 > inv_x1).
+    bool visible;                     ///< Drawn if true, blank otherwise.
+    struct ssd1306_widget_t *next;    ///< Next widget of the same UI.
+    struct ssd1306_ui_t *ui;          ///< Owning UI.
+    union {
+        struct {
+            char text[SSD1306_WIDGET_TEXT_MAX]; ///< Current text (label and value field).
+            const char *fmt;                    ///< Value format, e.g. "%ld rpm" (value field only).
+            int32_t value;                      ///< Current value (value field only).
+            bool auto_width;                    ///< Width follows the text (label added with width 0).
+        } text;
+        struct {
+            int32_t min, max, value;            ///< Range and current value.
+            int16_t fill;                       ///< Filled width in pixels.
+        } progress;
+        struct {
+            const char *const *items;           ///< Item texts.
+            uint16_t count;                     ///< Number of items.
+            uint16_t selected;                  ///< Selected item.
+            uint16_t top;                       ///< First visible item.
+            uint8_t rows;                       ///< Visible rows.
+            uint8_t row_h;                      ///< Row height in pixels.
+        } list;
+        struct {
+            const uint8_t *bitmap;              ///< Bitmap in `ssd1306_draw_bitmap` format.
+        } icon;
+    } u;
+} ssd1306_widget_t;
+
+/**
+ * @brief A set of widgets drawn on one display with one font.
+ */
+typedef struct ssd1306_ui_t {
+    ssd1306_handle_t disp;             ///< Target display.
+    const ssd1306_font_handle_t *font; ///< Font of all text widgets.
+    int16_t ascent;                    ///< Font height above the baseline.
+    int16_t line_h;                    ///< Font line height.
+    ssd1306_widget_t *first;           ///< First widget.
+    ssd1306_widget_t *last;            ///< Last widget.
+} ssd1306_ui_t;
+
+/**
+ * @brief Initializes an empty UI.
+ *
+ * @param[out] ui UI to initialize.
+ * @param[in] disp Target display.
+ * @param[in] font Font for all text widgets (a GFX font).
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments.
+ */
+esp_err_t ssd1306_ui_init(ssd1306_ui_t *ui, ssd1306_handle_t disp, const ssd1306_font_handle_t *font);
+
+/**
+ * @brief Adds a text label.
+ *
+ * @param[in] ui UI to add to.
+ * @param[out] w Widget storage.
+ * @param[in] x Left edge.
+ * @param[in] y Top edge.
+ * @param[in] width Width in pixels, or 0 to fit the text (also after `ssd1306_label_set_text`).
+ * @param[in] text Initial text (copied).
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_ui_add_label(ssd1306_ui_t *ui, ssd1306_widget_t *w, int16_t x, int16_t y, int16_t width, const char *text);
+
+/**
+ * @brief Adds an integer value field.
+ *
+ * @param[in] ui UI to add to.
+ * @param[out] w Widget storage.
+ * @param[in] x Left edge.
+ * @param[in] y Top edge.
+ * @param[in] width Width in pixels (must hold the widest value).
+ * @param[in] fmt printf format with one `int32_t` conversion, e.g. "%" PRId32 " C". Must stay valid.
+ * @param[in] value Initial value.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_ui_add_value(ssd1306_ui_t *ui, ssd1306_widget_t *w, int16_t x, int16_t y, int16_t width, const char *fmt, int32_t value);
+
+/**
+ * @brief Adds a horizontal progress bar with an outline.
+ *
+ * @param[in] ui UI to add to.
+ * @param[out] w Widget storage.
+ * @param[in] x Left edge.
+ * @param[in] y Top edge.
+ * @param[in] width Width in pixels (at least 3).
+ * @param[in] height Height in pixels (at least 3).
+ * @param[in] min Value of an empty bar.
+ * @param[in] max Value of a full bar (greater than `min`).
+ * @param[in] value Initial value.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_ui_add_progress(ssd1306_ui_t *ui, ssd1306_widget_t *w, int16_t x, int16_t y, int16_t width, int16_t height,
+                                  int32_t min, int32_t max, int32_t value);
+
+/**
+ * @brief Adds a selectable list. The selected row is drawn inverted.
+ *
+ * @param[in] ui UI to add to.
+ * @param[out] w Widget storage.
+ * @param[in] x Left edge.
+ * @param[in] y Top edge.
+ * @param[in] width Width in pixels.
+ * @param[in] rows Number of visible rows.
+ * @param[in] items Item texts (must stay valid).
+ * @param[in] count Number of items.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_ui_add_list(ssd1306_ui_t *ui, ssd1306_widget_t *w, int16_t x, int16_t y, int16_t width, uint8_t rows,
+                              const char *const *items, uint16_t count);
+
+/**
+ * @brief Adds an icon.
+ *
+ * @param[in] ui UI to add to.
+ * @param[out] w Widget storage.
+ * @param[in] x Left edge.
+ * @param[in] y Top edge.
+ * @param[in] bitmap Bitmap in `ssd1306_draw_bitmap` format (must stay valid).
+ * @param[in] width Bitmap width.
+ * @param[in] height Bitmap height.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_ui_add_icon(ssd1306_ui_t *ui, ssd1306_widget_t *w, int16_t x, int16_t y, const uint8_t *bitmap, int16_t width, int16_t height);
+
+/**
+ * @brief Changes the text of a label. Nothing is invalidated if the text is unchanged.
+ * An auto-width label is resized to the new text, and its old area is repainted too.
+ *
+ * @param[in] w Label widget.
+ * @param[in] text New text (copied, truncated to SSD1306_WIDGET_TEXT_MAX - 1 characters).
+ */
+void ssd1306_label_set_text(ssd1306_widget_t *w, const char *text);
+
+/**
+ * @brief Changes the value of a value field. Nothing is invalidated if the text is unchanged.
+ *
+ * @param[in] w Value widget.
+ * @param[in] value New value.
+ */
+void ssd1306_value_set(ssd1306_widget_t *w, int32_t value);
+
+/**
+ * @brief Changes the value of a progress bar. Only the columns between the old and the
+ * new fill level are invalidated.
+ *
+ * @param[in] w Progress widget.
+ * @param[in] value New value (clamped to the range).
+ */
+void ssd1306_progress_set(ssd1306_widget_t *w, int32_t value);
+
+/**
+ * @brief Selects a list item. If it is visible, only the old and the new row are
+ * invalidated; otherwise the list scrolls and is repainted.
+ *
+ * @param[in] w List widget.
+ * @param[in] index Item to select (clamped to the item count).
+ */
+void ssd1306_list_select(ssd1306_widget_t *w, uint16_t index);
+
+/**
+ * @brief Moves the list selection, wrapping around at both ends.
+ *
+ * @param[in] w List widget.
+ * @param[in] delta Number of items to move (negative moves up).
+ */
+void ssd1306_list_move(ssd1306_widget_t *w, int16_t delta);
+
+/**
+ * @brief Shows or hides a widget.
+ *
+ * @param[in] w Widget.
+ * @param[in] visible True to show the widget.
+ */
+void ssd1306_widget_set_visible(ssd1306_widget_t *w, bool visible);
+
+/**
+ * @brief Invalidates a whole widget, e.g. after drawing over it.
+ *
+ * @param[in] w Widget.
+ */
+void ssd1306_widget_invalidate(ssd1306_widget_t *w);
+
+/**
+ * @brief Repaints the invalidated areas of all widgets into the framebuffer.
+ *
+ * Call `ssd1306_update_screen` afterwards; it only sends the repainted area.
+ * The current font of the display is set to the UI font.
+ *
+ * @param[in] ui UI to render.
+ * @return uint16_t Number of widgets repainted.
+ */
+uint16_t ssd1306_ui_render(ssd1306_ui_t *ui);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_WIDGETS_H
@@ -0,0 +1,64 @@
+# Included by the ESP-IDF build into the project scope, so application components can
+# compile images into page-format headers at build time:
+#
+#   idf_component_register(SRCS "main.c" INCLUDE_DIRS "." REQUIRES ssd1306)
+#   ssd1306_add_assets(${COMPONENT_LIB} MANIFEST assets/assets.txt HEADER game_assets.h)
+#
+# The asset compiler (tools/asset_compiler) is built once per project with the host
+# compiler. The header is regenerated when the manifest or one of its images changes,
+# and its directory is added to the target's include path.
+
+set(SSD1306_ASSET_COMPILER_DIR "${CMAKE_CURRENT_LIST_DIR}/tools/asset_compiler")
+
+function(ssd1306_add_assets target)
+    cmake_parse_arguments(ARG "" "MANIFEST;HEADER" "" ${ARGN})
+    if(NOT ARG_MANIFEST)
+        message(FATAL_ERROR "ssd1306_add_assets: MANIFEST is required")
+    endif()
+    if(NOT ARG_HEADER)
+        set(ARG_HEADER "ssd1306_assets.h")
+    endif()
+    get_filename_component(manifest "${ARG_MANIFEST}" ABSOLUTE)
+    get_filename_component(manifest_dir "${manifest}" DIRECTORY)
+
+    # Host build of the compiler; the cross toolchain is deliberately not passed on.
+    set(tool_dir "${CMAKE_BINARY_DIR}/ssd1306_asset_compiler")
+    set(tool "${tool_dir}/ssd1306_assets${CMAKE_HOST_EXECUTABLE_SUFFIX}")
+    if(NOT TARGET ssd1306_asset_compiler)
+        include(ExternalProject)
+        ExternalProject_Add(ssd1306_asset_compiler
+            SOURCE_DIR "${SSD1306_ASSET_COMPILER_DIR}"
+            BINARY_DIR "${tool_dir}"
+            CMAKE_ARGS -DCMAKE_BUILD_TYPE=Release
+            INSTALL_COMMAND ""
+            BUILD_ALWAYS OFF
+            BUILD_BYPRODUCTS "${tool}")
+    endif()
+
+    # The images listed in the manifest (second field of each entry) are dependencies.
+    set(deps "${manifest}")
+    file(STRINGS "${manifest}" lines)
+    foreach(line IN LISTS lines)
+        if(line MATCHES "^[ \t]*[A-Za-z_][A-Za-z0-9_]*[ \t]+([^ \t#]+)")
+            set(image "${CMAKE_MATCH_1}")
+            if(NOT IS_ABSOLUTE "${image}")
+                set(image "${manifest_dir}/${image}")
+            endif()
+            list(APPEND deps "${image}")
+        endif()
+    endforeach()
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${manifest}")
+
+    set(out_dir "${CMAKE_CURRENT_BINARY_DIR}/ssd1306_assets")
+    set(header "${out_dir}/${ARG_HEADER}")
+    file(MAKE_DIRECTORY "${out_dir}")
+    add_custom_command(OUTPUT "${header}"
+        COMMAND "${tool}" "${manifest}" "${header}"
+        DEPENDS ${deps} ssd1306_asset_compiler "${tool}"
+        COMMENT "Compiling SSD1306 assets from ${ARG_MANIFEST}"
+        VERBATIM)
+    string(MAKE_C_IDENTIFIER "${target}_${ARG_HEADER}" assets_target)
+    add_custom_target(${assets_target} DEPENDS "${header}")
+    add_dependencies(${target} ${assets_target})
+    target_include_directories(${target} PRIVATE "${out_dir}")
+endfunction()
@@ -13,16 +13,23 @@
  */
 
 #include <string.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <math.h>
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "esp_log.h"
 #include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_rom_sys.h"
+#include "esp_rom_crc.h"
 #include "driver/gpio.h"
 
 #include "ssd1306.h"
+#include "ssd1306_qr.h"
+#include "ssd1306_bits.h"
 
 static const char *TAG = "SSD1306";
 
@@ -36,6 +43,7 @@ static const char *TAG = "SSD1306";
     } /**< Swaps two int16_t variables. */
 #define _abs(a) ((a) < 0 ? -(a) : (a))     /**< Computes the absolute value of a number. */
 #define _min(a, b) (((a) < (b)) ? (a) : (b)) /**< Returns the minimum of two values. */
+#define _max(a, b) (((a) > (b)) ? (a) : (b)) /**< Returns the maximum of two values. */
 
 // I2C Control Byte definitions for SSD1306
 #define OLED_CONTROL_BYTE_CMD_STREAM 0x00  /**< Control byte for a command stream. */
@@ -69,6 +77,125 @@ static const char *TAG = "SSD1306";
 #define OLED_CMD_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL 0x2A  /**< Vertical and left horizontal scroll. */
 #define OLED_CMD_SET_VERTICAL_SCROLL_AREA 0xA3           /**< Sets vertical scroll area. */
 
+// Deferred command kinds, used as bits in `pending_cmds`.
+#define SSD1306_PENDING_STOP_SCROLL (1 << 0) /**< Scroll deactivation is queued. */
+#define SSD1306_PENDING_CONTRAST (1 << 1)    /**< Contrast change is queued. */
+#define SSD1306_PENDING_INVERT (1 << 2)      /**< Normal/inverse display change is queued. */
+#define SSD1306_PENDING_ORIENTATION (1 << 3) /**< Segment remap and COM scan change is queued. */
+#define SSD1306_PENDING_START_LINE (1 << 4)  /**< Display start line change is queued. */
+#define SSD1306_PENDING_SCROLL (1 << 5)      /**< Scroll setup and activation is queued. */
+
+#define SSD1306_SCROLL_CMDS_MAX 16 /**< Longest scroll setup sequence (vertical area + diagonal setup). */
+#define SSD1306_SCROLL_SETTLE_US 10000 /**< Minimum time between scroll changes, so the previous one takes effect. */
+#define SSD1306_INIT_CMDS_MAX 28 /**< Length of the init sequence including display-on. */
+#define SSD1306_RESET_PULSE_US 10 /**< Fast boot reset pulse (datasheet minimum 3 us, with margin for slow RC edges). */
+#define SSD1306_RESET_RECOVERY_US 10 /**< Wait after releasing reset before the first command. */
+#define SSD1306_RCACHE_ENTRIES 32 /**< Raster cache slots; the pool size bounds the bytes they hold. */
+#define SSD1306_GLYPH_SCRATCH 512 /**< Stack buffer for a rotated glyph or a compressed asset frame (64x64 pixels). */
+
+// Primitive kinds of raster cache keys.
+#define SSD1306_RCACHE_CIRCLE 1       /**< `ssd1306_draw_circle`. */
+#define SSD1306_RCACHE_FILL_CIRCLE 2  /**< `ssd1306_fill_circle`. */
+#define SSD1306_RCACHE_ROUND_RECT 3   /**< `ssd1306_draw_round_rect`. */
+#define SSD1306_RCACHE_FILL_ROUND 4   /**< `ssd1306_fill_round_rect`. */
+#define SSD1306_RCACHE_TEXT 5         /**< `ssd1306_print` with a transparent background. */
+#define SSD1306_RCACHE_GLYPH 6        /**< Page-format glyph of `ssd1306_print_rotated`. */
+
+
+/**
+ * @struct ssd1306_panel_t
+ * @brief A physical panel driven by a handle.
+ * A plain display has a single panel; a tiled logical display has one per tile.
+ */
+typedef struct
+{
+    ssd1306_config_t config; /**< Bus, reset pin and resolution of this panel. */
+    uint16_t x;              /**< Left edge of the panel in logical coordinates. */
+    uint8_t page;            /**< Top page of the panel in logical coordinates. */
+    ssd1306_stats_t stats;   /**< Bus statistics of this panel. */
+
+    // Flush job, prepared by `ssd1306_update_screen` for the port workers.
+    bool job_data;           /**< The panel has damage to write. */
+    uint8_t job_min_col;     /**< First damaged column (panel coordinates). */
+    uint8_t job_max_col;     /**< Last damaged column (panel coordinates). */
+    uint8_t job_min_page;    /**< First damaged page (panel coordinates). */
+    uint8_t job_max_page;    /**< Last damaged page (panel coordinates). */
+    esp_err_t job_ret;       /**< Result of the last flush job. */
+} ssd1306_panel_t;
+
+/**
+ * @struct ssd1306_port_worker_t
+ * @brief Flush task serving all panels of one I2C port of a tiled display.
+ */
+typedef struct
+{
+    struct ssd1306_dev_t *owner; /**< Handle the worker belongs to. */
+    i2c_port_t port;             /**< I2C port served by this worker. */
+    TaskHandle_t task;           /**< Worker task. */
+    SemaphoreHandle_t start;     /**< Given to start a flush of this port's panels. */
+} ssd1306_port_worker_t;
+
+/**
+ * @struct ssd1306_rcache_key_t
+ * @brief Identifies a rasterized primitive independently of its position.
+ * Laid out without padding, so keys compare with memcmp.
+ */
+typedef struct
+{
+    const void *font;   /**< Font handle (text only). */
+    uint32_t text_hash; /**< FNV-1a hash of the text (text only). */
+    int16_t p[3];       /**< Shape parameters (radius, width, height). */
+    uint16_t text_len;  /**< Text length (text only). */
+    uint8_t kind;       /**< Primitive (SSD1306_RCACHE_*). */
+    uint8_t phase;      /**< Row of the bounding box top within its page. */
+    uint8_t size_x;     /**< Text scale on the x-axis (text only). */
+    uint8_t size_y;     /**< Text scale on the y-axis (text only). */
+} ssd1306_rcache_key_t;
+
+/**
+ * @struct ssd1306_rcache_entry_t
+ * @brief A cached raster: a page-format mask of the pixels the primitive sets, followed
+ * by the text it was drawn from (text only).
+ */
+typedef struct
+{
+    ssd1306_rcache_key_t key; /**< Primitive and parameters. */
+    uint32_t last_use;        /**< Use stamp for LRU eviction. */
+    uint32_t offset;          /**< Start of the data in the pool. */
+    uint32_t len;             /**< Data length (mask and text). */
+    uint16_t w;               /**< Mask width in columns. */
+    uint8_t pages;            /**< Mask height in pages. */
+    bool valid;               /**< Slot holds a raster. */
+} ssd1306_rcache_entry_t;
+
+/**
+ * @struct ssd1306_rcache_t
+ * @brief Raster cache of a handle, allocated in one block with its pool.
+ */
+typedef struct
+{
+    ssd1306_rcache_entry_t entries[SSD1306_RCACHE_ENTRIES]; /**< Slots. */
+    uint32_t clock;        /**< Use stamp counter. */
+    uint32_t hits;         /**< Lookups replayed from the cache. */
+    uint32_t misses;       /**< Lookups that rasterized. */
+    bool busy;             /**< A capture is in progress (nested primitives are not cached). */
+    size_t pool_size;      /**< Pool size in bytes. */
+    uint8_t pool[];        /**< Raster data. */
+} ssd1306_rcache_t;
+
+/**
+ * @struct ssd1306_rcache_capture_t
+ * @brief State of a primitive being rasterized into a new cache entry.
+ */
+typedef struct
+{
+    ssd1306_rcache_entry_t *entry; /**< Entry being filled (NULL if not capturing). */
+    int16_t x;                     /**< Left edge of the mask on screen. */
+    int16_t top;                   /**< Top row of the mask on screen (page-aligned). */
+    ssd1306_color_t color;         /**< Color requested by the caller. */
+    int16_t clip_x0, clip_y0;      /**< Clip rectangle to restore. */
+    int16_t clip_x1, clip_y1;      /**< Clip rectangle to restore. */
+} ssd1306_rcache_capture_t;
 
 /**
  * @struct ssd1306_dev_t
@@ -84,8 +211,8 @@ struct ssd1306_dev_t
     bool needs_update; /**< Flag indicating if an update is required. */
     uint8_t min_page;  /**< Minimum page for partial update. */
     uint8_t max_page;  /**< Maximum page for partial update. */
-    uint8_t min_col;   /**< Minimum column for partial update. */
-    uint8_t max_col;   /**< Maximum column for partial update. */
+    uint16_t min_col;  /**< Minimum column for partial update. */
+    uint16_t max_col;  /**< Maximum column for partial update. */
 
     // Graphics state (adapted from Adafruit_GFX)
     int16_t cursor_x;                     /**< Current x-coordinate of the text cursor. */
@@ -95,52 +222,157 @@ struct ssd1306_dev_t
     ssd1306_color_t textcolor;            /**< Text foreground color. */
     ssd1306_color_t textbgcolor;          /**< Text background color. */
     bool wrap;                            /**< Text wrapping mode. */
+    uint16_t stroke_height;               /**< Capital height of stroke fonts in pixels (0 = text size). */
+    uint8_t stroke_thickness;             /**< Pen width of stroke fonts in pixels. */
     const ssd1306_font_handle_t *gfxFont; /**< Current font handle. */
+    int16_t clip_x0, clip_y0;             /**< Top-left corner of the drawing clip rectangle. */
+    int16_t clip_x1, clip_y1;             /**< Bottom-right corner of the clip rectangle (exclusive). */
+
+    // Deferred command state
+    bool defer_cmds;                      /**< Queue setter commands until the next flush. */
+    uint8_t pending_cmds;                 /**< Bitmask of queued command kinds (SSD1306_PENDING_*). */
+    uint8_t pending_contrast;             /**< Queued contrast value. */
+    uint8_t pending_invert_cmd;           /**< Queued normal/inverse display command. */
+    uint8_t pending_seg_cmd;              /**< Queued segment remap command. */
+    uint8_t pending_com_cmd;              /**< Queued COM scan direction command. */
+    uint8_t pending_start_line;           /**< Queued display start line. */
+    uint8_t pending_scroll[SSD1306_SCROLL_CMDS_MAX]; /**< Queued scroll setup sequence (without activation). */
+    uint8_t pending_scroll_len;           /**< Length of the queued scroll setup sequence. */
+    ssd1306_cmd_error_cb_t cmd_error_cb;  /**< Called when a display command fails to reach the panel. */
+    void *cmd_error_ctx;                  /**< User context passed to `cmd_error_cb`. */
+
+    // Hardware scroll state
+    ssd1306_scroll_state_t scroll_state;  /**< Current hardware scroll state. */
+    bool scroll_on_panel;                 /**< A scroll run is active on the panel (independent of queued changes). */
+    ssd1306_scroll_config_t scroll_cfg;   /**< Last requested scroll configuration. */
+    int64_t scroll_changed_us;            /**< Timestamp of the last scroll command that reached the panel. */
+    ssd1306_scroll_config_t scroll_run_cfg; /**< Configuration of the current or last scroll run. */
+    int64_t scroll_run_since_us;          /**< Timestamp at which the current run was activated. */
+    uint32_t scroll_run_steps;            /**< Steps of the last run already applied to the framebuffer. */
+    bool scroll_run_valid;                /**< A finished run is available for resync. */
+    uint32_t frame_period_us;             /**< Panel frame period, used to estimate scroll steps. */
+    bool seg_remap;                       /**< Segment remap is enabled (the init default). */
+
+    // GDDRAM page flipping state
+    bool page_flip;                       /**< Render into the hidden half of GDDRAM and flip on update. */
+    uint8_t front_half;                   /**< GDDRAM half currently shown (0 = lower, 1 = upper). */
+    uint8_t flip_min_col;                 /**< Dirty area of the previous flush (minimum column). */
+    uint8_t flip_max_col;                 /**< Dirty area of the previous flush (maximum column). */
+    uint8_t flip_min_page;                /**< Dirty area of the previous flush (minimum page). */
+    uint8_t flip_max_page;                /**< Dirty area of the previous flush (maximum page). */
+    uint8_t flip_page_base;               /**< GDDRAM page the current flush writes to. */
+
+    // Controller register shadow (the values the panel currently holds)
+    uint8_t shadow_contrast;              /**< Contrast register. */
+    uint8_t shadow_invert_cmd;            /**< Normal/inverse display command in effect. */
+    uint8_t shadow_seg_cmd;               /**< Segment remap command in effect. */
+    uint8_t shadow_com_cmd;               /**< COM scan direction command in effect. */
+    uint8_t shadow_start_line;            /**< Display start line. */
+    bool shadow_display_on;               /**< Display is switched on. */
+
+    // Framebuffer suspension while the display is off
+    ssd1306_suspend_mode_t suspend_mode;  /**< What happens to the framebuffer on display-off. */
+    uint8_t *suspended;                   /**< Compressed framebuffer while suspended (NULL if discarded). */
+    size_t suspended_len;                 /**< Length of `suspended`. */
+
+    // Physical panels
+    ssd1306_panel_t *panels;              /**< Panels covered by the framebuffer (points to `panel` for a plain display). */
+    uint8_t panel_count;                  /**< Number of panels. */
+    ssd1306_panel_t panel;                /**< Storage for the single panel of a plain display. */
+    int64_t stats_since_us;               /**< Timestamp of the last statistics reset. */
+    int64_t create_start_us;              /**< Timestamp at which creation of the handle started. */
+    int64_t first_pixel_us;               /**< Timestamp at which the first frame reached the panels. */
+
+    // Parallel flush of tiled displays
+    ssd1306_port_worker_t *workers;       /**< One flush task per I2C port (NULL if all panels share a port). */
+    uint8_t worker_count;                 /**< Number of port workers. */
+    SemaphoreHandle_t flush_done;         /**< Given by each worker when its share of a flush is done. */
+    bool workers_exit;                    /**< Asks the workers to terminate. */
+    const uint8_t *job_pre;               /**< Commands sent before the data of the current flush. */
+    size_t job_pre_len;                   /**< Length of `job_pre`. */
+    const uint8_t *job_post;              /**< Commands sent after the data of the current flush. */
+    size_t job_post_len;                  /**< Length of `job_post`. */
+    const uint8_t *const *job_rows;       /**< Per-page data rows replacing the framebuffer as flush source (NULL = framebuffer). */
+
+    // Immediate mode
+    ssd1306_stats_t last_op;              /**< Bus cost of the last immediate-mode operation. */
+
+    // Raster cache
+    ssd1306_rcache_t *rcache;             /**< Cache of rasterized primitives (NULL unless enabled). */
+
+    // Memory
+    ssd1306_arena_handle_t arena;         /**< Arena for the driver's buffers (NULL = heap). */
+    bool own_arena;                       /**< The arena is deleted with the handle. */
+    uint32_t user_bufs;                   /**< Canvases and buffers handed out and not yet freed. */
 };
 
 
 /**
- * @brief Sends a list of commands to the SSD1306 display via I2C.
+ * @brief Executes an I2C transaction on a panel's bus and records its statistics.
  *
- * @param handle SSD1306 device handle.
+ * @param panel Target panel.
+ * @param cmd Prepared I2C link.
+ * @param bytes Number of bytes the link puts on the bus.
+ * @param ticks_to_wait Transfer timeout.
+ * @return esp_err_t Operation status.
+ */
+static esp_err_t _ssd1306_panel_exec(ssd1306_panel_t *panel, i2c_cmd_handle_t cmd, size_t bytes, TickType_t ticks_to_wait)
+{
+    int64_t t0 = esp_timer_get_time();
+    esp_err_t ret = i2c_master_cmd_begin(panel->config.i2c_port, cmd, ticks_to_wait);
+    panel->stats.busy_us += esp_timer_get_time() - t0;
+    panel->stats.transactions++;
+    if (ret == ESP_OK)
+        panel->stats.bytes += bytes;
+    else
+        panel->stats.errors++;
+    return ret;
+}
+
+/**
+ * @brief Sends a list of commands to one panel via I2C.
+ *
+ * @param panel Target panel.
  * @param cmd_list Array of commands to send.
  * @param size Size of the command array in bytes.
  * @return esp_err_t Operation status.
  */
 #define I2C_CMD_BUFFER_SIZE 256 // Static buffer size for the I2C link. Adjust if needed for very long command lists.
 
-static uint8_t i2c_cmd_buffer[I2C_CMD_BUFFER_SIZE]; // Static buffer for the I2C link to avoid repeated dynamic memory allocation.
-static i2c_cmd_handle_t cmd_cache = NULL;           // Cache the I2C link handle for reuse, improving efficiency.
+static uint8_t i2c_cmd_buffer[I2C_NUM_MAX][I2C_CMD_BUFFER_SIZE]; // Static buffer per port for the I2C link to avoid repeated dynamic memory allocation.
+static i2c_cmd_handle_t cmd_cache[I2C_NUM_MAX];                  // Cache the I2C link handle per port for reuse, improving efficiency.
+static uint8_t i2c_port_refs[I2C_NUM_MAX];                       // Number of panels using each I2C port driver.
+static const uint8_t ssd1306_zero_row[128];                      // Blank GDDRAM page row, streamed by immediate-mode writes.
 
-static esp_err_t _ssd1306_send_cmd_list(ssd1306_handle_t handle, const uint8_t *cmd_list, size_t size)
+static esp_err_t _ssd1306_panel_send_cmds(ssd1306_panel_t *panel, const uint8_t *cmd_list, size_t size)
 {
-    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    i2c_port_t port = panel->config.i2c_port;
 
     // Initialize the static I2C link if this is the first call.
     // This is an optimization to avoid recreating the handle every time.
-    if (!cmd_cache)
+    if (!cmd_cache[port])
     {
-        cmd_cache = i2c_cmd_link_create_static(i2c_cmd_buffer, I2C_CMD_BUFFER_SIZE);
-        ESP_RETURN_ON_FALSE(cmd_cache, ESP_ERR_NO_MEM, TAG, "Failed to create static I2C command link");
+        cmd_cache[port] = i2c_cmd_link_create_static(i2c_cmd_buffer[port], I2C_CMD_BUFFER_SIZE);
+        ESP_RETURN_ON_FALSE(cmd_cache[port], ESP_ERR_NO_MEM, TAG, "Failed to create static I2C command link");
     }
 
     // Reset and recreate the link from the existing static buffer.
     // This is faster than `i2c_cmd_link_create()` followed by `i2c_cmd_link_delete()`.
-    i2c_cmd_link_delete(cmd_cache);
-    cmd_cache = i2c_cmd_link_create_static(i2c_cmd_buffer, I2C_CMD_BUFFER_SIZE);
+    i2c_cmd_link_delete(cmd_cache[port]);
+    cmd_cache[port] = i2c_cmd_link_create_static(i2c_cmd_buffer[port], I2C_CMD_BUFFER_SIZE);
 
     // Build the I2C transmission sequence.
-    i2c_master_start(cmd_cache);
-    i2c_master_write_byte(cmd_cache, (handle->config.i2c_addr << 1) | I2C_MASTER_WRITE, true);
-    i2c_master_write_byte(cmd_cache, OLED_CONTROL_BYTE_CMD_STREAM, true); // Indicate that the following data is a command.
-    i2c_master_write(cmd_cache, cmd_list, size, true);
-    i2c_master_stop(cmd_cache);
+    i2c_master_start(cmd_cache[port]);
+    i2c_master_write_byte(cmd_cache[port], (panel->config.i2c_addr << 1) | I2C_MASTER_WRITE, true);
+    i2c_master_write_byte(cmd_cache[port], OLED_CONTROL_BYTE_CMD_STREAM, true); // Indicate that the following data is a command.
+    i2c_master_write(cmd_cache[port], cmd_list, size, true);
+    i2c_master_stop(cmd_cache[port]);
 
     esp_err_t ret = ESP_FAIL;
     // Retry mechanism to handle potential temporary glitches on the I2C bus.
     for (int retry = 0; retry < 3; retry++)
     { 
-        ret = i2c_master_cmd_begin(handle->config.i2c_port, cmd_cache, pdMS_TO_TICKS(100));
+        ret = _ssd1306_panel_exec(panel, cmd_cache[port], size + 2, pdMS_TO_TICKS(100));
         if (ret == ESP_OK)
             break; // If successful, exit the loop.
         vTaskDelay(pdMS_TO_TICKS(10)); // Wait a short time before retrying.
@@ -150,6 +382,270 @@ static esp_err_t _ssd1306_send_cmd_list(ssd1306_handle_t handle, const uint8_t *
     return ret;
 }
 
+/**
+ * @brief Sends a list of commands to the SSD1306 display via I2C.
+ * On a tiled display the commands are sent to every panel.
+ *
+ * @param handle SSD1306 device handle.
+ * @param cmd_list Array of commands to send.
+ * @param size Size of the command array in bytes.
+ * @return esp_err_t Operation status (the first error if several panels fail).
+ */
+static esp_err_t _ssd1306_send_cmd_list(ssd1306_handle_t handle, const uint8_t *cmd_list, size_t size)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+
+    esp_err_t ret = ESP_OK;
+    for (uint8_t i = 0; i < handle->panel_count; i++)
+    {
+        esp_err_t err = _ssd1306_panel_send_cmds(&handle->panels[i], cmd_list, size);
+        if (ret == ESP_OK)
+            ret = err;
+    }
+    return ret;
+}
+
+/**
+ * @brief Reports the result of a command whose status cannot be returned to the caller.
+ * Setters such as `ssd1306_set_contrast` return void, so failures are forwarded to the
+ * user's error callback instead of being silently dropped.
+ *
+ * @param handle SSD1306 device handle.
+ * @param err Result of the transmission.
+ */
+static void _ssd1306_report_cmd_error(ssd1306_handle_t handle, esp_err_t err)
+{
+    if (err == ESP_OK)
+        return;
+    ESP_LOGW(TAG, "Display command failed: %s", esp_err_to_name(err));
+    if (handle->cmd_error_cb)
+        handle->cmd_error_cb(handle, err, handle->cmd_error_ctx);
+}
+
+/**
+ * @brief Checks whether the scroll settle time has elapsed since the last scroll change.
+ *
+ * @param handle SSD1306 device handle.
+ * @return true if a new scroll setup may be sent.
+ */
+static bool _ssd1306_scroll_settled(ssd1306_handle_t handle)
+{
+    return (esp_timer_get_time() - handle->scroll_changed_us) >= SSD1306_SCROLL_SETTLE_US;
+}
+
+/**
+ * @brief Serializes the queued setter commands.
+ * Commands that must precede the framebuffer data are written to `pre`, the scroll
+ * setup and activation (which must follow any RAM write) are written to `post`.
+ * Each command kind appears at most once, so the last queued value wins. A scroll
+ * start is held back until the scroll settle time has elapsed.
+ *
+ * @param handle SSD1306 device handle.
+ * @param pre Output buffer for commands sent before the data phase (at least 8 bytes).
+ * @param pre_len Pointer to store the number of bytes written to `pre`.
+ * @param post Output buffer for commands sent after the data phase.
+ * @param post_len Pointer to store the number of bytes written to `post`.
+ * @return uint8_t Bitmask of the command kinds that were serialized.
+ */
+static uint8_t _ssd1306_build_pending_cmds(ssd1306_handle_t handle, uint8_t *pre, size_t *pre_len, uint8_t *post, size_t *post_len)
+{
+    size_t n = 0, m = 0;
+    uint8_t pending = handle->pending_cmds;
+    // Everything except a scroll start that is still settling goes out now.
+    uint8_t sent = pending & ~SSD1306_PENDING_SCROLL;
+
+    if (pending & SSD1306_PENDING_STOP_SCROLL)
+        pre[n++] = OLED_CMD_DEACTIVATE_SCROLL;
+    if (pending & SSD1306_PENDING_CONTRAST)
+    {
+        pre[n++] = OLED_CMD_SET_CONTRAST;
+        pre[n++] = handle->pending_contrast;
+    }
+    if (pending & SSD1306_PENDING_INVERT)
+        pre[n++] = handle->pending_invert_cmd;
+    if (pending & SSD1306_PENDING_ORIENTATION)
+    {
+        pre[n++] = handle->pending_seg_cmd;
+        pre[n++] = handle->pending_com_cmd;
+    }
+    if (pending & SSD1306_PENDING_START_LINE)
+        pre[n++] = OLED_CMD_SET_DISPLAY_START_LINE | handle->pending_start_line;
+    if ((pending & SSD1306_PENDING_SCROLL) && _ssd1306_scroll_settled(handle))
+    {
+        sent |= SSD1306_PENDING_SCROLL;
+        memcpy(post, handle->pending_scroll, handle->pending_scroll_len);
+        m = handle->pending_scroll_len;
+        post[m++] = OLED_CMD_ACTIVATE_SCROLL;
+    }
+
+    *pre_len = n;
+    *post_len = m;
+    return sent;
+}
+
+/**
+ * @brief Rotates a column range of the framebuffer in place.
+ * Mirrors what the controller does to GDDRAM during a horizontal scroll.
+ *
+ * @param handle SSD1306 device handle.
+ * @param start_page First page to rotate.
+ * @param end_page Last page to rotate.
+ * @param start_col First column of the range.
+ * @param end_col Last column of the range.
+ * @param shift Number of columns to move (positive = towards higher x).
+ */
+static void _ssd1306_rotate_columns(ssd1306_handle_t handle, uint8_t start_page, uint8_t end_page, uint8_t start_col, uint8_t end_col, int32_t shift)
+{
+    int32_t len = end_col - start_col + 1;
+    shift %= len;
+    if (shift < 0)
+        shift += len;
+    if (shift == 0)
+        return;
+
+    for (uint8_t page = start_page; page <= end_page; page++)
+    {
+        uint8_t *row = &handle->buffer[page * handle->config.screen_width + start_col];
+        // Rotate right by `shift` using three reversals (no temporary buffer needed).
+        int32_t spans[3][2] = {{0, len - 1}, {0, shift - 1}, {shift, len - 1}};
+        for (int k = 0; k < 3; k++)
+        {
+            for (int32_t i = spans[k][0], j = spans[k][1]; i < j; i++, j--)
+            {
+                uint8_t t = row[i];
+                row[i] = row[j];
+                row[j] = t;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Applies `steps` scroll steps of a finished scroll run to the framebuffer.
+ * Only the horizontal component moves GDDRAM; the vertical offset of the diagonal
+ * scrolls is a display mapping that the controller drops on deactivation.
+ *
+ * @param handle SSD1306 device handle.
+ * @param cfg Configuration of the scroll run.
+ * @param steps Number of steps to apply (may be negative to undo).
+ */
+static void _ssd1306_scroll_apply_steps(ssd1306_handle_t handle, const ssd1306_scroll_config_t *cfg, int32_t steps)
+{
+    bool right = (cfg->direction == SSD1306_SCROLL_RIGHT || cfg->direction == SSD1306_SCROLL_VERTICAL_RIGHT);
+    // Directions are defined for the default segment remap; a flipped mount reverses them.
+    if (!handle->seg_remap)
+        right = !right;
+    bool horizontal = (cfg->direction <= SSD1306_SCROLL_LEFT);
+    uint8_t start_col = horizontal ? cfg->start_col : 0;
+    uint8_t end_col = horizontal ? cfg->end_col : handle->config.screen_width - 1;
+    _ssd1306_rotate_columns(handle, cfg->start_page, cfg->end_page, start_col, end_col, right ? steps : -steps);
+}
+
+/**
+ * @brief Returns the duration of one scroll step at a speed setting.
+ *
+ * @param handle SSD1306 device handle.
+ * @param speed Scroll speed (interval code).
+ * @return uint64_t Step duration in microseconds.
+ */
+static uint64_t _ssd1306_scroll_step_us(ssd1306_handle_t handle, ssd1306_scroll_speed_t speed)
+{
+    static const uint16_t frames_per_step[] = {5, 64, 128, 256, 3, 4, 25, 2};
+    return (uint64_t)frames_per_step[speed] * handle->frame_period_us;
+}
+
+/**
+ * @brief Records the end of a scroll run and brings the framebuffer in line with GDDRAM.
+ * The number of elapsed steps is estimated from the run time, the configured speed
+ * and the frame period. `ssd1306_scroll_resync` can correct it with an exact count.
+ *
+ * @param handle SSD1306 device handle.
+ * @param now Timestamp at which the deactivation reached the panel.
+ */
+static void _ssd1306_scroll_finish_run(ssd1306_handle_t handle, int64_t now)
+{
+    uint64_t step_us = _ssd1306_scroll_step_us(handle, handle->scroll_run_cfg.speed);
+    int64_t elapsed = now - handle->scroll_run_since_us;
+
+    handle->scroll_run_steps = (elapsed > 0 && step_us) ? (uint32_t)(elapsed / step_us) : 0;
+    handle->scroll_run_valid = true;
+    _ssd1306_scroll_apply_steps(handle, &handle->scroll_run_cfg, handle->scroll_run_steps);
+}
+
+/**
+ * @brief Removes successfully sent commands from the queue and updates the scroll state.
+ *
+ * @param handle SSD1306 device handle.
+ * @param sent Bitmask of the command kinds that reached the panel.
+ */
+static void _ssd1306_commit_pending_cmds(ssd1306_handle_t handle, uint8_t sent)
+{
+    int64_t now = esp_timer_get_time();
+    handle->pending_cmds &= ~sent;
+    if (sent & SSD1306_PENDING_CONTRAST)
+        handle->shadow_contrast = handle->pending_contrast;
+    if (sent & SSD1306_PENDING_INVERT)
+        handle->shadow_invert_cmd = handle->pending_invert_cmd;
+    if (sent & SSD1306_PENDING_ORIENTATION)
+    {
+        handle->shadow_seg_cmd = handle->pending_seg_cmd;
+        handle->shadow_com_cmd = handle->pending_com_cmd;
+    }
+    if (sent & SSD1306_PENDING_START_LINE)
+        handle->shadow_start_line = handle->pending_start_line;
+    // The batch's deactivation ends the previous run before the new one replaces its
+    // configuration. `scroll_state` already reads PENDING when a restart is queued, so
+    // whether a run is on the panel is tracked separately.
+    if ((sent & SSD1306_PENDING_STOP_SCROLL) && handle->scroll_on_panel)
+    {
+        _ssd1306_scroll_finish_run(handle, now);
+        handle->scroll_on_panel = false;
+        handle->scroll_changed_us = now;
+    }
+    if (sent & SSD1306_PENDING_SCROLL)
+    {
+        handle->scroll_state = SSD1306_SCROLL_STATE_ACTIVE;
+        handle->scroll_on_panel = true;
+        handle->scroll_run_cfg = handle->scroll_cfg;
+        handle->scroll_run_since_us = now;
+        handle->scroll_changed_us = now;
+    }
+    else if (sent & SSD1306_PENDING_STOP_SCROLL)
+    {
+        // A start that is still settling keeps the state at PENDING.
+        if (!(handle->pending_cmds & SSD1306_PENDING_SCROLL))
+            handle->scroll_state = SSD1306_SCROLL_STATE_STOPPED;
+    }
+}
+
+/**
+ * @brief Sends all queued setter commands as a single command transaction.
+ * Used when there is no framebuffer data to carry them.
+ *
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t Operation status.
+ */
+static esp_err_t _ssd1306_send_pending_cmds(ssd1306_handle_t handle)
+{
+    if (!handle->pending_cmds)
+        return ESP_OK;
+
+    uint8_t cmds[8 + SSD1306_SCROLL_CMDS_MAX + 1];
+    size_t pre_len, post_len;
+    uint8_t sent = _ssd1306_build_pending_cmds(handle, cmds, &pre_len, cmds + 8, &post_len);
+    if (!sent)
+        return ESP_OK;
+    // Close the gap between the two halves so they go out back to back.
+    memmove(cmds + pre_len, cmds + 8, post_len);
+
+    esp_err_t ret = _ssd1306_send_cmd_list(handle, cmds, pre_len + post_len);
+    if (ret == ESP_OK)
+        _ssd1306_commit_pending_cmds(handle, sent); // Keep the queue on failure so the next flush retries it.
+    else
+        _ssd1306_report_cmd_error(handle, ret);
+    return ret;
+}
+
 /**
  * @brief Resets the dirty area for partial updates.
  * This is called after a screen update is successful.
@@ -179,8 +675,8 @@ static void _ssd1306_reset_dirty_area(ssd1306_handle_t handle)
  */
 static void _ssd1306_mark_dirty(ssd1306_handle_t handle, int16_t x, int16_t y, int16_t w, int16_t h)
 {
-    // Ignore if completely off-screen.
-    if (!handle || x >= handle->config.screen_width || y >= handle->config.screen_height ||
+    // Ignore if completely off-screen, or if there is no framebuffer to flush.
+    if (!handle || handle->config.no_framebuffer || x >= handle->config.screen_width || y >= handle->config.screen_height ||
         x + w <= 0 || y + h <= 0)
         return;
 
@@ -202,336 +698,2327 @@ static void _ssd1306_mark_dirty(ssd1306_handle_t handle, int16_t x, int16_t y, i
     handle->needs_update = true; // Flag that a pending update exists.
 }
 
-
 /**
- * @brief Helper function to draw a circle quadrant.
- * Used by `ssd1306_draw_round_rect`.
+ * @brief Compresses a byte stream with a PackBits-style run-length code.
+ * A control byte below 0x80 is followed by (control + 1) literal bytes; a control
+ * byte of 0x80 or more repeats the next byte (control - 0x80 + 2) times.
  *
- * @param handle SSD1306 device handle.
- * @param x0 Center x-coordinate.
- * @param y0 Center y-coordinate.
- * @param r Circle radius.
- * @param cornername Bitmask indicating which quadrant to draw.
- * @param color Drawing color.
+ * @param src Data to compress.
+ * @param len Length of `src`.
+ * @param dst Output buffer, or NULL to only compute the compressed length.
+ * @param cap Capacity of `dst`.
+ * @return size_t Compressed length, or 0 if the output does not fit.
  */
-static void _ssd1306_draw_circle_helper(ssd1306_handle_t handle, int16_t x0, int16_t y0, int16_t r, uint8_t cornername, ssd1306_color_t color)
+static size_t _ssd1306_rle_encode(const uint8_t *src, size_t len, uint8_t *dst, size_t cap)
 {
-    // Midpoint circle algorithm (Bresenham's)
-    int16_t f = 1 - r;
-    int16_t ddF_x = 1;
-    int16_t ddF_y = -2 * r;
-    int16_t x = 0;
-    int16_t y = r;
-
-    while (x < y)
+    size_t in = 0, out = 0;
+    while (in < len)
     {
-        if (f >= 0)
-        {
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
-        }
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
-        // Draw pixels in the appropriate quadrant based on the bitmask.
-        if (cornername & 0x4) // Bottom right
+        size_t run = 1;
+        while (in + run < len && run < 129 && src[in + run] == src[in])
+            run++;
+        // Runs of two are cheaper as part of a literal sequence.
+        if (run >= 3)
         {
-            ssd1306_draw_pixel(handle, x0 + x, y0 + y, color);
-            ssd1306_draw_pixel(handle, x0 + y, y0 + x, color);
-        }
-        if (cornername & 0x2) // Top right
-        {
-            ssd1306_draw_pixel(handle, x0 + x, y0 - y, color);
-            ssd1306_draw_pixel(handle, x0 + y, y0 - x, color);
-        }
-        if (cornername & 0x8) // Bottom left
-        {
-            ssd1306_draw_pixel(handle, x0 - y, y0 + x, color);
-            ssd1306_draw_pixel(handle, x0 - x, y0 + y, color);
+            if (out + 2 > cap)
+                return 0;
+            if (dst)
+            {
+                dst[out] = 0x80 | (uint8_t)(run - 2);
+                dst[out + 1] = src[in];
+            }
+            out += 2;
+            in += run;
+            continue;
         }
-        if (cornername & 0x1) // Top left
+
+        // Collect literals up to the next run of three or more equal bytes.
+        size_t lit = run;
+        while (in + lit < len && lit < 128 &&
+               !(in + lit + 2 < len && src[in + lit] == src[in + lit + 1] && src[in + lit] == src[in + lit + 2]))
+            lit++;
+        if (out + 1 + lit > cap)
+            return 0;
+        if (dst)
         {
-            ssd1306_draw_pixel(handle, x0 - y, y0 - x, color);
-            ssd1306_draw_pixel(handle, x0 - x, y0 - y, color);
+            dst[out] = (uint8_t)(lit - 1);
+            memcpy(&dst[out + 1], &src[in], lit);
         }
+        out += 1 + lit;
+        in += lit;
     }
+    return out;
 }
 
 /**
- * @brief Helper function to fill a circle quadrant.
- * Used by `ssd1306_fill_circle` and `ssd1306_fill_round_rect`.
+ * @brief Expands data compressed by `_ssd1306_rle_encode`.
  *
- * @param handle SSD1306 device handle.
- * @param x0 Center x-coordinate.
- * @param y0 Center y-coordinate.
- * @param r Circle radius.
- * @param corners Bitmask indicating which quadrants to fill.
- * @param delta Adjustment for vertical line height.
- * @param color Fill color.
+ * @param src Compressed data.
+ * @param len Length of `src`.
+ * @param dst Output buffer.
+ * @param out_len Exact expected output length.
+ * @return true if the stream is well formed and expands to exactly `out_len` bytes.
  */
-static void _ssd1306_fill_circle_helper(ssd1306_handle_t handle, int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta, ssd1306_color_t color)
+static bool _ssd1306_rle_decode(const uint8_t *src, size_t len, uint8_t *dst, size_t out_len)
 {
-    // Midpoint circle algorithm (Bresenham's) adapted for filling.
-    int16_t f = 1 - r;
-    int16_t ddF_x = 1;
-    int16_t ddF_y = -2 * r;
-    int16_t x = 0;
-    int16_t y = r;
-    int16_t px = x;
-    int16_t py = y;
-
-    delta++;
-
-    while (x < y)
+    size_t in = 0, out = 0;
+    while (in < len)
     {
-        if (f >= 0)
-        {
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
-        }
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
-        
-        // Draw vertical lines to fill the area between points on the circle's arc.
-        if (x < (y + 1))
+        uint8_t ctrl = src[in++];
+        if (ctrl & 0x80)
         {
-            if (corners & 1) // Right side
-                ssd1306_draw_fast_vline(handle, x0 + x, y0 - y, 2 * y + delta, color);
-            if (corners & 2) // Left side
-                ssd1306_draw_fast_vline(handle, x0 - x, y0 - y, 2 * y + delta, color);
+            size_t run = (ctrl & 0x7F) + 2;
+            if (in >= len || out + run > out_len)
+                return false;
+            memset(&dst[out], src[in++], run);
+            out += run;
         }
-        if (y != py)
+        else
         {
-            if (corners & 1)
-                ssd1306_draw_fast_vline(handle, x0 + py, y0 - px, 2 * px + delta, color);
-            if (corners & 2)
-                ssd1306_draw_fast_vline(handle, x0 - py, y0 - px, 2 * px + delta, color);
-            py = y;
+            size_t lit = ctrl + 1;
+            if (in + lit > len || out + lit > out_len)
+                return false;
+            memcpy(&dst[out], &src[in], lit);
+            in += lit;
+            out += lit;
         }
-        px = x;
     }
+    return out == out_len;
 }
 
-
 /**
- * @brief Calculates the bounding box for a single character.
- * This function does not draw, it only calculates dimensions and position.
+ * @brief Allocates a driver buffer from the handle's arena, or from the heap without one.
  *
  * @param handle SSD1306 device handle.
- * @param c Character to measure.
- * @param x Pointer to the current cursor x-coordinate (will be updated).
- * @param y Pointer to the current cursor y-coordinate (will be updated).
- * @param minx Pointer to the minimum x-coordinate (output).
- * @param miny Pointer to the minimum y-coordinate (output).
- * @param maxx Pointer to the maximum x-coordinate (output).
- * @param maxy Pointer to the maximum y-coordinate (output).
+ * @param len Bytes needed.
+ * @return void* Memory, or NULL.
  */
-static void _ssd1306_char_bounds(ssd1306_handle_t handle, unsigned char c, int16_t *x, int16_t *y, int16_t *minx, int16_t *miny, int16_t *maxx, int16_t *maxy)
+static void *_ssd1306_mem_alloc(ssd1306_handle_t handle, size_t len)
 {
-    if (!handle->gfxFont)
-        return;
+    return handle->arena ? ssd1306_arena_alloc(handle->arena, len) : malloc(len);
+}
 
-    // Handle newline character.
+/**
+ * @brief Frees a driver buffer. Buffers allocated before the arena was attached are
+ * still on the heap, so the owner is told by the address.
+ *
+ * @param handle SSD1306 device handle.
+ * @param ptr Buffer, or NULL.
+ */
+static void _ssd1306_mem_free(ssd1306_handle_t handle, void *ptr)
+{
+    if (ssd1306_arena_owns(handle->arena, ptr))
+        ssd1306_arena_free(handle->arena, ptr);
+    else
+        free(ptr);
+}
+
+/**
+ * @brief Releases the framebuffer while the display is off, according to the suspend mode.
+ * Skipped while a hardware scroll is running, since the framebuffer has to follow it.
+ *
+ * @param handle SSD1306 device handle.
+ */
+static void _ssd1306_suspend_buffer(ssd1306_handle_t handle)
+{
+    if (handle->suspend_mode == SSD1306_SUSPEND_NONE || !handle->buffer || handle->scroll_state != SSD1306_SCROLL_STATE_STOPPED)
+        return;
+
+    if (handle->suspend_mode == SSD1306_SUSPEND_COMPRESS)
+    {
+        // Size the blob exactly first, so the compressed copy never needs a full-size scratch buffer.
+        size_t len = _ssd1306_rle_encode(handle->buffer, handle->buffer_size, NULL, handle->buffer_size);
+        if (!len)
+            return; // Does not compress; keeping the framebuffer is cheaper.
+        handle->suspended = _ssd1306_mem_alloc(handle, len);
+        if (!handle->suspended)
+            return;
+        _ssd1306_rle_encode(handle->buffer, handle->buffer_size, handle->suspended, len);
+        handle->suspended_len = len;
+    }
+    _ssd1306_mem_free(handle, handle->buffer);
+    handle->buffer = NULL;
+}
+
+/**
+ * @brief Makes sure the framebuffer is allocated, restoring it if it was suspended.
+ *
+ * @param handle SSD1306 device handle.
+ * @return true if the framebuffer is available.
+ */
+static bool _ssd1306_buffer_ready(ssd1306_handle_t handle)
+{
+    if (handle->buffer)
+        return true;
+    if (handle->config.no_framebuffer)
+        return false; // Immediate mode: only the ssd1306_direct_* functions draw.
+    uint8_t *buffer = _ssd1306_mem_alloc(handle, handle->buffer_size);
+    if (!buffer)
+    {
+        ESP_LOGE(TAG, "Failed to restore framebuffer");
+        return false;
+    }
+
+    if (handle->suspended)
+    {
+        _ssd1306_rle_decode(handle->suspended, handle->suspended_len, buffer, handle->buffer_size);
+        _ssd1306_mem_free(handle, handle->suspended);
+        handle->suspended = NULL;
+        handle->suspended_len = 0;
+        handle->buffer = buffer;
+        return true;
+    }
+
+    // The content was discarded: the framebuffer restarts blank and the panel must be rewritten.
+    memset(buffer, 0, handle->buffer_size);
+    handle->buffer = buffer;
+    handle->flip_min_col = 0;
+    handle->flip_max_col = handle->config.screen_width - 1;
+    handle->flip_min_page = 0;
+    handle->flip_max_page = handle->config.screen_height / 8 - 1;
+    _ssd1306_mark_dirty(handle, 0, 0, handle->config.screen_width, handle->config.screen_height);
+    return true;
+}
+
+
+
+/**
+ * @brief Draws a page-format bitmap at any position within the clip rectangle.
+ * Each destination byte is assembled from the two source pages it straddles, so the
+ * bitmap does not have to be aligned to a page.
+ *
+ * @param handle SSD1306 device handle.
+ * @param src Bitmap of `w` columns by `(h + 7) / 8` pages, row 0 at bit 0 of its first page.
+ * @param w Bitmap width.
+ * @param h Bitmap height.
+ * @param x Left edge on screen.
+ * @param y Top edge on screen.
+ * @param color Color of the set bits.
+ * @param bg Color of the clear bits, or the same as `color` to leave them untouched.
+ */
+static void _ssd1306_blit_pages(ssd1306_handle_t handle, const uint8_t *src, int16_t w, int16_t h, int16_t x, int16_t y,
+                                ssd1306_color_t color, ssd1306_color_t bg)
+{
+    const int16_t width = handle->config.screen_width, pages = (h + 7) >> 3;
+    int16_t x0 = _max(x, handle->clip_x0), x1 = _min((int16_t)(x + w), handle->clip_x1);
+    int16_t y0 = _max(y, handle->clip_y0), y1 = _min((int16_t)(y + h), handle->clip_y1);
+    if (x0 >= x1 || y0 >= y1)
+        return;
+    for (int16_t page = y0 >> 3; page <= (y1 - 1) >> 3; page++)
+    {
+        // Rows of this page inside the clip rectangle.
+        int16_t r0 = _max((int16_t)(y0 - page * 8), (int16_t)0), r1 = _min((int16_t)(y1 - page * 8), (int16_t)8);
+        uint8_t rows = (uint8_t)((0xFF << r0) & (0xFF >> (8 - r1)));
+        // Source row that lands on bit 0 of this page, split into page and shift.
+        int16_t s = page * 8 - y;
+        int16_t sp = (s < 0) ? -1 : (s >> 3), sh = (s < 0) ? s + 8 : (s & 7);
+        const uint8_t *lo = (sp >= 0) ? &src[sp * w + (x0 - x)] : NULL;
+        const uint8_t *hi = (sh && sp + 1 < pages) ? &src[(sp + 1) * w + (x0 - x)] : NULL;
+        uint8_t *dst = &handle->buffer[page * width + x0];
+        for (int16_t i = 0; i < x1 - x0; i++)
+        {
+            uint8_t b = (uint8_t)((lo ? lo[i] >> sh : 0) | (hi ? hi[i] << (8 - sh) : 0));
+            uint8_t fg = b & rows, clear = ~b & rows;
+            if (color == OLED_COLOR_WHITE)
+                dst[i] |= fg;
+            else if (color == OLED_COLOR_BLACK)
+                dst[i] &= ~fg;
+            else
+                dst[i] ^= fg;
+            if (bg == color)
+                continue;
+            if (bg == OLED_COLOR_WHITE)
+                dst[i] |= clear;
+            else if (bg == OLED_COLOR_BLACK)
+                dst[i] &= ~clear;
+            else
+                dst[i] ^= clear;
+        }
+    }
+    _ssd1306_mark_dirty(handle, x0, y0, x1 - x0, y1 - y0);
+}
+
+/**
+ * @brief Applies a cached mask to the framebuffer within the clip rectangle.
+ *
+ * @param handle SSD1306 device handle.
+ * @param rc Raster cache.
+ * @param e Cache entry.
+ * @param x Left edge of the mask.
+ * @param top Top row of the mask (page-aligned).
+ * @param color OLED_COLOR_WHITE or OLED_COLOR_BLACK.
+ */
+static void _ssd1306_rcache_blit(ssd1306_handle_t handle, const ssd1306_rcache_t *rc, const ssd1306_rcache_entry_t *e, int16_t x, int16_t top, ssd1306_color_t color)
+{
+    _ssd1306_blit_pages(handle, &rc->pool[e->offset], e->w, e->pages * 8, x, top, color, color);
+}
+
+/**
+ * @brief Finds room for a raster in the pool, evicting least recently used entries.
+ * The pool is compacted when the free space is fragmented.
+ *
+ * @param rc Raster cache.
+ * @param len Bytes needed (at most the pool size).
+ * @return ssd1306_rcache_entry_t* Slot with `offset` and `len` set.
+ */
+static ssd1306_rcache_entry_t *_ssd1306_rcache_alloc(ssd1306_rcache_t *rc, uint32_t len)
+{
+    while (true)
+    {
+        ssd1306_rcache_entry_t *slot = NULL, *lru = NULL;
+        uint32_t end = 0, used = 0;
+        for (int i = 0; i < SSD1306_RCACHE_ENTRIES; i++)
+        {
+            ssd1306_rcache_entry_t *e = &rc->entries[i];
+            if (!e->valid)
+            {
+                slot = slot ? slot : e;
+                continue;
+            }
+            end = _max(end, e->offset + e->len);
+            used += e->len;
+            if (!lru || e->last_use < lru->last_use)
+                lru = e;
+        }
+        if (slot && rc->pool_size - end >= len)
+        {
+            slot->offset = end;
+        }
+        else if (slot && rc->pool_size - used >= len)
+        {
+            // Slide the rasters down in pool order to close the gaps.
+            uint32_t cursor = 0;
+            for (int n = 0; n < SSD1306_RCACHE_ENTRIES; n++)
+            {
+                ssd1306_rcache_entry_t *next = NULL;
+                for (int i = 0; i < SSD1306_RCACHE_ENTRIES; i++)
+                {
+                    ssd1306_rcache_entry_t *e = &rc->entries[i];
+                    if (e->valid && e->offset >= cursor && (!next || e->offset < next->offset))
+                        next = e;
+                }
+                if (!next)
+                    break;
+                memmove(&rc->pool[cursor], &rc->pool[next->offset], next->len);
+                next->offset = cursor;
+                cursor += next->len;
+            }
+            slot->offset = used;
+        }
+        else
+        {
+            lru->valid = false;
+            continue;
+        }
+        slot->len = len;
+        slot->valid = true;
+        return slot;
+    }
+}
+
+/**
+ * @brief Looks a primitive up in the raster cache and replays it on a hit. On a cacheable
+ * miss, prepares the capture: the bounding box is cleared and the clip rectangle lifted,
+ * so the caller's drawing in white leaves exactly the primitive's mask.
+ *
+ * @param handle SSD1306 device handle.
+ * @param cap Capture state, to be passed to `_ssd1306_rcache_end`.
+ * @param key Primitive and parameters (the phase is filled in here).
+ * @param text Text to store with the raster, or NULL.
+ * @param x Left edge of the bounding box.
+ * @param y Top edge of the bounding box.
+ * @param w Bounding box width.
+ * @param h Bounding box height.
+ * @param color Drawing color; switched to white while capturing.
+ * @return true if the primitive was replayed from the cache and must not be drawn.
+ */
+static bool _ssd1306_rcache_begin(ssd1306_handle_t handle, ssd1306_rcache_capture_t *cap, ssd1306_rcache_key_t *key, const char *text,
+                                  int16_t x, int16_t y, int16_t w, int16_t h, ssd1306_color_t *color)
+{
+    ssd1306_rcache_t *rc = handle->rcache;
+    cap->entry = NULL;
+    if (!rc || rc->busy || w <= 0 || h <= 0 || (*color != OLED_COLOR_WHITE && *color != OLED_COLOR_BLACK) || !_ssd1306_buffer_ready(handle))
+        return false;
+
+    key->phase = y & 7;
+    int16_t top = y - key->phase;
+    for (int i = 0; i < SSD1306_RCACHE_ENTRIES; i++)
+    {
+        ssd1306_rcache_entry_t *e = &rc->entries[i];
+        if (!e->valid || memcmp(&e->key, key, sizeof(*key)) != 0 ||
+            (text && memcmp(&rc->pool[e->offset + e->w * e->pages], text, key->text_len) != 0))
+            continue;
+        rc->hits++;
+        e->last_use = ++rc->clock;
+        _ssd1306_rcache_blit(handle, rc, e, x, top, *color);
+        return true;
+    }
+    rc->misses++;
+
+    // Only shapes that are entirely on screen yield a complete mask.
+    const int16_t width = handle->config.screen_width;
+    uint16_t pages = (key->phase + h + 7) >> 3;
+    uint32_t mask_len = (uint32_t)w * pages;
+    if (x < 0 || y < 0 || x + w > width || y + h > handle->config.screen_height || mask_len + key->text_len > rc->pool_size)
+        return false;
+
+    ssd1306_rcache_entry_t *e = _ssd1306_rcache_alloc(rc, mask_len + key->text_len);
+    e->key = *key;
+    e->w = w;
+    e->pages = pages;
+    e->last_use = ++rc->clock;
+    uint8_t *saved = &rc->pool[e->offset];
+    for (uint16_t i = 0; i < pages; i++)
+    {
+        uint8_t *row = &handle->buffer[((top >> 3) + i) * width + x];
+        memcpy(&saved[i * w], row, w);
+        memset(row, 0, w);
+    }
+    if (text)
+        memcpy(&saved[mask_len], text, key->text_len);
+
+    cap->entry = e;
+    cap->x = x;
+    cap->top = top;
+    cap->color = *color;
+    cap->clip_x0 = handle->clip_x0;
+    cap->clip_y0 = handle->clip_y0;
+    cap->clip_x1 = handle->clip_x1;
+    cap->clip_y1 = handle->clip_y1;
+    handle->clip_x0 = handle->clip_y0 = 0;
+    handle->clip_x1 = width;
+    handle->clip_y1 = handle->config.screen_height;
+    rc->busy = true;
+    *color = OLED_COLOR_WHITE;
+    return false;
+}
+
+/**
+ * @brief Finishes a capture: the drawn mask moves into the cache, the framebuffer gets
+ * its previous content back, and the mask is applied in the requested color.
+ *
+ * @param handle SSD1306 device handle.
+ * @param cap Capture state from `_ssd1306_rcache_begin`.
+ */
+static void _ssd1306_rcache_end(ssd1306_handle_t handle, ssd1306_rcache_capture_t *cap)
+{
+    ssd1306_rcache_entry_t *e = cap->entry;
+    if (!e)
+        return;
+    ssd1306_rcache_t *rc = handle->rcache;
+    uint8_t *data = &rc->pool[e->offset];
+    for (uint16_t i = 0; i < e->pages; i++)
+    {
+        uint8_t *row = &handle->buffer[((cap->top >> 3) + i) * handle->config.screen_width + cap->x];
+        for (uint16_t j = 0; j < e->w; j++)
+        {
+            uint8_t drawn = row[j];
+            row[j] = data[i * e->w + j];
+            data[i * e->w + j] = drawn;
+        }
+    }
+    handle->clip_x0 = cap->clip_x0;
+    handle->clip_y0 = cap->clip_y0;
+    handle->clip_x1 = cap->clip_x1;
+    handle->clip_y1 = cap->clip_y1;
+    rc->busy = false;
+    _ssd1306_rcache_blit(handle, rc, e, cap->x, cap->top, cap->color);
+    cap->entry = NULL;
+}
+
+
+/**
+ * @brief Raster cache lookup for `ssd1306_print`. Only single-line text drawn with a
+ * transparent background qualifies; the key holds the font, the scale and the text.
+ *
+ * @param handle SSD1306 device handle.
+ * @param str Text.
+ * @param cap Capture state, to be passed to `_ssd1306_rcache_end`.
+ * @return true if the text was replayed from the cache (the cursor is advanced).
+ */
+static bool _ssd1306_rcache_print_begin(ssd1306_handle_t handle, const char *str, ssd1306_rcache_capture_t *cap)
+{
+    cap->entry = NULL;
+    // The cursor at (0, 0) is moved by the first glyph, see `ssd1306_write`.
+    if (!handle->rcache || !handle->gfxFont || handle->gfxFont->type != FONT_TYPE_GFX || handle->textcolor != handle->textbgcolor ||
+        (handle->cursor_x == 0 && handle->cursor_y == 0))
+        return false;
+
+    const GFXfont *font = (const GFXfont *)handle->gfxFont->font_data;
+    uint8_t sx = handle->textsize_x, sy = handle->textsize_y;
+    int16_t x = handle->cursor_x, minx = INT16_MAX, miny = INT16_MAX, maxx = INT16_MIN, maxy = INT16_MIN;
+    uint32_t hash = 2166136261u; // FNV-1a
+    size_t len = 0;
+    for (const char *c = str; *c; c++, len++)
+    {
+        uint8_t ch = (uint8_t)*c;
+        if (ch == '\n' || ch == '\r')
+            return false;
+        hash = (hash ^ ch) * 16777619u;
+        if (ch < font->first || ch > font->last)
+            continue;
+        const GFXglyph *glyph = &font->glyph[ch - font->first];
+        if (glyph->width && glyph->height)
+        {
+            int16_t gx = x + glyph->xOffset * sx, gy = handle->cursor_y + glyph->yOffset * sy;
+            minx = _min(minx, gx);
+            miny = _min(miny, gy);
+            maxx = _max(maxx, (int16_t)(gx + glyph->width * sx));
+            maxy = _max(maxy, (int16_t)(gy + glyph->height * sy));
+        }
+        x += glyph->xAdvance * sx;
+    }
+    // A line that would wrap depends on its position.
+    if (maxx <= minx || len > UINT16_MAX || (handle->wrap && maxx > handle->config.screen_width))
+        return false;
+
+    ssd1306_rcache_key_t key = {
+        .font = handle->gfxFont,
+        .text_hash = hash,
+        .text_len = (uint16_t)len,
+        .kind = SSD1306_RCACHE_TEXT,
+        .size_x = sx,
+        .size_y = sy,
+    };
+    ssd1306_color_t color = handle->textcolor;
+    if (_ssd1306_rcache_begin(handle, cap, &key, str, minx, miny, maxx - minx, maxy - miny, &color))
+    {
+        handle->cursor_x = x;
+        return true;
+    }
+    if (cap->entry)
+        handle->textcolor = handle->textbgcolor = color;
+    return false;
+}
+
+/**
+ * @brief Helper function to draw a circle quadrant.
+ * Used by `ssd1306_draw_round_rect`.
+ *
+ * @param handle SSD1306 device handle.
+ * @param x0 Center x-coordinate.
+ * @param y0 Center y-coordinate.
+ * @param r Circle radius.
+ * @param cornername Bitmask indicating which quadrant to draw.
+ * @param color Drawing color.
+ */
+static void _ssd1306_draw_circle_helper(ssd1306_handle_t handle, int16_t x0, int16_t y0, int16_t r, uint8_t cornername, ssd1306_color_t color)
+{
+    // Midpoint circle algorithm (Bresenham's)
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+
+    while (x < y)
+    {
+        if (f >= 0)
+        {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+        // Draw pixels in the appropriate quadrant based on the bitmask.
+        if (cornername & 0x4) // Bottom right
+        {
+            ssd1306_draw_pixel(handle, x0 + x, y0 + y, color);
+            ssd1306_draw_pixel(handle, x0 + y, y0 + x, color);
+        }
+        if (cornername & 0x2) // Top right
+        {
+            ssd1306_draw_pixel(handle, x0 + x, y0 - y, color);
+            ssd1306_draw_pixel(handle, x0 + y, y0 - x, color);
+        }
+        if (cornername & 0x8) // Bottom left
+        {
+            ssd1306_draw_pixel(handle, x0 - y, y0 + x, color);
+            ssd1306_draw_pixel(handle, x0 - x, y0 + y, color);
+        }
+        if (cornername & 0x1) // Top left
+        {
+            ssd1306_draw_pixel(handle, x0 - y, y0 - x, color);
+            ssd1306_draw_pixel(handle, x0 - x, y0 - y, color);
+        }
+    }
+}
+
+/**
+ * @brief Helper function to fill a circle quadrant.
+ * Used by `ssd1306_fill_circle` and `ssd1306_fill_round_rect`.
+ *
+ * @param handle SSD1306 device handle.
+ * @param x0 Center x-coordinate.
+ * @param y0 Center y-coordinate.
+ * @param r Circle radius.
+ * @param corners Bitmask indicating which quadrants to fill.
+ * @param delta Adjustment for vertical line height.
+ * @param color Fill color.
+ */
+static void _ssd1306_fill_circle_helper(ssd1306_handle_t handle, int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta, ssd1306_color_t color)
+{
+    // Midpoint circle algorithm (Bresenham's) adapted for filling.
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+    int16_t px = x;
+    int16_t py = y;
+
+    delta++;
+
+    while (x < y)
+    {
+        if (f >= 0)
+        {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+        
+        // Draw vertical lines to fill the area between points on the circle's arc.
+        if (x < (y + 1))
+        {
+            if (corners & 1) // Right side
+                ssd1306_draw_fast_vline(handle, x0 + x, y0 - y, 2 * y + delta, color);
+            if (corners & 2) // Left side
+                ssd1306_draw_fast_vline(handle, x0 - x, y0 - y, 2 * y + delta, color);
+        }
+        if (y != py)
+        {
+            if (corners & 1)
+                ssd1306_draw_fast_vline(handle, x0 + py, y0 - px, 2 * px + delta, color);
+            if (corners & 2)
+                ssd1306_draw_fast_vline(handle, x0 - py, y0 - px, 2 * px + delta, color);
+            py = y;
+        }
+        px = x;
+    }
+}
+
+
+/**
+ * @brief Gets the stroke font scale of the current text settings.
+ *
+ * @param handle SSD1306 device handle.
+ * @param font Stroke font.
+ * @return int32_t Pixels per grid unit in 8.8 fixed point.
+ */
+static int32_t _ssd1306_stroke_scale(ssd1306_handle_t handle, const StrokeFont *font)
+{
+    if (handle->stroke_height)
+        return ((int32_t)handle->stroke_height << 8) / font->baseline;
+    return (int32_t)handle->textsize_y << 8;
+}
+
+/**
+ * @brief Sets one pixel inside the clip rectangle without marking it dirty.
+ *
+ * @param handle SSD1306 device handle.
+ * @param x X-coordinate.
+ * @param y Y-coordinate.
+ * @param color Pixel color.
+ */
+static inline void _ssd1306_stroke_plot(ssd1306_handle_t handle, int16_t x, int16_t y, ssd1306_color_t color)
+{
+    if (x < handle->clip_x0 || x >= handle->clip_x1 || y < handle->clip_y0 || y >= handle->clip_y1)
+        return;
+    uint8_t *b = &handle->buffer[(y >> 3) * handle->config.screen_width + x];
+    uint8_t bit = 1 << (y & 7);
+    if (color == OLED_COLOR_WHITE)
+        *b |= bit;
+    else if (color == OLED_COLOR_BLACK)
+        *b &= ~bit;
+    else
+        *b ^= bit;
+}
+
+/**
+ * @brief Draws a line with a pen of `t` pixels.
+ * Segments outside the clip rectangle are rejected as a whole, the dirty area is marked
+ * once, and each step sets a run of `t` pixels across the major axis directly in the
+ * framebuffer.
+ *
+ * @param handle SSD1306 device handle.
+ * @param x0 Starting x-coordinate.
+ * @param y0 Starting y-coordinate.
+ * @param x1 Ending x-coordinate.
+ * @param y1 Ending y-coordinate.
+ * @param t Pen width.
+ * @param color Line color.
+ */
+static void _ssd1306_stroke_line(ssd1306_handle_t handle, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t t, ssd1306_color_t color)
+{
+    int16_t lo = t / 2, hi = t - lo; // The pen covers [p - lo, p + hi).
+    int16_t bx0 = _max((int16_t)(_min(x0, x1) - lo), handle->clip_x0), bx1 = _min((int16_t)(_max(x0, x1) + hi), handle->clip_x1);
+    int16_t by0 = _max((int16_t)(_min(y0, y1) - lo), handle->clip_y0), by1 = _min((int16_t)(_max(y0, y1) + hi), handle->clip_y1);
+    if (bx0 >= bx1 || by0 >= by1)
+        return;
+    _ssd1306_mark_dirty(handle, bx0, by0, bx1 - bx0, by1 - by0);
+
+    int16_t dx = _abs(x1 - x0), dy = -_abs(y1 - y0);
+    int16_t sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+    int16_t err = dx + dy;
+    bool x_major = dx >= -dy;
+    while (true)
+    {
+        for (int16_t k = -lo; k < hi; k++)
+        {
+            if (x_major)
+                _ssd1306_stroke_plot(handle, x0, y0 + k, color);
+            else
+                _ssd1306_stroke_plot(handle, x0 + k, y0, color);
+        }
+        if (x0 == x1 && y0 == y1)
+            break;
+        int16_t e2 = 2 * err;
+        if (e2 >= dy)
+        {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx)
+        {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+/**
+ * @brief Draws a stroke font character with its baseline at `y`.
+ * Polyline vertices of wide pens get a square cap, so joints have no notches.
+ *
+ * @param handle SSD1306 device handle.
+ * @param x Cursor x-coordinate.
+ * @param y Baseline y-coordinate.
+ * @param c Character.
+ * @param color Text color.
+ */
+static void _ssd1306_draw_stroke_char(ssd1306_handle_t handle, int16_t x, int16_t y, unsigned char c, ssd1306_color_t color)
+{
+    const StrokeFont *font = (const StrokeFont *)handle->gfxFont->font_data;
+    if (!font || c < font->first || c > font->last || !_ssd1306_buffer_ready(handle))
+        return;
+    const StrokeGlyph *glyph = &font->glyph[c - font->first];
+    const uint8_t *pt = &font->points[glyph->offset];
+    int32_t scale = _ssd1306_stroke_scale(handle, font);
+    uint8_t t = handle->stroke_thickness;
+    int16_t px = 0, py = 0;
+    bool pen = false;
+    for (uint8_t i = 0; i < glyph->count; i++)
+    {
+        if (pt[i] == STROKE_PEN_UP)
+        {
+            pen = false;
+            continue;
+        }
+        int16_t nx = x + (int16_t)(((pt[i] >> 4) * scale + 128) >> 8);
+        int16_t ny = y + (int16_t)((((pt[i] & 0x0F) - font->baseline) * scale + 128) >> 8);
+        if (pen)
+            _ssd1306_stroke_line(handle, px, py, nx, ny, t, color);
+        if (t > 1)
+            _ssd1306_stroke_line(handle, nx, ny - t / 2, nx, ny - t / 2 + t - 1, t, color);
+        px = nx;
+        py = ny;
+        pen = true;
+    }
+}
+
+/**
+ * @brief Writes a character with a stroke font at the cursor and advances it.
+ * Mirrors `ssd1306_write` for GFX fonts: newline, wrapping and the first-line offset.
+ *
+ * @param handle SSD1306 device handle.
+ * @param c Character to write.
+ */
+static void _ssd1306_write_stroke(ssd1306_handle_t handle, uint8_t c)
+{
+    const StrokeFont *font = (const StrokeFont *)handle->gfxFont->font_data;
+    int32_t scale = _ssd1306_stroke_scale(handle, font);
+    if (c == '\n')
+    {
+        handle->cursor_x = 0;
+        handle->cursor_y += (int16_t)((font->yAdvance * scale + 128) >> 8);
+        return;
+    }
+    if (c == '\r' || c < font->first || c > font->last)
+        return;
+    int16_t advance = (int16_t)((font->glyph[c - font->first].xAdvance * scale + 128) >> 8);
+    if (handle->cursor_x == 0 && handle->cursor_y == 0)
+        handle->cursor_y = (int16_t)((font->baseline * scale + 128) >> 8) + handle->stroke_thickness / 2 + 1;
+    if (handle->wrap && handle->cursor_x + advance > handle->config.screen_width)
+    {
+        handle->cursor_x = 0;
+        handle->cursor_y += (int16_t)((font->yAdvance * scale + 128) >> 8);
+    }
+    _ssd1306_draw_stroke_char(handle, handle->cursor_x, handle->cursor_y, c, handle->textcolor);
+    handle->cursor_x += advance;
+}
+
+/**
+ * @brief Calculates the bounding box of a stroke font character, pen width included.
+ *
+ * @param handle SSD1306 device handle.
+ * @param c Character to measure.
+ * @param x Pointer to the current cursor x-coordinate (will be updated).
+ * @param y Pointer to the current cursor y-coordinate (will be updated).
+ * @param minx Pointer to the minimum x-coordinate (output).
+ * @param miny Pointer to the minimum y-coordinate (output).
+ * @param maxx Pointer to the maximum x-coordinate (output).
+ * @param maxy Pointer to the maximum y-coordinate (output).
+ */
+static void _ssd1306_stroke_char_bounds(ssd1306_handle_t handle, unsigned char c, int16_t *x, int16_t *y, int16_t *minx, int16_t *miny, int16_t *maxx, int16_t *maxy)
+{
+    const StrokeFont *font = (const StrokeFont *)handle->gfxFont->font_data;
+    int32_t scale = _ssd1306_stroke_scale(handle, font);
+    if (c == '\n')
+    {
+        *x = 0;
+        *y += (int16_t)((font->yAdvance * scale + 128) >> 8);
+        return;
+    }
+    if (c == '\r' || c < font->first || c > font->last)
+        return;
+    const StrokeGlyph *glyph = &font->glyph[c - font->first];
+    int16_t advance = (int16_t)((glyph->xAdvance * scale + 128) >> 8);
+    if (handle->wrap && *x + advance > handle->config.screen_width)
+    {
+        *x = 0;
+        *y += (int16_t)((font->yAdvance * scale + 128) >> 8);
+    }
+    int16_t lo = handle->stroke_thickness / 2, hi = handle->stroke_thickness - lo - 1;
+    const uint8_t *pt = &font->points[glyph->offset];
+    for (uint8_t i = 0; i < glyph->count; i++)
+    {
+        if (pt[i] == STROKE_PEN_UP)
+            continue;
+        int16_t px = *x + (int16_t)(((pt[i] >> 4) * scale + 128) >> 8);
+        int16_t py = *y + (int16_t)((((pt[i] & 0x0F) - font->baseline) * scale + 128) >> 8);
+        if (px - lo < *minx) *minx = px - lo;
+        if (py - lo < *miny) *miny = py - lo;
+        if (px + hi > *maxx) *maxx = px + hi;
+        if (py + hi > *maxy) *maxy = py + hi;
+    }
+    *x += advance;
+}
+
+/**
+ * @brief Calculates the bounding box for a single character.
+ * This function does not draw, it only calculates dimensions and position.
+ *
+ * @param handle SSD1306 device handle.
+ * @param c Character to measure.
+ * @param x Pointer to the current cursor x-coordinate (will be updated).
+ * @param y Pointer to the current cursor y-coordinate (will be updated).
+ * @param minx Pointer to the minimum x-coordinate (output).
+ * @param miny Pointer to the minimum y-coordinate (output).
+ * @param maxx Pointer to the maximum x-coordinate (output).
+ * @param maxy Pointer to the maximum y-coordinate (output).
+ */
+static void _ssd1306_char_bounds(ssd1306_handle_t handle, unsigned char c, int16_t *x, int16_t *y, int16_t *minx, int16_t *miny, int16_t *maxx, int16_t *maxy)
+{
+    if (!handle->gfxFont)
+        return;
+    if (handle->gfxFont->type == FONT_TYPE_STROKE)
+    {
+        _ssd1306_stroke_char_bounds(handle, c, x, y, minx, miny, maxx, maxy);
+        return;
+    }
+
+    // Handle newline character.
     if (c == '\n')
     {
-        *x = 0; // Move cursor x to the beginning of the line.
-        const GFXfont *font = (const GFXfont *)handle->gfxFont->font_data;
-        *y += handle->textsize_y * font->yAdvance; // Move cursor y to the next line.
+        *x = 0; // Move cursor x to the beginning of the line.
+        const GFXfont *font = (const GFXfont *)handle->gfxFont->font_data;
+        *y += handle->textsize_y * font->yAdvance; // Move cursor y to the next line.
+    }
+    else if (c != '\r') // Ignore carriage return.
+    {
+        const GFXfont *font = (const GFXfont *)handle->gfxFont->font_data;
+        // Ensure character is within the font range.
+        if (c >= font->first && c <= font->last)
+        {
+            const GFXglyph *glyph = &font->glyph[c - font->first]; // Get glyph data for the character.
+            uint8_t gw = glyph->width, gh = glyph->height, xa = glyph->xAdvance;
+            int8_t xo = glyph->xOffset, yo = glyph->yOffset;
+
+            // Handle text wrapping if the character exceeds screen width.
+            if (handle->wrap && ((*x + ((int16_t)xo + gw) * handle->textsize_x) > handle->config.screen_width))
+            {
+                *x = 0;
+                *y += handle->textsize_y * font->yAdvance;
+            }
+            // Calculate absolute bounding box coordinates.
+            int16_t x1 = *x + xo * handle->textsize_x;
+            int16_t y1 = *y + yo * handle->textsize_y;
+            int16_t x2 = x1 + gw * handle->textsize_x - 1;
+            int16_t y2 = y1 + gh * handle->textsize_y - 1;
+
+            // Update the global min/max boundaries.
+            if (x1 < *minx) *minx = x1;
+            if (y1 < *miny) *miny = y1;
+            if (x2 > *maxx) *maxx = x2;
+            if (y2 > *maxy) *maxy = y2;
+
+            // Advance cursor x for the next character.
+            *x += xa * handle->textsize_x;
+        }
+    }
+}
+
+
+/**
+ * @brief Initializes the software state shared by plain and tiled handles.
+ *
+ * @param handle SSD1306 device handle (zero-initialized, `config` already set).
+ * @return esp_err_t Operation status.
+ */
+static esp_err_t _ssd1306_init_state(ssd1306_handle_t handle)
+{
+    // Allocate memory for the framebuffer. Size is (width * height) / 8 because 1 byte represents 8 vertical pixels.
+    handle->buffer_size = (handle->config.screen_width * handle->config.screen_height) / 8;
+    handle->arena = handle->config.arena;
+    if (!handle->config.no_framebuffer)
+    {
+        handle->buffer = _ssd1306_mem_alloc(handle, handle->buffer_size);
+        ESP_RETURN_ON_FALSE(handle->buffer, ESP_ERR_NO_MEM, TAG, "Failed to allocate buffer");
+    }
+
+    // Initialize default graphics state.
+    handle->cursor_x = 0;
+    handle->cursor_y = 0;
+    handle->textsize_x = 1;
+    handle->textsize_y = 1;
+    handle->textcolor = OLED_COLOR_WHITE;
+    handle->textbgcolor = OLED_COLOR_BLACK;
+    handle->wrap = true;
+    handle->stroke_thickness = 1;
+    handle->gfxFont = &FONT_5x7; // Set default font.
+    ssd1306_reset_clip_rect(handle);
+
+    // Frame period for the init settings below: Fosc ~370 kHz / (K = 66 DCLKs per row * MUX rows).
+    handle->frame_period_us = (uint32_t)handle->panels[0].config.screen_height * 66 * 100 / 37;
+    handle->seg_remap = true;
+    // Register values set by the init sequence.
+    handle->shadow_contrast = 0xCF;
+    handle->shadow_invert_cmd = OLED_CMD_DISPLAY_NORMAL;
+    handle->shadow_seg_cmd = OLED_CMD_SET_SEGMENT_REMAP | 0x01;
+    handle->shadow_com_cmd = OLED_CMD_SET_COM_SCAN_MODE | 0x08;
+    handle->shadow_start_line = 0;
+    handle->shadow_display_on = true;
+    handle->stats_since_us = esp_timer_get_time();
+    return ESP_OK;
+}
+
+/**
+ * @brief Installs the I2C master driver for a panel's port, unless another panel already did.
+ *
+ * @param config Panel configuration.
+ * @return esp_err_t Operation status.
+ */
+static esp_err_t _ssd1306_i2c_acquire(const ssd1306_config_t *config)
+{
+    ESP_RETURN_ON_FALSE(config->i2c_port >= 0 && config->i2c_port < I2C_NUM_MAX, ESP_ERR_INVALID_ARG, TAG, "Invalid I2C port");
+    if (i2c_port_refs[config->i2c_port]++ > 0)
+        return ESP_OK; // Panels sharing a port share its driver (and its pin/clock setup).
+
+    // Configure the I2C master driver.
+    i2c_config_t i2c_conf = {
+        .mode = I2C_MODE_MASTER,
+        .sda_io_num = config->sda_pin,
+        .scl_io_num = config->scl_pin,
+        .sda_pullup_en = GPIO_PULLUP_ENABLE,
+        .scl_pullup_en = GPIO_PULLUP_ENABLE,
+        .master.clk_speed = config->i2c_clk_speed_hz,
+    };
+    esp_err_t ret = i2c_param_config(config->i2c_port, &i2c_conf);
+    if (ret == ESP_OK)
+        ret = i2c_driver_install(config->i2c_port, I2C_MODE_MASTER, 0, 0, 0);
+    if (ret != ESP_OK)
+    {
+        i2c_port_refs[config->i2c_port]--;
+        ESP_LOGE(TAG, "Failed to set up I2C port %d: %s", config->i2c_port, esp_err_to_name(ret));
+    }
+    return ret;
+}
+
+/**
+ * @brief Releases a panel's reference to its I2C port driver.
+ *
+ * @param port I2C port.
+ */
+static void _ssd1306_i2c_release(i2c_port_t port)
+{
+    if (i2c_port_refs[port] > 0 && --i2c_port_refs[port] == 0)
+        i2c_driver_delete(port); // Delete the I2C driver once its last panel is gone.
+}
+
+/**
+ * @brief Builds the initialization command sequence for a panel.
+ *
+ * @param config Panel configuration.
+ * @param out Output buffer (at least SSD1306_INIT_CMDS_MAX bytes).
+ * @param display_on Append the display-on command.
+ * @return size_t Number of command bytes written.
+ */
+static size_t _ssd1306_build_init_cmds(const ssd1306_config_t *config, uint8_t *out, bool display_on)
+{
+    // Initialization command sequence to configure the SSD1306 controller.
+    const uint8_t init_cmds[] = {
+        OLED_CMD_DISPLAY_OFF,                 // Turn display off during setup
+        OLED_CMD_SET_DISPLAY_CLK_DIV, 0x80,   // Set clock
+        OLED_CMD_SET_MUX_RATIO, (uint8_t)(config->screen_height - 1), // Set based on screen height
+        OLED_CMD_SET_DISPLAY_OFFSET, 0x00,    // No offset
+        OLED_CMD_SET_DISPLAY_START_LINE | 0x00, // Start at line 0
+        OLED_CMD_SET_CHARGE_PUMP, 0x14,       // Enable charge pump
+        OLED_CMD_SET_MEMORY_ADDR_MODE, 0x00,  // Horizontal addressing mode
+        OLED_CMD_SET_SEGMENT_REMAP | 0x01,    // Remap segment (column 127 is at SEG0)
+        OLED_CMD_SET_COM_SCAN_MODE | 0x08,    // Remap COM (scan from COM[N-1] to COM0)
+        OLED_CMD_SET_COM_PIN_MAP, (config->screen_height == 64) ? (uint8_t)0x12 : (uint8_t)0x02, // COM pin config
+        OLED_CMD_SET_CONTRAST, 0xCF,           // Set contrast
+        OLED_CMD_SET_PRECHARGE, 0xF1,         // Set pre-charge period
+        OLED_CMD_SET_VCOMH_DESELCT, 0x40,     // Set VCOMH level
+        OLED_CMD_DISPLAY_RAM,                 // Display RAM content
+        OLED_CMD_DISPLAY_NORMAL,              // Normal display mode (not inverted)
+        OLED_CMD_DEACTIVATE_SCROLL,           // Deactivate scrolling
+    };
+    memcpy(out, init_cmds, sizeof(init_cmds));
+    size_t len = sizeof(init_cmds);
+    if (display_on)
+        out[len++] = OLED_CMD_DISPLAY_ON;     // Turn display on
+    return len;
+}
+
+/**
+ * @brief Resets a panel (if it has a reset pin) and, unless the init sequence is
+ * deferred to the boot burst, sends the init sequence.
+ *
+ * @param panel Panel to initialize.
+ * @param fast_boot Use the datasheet-minimum reset timing and leave the init sequence to the boot burst.
+ * @return esp_err_t Operation status.
+ */
+static esp_err_t _ssd1306_panel_init(ssd1306_panel_t *panel, bool fast_boot)
+{
+    const ssd1306_config_t *config = &panel->config;
+
+    // Perform a hardware reset on the display if the RST pin is defined.
+    if (config->rst_pin != -1)
+    {
+        gpio_set_direction(config->rst_pin, GPIO_MODE_OUTPUT);
+        gpio_set_level(config->rst_pin, 0);
+        if (fast_boot)
+            esp_rom_delay_us(SSD1306_RESET_PULSE_US);
+        else
+            vTaskDelay(pdMS_TO_TICKS(50)); // Hold reset for 50ms.
+        gpio_set_level(config->rst_pin, 1);
+        esp_rom_delay_us(SSD1306_RESET_RECOVERY_US); // Let the controller leave reset before the first command.
+    }
+    if (fast_boot)
+        return ESP_OK;
+
+    uint8_t init_cmds[SSD1306_INIT_CMDS_MAX];
+    size_t len = _ssd1306_build_init_cmds(config, init_cmds, true);
+    return _ssd1306_panel_send_cmds(panel, init_cmds, len);
+}
+
+/**
+ * @brief Writes one panel's share of a flush as a single I2C transaction.
+ * The transaction carries the queued commands, the update window, the damaged
+ * framebuffer bytes and the trailing commands (scroll activation, page flip).
+ *
+ * @param handle SSD1306 device handle.
+ * @param panel Panel to write.
+ * @return esp_err_t Operation status.
+ */
+static esp_err_t _ssd1306_panel_flush(ssd1306_handle_t handle, ssd1306_panel_t *panel)
+{
+    if (!panel->job_data && !handle->job_pre_len && !handle->job_post_len)
+        return ESP_OK;
+
+    uint8_t addr = (panel->config.i2c_addr << 1) | I2C_MASTER_WRITE;
+    size_t bytes = 0;
+
+    // Create a new I2C link to send the commands and framebuffer data.
+    // Cache is not used here as data transfers can be larger than the static buffer.
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+    ESP_RETURN_ON_FALSE(cmd, ESP_ERR_NO_MEM, TAG, "Failed to create I2C command link");
+
+    // Command phase: queued commands followed by the update window.
+    if (handle->job_pre_len || panel->job_data)
+    {
+        i2c_master_start(cmd);
+        i2c_master_write_byte(cmd, addr, true);
+        i2c_master_write_byte(cmd, OLED_CONTROL_BYTE_CMD_STREAM, true);
+        if (handle->job_pre_len)
+            i2c_master_write(cmd, handle->job_pre, handle->job_pre_len, true);
+        bytes += 2 + handle->job_pre_len;
+    }
+
+    if (panel->job_data)
+    {
+        // Set the update "window" on the display, corresponding to the dirty area.
+        uint8_t window[] = {
+            OLED_CMD_SET_COLUMN_RANGE, panel->job_min_col, panel->job_max_col,
+            OLED_CMD_SET_PAGE_RANGE, (uint8_t)(handle->flip_page_base + panel->job_min_page), (uint8_t)(handle->flip_page_base + panel->job_max_page)
+        };
+        i2c_master_write(cmd, window, sizeof(window), true);
+
+        // Data phase, started with a repeated START so the whole flush is one transaction.
+        i2c_master_start(cmd);
+        i2c_master_write_byte(cmd, addr, true);
+        i2c_master_write_byte(cmd, OLED_CONTROL_BYTE_DATA_STREAM, true); // Indicate that the following is image data.
+
+        // Send data page by page, only for columns within the dirty area.
+        uint16_t len = panel->job_max_col - panel->job_min_col + 1;
+        for (uint8_t page = panel->job_min_page; page <= panel->job_max_page; ++page)
+        {
+            // Calculate the starting offset for the data of the current page and column.
+            size_t offset = (size_t)(panel->page + page) * handle->config.screen_width + panel->x + panel->job_min_col;
+            const uint8_t *row = handle->job_rows ? handle->job_rows[page - panel->job_min_page] : &handle->buffer[offset];
+            i2c_master_write(cmd, row, len, true);
+        }
+        bytes += sizeof(window) + 2 + (size_t)len * (panel->job_max_page - panel->job_min_page + 1);
+    }
+
+    // Scroll activation and the page flip must follow the RAM write, so they close the transaction.
+    if (handle->job_post_len)
+    {
+        i2c_master_start(cmd);
+        i2c_master_write_byte(cmd, addr, true);
+        i2c_master_write_byte(cmd, OLED_CONTROL_BYTE_CMD_STREAM, true);
+        i2c_master_write(cmd, handle->job_post, handle->job_post_len, true);
+        bytes += 2 + handle->job_post_len;
+    }
+
+    i2c_master_stop(cmd);
+
+    // Send the data to the I2C bus.
+    esp_err_t ret = _ssd1306_panel_exec(panel, cmd, bytes, pdMS_TO_TICKS(1000));
+    i2c_cmd_link_delete(cmd); // Free the link after use.
+    return ret;
+}
+
+/**
+ * @brief Flush task serving the panels of one I2C port of a tiled display.
+ *
+ * @param arg Pointer to the `ssd1306_port_worker_t` of this task.
+ */
+static void _ssd1306_port_worker_task(void *arg)
+{
+    ssd1306_port_worker_t *worker = (ssd1306_port_worker_t *)arg;
+    ssd1306_handle_t handle = worker->owner;
+
+    for (;;)
+    {
+        xSemaphoreTake(worker->start, portMAX_DELAY);
+        if (handle->workers_exit)
+            break;
+        for (uint8_t i = 0; i < handle->panel_count; i++)
+        {
+            ssd1306_panel_t *panel = &handle->panels[i];
+            if (panel->config.i2c_port == worker->port)
+                panel->job_ret = _ssd1306_panel_flush(handle, panel);
+        }
+        xSemaphoreGive(handle->flush_done);
+    }
+    xSemaphoreGive(handle->flush_done);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Runs the prepared flush jobs of all panels.
+ * Panels on independent I2C ports are written in parallel by their port workers.
+ *
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t Operation status (the first error if several panels fail).
+ */
+static esp_err_t _ssd1306_run_flush_jobs(ssd1306_handle_t handle)
+{
+    if (handle->worker_count)
+    {
+        for (uint8_t w = 0; w < handle->worker_count; w++)
+            xSemaphoreGive(handle->workers[w].start);
+        for (uint8_t w = 0; w < handle->worker_count; w++)
+            xSemaphoreTake(handle->flush_done, portMAX_DELAY);
+    }
+    else
+    {
+        for (uint8_t i = 0; i < handle->panel_count; i++)
+            handle->panels[i].job_ret = _ssd1306_panel_flush(handle, &handle->panels[i]);
+    }
+
+    esp_err_t ret = ESP_OK;
+    for (uint8_t i = 0; i < handle->panel_count && ret == ESP_OK; i++)
+        ret = handle->panels[i].job_ret;
+    return ret;
+}
+
+/**
+ * @brief Stops the port workers of a tiled display and frees their resources.
+ *
+ * @param handle SSD1306 device handle.
+ */
+static void _ssd1306_stop_workers(ssd1306_handle_t handle)
+{
+    handle->workers_exit = true;
+    for (uint8_t w = 0; w < handle->worker_count; w++)
+    {
+        if (handle->workers[w].task)
+        {
+            xSemaphoreGive(handle->workers[w].start);
+            xSemaphoreTake(handle->flush_done, portMAX_DELAY);
+        }
+        if (handle->workers[w].start)
+            vSemaphoreDelete(handle->workers[w].start);
+    }
+    if (handle->flush_done)
+        vSemaphoreDelete(handle->flush_done);
+    free(handle->workers);
+    handle->workers = NULL;
+    handle->worker_count = 0;
+}
+
+/**
+ * @brief Starts one flush task per I2C port used by a tiled display.
+ * Not needed (and not started) when all panels share a single port.
+ *
+ * @param handle SSD1306 device handle.
+ * @param config Tiled display configuration.
+ * @return esp_err_t Operation status.
+ */
+static esp_err_t _ssd1306_start_workers(ssd1306_handle_t handle, const ssd1306_tiled_config_t *config)
+{
+    i2c_port_t ports[I2C_NUM_MAX];
+    uint8_t port_count = 0;
+    for (uint8_t i = 0; i < handle->panel_count; i++)
+    {
+        bool known = false;
+        for (uint8_t p = 0; p < port_count; p++)
+            known |= (ports[p] == handle->panels[i].config.i2c_port);
+        if (!known)
+            ports[port_count++] = handle->panels[i].config.i2c_port;
+    }
+    if (port_count < 2)
+        return ESP_OK;
+
+    handle->workers = calloc(port_count, sizeof(ssd1306_port_worker_t));
+    handle->flush_done = xSemaphoreCreateCounting(port_count, 0);
+    ESP_RETURN_ON_FALSE(handle->workers && handle->flush_done, ESP_ERR_NO_MEM, TAG, "Failed to allocate flush workers");
+    handle->worker_count = port_count;
+
+    for (uint8_t w = 0; w < port_count; w++)
+    {
+        ssd1306_port_worker_t *worker = &handle->workers[w];
+        worker->owner = handle;
+        worker->port = ports[w];
+        worker->start = xSemaphoreCreateBinary();
+        ESP_RETURN_ON_FALSE(worker->start, ESP_ERR_NO_MEM, TAG, "Failed to allocate flush worker");
+        BaseType_t ok = xTaskCreate(_ssd1306_port_worker_task, "ssd1306_flush",
+                                    config->flush_task_stack ? config->flush_task_stack : 3072,
+                                    worker, config->flush_task_priority ? config->flush_task_priority : 5, &worker->task);
+        ESP_RETURN_ON_FALSE(ok == pdPASS, ESP_ERR_NO_MEM, TAG, "Failed to start flush worker");
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Shows the first frame after the panels have been set up.
+ * The framebuffer is loaded with the configured boot frame (or cleared). In fast
+ * boot mode each panel receives its init sequence, the frame and the display-on
+ * command in a single transaction, so the first lit pixel is already the frame.
+ *
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t Operation status.
+ */
+static esp_err_t _ssd1306_boot_frame(ssd1306_handle_t handle)
+{
+    // Without a framebuffer, the frame is streamed straight from its source.
+    const uint8_t *rows[8];
+    if (handle->config.no_framebuffer)
+    {
+        for (uint8_t page = 0; page < handle->config.screen_height / 8; page++)
+            rows[page] = handle->config.boot_frame ? handle->config.boot_frame + page * handle->config.screen_width : ssd1306_zero_row;
+    }
+    else if (handle->config.boot_frame)
+        memcpy(handle->buffer, handle->config.boot_frame, handle->buffer_size);
+    else
+        memset(handle->buffer, 0, handle->buffer_size);
+
+    esp_err_t ret;
+    if (!handle->config.fast_boot && !handle->config.no_framebuffer)
+    {
+        _ssd1306_mark_dirty(handle, 0, 0, handle->config.screen_width, handle->config.screen_height);
+        ret = ssd1306_update_screen(handle);
+    }
+    else
+    {
+        // All panels of a handle share one resolution, so one init sequence fits them all.
+        uint8_t init_cmds[SSD1306_INIT_CMDS_MAX];
+        const uint8_t display_on = OLED_CMD_DISPLAY_ON;
+        if (handle->config.fast_boot)
+        {
+            handle->job_pre = init_cmds;
+            handle->job_pre_len = _ssd1306_build_init_cmds(&handle->panels[0].config, init_cmds, false);
+            handle->job_post = &display_on;
+            handle->job_post_len = 1;
+        }
+        if (handle->config.no_framebuffer)
+            handle->job_rows = rows;
+        handle->flip_page_base = 0;
+        for (uint8_t i = 0; i < handle->panel_count; i++)
+        {
+            ssd1306_panel_t *panel = &handle->panels[i];
+            panel->job_data = true;
+            panel->job_min_col = 0;
+            panel->job_max_col = panel->config.screen_width - 1;
+            panel->job_min_page = 0;
+            panel->job_max_page = panel->config.screen_height / 8 - 1;
+        }
+        ret = _ssd1306_run_flush_jobs(handle);
+        handle->job_pre_len = handle->job_post_len = 0;
+        handle->job_rows = NULL;
+        _ssd1306_reset_dirty_area(handle);
+    }
+
+    handle->first_pixel_us = esp_timer_get_time();
+    return ret;
+}
+
+/**
+ * @brief Creates and initializes an SSD1306 driver instance.
+ *
+ * @param config Pointer to the SSD1306 configuration structure.
+ * @param out_handle Pointer to store the created device handle.
+ * @return esp_err_t Operation status.
+ */
+esp_err_t ssd1306_create(const ssd1306_config_t *config, ssd1306_handle_t *out_handle)
+{
+    int64_t create_start_us = esp_timer_get_time();
+    ESP_RETURN_ON_FALSE(config && out_handle && *out_handle == NULL, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+
+    // Allocate memory for the driver handle.
+    ssd1306_handle_t handle = calloc(1, sizeof(struct ssd1306_dev_t));
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_NO_MEM, TAG, "Failed to allocate handle");
+
+    handle->config = *config;
+    handle->create_start_us = create_start_us;
+    handle->panel.config = *config;
+    handle->panels = &handle->panel;
+    handle->panel_count = 1;
+
+    esp_err_t ret = _ssd1306_init_state(handle);
+    if (ret == ESP_OK)
+    {
+        ret = _ssd1306_i2c_acquire(config);
+        if (ret == ESP_OK)
+        {
+            ret = _ssd1306_panel_init(&handle->panel, config->fast_boot);
+            if (ret != ESP_OK)
+                ESP_LOGE(TAG, "Display initialization failed");
+            else
+            {
+                // Prepare driver for use.
+                _ssd1306_reset_dirty_area(handle);
+                ret = _ssd1306_boot_frame(handle);
+                if (ret != ESP_OK)
+                    ESP_LOGE(TAG, "Initial screen update failed");
+            }
+            if (ret != ESP_OK)
+                _ssd1306_i2c_release(config->i2c_port);
+        }
+    }
+    if (ret != ESP_OK)
+    {
+        _ssd1306_mem_free(handle, handle->buffer);
+        free(handle);
+        return ret;
+    }
+
+    *out_handle = handle;
+    ESP_LOGI(TAG, "SSD1306 driver initialized successfully (first frame after %lld us)", (long long)(handle->first_pixel_us - create_start_us));
+    return ESP_OK;
+}
+
+/**
+ * @brief Gets the boot latency measured while the display was created.
+ *
+ * @param handle SSD1306 device handle.
+ * @param out Pointer to store the measurement.
+ * @return esp_err_t Operation status.
+ */
+esp_err_t ssd1306_get_boot_timing(ssd1306_handle_t handle, ssd1306_boot_timing_t *out)
+{
+    ESP_RETURN_ON_FALSE(handle && out, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    out->create_start_us = handle->create_start_us;
+    out->first_pixel_us = handle->first_pixel_us;
+    out->create_to_first_pixel_us = (uint32_t)(handle->first_pixel_us - handle->create_start_us);
+    return ESP_OK;
+}
+
+/**
+ * @brief Creates a logical display spanning a grid of physical panels.
+ *
+ * @param config Pointer to the tiled display configuration.
+ * @param out_handle Pointer to store the created device handle.
+ * @return esp_err_t Operation status.
+ */
+esp_err_t ssd1306_create_tiled(const ssd1306_tiled_config_t *config, ssd1306_handle_t *out_handle)
+{
+    int64_t create_start_us = esp_timer_get_time();
+    ESP_RETURN_ON_FALSE(config && config->panels && config->cols && config->rows && out_handle && *out_handle == NULL,
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    uint16_t count = config->cols * config->rows;
+    ESP_RETURN_ON_FALSE(count <= UINT8_MAX, ESP_ERR_INVALID_ARG, TAG, "Too many panels");
+    const ssd1306_config_t *first = &config->panels[0];
+    ESP_RETURN_ON_FALSE(!first->no_framebuffer, ESP_ERR_NOT_SUPPORTED, TAG, "Tiled displays need a framebuffer");
+    for (uint16_t i = 1; i < count; i++)
+    {
+        ESP_RETURN_ON_FALSE(config->panels[i].screen_width == first->screen_width && config->panels[i].screen_height == first->screen_height,
+                            ESP_ERR_INVALID_ARG, TAG, "All panels must have the same resolution");
+        // Two tiles on one device would both take the same bus and draw over each other.
+        for (uint16_t j = 0; j < i; j++)
+        {
+            ESP_RETURN_ON_FALSE(config->panels[i].i2c_port != config->panels[j].i2c_port || config->panels[i].i2c_addr != config->panels[j].i2c_addr,
+                                ESP_ERR_INVALID_ARG, TAG, "Panels %d and %d share an I2C port and address", j, i);
+        }
+    }
+
+    ssd1306_handle_t handle = calloc(1, sizeof(struct ssd1306_dev_t));
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_NO_MEM, TAG, "Failed to allocate handle");
+    handle->panels = calloc(count, sizeof(ssd1306_panel_t));
+    if (!handle->panels)
+    {
+        free(handle);
+        return ESP_ERR_NO_MEM;
+    }
+
+    // The logical display takes its bus settings from the first panel and its size from the grid.
+    handle->config = *first;
+    handle->config.screen_width = first->screen_width * config->cols;
+    handle->config.screen_height = first->screen_height * config->rows;
+    handle->create_start_us = create_start_us;
+    handle->panel_count = count;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        handle->panels[i].config = config->panels[i];
+        handle->panels[i].x = (i % config->cols) * first->screen_width;
+        handle->panels[i].page = (i / config->cols) * (first->screen_height / 8);
+    }
+
+    uint8_t acquired = 0;
+    esp_err_t ret = _ssd1306_init_state(handle);
+    for (; ret == ESP_OK && acquired < count; acquired++)
+    {
+        ret = _ssd1306_i2c_acquire(&handle->panels[acquired].config);
+        if (ret != ESP_OK)
+            break;
+        ret = _ssd1306_panel_init(&handle->panels[acquired], first->fast_boot);
+        if (ret != ESP_OK)
+            ESP_LOGE(TAG, "Panel %u initialization failed", acquired);
+    }
+    if (ret == ESP_OK)
+        ret = _ssd1306_start_workers(handle, config);
+    if (ret == ESP_OK)
+    {
+        _ssd1306_reset_dirty_area(handle);
+        ret = _ssd1306_boot_frame(handle);
+        if (ret != ESP_OK)
+            ESP_LOGE(TAG, "Initial screen update failed");
+    }
+    if (ret != ESP_OK)
+    {
+        _ssd1306_stop_workers(handle);
+        for (uint8_t i = 0; i < acquired; i++)
+            _ssd1306_i2c_release(handle->panels[i].config.i2c_port);
+        _ssd1306_mem_free(handle, handle->buffer);
+        free(handle->panels);
+        free(handle);
+        return ret;
+    }
+
+    *out_handle = handle;
+    ESP_LOGI(TAG, "SSD1306 tiled display %dx%d initialized (%u panels)", handle->config.screen_width, handle->config.screen_height, count);
+    return ESP_OK;
+}
+
+#define SSD1306_SNAPSHOT_MAGIC 0x31333036u /**< Identifies a driver snapshot ("1306"). */
+
+/**
+ * @brief Header of a driver snapshot, followed by the compressed framebuffer.
+ */
+typedef struct
+{
+    uint32_t magic;            /**< SSD1306_SNAPSHOT_MAGIC. */
+    uint32_t crc;              /**< CRC32 of the remaining header fields and the payload. */
+    uint16_t width;            /**< Display width. */
+    uint16_t height;           /**< Display height. */
+    uint16_t payload_len;      /**< Length of the compressed framebuffer. */
+    uint8_t i2c_addr;          /**< Address of the panel the snapshot belongs to. */
+    uint8_t contrast;          /**< Shadowed contrast register. */
+    uint8_t invert_cmd;        /**< Shadowed normal/inverse command. */
+    uint8_t seg_cmd;           /**< Shadowed segment remap command. */
+    uint8_t com_cmd;           /**< Shadowed COM scan direction command. */
+    uint8_t start_line;        /**< Shadowed display start line. */
+    uint8_t display_on;        /**< Display was switched on. */
+    uint8_t page_flip;         /**< Page flipping was enabled. */
+    uint8_t front_half;        /**< Visible GDDRAM half (page flipping). */
+    uint8_t needs_update;      /**< Framebuffer had changes not yet sent. */
+    uint8_t min_page;          /**< Dirty area (minimum page). */
+    uint8_t max_page;          /**< Dirty area (maximum page). */
+    uint8_t flip_min_col;      /**< Previous dirty area (page flipping). */
+    uint8_t flip_max_col;      /**< Previous dirty area (page flipping). */
+    uint8_t flip_min_page;     /**< Previous dirty area (page flipping). */
+    uint8_t flip_max_page;     /**< Previous dirty area (page flipping). */
+    uint16_t min_col;          /**< Dirty area (minimum column). */
+    uint16_t max_col;          /**< Dirty area (maximum column). */
+} ssd1306_snapshot_hdr_t;
+
+/**
+ * @brief Computes the checksum of a snapshot.
+ *
+ * @param hdr Snapshot header (the payload follows it).
+ * @return uint32_t CRC32 of everything after the `crc` field.
+ */
+static uint32_t _ssd1306_snapshot_crc(const ssd1306_snapshot_hdr_t *hdr)
+{
+    const uint8_t *start = (const uint8_t *)&hdr->width;
+    size_t len = sizeof(*hdr) - offsetof(ssd1306_snapshot_hdr_t, width) + hdr->payload_len;
+    return esp_rom_crc32_le(0, start, len);
+}
+
+/**
+ * @brief Gets the buffer size that is always large enough for a snapshot.
+ *
+ * @param handle SSD1306 device handle.
+ * @return size_t Worst-case snapshot size in bytes (0 for an invalid handle).
+ */
+size_t ssd1306_snapshot_max_size(ssd1306_handle_t handle)
+{
+    if (!handle)
+        return 0;
+    // Incompressible data costs one control byte per 128 literals, plus one for a short tail.
+    return sizeof(ssd1306_snapshot_hdr_t) + handle->buffer_size + handle->buffer_size / 128 + 1;
+}
+
+/**
+ * @brief Saves the framebuffer and the panel state into a compact snapshot.
+ *
+ * @param handle SSD1306 device handle.
+ * @param buf Destination (e.g. RTC memory).
+ * @param buf_size Size of `buf`.
+ * @param out_len Optional pointer to store the snapshot length.
+ * @return esp_err_t Operation status.
+ */
+esp_err_t ssd1306_save_snapshot(ssd1306_handle_t handle, void *buf, size_t buf_size, size_t *out_len)
+{
+    ESP_RETURN_ON_FALSE(handle && buf, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(!handle->config.no_framebuffer, ESP_ERR_NOT_SUPPORTED, TAG, "Snapshots need a framebuffer");
+    ESP_RETURN_ON_FALSE(handle->panel_count == 1, ESP_ERR_NOT_SUPPORTED, TAG, "Snapshots of tiled displays are not supported");
+    // Queued commands and a running scroll make the panel diverge from what the snapshot describes.
+    ESP_RETURN_ON_FALSE(!handle->pending_cmds && handle->scroll_state == SSD1306_SCROLL_STATE_STOPPED, ESP_ERR_INVALID_STATE, TAG,
+                        "Flush queued commands and stop scrolling before saving a snapshot");
+    ESP_RETURN_ON_FALSE(buf_size > sizeof(ssd1306_snapshot_hdr_t), ESP_ERR_INVALID_SIZE, TAG, "Snapshot buffer too small");
+    ESP_RETURN_ON_FALSE(_ssd1306_buffer_ready(handle), ESP_ERR_NO_MEM, TAG, "Framebuffer unavailable");
+
+    ssd1306_snapshot_hdr_t hdr = {
+        .magic = SSD1306_SNAPSHOT_MAGIC,
+        .width = handle->config.screen_width,
+        .height = handle->config.screen_height,
+        .i2c_addr = handle->config.i2c_addr,
+        .contrast = handle->shadow_contrast,
+        .invert_cmd = handle->shadow_invert_cmd,
+        .seg_cmd = handle->shadow_seg_cmd,
+        .com_cmd = handle->shadow_com_cmd,
+        .start_line = handle->shadow_start_line,
+        .display_on = handle->shadow_display_on,
+        .page_flip = handle->page_flip,
+        .front_half = handle->front_half,
+        .needs_update = handle->needs_update,
+        .min_page = handle->min_page,
+        .max_page = handle->max_page,
+        .flip_min_col = handle->flip_min_col,
+        .flip_max_col = handle->flip_max_col,
+        .flip_min_page = handle->flip_min_page,
+        .flip_max_page = handle->flip_max_page,
+        .min_col = handle->min_col,
+        .max_col = handle->max_col,
+    };
+    uint8_t *payload = (uint8_t *)buf + sizeof(hdr);
+    size_t len = _ssd1306_rle_encode(handle->buffer, handle->buffer_size, payload, buf_size - sizeof(hdr));
+    ESP_RETURN_ON_FALSE(len, ESP_ERR_INVALID_SIZE, TAG, "Snapshot buffer too small");
+    hdr.payload_len = len;
+    memcpy(buf, &hdr, sizeof(hdr));
+    ((ssd1306_snapshot_hdr_t *)buf)->crc = _ssd1306_snapshot_crc((const ssd1306_snapshot_hdr_t *)buf);
+
+    if (out_len)
+        *out_len = sizeof(hdr) + len;
+    return ESP_OK;
+}
+
+/**
+ * @brief Creates a driver instance for a panel that is already initialized and
+ * still shows the content described by a snapshot (e.g. after deep sleep).
+ * No reset, init sequence or frame is sent.
+ *
+ * @param config Pointer to the SSD1306 configuration structure.
+ * @param snapshot Snapshot saved by `ssd1306_save_snapshot`.
+ * @param len Length of the snapshot.
+ * @param out_handle Pointer to store the created device handle.
+ * @return esp_err_t Operation status.
+ */
+esp_err_t ssd1306_attach(const ssd1306_config_t *config, const void *snapshot, size_t len, ssd1306_handle_t *out_handle)
+{
+    int64_t create_start_us = esp_timer_get_time();
+    ESP_RETURN_ON_FALSE(config && snapshot && out_handle && *out_handle == NULL, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(!config->no_framebuffer, ESP_ERR_NOT_SUPPORTED, TAG, "Snapshots need a framebuffer");
+
+    // Validate the snapshot before touching anything.
+    ssd1306_snapshot_hdr_t hdr;
+    ESP_RETURN_ON_FALSE(len >= sizeof(hdr), ESP_ERR_INVALID_SIZE, TAG, "Snapshot too short");
+    memcpy(&hdr, snapshot, sizeof(hdr));
+    ESP_RETURN_ON_FALSE(hdr.magic == SSD1306_SNAPSHOT_MAGIC && sizeof(hdr) + hdr.payload_len <= len, ESP_ERR_INVALID_STATE, TAG, "No valid snapshot");
+    ESP_RETURN_ON_FALSE(hdr.crc == _ssd1306_snapshot_crc((const ssd1306_snapshot_hdr_t *)snapshot), ESP_ERR_INVALID_CRC, TAG, "Snapshot is corrupted");
+    ESP_RETURN_ON_FALSE(hdr.width == config->screen_width && hdr.height == config->screen_height && hdr.i2c_addr == config->i2c_addr,
+                        ESP_ERR_INVALID_STATE, TAG, "Snapshot belongs to another panel");
+
+    ssd1306_handle_t handle = calloc(1, sizeof(struct ssd1306_dev_t));
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_NO_MEM, TAG, "Failed to allocate handle");
+    handle->config = *config;
+    handle->create_start_us = create_start_us;
+    handle->panel.config = *config;
+    handle->panels = &handle->panel;
+    handle->panel_count = 1;
+
+    esp_err_t ret = _ssd1306_init_state(handle);
+    if (ret == ESP_OK && !_ssd1306_rle_decode((const uint8_t *)snapshot + sizeof(hdr), hdr.payload_len, handle->buffer, handle->buffer_size))
+        ret = ESP_ERR_INVALID_STATE;
+    if (ret == ESP_OK)
+        ret = _ssd1306_i2c_acquire(config);
+    if (ret != ESP_OK)
+    {
+        _ssd1306_mem_free(handle, handle->buffer);
+        free(handle);
+        return ret;
+    }
+
+    // Keep the panel out of reset; the pin may have been held across sleep.
+    if (config->rst_pin != -1)
+    {
+        gpio_set_level(config->rst_pin, 1);
+        gpio_set_direction(config->rst_pin, GPIO_MODE_OUTPUT);
+        gpio_hold_dis(config->rst_pin);
+    }
+
+    handle->shadow_contrast = hdr.contrast;
+    handle->shadow_invert_cmd = hdr.invert_cmd;
+    handle->shadow_seg_cmd = hdr.seg_cmd;
+    handle->shadow_com_cmd = hdr.com_cmd;
+    handle->shadow_start_line = hdr.start_line;
+    handle->shadow_display_on = hdr.display_on;
+    handle->seg_remap = (hdr.seg_cmd & 0x01);
+    handle->page_flip = hdr.page_flip;
+    handle->front_half = hdr.front_half;
+    handle->flip_min_col = hdr.flip_min_col;
+    handle->flip_max_col = hdr.flip_max_col;
+    handle->flip_min_page = hdr.flip_min_page;
+    handle->flip_max_page = hdr.flip_max_page;
+    // Changes drawn before the snapshot but never sent are still owed to the panel.
+    _ssd1306_reset_dirty_area(handle);
+    if (hdr.needs_update)
+    {
+        handle->needs_update = true;
+        handle->min_page = hdr.min_page;
+        handle->max_page = hdr.max_page;
+        handle->min_col = hdr.min_col;
+        handle->max_col = hdr.max_col;
+    }
+
+    handle->first_pixel_us = esp_timer_get_time();
+    *out_handle = handle;
+    ESP_LOGI(TAG, "SSD1306 driver attached to running panel");
+    return ESP_OK;
+}
+
+/**
+ * @brief Deletes an SSD1306 driver instance and frees resources.
+ *
+ * @param handle_ptr Pointer to the device handle to be deleted.
+ * @return esp_err_t Operation status.
+ */
+esp_err_t ssd1306_delete(ssd1306_handle_t *handle_ptr)
+{
+    ESP_RETURN_ON_FALSE(handle_ptr && *handle_ptr, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ssd1306_handle_t handle = *handle_ptr;
+    _ssd1306_stop_workers(handle);
+    for (uint8_t i = 0; i < handle->panel_count; i++)
+        _ssd1306_i2c_release(handle->panels[i].config.i2c_port); // Delete the I2C driver once unused.
+    if (handle->panels != &handle->panel)
+        free(handle->panels);
+    _ssd1306_mem_free(handle, handle->buffer); // Free the framebuffer memory.
+    _ssd1306_mem_free(handle, handle->suspended);
+    _ssd1306_mem_free(handle, handle->rcache);
+    if (handle->user_bufs)
+        ESP_LOGW(TAG, "%u canvases or buffers still allocated", (unsigned)handle->user_bufs);
+    if (handle->own_arena)
+        ssd1306_arena_delete(handle->arena);
+    free(handle);                              // Free the handle memory.
+    *handle_ptr = NULL;                        // Set pointer to NULL to prevent dangling pointers.
+    return ESP_OK;
+}
+
+/**
+ * @brief Updates the display with the contents of the internal buffer.
+ * This function only sends the changed area (dirty area) for efficiency. On a
+ * tiled display the dirty area is split into each panel's span.
+ *
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t Operation status.
+ */
+esp_err_t ssd1306_update_screen(ssd1306_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(!handle->config.no_framebuffer, ESP_ERR_NOT_SUPPORTED, TAG, "No framebuffer to send");
+    // If nothing has changed, only the queued commands (if any) need to go out.
+    if (!handle->needs_update)
+    {
+        return _ssd1306_send_pending_cmds(handle);
     }
-    else if (c != '\r') // Ignore carriage return.
+
+    ESP_RETURN_ON_FALSE(_ssd1306_buffer_ready(handle), ESP_ERR_NO_MEM, TAG, "Framebuffer unavailable");
+
+    // Queued setter commands ride along in the same transaction as the pixel data.
+    uint8_t pre[8];
+    uint8_t post[SSD1306_SCROLL_CMDS_MAX + 2];
+    size_t pre_len, post_len;
+    uint8_t sent = _ssd1306_build_pending_cmds(handle, pre, &pre_len, post, &post_len);
+
+    uint16_t min_col = handle->min_col, max_col = handle->max_col;
+    uint8_t min_page = handle->min_page, max_page = handle->max_page;
+    handle->flip_page_base = 0;
+    if (handle->page_flip)
     {
-        const GFXfont *font = (const GFXfont *)handle->gfxFont->font_data;
-        // Ensure character is within the font range.
-        if (c >= font->first && c <= font->last)
+        // The hidden half last received the frame before the visible one, so it also
+        // misses the area changed by the previous flush.
+        min_col = _min(min_col, handle->flip_min_col);
+        max_col = max_col > handle->flip_max_col ? max_col : handle->flip_max_col;
+        min_page = _min(min_page, handle->flip_min_page);
+        max_page = max_page > handle->flip_max_page ? max_page : handle->flip_max_page;
+        handle->flip_min_col = handle->min_col;
+        handle->flip_max_col = handle->max_col;
+        handle->flip_min_page = handle->min_page;
+        handle->flip_max_page = handle->max_page;
+        handle->flip_page_base = (handle->front_half ^ 1) * (handle->config.screen_height / 8);
+        // Present the hidden half once its data is written.
+        memmove(post + 1, post, post_len);
+        post[0] = OLED_CMD_SET_DISPLAY_START_LINE | (handle->flip_page_base * 8);
+        post_len++;
+    }
+    else if (handle->front_half)
+    {
+        // Page flipping was turned off while the upper half was shown: return to the lower
+        // half once this flush has written the frame into it.
+        memmove(post + 1, post, post_len);
+        post[0] = OLED_CMD_SET_DISPLAY_START_LINE;
+        post_len++;
+    }
+
+    // Route the damage to the span of every panel it touches.
+    for (uint8_t i = 0; i < handle->panel_count; i++)
+    {
+        ssd1306_panel_t *panel = &handle->panels[i];
+        int16_t x0 = _max((int16_t)min_col, (int16_t)panel->x);
+        int16_t x1 = _min((int16_t)max_col, (int16_t)(panel->x + panel->config.screen_width - 1));
+        int16_t p0 = _max((int16_t)min_page, (int16_t)panel->page);
+        int16_t p1 = _min((int16_t)max_page, (int16_t)(panel->page + panel->config.screen_height / 8 - 1));
+        panel->job_data = (x0 <= x1 && p0 <= p1);
+        if (panel->job_data)
         {
-            const GFXglyph *glyph = &font->glyph[c - font->first]; // Get glyph data for the character.
-            uint8_t gw = glyph->width, gh = glyph->height, xa = glyph->xAdvance;
-            int8_t xo = glyph->xOffset, yo = glyph->yOffset;
+            panel->job_min_col = x0 - panel->x;
+            panel->job_max_col = x1 - panel->x;
+            panel->job_min_page = p0 - panel->page;
+            panel->job_max_page = p1 - panel->page;
+        }
+    }
+    handle->job_pre = pre;
+    handle->job_pre_len = pre_len;
+    handle->job_post = post;
+    handle->job_post_len = post_len;
 
-            // Handle text wrapping if the character exceeds screen width.
-            if (handle->wrap && ((*x + ((int16_t)xo + gw) * handle->textsize_x) > handle->config.screen_width))
-            {
-                *x = 0;
-                *y += handle->textsize_y * font->yAdvance;
-            }
-            // Calculate absolute bounding box coordinates.
-            int16_t x1 = *x + xo * handle->textsize_x;
-            int16_t y1 = *y + yo * handle->textsize_y;
-            int16_t x2 = x1 + gw * handle->textsize_x - 1;
-            int16_t y2 = y1 + gh * handle->textsize_y - 1;
+    esp_err_t ret = _ssd1306_run_flush_jobs(handle);
+    handle->job_pre_len = handle->job_post_len = 0;
 
-            // Update the global min/max boundaries.
-            if (x1 < *minx) *minx = x1;
-            if (y1 < *miny) *miny = y1;
-            if (x2 > *maxx) *maxx = x2;
-            if (y2 > *maxy) *maxy = y2;
+    if (ret == ESP_OK && (handle->page_flip || handle->front_half))
+    {
+        handle->front_half = handle->page_flip ? handle->front_half ^ 1 : 0;
+        handle->shadow_start_line = handle->flip_page_base * 8;
+    }
+    if (ret == ESP_OK)
+        _ssd1306_commit_pending_cmds(handle, sent);
+    else if (sent)
+        _ssd1306_report_cmd_error(handle, ret);
 
-            // Advance cursor x for the next character.
-            *x += xa * handle->textsize_x;
-        }
+    // After the update, reset the dirty area.
+    _ssd1306_reset_dirty_area(handle);
+    return ret;
+}
+
+/**
+ * @brief Gets the bus statistics of a handle, summed over all of its panels.
+ *
+ * @param handle SSD1306 device handle.
+ * @param out Pointer to store the statistics.
+ * @return esp_err_t Operation status.
+ */
+esp_err_t ssd1306_get_stats(ssd1306_handle_t handle, ssd1306_stats_t *out)
+{
+    ESP_RETURN_ON_FALSE(handle && out, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    memset(out, 0, sizeof(*out));
+    for (uint8_t i = 0; i < handle->panel_count; i++)
+    {
+        ssd1306_stats_t panel;
+        ssd1306_get_panel_stats(handle, i, &panel);
+        out->transactions += panel.transactions;
+        out->bytes += panel.bytes;
+        out->errors += panel.errors;
+        out->busy_us += panel.busy_us;
+        out->elapsed_us = panel.elapsed_us;
+        // Buses run in parallel, so the busiest one is what limits the frame rate.
+        if (panel.utilization > out->utilization)
+            out->utilization = panel.utilization;
+    }
+    ssd1306_rcache_t *rc = handle->rcache;
+    if (rc)
+    {
+        out->cache_hits = rc->hits;
+        out->cache_misses = rc->misses;
+        out->cache_hit_rate = (rc->hits + rc->misses) ? (uint8_t)((uint64_t)rc->hits * 100 / (rc->hits + rc->misses)) : 0;
+        for (int i = 0; i < SSD1306_RCACHE_ENTRIES; i++)
+            out->cache_bytes += rc->entries[i].valid ? rc->entries[i].len : 0;
     }
+    return ESP_OK;
 }
 
+/**
+ * @brief Gets the bus statistics of one panel.
+ *
+ * @param handle SSD1306 device handle.
+ * @param panel Panel index (row-major for tiled displays, 0 for a plain display).
+ * @param out Pointer to store the statistics.
+ * @return esp_err_t Operation status.
+ */
+esp_err_t ssd1306_get_panel_stats(ssd1306_handle_t handle, uint8_t panel, ssd1306_stats_t *out)
+{
+    ESP_RETURN_ON_FALSE(handle && out && panel < handle->panel_count, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    *out = handle->panels[panel].stats;
+    out->elapsed_us = esp_timer_get_time() - handle->stats_since_us;
+    out->utilization = out->elapsed_us ? (uint8_t)_min(100, out->busy_us * 100 / out->elapsed_us) : 0;
+    return ESP_OK;
+}
 
 /**
- * @brief Creates and initializes an SSD1306 driver instance.
+ * @brief Resets the bus statistics of all panels.
  *
- * @param config Pointer to the SSD1306 configuration structure.
- * @param out_handle Pointer to store the created device handle.
+ * @param handle SSD1306 device handle.
+ */
+void ssd1306_reset_stats(ssd1306_handle_t handle)
+{
+    if (!handle)
+        return;
+    for (uint8_t i = 0; i < handle->panel_count; i++)
+        memset(&handle->panels[i].stats, 0, sizeof(ssd1306_stats_t));
+    if (handle->rcache)
+        handle->rcache->hits = handle->rcache->misses = 0;
+    handle->stats_since_us = esp_timer_get_time();
+}
+
+/**
+ * @brief Gets the number of physical panels driven by a handle.
+ *
+ * @param handle SSD1306 device handle.
+ * @return uint8_t Panel count (1 for a plain display).
+ */
+uint8_t ssd1306_get_panel_count(ssd1306_handle_t handle)
+{
+    return handle ? handle->panel_count : 0;
+}
+
+/**
+ * @brief Writes page-aligned data straight to GDDRAM (immediate mode).
+ * Queued setter commands ride along in the same transaction.
+ *
+ * @param handle SSD1306 device handle.
+ * @param col First column.
+ * @param page First page.
+ * @param w Width in columns.
+ * @param pages Height in pages.
+ * @param rows One row of `w` bytes per page.
  * @return esp_err_t Operation status.
  */
-esp_err_t ssd1306_create(const ssd1306_config_t *config, ssd1306_handle_t *out_handle)
+static esp_err_t _ssd1306_direct_write(ssd1306_handle_t handle, uint8_t col, uint8_t page, uint8_t w, uint8_t pages, const uint8_t *const rows[])
 {
-    ESP_RETURN_ON_FALSE(config && out_handle && *out_handle == NULL, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ssd1306_panel_t *panel = &handle->panel;
+    ssd1306_stats_t before = panel->stats;
+
+    uint8_t pre[8];
+    uint8_t post[SSD1306_SCROLL_CMDS_MAX + 2];
+    size_t pre_len, post_len;
+    uint8_t sent = _ssd1306_build_pending_cmds(handle, pre, &pre_len, post, &post_len);
+
+    panel->job_data = true;
+    panel->job_min_col = col;
+    panel->job_max_col = col + w - 1;
+    panel->job_min_page = page;
+    panel->job_max_page = page + pages - 1;
+    handle->job_pre = pre;
+    handle->job_pre_len = pre_len;
+    handle->job_post = post;
+    handle->job_post_len = post_len;
+    handle->job_rows = rows;
+    esp_err_t ret = _ssd1306_panel_flush(handle, panel);
+    handle->job_rows = NULL;
+    handle->job_pre_len = handle->job_post_len = 0;
+
+    if (ret == ESP_OK)
+        _ssd1306_commit_pending_cmds(handle, sent);
+    else if (sent)
+        _ssd1306_report_cmd_error(handle, ret);
+
+    handle->last_op.transactions = panel->stats.transactions - before.transactions;
+    handle->last_op.bytes = panel->stats.bytes - before.bytes;
+    handle->last_op.errors = panel->stats.errors - before.errors;
+    handle->last_op.busy_us = panel->stats.busy_us - before.busy_us;
+    return ret;
+}
 
-    // Allocate memory for the driver handle.
-    ssd1306_handle_t handle = calloc(1, sizeof(struct ssd1306_dev_t));
-    ESP_RETURN_ON_FALSE(handle, ESP_ERR_NO_MEM, TAG, "Failed to allocate handle");
+/**
+ * @brief Validates an immediate-mode target area.
+ *
+ * @param handle SSD1306 device handle.
+ * @param col First column.
+ * @param page First page.
+ * @param w Width in columns.
+ * @param pages Height in pages.
+ * @return esp_err_t Operation status.
+ */
+static esp_err_t _ssd1306_direct_check(ssd1306_handle_t handle, int16_t col, int16_t page, int16_t w, int16_t pages)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(handle->config.no_framebuffer, ESP_ERR_INVALID_STATE, TAG, "Immediate mode needs a handle without framebuffer");
+    ESP_RETURN_ON_FALSE(col >= 0 && page >= 0 && w > 0 && pages > 0 &&
+                        col + w <= handle->config.screen_width && page + pages <= handle->config.screen_height / 8,
+                        ESP_ERR_INVALID_ARG, TAG, "Area outside the page grid");
+    return ESP_OK;
+}
 
-    handle->config = *config;
-    // Allocate memory for the framebuffer. Size is (width * height) / 8 because 1 byte represents 8 vertical pixels.
-    handle->buffer_size = (config->screen_width * config->screen_height) / 8;
-    handle->buffer = malloc(handle->buffer_size);
-    if (!handle->buffer)
+/**
+ * @brief Fills whole pages of a column range with a byte pattern (immediate mode).
+ *
+ * @param handle SSD1306 device handle.
+ * @param col First column.
+ * @param page First page.
+ * @param w Width in columns.
+ * @param pages Height in pages.
+ * @param pattern Byte written to every column (bit 0 is the top row of the page).
+ * @return esp_err_t Operation status.
+ */
+esp_err_t ssd1306_direct_fill(ssd1306_handle_t handle, uint8_t col, uint8_t page, uint8_t w, uint8_t pages, uint8_t pattern)
+{
+    ESP_RETURN_ON_ERROR(_ssd1306_direct_check(handle, col, page, w, pages), TAG, "Invalid fill");
+    uint8_t row[128];
+    memset(row, pattern, w);
+    const uint8_t *rows[8];
+    for (uint8_t p = 0; p < pages; p++)
+        rows[p] = pattern ? row : ssd1306_zero_row;
+    return _ssd1306_direct_write(handle, col, page, w, pages, rows);
+}
+
+/**
+ * @brief Draws a bitmap in page layout at a page-aligned position (immediate mode).
+ *
+ * @param handle SSD1306 device handle.
+ * @param col First column.
+ * @param page First page.
+ * @param bitmap `pages` rows of `w` bytes, each byte a vertical 8-pixel column (bit 0 on top).
+ * @param w Width in columns.
+ * @param pages Height in pages.
+ * @return esp_err_t Operation status.
+ */
+esp_err_t ssd1306_direct_draw_bitmap(ssd1306_handle_t handle, uint8_t col, uint8_t page, const uint8_t *bitmap, uint8_t w, uint8_t pages)
+{
+    ESP_RETURN_ON_FALSE(bitmap, ESP_ERR_INVALID_ARG, TAG, "Invalid bitmap");
+    ESP_RETURN_ON_ERROR(_ssd1306_direct_check(handle, col, page, w, pages), TAG, "Invalid bitmap area");
+    const uint8_t *rows[8];
+    for (uint8_t p = 0; p < pages; p++)
+        rows[p] = bitmap + (size_t)p * w;
+    return _ssd1306_direct_write(handle, col, page, w, pages, rows);
+}
+
+/**
+ * @brief Prints text into one page-high row of character cells (immediate mode).
+ * Each cell is fully overwritten, background included. Text running past the right
+ * edge is cut off.
+ *
+ * @param handle SSD1306 device handle.
+ * @param col First column.
+ * @param page Text row (page).
+ * @param text String to print.
+ * @param color OLED_COLOR_WHITE for lit text on black, OLED_COLOR_BLACK for inverted cells.
+ * @return esp_err_t Operation status.
+ */
+esp_err_t ssd1306_direct_print(ssd1306_handle_t handle, uint8_t col, uint8_t page, const char *text, ssd1306_color_t color)
+{
+    ESP_RETURN_ON_FALSE(text, ESP_ERR_INVALID_ARG, TAG, "Invalid text");
+    ESP_RETURN_ON_ERROR(_ssd1306_direct_check(handle, col, page, 1, 1), TAG, "Invalid text position");
+    ESP_RETURN_ON_FALSE(handle->gfxFont && handle->gfxFont->type == FONT_TYPE_GFX, ESP_ERR_NOT_SUPPORTED, TAG, "Unsupported font");
+    const GFXfont *font = (const GFXfont *)handle->gfxFont->font_data;
+    ESP_RETURN_ON_FALSE(font->yAdvance <= 8, ESP_ERR_NOT_SUPPORTED, TAG, "Font taller than a page");
+
+    // Render the glyphs column by column; the baseline sits on the bottom row of the cell.
+    uint8_t row[128] = {0};
+    int16_t x = 0, limit = handle->config.screen_width - col;
+    for (const char *c = text; *c && x < limit; c++)
     {
-        ESP_LOGE(TAG, "Failed to allocate buffer");
-        free(handle);
-        return ESP_ERR_NO_MEM;
+        if ((uint8_t)*c < font->first || (uint8_t)*c > font->last)
+            continue;
+        const GFXglyph *glyph = &font->glyph[(uint8_t)*c - font->first];
+        const uint8_t *bitmap = font->bitmap + glyph->bitmapOffset;
+        uint16_t bit = 0;
+        for (uint8_t yy = 0; yy < glyph->height; yy++)
+        {
+            int16_t r = 7 + glyph->yOffset + yy;
+            for (uint8_t xx = 0; xx < glyph->width; xx++, bit++)
+            {
+                int16_t cx = x + glyph->xOffset + xx;
+                if ((bitmap[bit >> 3] & (0x80 >> (bit & 7))) && r >= 0 && r < 8 && cx >= 0 && cx < limit)
+                    row[cx] |= 1 << r;
+            }
+        }
+        x += glyph->xAdvance;
+    }
+    uint8_t w = _min(x, limit);
+    if (w == 0)
+        return ESP_OK;
+    if (color == OLED_COLOR_BLACK)
+    {
+        for (uint8_t i = 0; i < w; i++)
+            row[i] = ~row[i];
     }
+    const uint8_t *rows[1] = {row};
+    return _ssd1306_direct_write(handle, col, page, w, 1, rows);
+}
 
-    // Initialize default graphics state.
-    handle->cursor_x = 0;
-    handle->cursor_y = 0;
-    handle->textsize_x = 1;
-    handle->textsize_y = 1;
-    handle->textcolor = OLED_COLOR_WHITE;
-    handle->textbgcolor = OLED_COLOR_BLACK;
-    handle->wrap = true;
-    handle->gfxFont = &FONT_5x7; // Set default font.
+/**
+ * @brief Draws a one-page-high horizontal bar (immediate mode).
+ *
+ * @param handle SSD1306 device handle.
+ * @param col First column.
+ * @param page Bar row (page).
+ * @param w Bar width in columns, including the end caps.
+ * @param filled Number of filled columns (clamped to `w`).
+ * @return esp_err_t Operation status.
+ */
+esp_err_t ssd1306_direct_draw_hbar(ssd1306_handle_t handle, uint8_t col, uint8_t page, uint8_t w, uint8_t filled)
+{
+    ESP_RETURN_ON_ERROR(_ssd1306_direct_check(handle, col, page, w, 1), TAG, "Invalid bar area");
+    uint8_t row[128];
+    for (uint8_t i = 0; i < w; i++)
+        row[i] = (i < filled || i == 0 || i == w - 1) ? 0x7E : 0x42; // Solid inside, outline elsewhere.
+    const uint8_t *rows[1] = {row};
+    return _ssd1306_direct_write(handle, col, page, w, 1, rows);
+}
 
-    // Configure the I2C master driver.
-    i2c_config_t i2c_conf = {
-        .mode = I2C_MODE_MASTER,
-        .sda_io_num = config->sda_pin,
-        .scl_io_num = config->scl_pin,
-        .sda_pullup_en = GPIO_PULLUP_ENABLE,
-        .scl_pullup_en = GPIO_PULLUP_ENABLE,
-        .master.clk_speed = config->i2c_clk_speed_hz,
-    };
-    ESP_ERROR_CHECK(i2c_param_config(config->i2c_port, &i2c_conf));
-    ESP_ERROR_CHECK(i2c_driver_install(config->i2c_port, I2C_MODE_MASTER, 0, 0, 0));
+/**
+ * @brief Draws a vertical bar growing from the bottom of a page range (immediate mode).
+ *
+ * @param handle SSD1306 device handle.
+ * @param col First column.
+ * @param w Bar width in columns.
+ * @param page Top page of the bar area.
+ * @param pages Height of the bar area in pages.
+ * @param level Lit rows counted from the bottom (clamped to `pages * 8`).
+ * @return esp_err_t Operation status.
+ */
+esp_err_t ssd1306_direct_draw_vbar(ssd1306_handle_t handle, uint8_t col, uint8_t w, uint8_t page, uint8_t pages, uint16_t level)
+{
+    ESP_RETURN_ON_ERROR(_ssd1306_direct_check(handle, col, page, w, pages), TAG, "Invalid bar area");
+    static const uint8_t full[128] = {[0 ... 127] = 0xFF};
+    uint8_t partial[128];
+    const uint8_t *rows[8];
+    for (uint8_t p = 0; p < pages; p++)
+    {
+        // Rows lit in this page: the bar fills from the bottom page upwards.
+        int16_t lit = (int16_t)level - (pages - 1 - p) * 8;
+        if (lit >= 8)
+            rows[p] = full;
+        else if (lit <= 0)
+            rows[p] = ssd1306_zero_row;
+        else
+        {
+            memset(partial, (uint8_t)(0xFF << (8 - lit)), w);
+            rows[p] = partial;
+        }
+    }
+    return _ssd1306_direct_write(handle, col, page, w, pages, rows);
+}
 
-    // Perform a hardware reset on the display if the RST pin is defined.
-    if (handle->config.rst_pin != -1)
+/**
+ * @brief Gets the bus cost of the last immediate-mode operation.
+ *
+ * @param handle SSD1306 device handle.
+ * @param out Pointer to store the cost (`elapsed_us` and `utilization` are not used).
+ * @return esp_err_t Operation status.
+ */
+esp_err_t ssd1306_direct_get_last_cost(ssd1306_handle_t handle, ssd1306_stats_t *out)
+{
+    ESP_RETURN_ON_FALSE(handle && out, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    *out = handle->last_op;
+    return ESP_OK;
+}
+
+/**
+ * @brief Enables or disables GDDRAM page flipping.
+ *
+ * @param handle SSD1306 device handle.
+ * @param enable true to render into the hidden half of GDDRAM and flip on each update.
+ * @return esp_err_t Operation status.
+ */
+esp_err_t ssd1306_set_page_flip(ssd1306_handle_t handle, bool enable)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(!enable || (handle->panel_count == 1 && !handle->config.no_framebuffer && handle->config.screen_height * 2 <= 64), ESP_ERR_NOT_SUPPORTED, TAG, "Page flipping needs a single panel of at most 32 rows");
+    if (enable == handle->page_flip)
+        return ESP_OK;
+
+    handle->page_flip = enable;
+    if (enable)
     {
-        gpio_set_direction(handle->config.rst_pin, GPIO_MODE_OUTPUT);
-        gpio_set_level(handle->config.rst_pin, 0);
-        vTaskDelay(pdMS_TO_TICKS(50)); // Hold reset for 50ms.
-        gpio_set_level(handle->config.rst_pin, 1);
+        // The other half holds unknown data, so the first flip must write the whole frame.
+        handle->flip_min_col = 0;
+        handle->flip_max_col = handle->config.screen_width - 1;
+        handle->flip_min_page = 0;
+        handle->flip_max_page = handle->config.screen_height / 8 - 1;
+        _ssd1306_mark_dirty(handle, 0, 0, handle->config.screen_width, handle->config.screen_height);
+        return ESP_OK;
     }
+    // Leaving flip mode. If the upper half is shown, the lower half is one frame behind:
+    // the next update writes the whole frame there and moves the start line back in the
+    // same transaction, so the old frame never appears.
+    if (handle->front_half)
+        _ssd1306_mark_dirty(handle, 0, 0, handle->config.screen_width, handle->config.screen_height);
+    return ESP_OK;
+}
 
-    // Initialization command sequence to configure the SSD1306 controller.
-    const uint8_t init_cmds[] = {
-        OLED_CMD_DISPLAY_OFF,                 // Turn display off during setup
-        OLED_CMD_SET_DISPLAY_CLK_DIV, 0x80,   // Set clock
-        OLED_CMD_SET_MUX_RATIO, (uint8_t)(config->screen_height - 1), // Set based on screen height
-        OLED_CMD_SET_DISPLAY_OFFSET, 0x00,    // No offset
-        OLED_CMD_SET_DISPLAY_START_LINE | 0x00, // Start at line 0
-        OLED_CMD_SET_CHARGE_PUMP, 0x14,       // Enable charge pump
-        OLED_CMD_SET_MEMORY_ADDR_MODE, 0x00,  // Horizontal addressing mode
-        OLED_CMD_SET_SEGMENT_REMAP | 0x01,    // Remap segment (column 127 is at SEG0)
-        OLED_CMD_SET_COM_SCAN_MODE | 0x08,    // Remap COM (scan from COM[N-1] to COM0)
-        OLED_CMD_SET_COM_PIN_MAP, (config->screen_height == 64) ? (uint8_t)0x12 : (uint8_t)0x02, // COM pin config
-        OLED_CMD_SET_CONTRAST, 0xCF,           // Set contrast
-        OLED_CMD_SET_PRECHARGE, 0xF1,         // Set pre-charge period
-        OLED_CMD_SET_VCOMH_DESELCT, 0x40,     // Set VCOMH level
-        OLED_CMD_DISPLAY_RAM,                 // Display RAM content
-        OLED_CMD_DISPLAY_NORMAL,              // Normal display mode (not inverted)
-        OLED_CMD_DEACTIVATE_SCROLL,           // Deactivate scrolling
-        OLED_CMD_DISPLAY_ON                   // Turn display on
-    };
-    ESP_RETURN_ON_ERROR(_ssd1306_send_cmd_list(handle, init_cmds, sizeof(init_cmds)), TAG, "Display initialization failed");
+/**
+ * @brief Enables or disables deferred command mode.
+ * When disabled, any commands still in the queue are sent immediately.
+ *
+ * @param handle SSD1306 device handle.
+ * @param enable true to queue setter commands until the next flush.
+ * @return esp_err_t Operation status.
+ */
+esp_err_t ssd1306_set_deferred_commands(ssd1306_handle_t handle, bool enable)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    handle->defer_cmds = enable;
+    return enable ? ESP_OK : _ssd1306_send_pending_cmds(handle);
+}
 
-    // Prepare driver for use.
-    _ssd1306_reset_dirty_area(handle);
-    ssd1306_clear_buffer(handle);
-    ESP_RETURN_ON_ERROR(ssd1306_update_screen(handle), TAG, "Initial screen update failed");
+/**
+ * @brief Selects what happens to the framebuffer while the display is off.
+ *
+ * @param handle SSD1306 device handle.
+ * @param mode Suspend mode.
+ * @return esp_err_t Operation status.
+ */
+esp_err_t ssd1306_set_suspend_mode(ssd1306_handle_t handle, ssd1306_suspend_mode_t mode)
+{
+    ESP_RETURN_ON_FALSE(handle && mode <= SSD1306_SUSPEND_DISCARD, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(!handle->config.no_framebuffer, ESP_ERR_NOT_SUPPORTED, TAG, "No framebuffer to suspend");
+    handle->suspend_mode = mode;
+    if (mode == SSD1306_SUSPEND_NONE)
+        ESP_RETURN_ON_FALSE(_ssd1306_buffer_ready(handle), ESP_ERR_NO_MEM, TAG, "Framebuffer unavailable");
+    else if (!handle->shadow_display_on)
+        _ssd1306_suspend_buffer(handle);
+    return ESP_OK;
+}
 
-    *out_handle = handle;
-    ESP_LOGI(TAG, "SSD1306 driver initialized successfully");
+/**
+ * @brief Enables, resizes or disables the raster cache.
+ * Cached rasters are dropped in every case.
+ *
+ * @param handle SSD1306 device handle.
+ * @param pool_bytes Pool size in bytes (0 to disable).
+ * @return esp_err_t Operation status.
+ */
+esp_err_t ssd1306_set_raster_cache(ssd1306_handle_t handle, size_t pool_bytes)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(!handle->config.no_framebuffer, ESP_ERR_NOT_SUPPORTED, TAG, "No framebuffer to draw into");
+    _ssd1306_mem_free(handle, handle->rcache);
+    handle->rcache = NULL;
+    if (!pool_bytes)
+        return ESP_OK;
+    handle->rcache = _ssd1306_mem_alloc(handle, sizeof(ssd1306_rcache_t) + pool_bytes);
+    ESP_RETURN_ON_FALSE(handle->rcache, ESP_ERR_NO_MEM, TAG, "Failed to allocate raster cache");
+    memset(handle->rcache, 0, sizeof(ssd1306_rcache_t));
+    handle->rcache->pool_size = pool_bytes;
     return ESP_OK;
 }
 
 /**
- * @brief Deletes an SSD1306 driver instance and frees resources.
+ * @brief Moves a driver buffer to a new owner (an arena, or the heap for NULL).
  *
- * @param handle_ptr Pointer to the device handle to be deleted.
- * @return esp_err_t Operation status.
+ * @param from Current arena (NULL = heap).
+ * @param to New arena (NULL = heap).
+ * @param ptr Buffer to move; replaced on success.
+ * @param len Buffer length.
+ * @return true on success (or for a NULL buffer).
  */
-esp_err_t ssd1306_delete(ssd1306_handle_t *handle_ptr)
+static bool _ssd1306_mem_move(ssd1306_arena_handle_t from, ssd1306_arena_handle_t to, void **ptr, size_t len)
 {
-    ESP_RETURN_ON_FALSE(handle_ptr && *handle_ptr, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
-    ssd1306_handle_t handle = *handle_ptr;
-    i2c_driver_delete(handle->config.i2c_port); // Delete the I2C driver.
-    free(handle->buffer);                      // Free the framebuffer memory.
-    free(handle);                              // Free the handle memory.
-    *handle_ptr = NULL;                        // Set pointer to NULL to prevent dangling pointers.
-    return ESP_OK;
+    if (!*ptr)
+        return true;
+    void *moved = to ? ssd1306_arena_alloc(to, len) : malloc(len);
+    if (!moved)
+        return false;
+    memcpy(moved, *ptr, len);
+    if (ssd1306_arena_owns(from, *ptr))
+        ssd1306_arena_free(from, *ptr);
+    else
+        free(*ptr);
+    *ptr = moved;
+    return true;
 }
 
 /**
- * @brief Updates the display with the contents of the internal buffer.
- * This function only sends the changed area (dirty area) for efficiency.
+ * @brief Attaches an arena for the driver's buffers and moves the existing ones into it.
  *
  * @param handle SSD1306 device handle.
+ * @param arena Arena, or NULL to go back to the heap.
+ * @param take_ownership Delete the arena in `ssd1306_delete`.
  * @return esp_err_t Operation status.
  */
-esp_err_t ssd1306_update_screen(ssd1306_handle_t handle)
+esp_err_t ssd1306_set_arena(ssd1306_handle_t handle, ssd1306_arena_handle_t arena, bool take_ownership)
 {
     ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
-    // If nothing has changed, do nothing.
-    if (!handle->needs_update)
+    ssd1306_arena_handle_t old = handle->arena;
+    if (arena == old)
     {
+        handle->own_arena = arena && take_ownership;
         return ESP_OK;
     }
+    // Handed-out buffers are freed by address against the current arena, so they must
+    // not outlive a switch.
+    ESP_RETURN_ON_FALSE(!handle->user_bufs, ESP_ERR_INVALID_STATE, TAG, "Free canvases before switching arenas");
+
+    // Move every buffer or none: on failure the ones already moved go back.
+    void **bufs[] = {(void **)&handle->buffer, (void **)&handle->suspended, (void **)&handle->rcache};
+    size_t lens[] = {handle->buffer_size, handle->suspended_len,
+                     handle->rcache ? sizeof(ssd1306_rcache_t) + handle->rcache->pool_size : 0};
+    size_t moved = 0;
+    while (moved < 3 && _ssd1306_mem_move(old, arena, bufs[moved], lens[moved]))
+        moved++;
+    if (moved < 3)
+    {
+        while (moved--)
+            _ssd1306_mem_move(arena, old, bufs[moved], lens[moved]);
+        ESP_LOGE(TAG, "Arena too small for the display buffers");
+        return ESP_ERR_NO_MEM;
+    }
 
-    // Set the update "window" on the display, corresponding to the dirty area.
-    uint8_t cmds[] = {
-        OLED_CMD_SET_COLUMN_RANGE, handle->min_col, handle->max_col,
-        OLED_CMD_SET_PAGE_RANGE, handle->min_page, handle->max_page
-    };
-    ESP_RETURN_ON_ERROR(_ssd1306_send_cmd_list(handle, cmds, sizeof(cmds)), TAG, "Failed to set update window");
-
-    // Create a new I2C link to send the framebuffer data.
-    // Cache is not used here as data transfers can be larger than the static buffer.
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    ESP_RETURN_ON_FALSE(cmd, ESP_ERR_NO_MEM, TAG, "Failed to create I2C command link");
+    if (handle->own_arena)
+        ssd1306_arena_delete(old);
+    handle->arena = arena;
+    handle->own_arena = arena && take_ownership;
+    return ESP_OK;
+}
 
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (handle->config.i2c_addr << 1) | I2C_MASTER_WRITE, true);
-    i2c_master_write_byte(cmd, OLED_CONTROL_BYTE_DATA_STREAM, true); // Indicate that the following is image data.
+/**
+ * @brief Allocates a buffer from the display's arena, or from the heap without one.
+ *
+ * @param handle SSD1306 device handle, or NULL for the heap.
+ * @param len Bytes needed.
+ * @return void* Buffer, or NULL.
+ */
+void *ssd1306_alloc_buffer(ssd1306_handle_t handle, size_t len)
+{
+    if (!handle)
+        return malloc(len);
+    void *buf = _ssd1306_mem_alloc(handle, len);
+    if (buf)
+        handle->user_bufs++;
+    return buf;
+}
 
-    // Send data page by page, only for columns within the dirty area.
-    for (uint8_t page = handle->min_page; page <= handle->max_page; ++page)
+/**
+ * @brief Frees a buffer from `ssd1306_alloc_buffer` or `ssd1306_alloc_canvas`.
+ *
+ * @param handle SSD1306 device handle it was allocated with.
+ * @param buf Buffer, or NULL.
+ */
+void ssd1306_free_buffer(ssd1306_handle_t handle, void *buf)
+{
+    if (!handle)
     {
-        // Calculate the starting offset for the data of the current page and column.
-        uint16_t offset = (page * handle->config.screen_width) + handle->min_col;
-        uint16_t len = handle->max_col - handle->min_col + 1;
-        i2c_master_write(cmd, &handle->buffer[offset], len, true);
+        free(buf);
+        return;
     }
+    if (!buf)
+        return;
+    _ssd1306_mem_free(handle, buf);
+    handle->user_bufs--;
+}
 
-    i2c_master_stop(cmd);
+/**
+ * @brief Allocates a blank canvas the size of the framebuffer.
+ *
+ * @param handle SSD1306 device handle.
+ * @return uint8_t* Canvas, or NULL.
+ */
+uint8_t *ssd1306_alloc_canvas(ssd1306_handle_t handle)
+{
+    if (!handle)
+        return NULL;
+    size_t len = (size_t)handle->config.screen_width * handle->config.screen_height / 8;
+    uint8_t *canvas = ssd1306_alloc_buffer(handle, len);
+    if (canvas)
+        memset(canvas, 0, len);
+    return canvas;
+}
 
-    // Send the data to the I2C bus.
-    esp_err_t ret = i2c_master_cmd_begin(handle->config.i2c_port, cmd, pdMS_TO_TICKS(1000));
-    i2c_cmd_link_delete(cmd); // Free the link after use.
+/**
+ * @brief Frees a canvas from `ssd1306_alloc_canvas`.
+ *
+ * @param handle SSD1306 device handle.
+ * @param canvas Canvas, or NULL.
+ */
+void ssd1306_free_canvas(ssd1306_handle_t handle, uint8_t *canvas)
+{
+    if (handle)
+        ssd1306_free_buffer(handle, canvas);
+}
 
-    // After a successful update, reset the dirty area.
-    _ssd1306_reset_dirty_area(handle);
-    return ret;
+/**
+ * @brief Registers a callback for display command failures.
+ *
+ * @param handle SSD1306 device handle.
+ * @param cb Callback function, or NULL to remove it.
+ * @param user_ctx User context passed to the callback.
+ */
+void ssd1306_set_cmd_error_callback(ssd1306_handle_t handle, ssd1306_cmd_error_cb_t cb, void *user_ctx)
+{
+    if (!handle)
+        return;
+    handle->cmd_error_cb = cb;
+    handle->cmd_error_ctx = user_ctx;
 }
 
 /**
@@ -557,6 +3044,15 @@ void ssd1306_fill_buffer(ssd1306_handle_t handle, ssd1306_color_t color)
 {
     if (!handle)
         return;
+    // The whole frame is overwritten, so suspended content need not be restored.
+    if (!handle->buffer)
+    {
+        _ssd1306_mem_free(handle, handle->suspended);
+        handle->suspended = NULL;
+        handle->suspended_len = 0;
+    }
+    if (!_ssd1306_buffer_ready(handle))
+        return;
     // Use memset for a fast buffer fill. 0x00 for black, 0xFF for white.
     memset(handle->buffer, (color == OLED_COLOR_BLACK) ? 0x00 : 0xFF, handle->buffer_size);
     // Mark the entire screen as dirty since it has all been changed.
@@ -594,6 +3090,21 @@ void ssd1306_set_text_size_custom(ssd1306_handle_t handle, uint8_t size_x, uint8
     handle->textsize_y = (size_y > 0) ? size_y : 1;
 }
 
+/**
+ * @brief Sets the size and pen width of stroke fonts.
+ *
+ * @param handle SSD1306 device handle.
+ * @param height Capital height in pixels (0 = follow the text size).
+ * @param thickness Pen width in pixels.
+ */
+void ssd1306_set_stroke_style(ssd1306_handle_t handle, uint16_t height, uint8_t thickness)
+{
+    if (!handle)
+        return;
+    handle->stroke_height = height;
+    handle->stroke_thickness = (thickness > 0) ? thickness : 1;
+}
+
 /**
  * @brief Sets the font for text rendering.
  *
@@ -607,6 +3118,17 @@ void ssd1306_set_font(ssd1306_handle_t handle, const ssd1306_font_handle_t *font
     handle->gfxFont = font_handle;
 }
 
+/**
+ * @brief Gets the font used for text rendering.
+ *
+ * @param handle SSD1306 device handle.
+ * @return const ssd1306_font_handle_t* Current font, or NULL for an invalid handle.
+ */
+const ssd1306_font_handle_t *ssd1306_get_font(ssd1306_handle_t handle)
+{
+    return handle ? handle->gfxFont : NULL;
+}
+
 /**
  * @brief Sets the text cursor position.
  *
@@ -667,6 +3189,65 @@ void ssd1306_set_text_wrap(ssd1306_handle_t handle, bool wrap)
     handle->wrap = wrap;
 }
 
+/**
+ * @brief Restricts all drawing to a rectangle.
+ * Pixels outside of it are left untouched by every drawing function.
+ *
+ * @param handle SSD1306 device handle.
+ * @param x Top-left x-coordinate.
+ * @param y Top-left y-coordinate.
+ * @param w Width.
+ * @param h Height.
+ */
+void ssd1306_set_clip_rect(ssd1306_handle_t handle, int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    if (!handle)
+        return;
+    handle->clip_x0 = _max(x, (int16_t)0);
+    handle->clip_y0 = _max(y, (int16_t)0);
+    handle->clip_x1 = _min((int16_t)(x + w), handle->config.screen_width);
+    handle->clip_y1 = _min((int16_t)(y + h), handle->config.screen_height);
+}
+
+/**
+ * @brief Resets the clip rectangle to the whole screen.
+ *
+ * @param handle SSD1306 device handle.
+ */
+void ssd1306_reset_clip_rect(ssd1306_handle_t handle)
+{
+    if (!handle)
+        return;
+    handle->clip_x0 = 0;
+    handle->clip_y0 = 0;
+    handle->clip_x1 = handle->config.screen_width;
+    handle->clip_y1 = handle->config.screen_height;
+}
+
+/**
+ * @brief Gets the current clip rectangle.
+ *
+ * @param handle SSD1306 device handle.
+ * @param x Pointer to store the top-left x-coordinate (may be NULL).
+ * @param y Pointer to store the top-left y-coordinate (may be NULL).
+ * @param w Pointer to store the width (may be NULL).
+ * @param h Pointer to store the height (may be NULL).
+ * @return esp_err_t Operation status.
+ */
+esp_err_t ssd1306_get_clip_rect(ssd1306_handle_t handle, int16_t *x, int16_t *y, int16_t *w, int16_t *h)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    if (x)
+        *x = handle->clip_x0;
+    if (y)
+        *y = handle->clip_y0;
+    if (w)
+        *w = handle->clip_x1 - handle->clip_x0;
+    if (h)
+        *h = handle->clip_y1 - handle->clip_y0;
+    return ESP_OK;
+}
+
 
 /**
  * @brief Gets the current x-coordinate of the text cursor.
@@ -734,6 +3315,9 @@ size_t ssd1306_print(ssd1306_handle_t handle, const char *str)
 {
     if (!handle || !str)
         return 0;
+    ssd1306_rcache_capture_t cap;
+    if (_ssd1306_rcache_print_begin(handle, str, &cap))
+        return strlen(str);
     size_t n = 0;
     while (*str)
     {
@@ -742,6 +3326,11 @@ size_t ssd1306_print(ssd1306_handle_t handle, const char *str)
         else
             break;
     }
+    if (cap.entry)
+    {
+        handle->textcolor = handle->textbgcolor = cap.color;
+        _ssd1306_rcache_end(handle, &cap);
+    }
     return n;
 }
 
@@ -756,6 +3345,11 @@ size_t ssd1306_write(ssd1306_handle_t handle, uint8_t c)
 {
     if (!handle || !handle->gfxFont)
         return 0;
+    if (handle->gfxFont->type == FONT_TYPE_STROKE)
+    {
+        _ssd1306_write_stroke(handle, c);
+        return 1;
+    }
 
     const GFXfont *font = (const GFXfont *)handle->gfxFont->font_data;
 
@@ -820,6 +3414,12 @@ size_t ssd1306_write(ssd1306_handle_t handle, uint8_t c)
  */
 void ssd1306_draw_char(ssd1306_handle_t handle, int16_t x, int16_t y, unsigned char c, ssd1306_color_t color, ssd1306_color_t bg_color, uint8_t size_x, uint8_t size_y)
 {
+    if (handle && handle->gfxFont && handle->gfxFont->type == FONT_TYPE_STROKE)
+    {
+        // Stroke fonts scale with the stroke style and have no background.
+        _ssd1306_draw_stroke_char(handle, x, y, c, color);
+        return;
+    }
     // Validate input and ensure font is of GFX type.
     if (!handle || !handle->gfxFont || handle->gfxFont->type != FONT_TYPE_GFX)
         return;
@@ -943,7 +3543,8 @@ void ssd1306_get_text_bounds(ssd1306_handle_t handle, const char *str, int16_t x
 void __attribute__((always_inline)) inline ssd1306_draw_pixel(ssd1306_handle_t handle, int16_t x, int16_t y, ssd1306_color_t color)
 {
     // Ignore if the pixel is off-screen (basic clipping).
-    if (x < 0 || x >= handle->config.screen_width || y < 0 || y >= handle->config.screen_height) return;
+    if (x < handle->clip_x0 || x >= handle->clip_x1 || y < handle->clip_y0 || y >= handle->clip_y1) return;
+    if (!handle->buffer && !_ssd1306_buffer_ready(handle)) return;
 
     // Calculate the byte index in the framebuffer. The screen is organized in 8-pixel-high "pages".
     // index = x + (y / 8) * screen_width
@@ -969,6 +3570,23 @@ void __attribute__((always_inline)) inline ssd1306_draw_pixel(ssd1306_handle_t h
     _ssd1306_mark_dirty(handle, x, y, 1, 1);
 }
 
+/**
+ * @brief Reads a single pixel from the framebuffer.
+ *
+ * @param handle SSD1306 device handle.
+ * @param x X-coordinate of the pixel.
+ * @param y Y-coordinate of the pixel.
+ * @return bool True if the pixel is set.
+ */
+bool ssd1306_get_pixel(ssd1306_handle_t handle, int16_t x, int16_t y)
+{
+    if (!handle || x < 0 || x >= handle->config.screen_width || y < 0 || y >= handle->config.screen_height)
+        return false;
+    if (!_ssd1306_buffer_ready(handle))
+        return false;
+    return (handle->buffer[x + (y >> 3) * handle->config.screen_width] >> (y & 0x07)) & 1;
+}
+
 /**
  * @brief Draws a straight line from one point to another.
  * Uses Bresenham's line algorithm.
@@ -1041,7 +3659,7 @@ void ssd1306_draw_line(ssd1306_handle_t handle, int16_t x0, int16_t y0, int16_t
 void ssd1306_draw_fast_vline(ssd1306_handle_t handle, int16_t x, int16_t y, int16_t h, ssd1306_color_t color)
 {
     // Basic clipping
-    if (!handle || x < 0 || x >= handle->config.screen_width || h == 0)
+    if (!handle || x < handle->clip_x0 || x >= handle->clip_x1 || h == 0 || !_ssd1306_buffer_ready(handle))
         return;
 
     // Handle negative height
@@ -1050,36 +3668,37 @@ void ssd1306_draw_fast_vline(ssd1306_handle_t handle, int16_t x, int16_t y, int1
         y += h;
         h = -h;
     }
-    if (y >= handle->config.screen_height)
-        return;
 
     // Clip top and bottom boundaries
     int16_t y_end = y + h;
-    if (y_end > handle->config.screen_height)
-        y_end = handle->config.screen_height;
-    if (y < 0)
-        y = 0;
+    if (y_end > handle->clip_y1)
+        y_end = handle->clip_y1;
+    if (y < handle->clip_y0)
+        y = handle->clip_y0;
+    if (y >= y_end)
+        return;
 
     // Mark the entire line area as dirty once
     _ssd1306_mark_dirty(handle, x, y, 1, y_end - y);
 
-    // Loop through each vertical pixel
-    for (int16_t i = y; i < y_end; ++i)
+    // Work page by page: one masked byte operation per page instead of one per pixel.
+    for (int16_t page = y >> 3; page <= (y_end - 1) >> 3; ++page)
     {
-        // Calculate index and bit position for the current pixel
-        size_t index = x + (i >> 3) * handle->config.screen_width;
-        uint8_t bit_pos = i & 0x07;
-        // Manipulate the bit in the framebuffer
+        int16_t top = page * 8;
+        uint8_t from = (y > top) ? (y - top) : 0;              // First row inside this page.
+        uint8_t to = (y_end < top + 8) ? (y_end - top) : 8;    // One past the last row inside this page.
+        uint8_t mask = (uint8_t)((0xFF << from) & (0xFF >> (8 - to)));
+        uint8_t *byte = &handle->buffer[x + page * handle->config.screen_width];
         switch (color)
         {
         case OLED_COLOR_WHITE:
-            handle->buffer[index] |= (1 << bit_pos);
+            *byte |= mask;
             break;
         case OLED_COLOR_BLACK:
-            handle->buffer[index] &= ~(1 << bit_pos);
+            *byte &= ~mask;
             break;
         case OLED_COLOR_INVERT:
-            handle->buffer[index] ^= (1 << bit_pos);
+            *byte ^= mask;
             break;
         }
     }
@@ -1098,7 +3717,7 @@ void ssd1306_draw_fast_vline(ssd1306_handle_t handle, int16_t x, int16_t y, int1
 void ssd1306_draw_fast_hline(ssd1306_handle_t handle, int16_t x, int16_t y, int16_t w, ssd1306_color_t color)
 {
     // Basic clipping
-    if (!handle || y < 0 || y >= handle->config.screen_height || w == 0)
+    if (!handle || y < handle->clip_y0 || y >= handle->clip_y1 || w == 0 || !_ssd1306_buffer_ready(handle))
         return;
 
     // Handle negative width
@@ -1107,15 +3726,15 @@ void ssd1306_draw_fast_hline(ssd1306_handle_t handle, int16_t x, int16_t y, int1
         x += w;
         w = -w;
     }
-    if (x >= handle->config.screen_width)
-        return;
 
     // Clip left and right boundaries
     int16_t x_end = x + w;
-    if (x_end > handle->config.screen_width)
-        x_end = handle->config.screen_width;
-    if (x < 0)
-        x = 0;
+    if (x_end > handle->clip_x1)
+        x_end = handle->clip_x1;
+    if (x < handle->clip_x0)
+        x = handle->clip_x0;
+    if (x >= x_end)
+        return;
 
     // Mark the entire line area as dirty once
     _ssd1306_mark_dirty(handle, x, y, x_end - x, 1);
@@ -1185,17 +3804,19 @@ void ssd1306_fill_rect(ssd1306_handle_t handle, int16_t x, int16_t y, int16_t w,
         return;
 
     // Clipping
-    if (x >= handle->config.screen_width || y >= handle->config.screen_height)
-        return;
-    if (x + w < 0 || y + h < 0)
-        return;
-
     int16_t x_end = x + w;
-
-    if (x < 0)
-        x = 0;
-    if (x_end > handle->config.screen_width)
-        x_end = handle->config.screen_width;
+    int16_t y_end = y + h;
+    if (x < handle->clip_x0)
+        x = handle->clip_x0;
+    if (x_end > handle->clip_x1)
+        x_end = handle->clip_x1;
+    if (y < handle->clip_y0)
+        y = handle->clip_y0;
+    if (y_end > handle->clip_y1)
+        y_end = handle->clip_y1;
+    if (x >= x_end || y >= y_end)
+        return;
+    h = y_end - y;
 
     // Mark the entire dirty area once for efficiency.
     _ssd1306_mark_dirty(handle, x, y, x_end - x, h);
@@ -1221,6 +3842,10 @@ void ssd1306_draw_circle(ssd1306_handle_t handle, int16_t x0, int16_t y0, int16_
 {
     if (!handle)
         return;
+    ssd1306_rcache_capture_t cap;
+    ssd1306_rcache_key_t key = {.kind = SSD1306_RCACHE_CIRCLE, .p = {r}};
+    if (_ssd1306_rcache_begin(handle, &cap, &key, NULL, x0 - r, y0 - r, 2 * r + 1, 2 * r + 1, &color))
+        return;
     int16_t f = 1 - r;
     int16_t ddF_x = 1, ddF_y = -2 * r, x = 0, y = r;
     // Draw the 4 cardinal points.
@@ -1249,6 +3874,7 @@ void ssd1306_draw_circle(ssd1306_handle_t handle, int16_t x0, int16_t y0, int16_
         ssd1306_draw_pixel(handle, x0 + y, y0 - x, color);
         ssd1306_draw_pixel(handle, x0 - y, y0 - x, color);
     }
+    _ssd1306_rcache_end(handle, &cap);
 }
 
 /**
@@ -1264,10 +3890,15 @@ void ssd1306_fill_circle(ssd1306_handle_t handle, int16_t x0, int16_t y0, int16_
 {
     if (!handle)
         return;
+    ssd1306_rcache_capture_t cap;
+    ssd1306_rcache_key_t key = {.kind = SSD1306_RCACHE_FILL_CIRCLE, .p = {r}};
+    if (_ssd1306_rcache_begin(handle, &cap, &key, NULL, x0 - r, y0 - r, 2 * r + 1, 2 * r + 1, &color))
+        return;
     // Start by drawing a vertical line at the center.
     ssd1306_draw_fast_vline(handle, x0, y0 - r, 2 * r + 1, color);
     // Use the helper to fill the remaining quadrants.
     _ssd1306_fill_circle_helper(handle, x0, y0, r, 3, 0, color);
+    _ssd1306_rcache_end(handle, &cap);
 }
 
 /**
@@ -1366,6 +3997,10 @@ void ssd1306_draw_round_rect(ssd1306_handle_t handle, int16_t x, int16_t y, int1
     int16_t max_radius = ((w < h) ? w : h) / 2;
     if (r > max_radius)
         r = max_radius;
+    ssd1306_rcache_capture_t cap;
+    ssd1306_rcache_key_t key = {.kind = SSD1306_RCACHE_ROUND_RECT, .p = {w, h, r}};
+    if (_ssd1306_rcache_begin(handle, &cap, &key, NULL, x, y, w, h, &color))
+        return;
     // Draw the straight sides.
     ssd1306_draw_fast_hline(handle, x + r, y, w - 2 * r, color);         // Top
     ssd1306_draw_fast_hline(handle, x + r, y + h - 1, w - 2 * r, color); // Bottom
@@ -1376,6 +4011,7 @@ void ssd1306_draw_round_rect(ssd1306_handle_t handle, int16_t x, int16_t y, int1
     _ssd1306_draw_circle_helper(handle, x + w - r - 1, y + r, r, 2, color);
     _ssd1306_draw_circle_helper(handle, x + w - r - 1, y + h - r - 1, r, 4, color);
     _ssd1306_draw_circle_helper(handle, x + r, y + h - r - 1, r, 8, color);
+    _ssd1306_rcache_end(handle, &cap);
 }
 
 /**
@@ -1397,11 +4033,16 @@ void ssd1306_fill_round_rect(ssd1306_handle_t handle, int16_t x, int16_t y, int1
     int16_t max_radius = ((w < h) ? w : h) / 2;
     if (r > max_radius)
         r = max_radius;
+    ssd1306_rcache_capture_t cap;
+    ssd1306_rcache_key_t key = {.kind = SSD1306_RCACHE_FILL_ROUND, .p = {w, h, r}};
+    if (_ssd1306_rcache_begin(handle, &cap, &key, NULL, x, y, w, h, &color))
+        return;
     // Fill the center part (rectangle).
     ssd1306_fill_rect(handle, x + r, y, w - 2 * r, h, color);
     // Fill the corner parts using the circle helper.
     _ssd1306_fill_circle_helper(handle, x + w - r - 1, y + r, r, 1, h - 2 * r - 1, color);
     _ssd1306_fill_circle_helper(handle, x + r, y + r, r, 2, h - 2 * r - 1, color);
+    _ssd1306_rcache_end(handle, &cap);
 }
 
 
@@ -1438,11 +4079,11 @@ void ssd1306_draw_bitmap(ssd1306_handle_t handle, int16_t x, int16_t y, const ui
  */
 void ssd1306_draw_bitmap_bg(ssd1306_handle_t handle, int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, ssd1306_color_t color, ssd1306_color_t bg_color)
 {
-    if (!handle || !bitmap)
+    if (!handle || !bitmap || !_ssd1306_buffer_ready(handle))
         return;
 
-    // Stop if the bitmap is completely off-screen.
-    if (x >= handle->config.screen_width || y >= handle->config.screen_height || (x + w) <= 0 || (y + h) <= 0)
+    // Stop if the bitmap is completely outside the clip rectangle.
+    if (x >= handle->clip_x1 || y >= handle->clip_y1 || (x + w) <= handle->clip_x0 || (y + h) <= handle->clip_y0)
     {
         return;
     }
@@ -1458,18 +4099,14 @@ void ssd1306_draw_bitmap_bg(ssd1306_handle_t handle, int16_t x, int16_t y, const
     for (int16_t j = 0; j < h; j++)
     {
         int16_t current_y = y + j;
-        // Skip rows that are off-screen.
-        if (current_y < 0 || current_y >= handle->config.screen_height)
+        // Skip rows that are outside the clip rectangle.
+        if (current_y < handle->clip_y0 || current_y >= handle->clip_y1)
             continue;
 
         for (int16_t i = 0; i < w; i++)
         {
-            int16_t current_x = x + i;
-            // Skip columns that are off-screen.
-            if (current_x < 0 || current_x >= handle->config.screen_width)
-                continue;
-
-            // Read a new byte from bitmap data every 8 pixels.
+            // Read a new byte from bitmap data every 8 pixels. This happens before the
+            // clip test so that skipped columns still consume their bits.
             if (i & 7)
             {
                 byte <<= 1;
@@ -1479,6 +4116,11 @@ void ssd1306_draw_bitmap_bg(ssd1306_handle_t handle, int16_t x, int16_t y, const
                 byte = bitmap[j * byte_width + i / 8];
             }
 
+            int16_t current_x = x + i;
+            // Skip columns that are outside the clip rectangle.
+            if (current_x < handle->clip_x0 || current_x >= handle->clip_x1)
+                continue;
+
             // Determine the color for the current pixel.
             ssd1306_color_t pixel_color = (byte & 0x80) ? color : bg_color;
 
@@ -1507,89 +4149,393 @@ void ssd1306_draw_bitmap_bg(ssd1306_handle_t handle, int16_t x, int16_t y, const
 
 
 /**
- * @brief Draws an XBM (X BitMap) format bitmap.
+ * @brief Draws an XBM (X BitMap) format bitmap.
+ *
+ * @param handle SSD1306 device handle.
+ * @param x Top-left x-coordinate.
+ * @param y Top-left y-coordinate.
+ * @param bitmap XBM data array.
+ * @param w Bitmap width.
+ * @param h Bitmap height.
+ * @param color Foreground color.
+ */
+void ssd1306_draw_xbitmap(ssd1306_handle_t handle, int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, ssd1306_color_t color)
+{
+    if (!handle || !bitmap)
+        return;
+    int16_t byteWidth = (w + 7) / 8, byte = 0;
+    for (int16_t j = 0; j < h; j++, y++)
+    {
+        for (int16_t i = 0; i < w; i++)
+        {
+            if (i & 7)
+                byte >>= 1; // Shift for the next bit (LSB-first format).
+            else
+                byte = bitmap[j * byteWidth + i / 8]; // Read a new byte.
+            // If the bit is 1, draw the pixel.
+            if (byte & 0x01)
+                ssd1306_draw_pixel(handle, x + i, y, color);
+        }
+    }
+}
+
+/**
+ * @brief Draws a frame of a page-format asset with the page blitter.
+ *
+ * @param handle SSD1306 device handle.
+ * @param x Top-left x-coordinate.
+ * @param y Top-left y-coordinate.
+ * @param asset Asset.
+ * @param frame Frame index.
+ * @param color Color for set pixels.
+ * @param bg_color Color for clear pixels (same as `color` for transparent).
+ * @return esp_err_t ESP_OK on success, or an error code.
+ */
+esp_err_t ssd1306_draw_asset(ssd1306_handle_t handle, int16_t x, int16_t y, const ssd1306_asset_t *asset, uint16_t frame,
+                             ssd1306_color_t color, ssd1306_color_t bg_color)
+{
+    ESP_RETURN_ON_FALSE(handle && asset && asset->data && asset->offsets && frame < asset->frames, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(!handle->config.no_framebuffer, ESP_ERR_NOT_SUPPORTED, TAG, "No framebuffer to draw into");
+    ESP_RETURN_ON_FALSE(_ssd1306_buffer_ready(handle), ESP_ERR_NO_MEM, TAG, "Framebuffer unavailable");
+    const uint8_t *src = &asset->data[asset->offsets[frame]];
+    if (!asset->rle)
+    {
+        _ssd1306_blit_pages(handle, src, asset->width, asset->height, x, y, color, bg_color);
+        return ESP_OK;
+    }
+
+    // Small frames expand on the stack; larger ones get a temporary buffer.
+    size_t len = (size_t)asset->width * ((asset->height + 7) / 8);
+    uint8_t scratch[SSD1306_GLYPH_SCRATCH];
+    uint8_t *raw = (len <= sizeof(scratch)) ? scratch : _ssd1306_mem_alloc(handle, len);
+    ESP_RETURN_ON_FALSE(raw, ESP_ERR_NO_MEM, TAG, "No memory for the frame");
+    bool ok = _ssd1306_rle_decode(src, asset->offsets[frame + 1] - asset->offsets[frame], raw, len);
+    if (ok)
+        _ssd1306_blit_pages(handle, raw, asset->width, asset->height, x, y, color, bg_color);
+    if (raw != scratch)
+        _ssd1306_mem_free(handle, raw);
+    ESP_RETURN_ON_FALSE(ok, ESP_ERR_INVALID_SIZE, TAG, "Corrupt frame");
+    return ESP_OK;
+}
+
+/**
+ * @brief Inverts the display colors (black becomes white and vice-versa).
+ * This is a hardware operation.
+ *
+ * @param handle SSD1306 device handle.
+ * @param invert true to invert, false to restore to normal.
+ */
+void ssd1306_invert_display(ssd1306_handle_t handle, bool invert)
+{
+    if (!handle)
+        return;
+    uint8_t cmd = invert ? OLED_CMD_INVERTDISPLAY : OLED_CMD_DISPLAY_NORMAL;
+    if (handle->defer_cmds)
+    {
+        handle->pending_invert_cmd = cmd;
+        handle->pending_cmds |= SSD1306_PENDING_INVERT;
+        return;
+    }
+    esp_err_t ret = _ssd1306_send_cmd_list(handle, &cmd, 1);
+    if (ret == ESP_OK)
+        handle->shadow_invert_cmd = cmd;
+    _ssd1306_report_cmd_error(handle, ret);
+}
+
+/**
+ * @brief Sets the display contrast.
+ *
+ * @param handle SSD1306 device handle.
+ * @param contrast Contrast value (0-255).
+ */
+void ssd1306_set_contrast(ssd1306_handle_t handle, uint8_t contrast)
+{
+    if (!handle)
+        return;
+    if (handle->defer_cmds)
+    {
+        handle->pending_contrast = contrast;
+        handle->pending_cmds |= SSD1306_PENDING_CONTRAST;
+        return;
+    }
+    esp_err_t ret = _ssd1306_send_cmd_list(handle, (uint8_t[]){OLED_CMD_SET_CONTRAST, contrast}, 2);
+    if (ret == ESP_OK)
+        handle->shadow_contrast = contrast;
+    _ssd1306_report_cmd_error(handle, ret);
+}
+
+/**
+ * @brief Stops any active hardware scrolling effect.
+ * Stopping is never delayed; a scroll start that is still waiting for its settle
+ * time is cancelled.
+ *
+ * @param handle SSD1306 device handle.
+ */
+void ssd1306_stop_scroll(ssd1306_handle_t handle)
+{
+    if (!handle)
+        return;
+    // A queued scroll that never started is simply dropped.
+    handle->pending_cmds &= ~SSD1306_PENDING_SCROLL;
+    if (handle->defer_cmds)
+    {
+        handle->pending_cmds |= SSD1306_PENDING_STOP_SCROLL;
+        return;
+    }
+    esp_err_t ret = _ssd1306_send_cmd_list(handle, (uint8_t[]){OLED_CMD_DEACTIVATE_SCROLL}, 1);
+    if (ret == ESP_OK)
+        _ssd1306_commit_pending_cmds(handle, SSD1306_PENDING_STOP_SCROLL);
+    _ssd1306_report_cmd_error(handle, ret);
+}
+
+/**
+ * @brief Queues a scroll setup sequence.
+ * The previous scroll is stopped first, and the activation is appended after the
+ * framebuffer data when the queue is sent.
+ *
+ * @param handle SSD1306 device handle.
+ * @param cmds Scroll setup commands (without activation).
+ * @param size Number of command bytes.
+ */
+static void _ssd1306_queue_scroll(ssd1306_handle_t handle, const uint8_t *cmds, size_t size)
+{
+    memcpy(handle->pending_scroll, cmds, size);
+    handle->pending_scroll_len = size;
+    handle->pending_cmds |= SSD1306_PENDING_STOP_SCROLL | SSD1306_PENDING_SCROLL;
+}
+
+/**
+ * @brief Builds the scroll setup command sequence for a configuration.
+ *
+ * @param handle SSD1306 device handle.
+ * @param cfg Scroll configuration (already validated).
+ * @param out Output buffer (at least SSD1306_SCROLL_CMDS_MAX bytes).
+ * @return size_t Number of command bytes written.
+ */
+static size_t _ssd1306_build_scroll_cmds(ssd1306_handle_t handle, const ssd1306_scroll_config_t *cfg, uint8_t *out)
+{
+    size_t n = 0;
+    switch (cfg->direction)
+    {
+    case SSD1306_SCROLL_RIGHT:
+    case SSD1306_SCROLL_LEFT:
+        out[n++] = (cfg->direction == SSD1306_SCROLL_RIGHT) ? OLED_CMD_RIGHT_HORIZONTAL_SCROLL : OLED_CMD_LEFT_HORIZONTAL_SCROLL;
+        out[n++] = 0x00;
+        out[n++] = cfg->start_page;
+        out[n++] = cfg->speed;
+        out[n++] = cfg->end_page;
+        // Full width uses the classic dummy bytes (00h/FFh), which controllers without
+        // column range support expect. Narrower ranges send the real column bounds.
+        if (cfg->start_col == 0 && cfg->end_col >= handle->config.screen_width - 1)
+        {
+            out[n++] = 0x00;
+            out[n++] = 0xFF;
+        }
+        else
+        {
+            out[n++] = cfg->start_col;
+            out[n++] = cfg->end_col;
+        }
+        break;
+    case SSD1306_SCROLL_VERTICAL_RIGHT:
+    case SSD1306_SCROLL_VERTICAL_LEFT:
+        // Set the vertical scroll area to encompass the whole screen.
+        out[n++] = OLED_CMD_SET_VERTICAL_SCROLL_AREA;
+        out[n++] = 0;                            // Number of fixed rows at the top
+        out[n++] = handle->config.screen_height; // Number of rows to scroll
+        out[n++] = (cfg->direction == SSD1306_SCROLL_VERTICAL_RIGHT) ? OLED_CMD_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL : OLED_CMD_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL;
+        out[n++] = 0x00;
+        out[n++] = cfg->start_page;
+        out[n++] = cfg->speed;
+        out[n++] = cfg->end_page;
+        out[n++] = cfg->vertical_offset;
+        break;
+    }
+    return n;
+}
+
+/**
+ * @brief Starts a hardware scroll without blocking.
+ * Stop, setup and activation are sent as one command batch. If the previous scroll
+ * change is younger than the settle time, the stop goes out at once and the setup and
+ * activation are parked until `ssd1306_scroll_poll` or `ssd1306_update_screen`.
+ *
+ * @param handle SSD1306 device handle.
+ * @param cfg Scroll configuration.
+ * @return esp_err_t ESP_OK if sent or queued, ESP_ERR_NOT_FINISHED if parked.
+ */
+esp_err_t ssd1306_scroll_start(ssd1306_handle_t handle, const ssd1306_scroll_config_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(handle && cfg, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(!handle->config.no_framebuffer, ESP_ERR_NOT_SUPPORTED, TAG, "Hardware scroll needs a framebuffer");
+    ESP_RETURN_ON_FALSE(handle->panel_count == 1, ESP_ERR_NOT_SUPPORTED, TAG, "Hardware scroll is not supported on tiled displays");
+    ESP_RETURN_ON_FALSE(_ssd1306_buffer_ready(handle), ESP_ERR_NO_MEM, TAG, "Framebuffer unavailable");
+    ESP_RETURN_ON_FALSE(cfg->direction <= SSD1306_SCROLL_VERTICAL_LEFT, ESP_ERR_INVALID_ARG, TAG, "Invalid scroll direction");
+    ESP_RETURN_ON_FALSE(cfg->start_page <= cfg->end_page && cfg->end_page < handle->config.screen_height / 8, ESP_ERR_INVALID_ARG, TAG, "Invalid page range");
+    ESP_RETURN_ON_FALSE(cfg->start_col <= cfg->end_col && cfg->end_col < handle->config.screen_width, ESP_ERR_INVALID_ARG, TAG, "Invalid column range");
+    ESP_RETURN_ON_FALSE(cfg->speed <= SSD1306_SCROLL_FRAMES_2, ESP_ERR_INVALID_ARG, TAG, "Invalid scroll speed");
+    if (cfg->direction >= SSD1306_SCROLL_VERTICAL_RIGHT)
+    {
+        ESP_RETURN_ON_FALSE(cfg->vertical_offset > 0 && cfg->vertical_offset < handle->config.screen_height, ESP_ERR_INVALID_ARG, TAG, "Invalid vertical offset");
+    }
+
+    uint8_t cmds[SSD1306_SCROLL_CMDS_MAX];
+    _ssd1306_queue_scroll(handle, cmds, _ssd1306_build_scroll_cmds(handle, cfg, cmds));
+    handle->scroll_cfg = *cfg;
+    handle->scroll_state = SSD1306_SCROLL_STATE_PENDING;
+
+    // In deferred mode the batch waits for the next flush anyway.
+    if (handle->defer_cmds)
+        return ESP_OK;
+    return ssd1306_scroll_poll(handle);
+}
+
+/**
+ * @brief Sends a parked scroll start once the settle time has elapsed.
+ * A queued stop is never held back: it is sent right away so the previous run ends
+ * even while the new setup is still waiting.
  *
  * @param handle SSD1306 device handle.
- * @param x Top-left x-coordinate.
- * @param y Top-left y-coordinate.
- * @param bitmap XBM data array.
- * @param w Bitmap width.
- * @param h Bitmap height.
- * @param color Foreground color.
+ * @return esp_err_t ESP_OK if nothing is parked or it was sent, ESP_ERR_NOT_FINISHED
+ *         if the settle time has not elapsed yet.
  */
-void ssd1306_draw_xbitmap(ssd1306_handle_t handle, int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, ssd1306_color_t color)
+esp_err_t ssd1306_scroll_poll(ssd1306_handle_t handle)
 {
-    if (!handle || !bitmap)
-        return;
-    int16_t byteWidth = (w + 7) / 8, byte = 0;
-    for (int16_t j = 0; j < h; j++, y++)
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    if (!(handle->pending_cmds & SSD1306_PENDING_SCROLL))
+        return ESP_OK;
+    // The builder holds back an unsettled setup and sends everything else.
+    ESP_RETURN_ON_ERROR(_ssd1306_send_pending_cmds(handle), TAG, "Failed to send scroll commands");
+    return (handle->pending_cmds & SSD1306_PENDING_SCROLL) ? ESP_ERR_NOT_FINISHED : ESP_OK;
+}
+
+/**
+ * @brief Starts a scroll for the void legacy wrappers.
+ * These cannot report a parked start, so in immediate mode they wait out the rest of
+ * the settle time instead of leaving the start to a poll the caller never makes.
+ *
+ * @param handle SSD1306 device handle.
+ * @param cfg Scroll configuration.
+ */
+static void _ssd1306_scroll_start_wait(ssd1306_handle_t handle, const ssd1306_scroll_config_t *cfg)
+{
+    esp_err_t ret = ssd1306_scroll_start(handle, cfg);
+    while (ret == ESP_ERR_NOT_FINISHED)
     {
-        for (int16_t i = 0; i < w; i++)
-        {
-            if (i & 7)
-                byte >>= 1; // Shift for the next bit (LSB-first format).
-            else
-                byte = bitmap[j * byteWidth + i / 8]; // Read a new byte.
-            // If the bit is 1, draw the pixel.
-            if (byte & 0x01)
-                ssd1306_draw_pixel(handle, x + i, y, color);
-        }
+        vTaskDelay(1);
+        ret = ssd1306_scroll_poll(handle);
     }
+    _ssd1306_report_cmd_error(handle, ret);
 }
 
 /**
- * @brief Inverts the display colors (black becomes white and vice-versa).
- * This is a hardware operation.
+ * @brief Gets the current hardware scroll state and configuration.
  *
  * @param handle SSD1306 device handle.
- * @param invert true to invert, false to restore to normal.
+ * @param cfg Pointer to store the last requested configuration (may be NULL).
+ * @return ssd1306_scroll_state_t Current scroll state.
  */
-void ssd1306_invert_display(ssd1306_handle_t handle, bool invert)
+ssd1306_scroll_state_t ssd1306_scroll_get_state(ssd1306_handle_t handle, ssd1306_scroll_config_t *cfg)
 {
-    _ssd1306_send_cmd_list(handle, (uint8_t[]){invert ? OLED_CMD_INVERTDISPLAY : OLED_CMD_DISPLAY_NORMAL}, 1);
+    if (!handle)
+        return SSD1306_SCROLL_STATE_STOPPED;
+    if (cfg)
+        *cfg = handle->scroll_cfg;
+    return handle->scroll_state;
 }
 
 /**
- * @brief Sets the display contrast.
+ * @brief Corrects the framebuffer after a scroll run with an exact step count.
+ * The estimated rotation applied at stop time is replaced by `steps`.
  *
  * @param handle SSD1306 device handle.
- * @param contrast Contrast value (0-255).
+ * @param steps Number of scroll steps the controller actually performed.
+ * @return esp_err_t Operation status.
  */
-void ssd1306_set_contrast(ssd1306_handle_t handle, uint8_t contrast)
+esp_err_t ssd1306_scroll_resync(ssd1306_handle_t handle, uint32_t steps)
 {
-    _ssd1306_send_cmd_list(handle, (uint8_t[]){OLED_CMD_SET_CONTRAST, contrast}, 2);
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(!handle->config.no_framebuffer, ESP_ERR_NOT_SUPPORTED, TAG, "No framebuffer to resync");
+    ESP_RETURN_ON_FALSE(handle->scroll_run_valid, ESP_ERR_INVALID_STATE, TAG, "No finished scroll run to resync");
+    ESP_RETURN_ON_FALSE(_ssd1306_buffer_ready(handle), ESP_ERR_NO_MEM, TAG, "Framebuffer unavailable");
+    _ssd1306_scroll_apply_steps(handle, &handle->scroll_run_cfg, (int32_t)steps - (int32_t)handle->scroll_run_steps);
+    handle->scroll_run_steps = steps;
+    return ESP_OK;
 }
 
 /**
- * @brief Stops any active hardware scrolling effect.
+ * @brief Gets the number of steps applied to the framebuffer for the last scroll run.
  *
  * @param handle SSD1306 device handle.
+ * @return uint32_t Step count (estimated, or the value given to `ssd1306_scroll_resync`).
  */
-void ssd1306_stop_scroll(ssd1306_handle_t handle)
+uint32_t ssd1306_scroll_get_elapsed_steps(ssd1306_handle_t handle)
 {
-    if (handle)
-        _ssd1306_send_cmd_list(handle, (uint8_t[]){OLED_CMD_DEACTIVATE_SCROLL}, 1);
+    return (handle && handle->scroll_run_valid) ? handle->scroll_run_steps : 0;
 }
 
 /**
- * @brief Internal helper to start a hardware scrolling effect.
+ * @brief Sets the panel frame period used to estimate scroll steps.
  *
  * @param handle SSD1306 device handle.
- * @param scroll_cmd Scroll command (right or left).
+ * @param frame_period_us Frame period in microseconds.
+ */
+void ssd1306_scroll_set_frame_period(ssd1306_handle_t handle, uint32_t frame_period_us)
+{
+    if (!handle || frame_period_us == 0)
+        return;
+    handle->frame_period_us = frame_period_us;
+}
+
+/**
+ * @brief Gets the duration of one hardware scroll step.
+ *
+ * @param handle SSD1306 device handle.
+ * @param speed Scroll speed.
+ * @return uint32_t Step duration in microseconds, or 0 for invalid arguments.
+ */
+uint32_t ssd1306_scroll_get_step_period(ssd1306_handle_t handle, ssd1306_scroll_speed_t speed)
+{
+    if (!handle || speed > SSD1306_SCROLL_FRAMES_2)
+        return 0;
+    return (uint32_t)_ssd1306_scroll_step_us(handle, speed);
+}
+
+/**
+ * @brief Gets the horizontal scroll direction that moves content left or right on screen.
+ * The controller directions refer to GDDRAM columns, which the segment remap mirrors.
+ *
+ * @param handle SSD1306 device handle.
+ * @param left True for content moving towards x = 0.
+ * @return ssd1306_scroll_dir_t Scroll direction to use.
+ */
+ssd1306_scroll_dir_t ssd1306_scroll_get_screen_dir(ssd1306_handle_t handle, bool left)
+{
+    bool remap = !handle || handle->seg_remap;
+    return (left == remap) ? SSD1306_SCROLL_LEFT : SSD1306_SCROLL_RIGHT;
+}
+
+/**
+ * @brief Internal helper to start a full-width horizontal scroll.
+ *
+ * @param handle SSD1306 device handle.
+ * @param direction Scroll direction (right or left).
  * @param start_page Starting page for scrolling (0-7).
  * @param end_page Ending page for scrolling (0-7).
  */
-static void _ssd1306_start_scroll(ssd1306_handle_t handle, uint8_t scroll_cmd, uint8_t start_page, uint8_t end_page)
+static void _ssd1306_start_scroll(ssd1306_handle_t handle, ssd1306_scroll_dir_t direction, uint8_t start_page, uint8_t end_page)
 {
     if (!handle || start_page > 7 || end_page > 7 || start_page > end_page)
         return;
-    ssd1306_stop_scroll(handle); // Stop any previous scroll.
-    vTaskDelay(pdMS_TO_TICKS(10)); // Short delay.
-    // Send scroll setup command.
-    uint8_t cmds[] = {scroll_cmd, 0x00, start_page, 0x00, end_page, 0x00, 0xFF};
-    _ssd1306_send_cmd_list(handle, cmds, sizeof(cmds));
-    // Activate scroll.
-    _ssd1306_send_cmd_list(handle, (uint8_t[]){OLED_CMD_ACTIVATE_SCROLL}, 1);
+    ssd1306_scroll_config_t cfg = {
+        .direction = direction,
+        .start_page = start_page,
+        .end_page = end_page,
+        .start_col = 0,
+        .end_col = handle->config.screen_width - 1,
+        .speed = SSD1306_SCROLL_FRAMES_5,
+    };
+    _ssd1306_scroll_start_wait(handle, &cfg);
 }
 
 /**
@@ -1601,7 +4547,7 @@ static void _ssd1306_start_scroll(ssd1306_handle_t handle, uint8_t scroll_cmd, u
  */
 void ssd1306_start_scroll_right(ssd1306_handle_t handle, uint8_t start_page, uint8_t end_page)
 {
-    _ssd1306_start_scroll(handle, OLED_CMD_RIGHT_HORIZONTAL_SCROLL, start_page, end_page);
+    _ssd1306_start_scroll(handle, SSD1306_SCROLL_RIGHT, start_page, end_page);
 }
 
 /**
@@ -1613,7 +4559,7 @@ void ssd1306_start_scroll_right(ssd1306_handle_t handle, uint8_t start_page, uin
  */
 void ssd1306_start_scroll_left(ssd1306_handle_t handle, uint8_t start_page, uint8_t end_page)
 {
-    _ssd1306_start_scroll(handle, OLED_CMD_LEFT_HORIZONTAL_SCROLL, start_page, end_page);
+    _ssd1306_start_scroll(handle, SSD1306_SCROLL_LEFT, start_page, end_page);
 }
 
 /**
@@ -1624,7 +4570,11 @@ void ssd1306_start_scroll_left(ssd1306_handle_t handle, uint8_t start_page, uint
  */
 esp_err_t ssd1306_display_on(ssd1306_handle_t handle)
 {
-    return _ssd1306_send_cmd_list(handle, (uint8_t[]){OLED_CMD_DISPLAY_ON}, 1);
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    esp_err_t ret = _ssd1306_send_cmd_list(handle, (uint8_t[]){OLED_CMD_DISPLAY_ON}, 1);
+    if (ret == ESP_OK)
+        handle->shadow_display_on = true;
+    return ret;
 }
 
 /**
@@ -1635,48 +4585,40 @@ esp_err_t ssd1306_display_on(ssd1306_handle_t handle)
  */
 esp_err_t ssd1306_display_off(ssd1306_handle_t handle)
 {
-    return _ssd1306_send_cmd_list(handle, (uint8_t[]){OLED_CMD_DISPLAY_OFF}, 1);
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    esp_err_t ret = _ssd1306_send_cmd_list(handle, (uint8_t[]){OLED_CMD_DISPLAY_OFF}, 1);
+    if (ret == ESP_OK)
+    {
+        handle->shadow_display_on = false;
+        _ssd1306_suspend_buffer(handle);
+    }
+    return ret;
 }
 
 /**
  * @brief Internal helper to configure and start diagonal hardware scrolling.
  *
  * @param handle SSD1306 device handle.
- * @param scroll_cmd Scroll command (0x29 for right, 0x2A for left).
+ * @param direction Scroll direction (vertical and right, or vertical and left).
  * @param start_page Starting page for scrolling (0-7).
  * @param end_page Ending page for scrolling (0-7).
  * @param offset Number of vertical lines to scroll per step (1-63).
- * @param speed Horizontal scroll speed (0-7, 0 is fastest).
+ * @param speed Scroll step interval (see ssd1306_scroll_speed_t).
  */
-static void _ssd1306_start_diag_scroll(ssd1306_handle_t handle, uint8_t scroll_cmd, uint8_t start_page, uint8_t end_page, uint8_t offset, uint8_t speed)
+static void _ssd1306_start_diag_scroll(ssd1306_handle_t handle, ssd1306_scroll_dir_t direction, uint8_t start_page, uint8_t end_page, uint8_t offset, uint8_t speed)
 {
     if (!handle || start_page > 7 || end_page > 7 || start_page > end_page || speed > 7 || offset == 0 || offset > 63)
         return;
-
-    ssd1306_stop_scroll(handle);
-    vTaskDelay(pdMS_TO_TICKS(10));
-
-    // Set the vertical scroll area to encompass the whole screen.
-    uint8_t setup_cmds[] = {
-        OLED_CMD_SET_VERTICAL_SCROLL_AREA,
-        0, // Number of fixed rows at the top
-        handle->config.screen_height // Number of rows to scroll
+    ssd1306_scroll_config_t cfg = {
+        .direction = direction,
+        .start_page = start_page,
+        .end_page = end_page,
+        .start_col = 0,
+        .end_col = handle->config.screen_width - 1,
+        .speed = (ssd1306_scroll_speed_t)speed,
+        .vertical_offset = offset,
     };
-    _ssd1306_send_cmd_list(handle, setup_cmds, sizeof(setup_cmds));
-
-    // Send diagonal scroll setup command.
-    uint8_t scroll_cmds[] = {
-        scroll_cmd,
-        0x00,
-        start_page,
-        speed,
-        end_page,
-        offset // Vertical offset
-    };
-    _ssd1306_send_cmd_list(handle, scroll_cmds, sizeof(scroll_cmds));
-
-    // Activate scroll.
-    _ssd1306_send_cmd_list(handle, (uint8_t[]){OLED_CMD_ACTIVATE_SCROLL}, 1);
+    _ssd1306_scroll_start_wait(handle, &cfg);
 }
 
 /**
@@ -1686,11 +4628,11 @@ static void _ssd1306_start_diag_scroll(ssd1306_handle_t handle, uint8_t scroll_c
  * @param start_page Starting page for scrolling (0-7).
  * @param end_page Ending page for scrolling (0-7).
  * @param offset Number of lines to scroll downward per step (1-63).
- * @param speed Horizontal scroll speed (0-7, 0 is fastest).
+ * @param speed Scroll step interval (see ssd1306_scroll_speed_t).
  */
 void ssd1306_start_scroll_diag_right_down(ssd1306_handle_t handle, uint8_t start_page, uint8_t end_page, uint8_t offset, uint8_t speed)
 {
-    _ssd1306_start_diag_scroll(handle, OLED_CMD_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL, start_page, end_page, offset, speed);
+    _ssd1306_start_diag_scroll(handle, SSD1306_SCROLL_VERTICAL_RIGHT, start_page, end_page, offset, speed);
 }
 
 /**
@@ -1700,13 +4642,15 @@ void ssd1306_start_scroll_diag_right_down(ssd1306_handle_t handle, uint8_t start
  * @param start_page Starting page for scrolling (0-7).
  * @param end_page Ending page for scrolling (0-7).
  * @param offset Number of lines to scroll upward per step (1-63).
- * @param speed Horizontal scroll speed (0-7, 0 is fastest).
+ * @param speed Scroll step interval (see ssd1306_scroll_speed_t).
  */
 void ssd1306_start_scroll_diag_left_up(ssd1306_handle_t handle, uint8_t start_page, uint8_t end_page, uint8_t offset, uint8_t speed)
 {
+    if (!handle || offset == 0 || offset >= handle->config.screen_height)
+        return;
     // Scrolling up is implemented by providing a negative offset (relative to screen height).
     uint8_t true_offset = handle->config.screen_height - offset;
-    _ssd1306_start_diag_scroll(handle, OLED_CMD_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL, start_page, end_page, true_offset, speed);
+    _ssd1306_start_diag_scroll(handle, SSD1306_SCROLL_VERTICAL_LEFT, start_page, end_page, true_offset, speed);
 }
 
 /**
@@ -1776,7 +4720,7 @@ void ssd1306_draw_polyline(ssd1306_handle_t handle, const int16_t *x, const int1
  */
 void ssd1306_shift_framebuffer(ssd1306_handle_t handle, int16_t dx, int16_t dy, bool wrap)
 {
-    if (!handle || !handle->buffer || (dx == 0 && dy == 0))
+    if (!handle || (dx == 0 && dy == 0) || !_ssd1306_buffer_ready(handle))
     {
         return;
     }
@@ -1817,6 +4761,29 @@ void ssd1306_shift_framebuffer(ssd1306_handle_t handle, int16_t dx, int16_t dy,
         return;
     }
 
+    // --- Fast Vertical Shift Without Wrap ---
+    // A column of up to 64 pixels fits in one 64-bit word, so each column is shifted with
+    // a single shift instead of pixel by pixel.
+    if (dx == 0 && !wrap && height <= 64)
+    {
+        const int16_t pages = height / 8;
+        int16_t shift_abs = (dy > 0) ? dy : -dy;
+        for (int16_t x = 0; x < width; x++)
+        {
+            uint64_t column = 0;
+            if (shift_abs < height)
+            {
+                for (int16_t p = 0; p < pages; p++)
+                    column |= (uint64_t)handle->buffer[x + p * width] << (p * 8);
+                column = (dy > 0) ? (column << dy) : (column >> shift_abs);
+            }
+            for (int16_t p = 0; p < pages; p++)
+                handle->buffer[x + p * width] = (uint8_t)(column >> (p * 8));
+        }
+        _ssd1306_mark_dirty(handle, 0, 0, width, height);
+        return;
+    }
+
     // --- Advanced Implementation for Complex Cases (Vertical or Wrap) ---
     // For these cases, we need to process pixel by pixel.
 
@@ -1874,6 +4841,402 @@ void ssd1306_shift_framebuffer(ssd1306_handle_t handle, int16_t dx, int16_t dy,
     _ssd1306_mark_dirty(handle, 0, 0, width, height);
 }
 
+/**
+ * @brief Shifts the contents of a rectangle horizontally.
+ * Full pages are moved with memmove; partially covered pages are merged through a row mask.
+ *
+ * @param handle SSD1306 device handle.
+ * @param x Top-left x-coordinate.
+ * @param y Top-left y-coordinate.
+ * @param w Width.
+ * @param h Height.
+ * @param dx Horizontal shift (positive = right, negative = left).
+ */
+void ssd1306_shift_rect(ssd1306_handle_t handle, int16_t x, int16_t y, int16_t w, int16_t h, int16_t dx)
+{
+    if (!handle || dx == 0 || !_ssd1306_buffer_ready(handle))
+        return;
+
+    // Clip the rectangle to the screen.
+    const int16_t width = handle->config.screen_width;
+    int16_t x_end = _min((int16_t)(x + w), width);
+    int16_t y_end = _min((int16_t)(y + h), (int16_t)handle->config.screen_height);
+    x = _max(x, (int16_t)0);
+    y = _max(y, (int16_t)0);
+    if (x >= x_end || y >= y_end)
+        return;
+    w = x_end - x;
+
+    int16_t shift_abs = (dx > 0) ? dx : -dx;
+    int16_t keep = (shift_abs < w) ? w - shift_abs : 0; // Columns that stay inside the rectangle.
+    for (int16_t page = y >> 3; page <= (y_end - 1) >> 3; page++)
+    {
+        int16_t top = page * 8;
+        uint8_t from = (y > top) ? (y - top) : 0;
+        uint8_t to = (y_end < top + 8) ? (y_end - top) : 8;
+        uint8_t mask = (uint8_t)((0xFF << from) & (0xFF >> (8 - to)));
+        uint8_t *row = &handle->buffer[x + page * width];
+        uint8_t *dst = (dx > 0) ? row + shift_abs : row;
+        const uint8_t *src = (dx > 0) ? row : row + shift_abs;
+        uint8_t *vacated = (dx > 0) ? row : row + keep;
+
+        if (mask == 0xFF)
+        {
+            memmove(dst, src, keep);
+            memset(vacated, 0, w - keep);
+            continue;
+        }
+        // Copy in the direction that never reads an already overwritten byte.
+        if (dx > 0)
+        {
+            for (int16_t i = keep - 1; i >= 0; i--)
+                dst[i] = (dst[i] & ~mask) | (src[i] & mask);
+        }
+        else
+        {
+            for (int16_t i = 0; i < keep; i++)
+                dst[i] = (dst[i] & ~mask) | (src[i] & mask);
+        }
+        for (int16_t i = 0; i < w - keep; i++)
+            vacated[i] &= ~mask;
+    }
+    _ssd1306_mark_dirty(handle, x, y, w, y_end - y);
+}
+
+/**
+ * @brief Copies a run of framebuffer bytes of one page.
+ *
+ * @param handle SSD1306 device handle.
+ * @param x First column.
+ * @param page Page.
+ * @param dst Destination of `w` bytes.
+ * @param w Number of columns.
+ */
+void ssd1306_read_page(ssd1306_handle_t handle, int16_t x, uint8_t page, uint8_t *dst, int16_t w)
+{
+    if (!handle || !dst || w <= 0)
+        return;
+    memset(dst, 0, w);
+    if (!_ssd1306_buffer_ready(handle) || page >= handle->config.screen_height / 8)
+        return;
+    const int16_t width = handle->config.screen_width;
+    int16_t x0 = _max(x, (int16_t)0), x1 = _min((int16_t)(x + w), width);
+    if (x0 < x1)
+        memcpy(dst + (x0 - x), &handle->buffer[page * width + x0], x1 - x0);
+}
+
+/**
+ * @brief Writes a run of framebuffer bytes of one page through a row mask.
+ * Only the span between the first and the last changed byte is marked dirty.
+ *
+ * @param handle SSD1306 device handle.
+ * @param x First column.
+ * @param page Page.
+ * @param src Source of `w` bytes.
+ * @param w Number of columns.
+ * @param mask Rows of the page to write.
+ */
+void ssd1306_write_page(ssd1306_handle_t handle, int16_t x, uint8_t page, const uint8_t *src, int16_t w, uint8_t mask)
+{
+    if (!handle || !src || w <= 0 || mask == 0 || !_ssd1306_buffer_ready(handle) || page >= handle->config.screen_height / 8)
+        return;
+    const int16_t width = handle->config.screen_width;
+    int16_t x0 = _max(x, (int16_t)0), x1 = _min((int16_t)(x + w), width);
+    uint8_t *row = &handle->buffer[page * width];
+    int16_t first = -1, last = -1;
+    for (int16_t i = x0; i < x1; i++)
+    {
+        uint8_t b = (row[i] & ~mask) | (src[i - x] & mask);
+        if (b == row[i])
+            continue;
+        row[i] = b;
+        if (first < 0)
+            first = i;
+        last = i;
+    }
+    if (first >= 0)
+        _ssd1306_mark_dirty(handle, first, page * 8, last - first + 1, 8);
+}
+
+/**
+ * @brief Draws an encoded QR code, building each page byte from the modules it covers.
+ * Each run of `scale` columns shares one module column, so the byte is computed once
+ * per run and stored with a row mask.
+ *
+ * @param handle SSD1306 device handle.
+ * @param x Left edge of the quiet zone.
+ * @param y Top edge of the quiet zone.
+ * @param qr Encoded code.
+ * @param scale Pixels per module.
+ * @param quiet Quiet zone width in modules.
+ * @return esp_err_t ESP_OK on success, or an error code.
+ */
+esp_err_t ssd1306_draw_qr(ssd1306_handle_t handle, int16_t x, int16_t y, ssd1306_qr_t *qr, uint8_t scale, uint8_t quiet)
+{
+    ESP_RETURN_ON_FALSE(handle && qr && qr->size && scale > 0, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(!handle->config.no_framebuffer, ESP_ERR_NOT_SUPPORTED, TAG, "No framebuffer to draw into");
+    ESP_RETURN_ON_FALSE(_ssd1306_buffer_ready(handle), ESP_ERR_NO_MEM, TAG, "Framebuffer unavailable");
+    int64_t t0 = esp_timer_get_time();
+
+    // Clip the code (quiet zone included) to the clip rectangle.
+    int16_t side = ssd1306_qr_get_pixel_size(qr, scale, quiet);
+    int16_t x0 = _max(x, handle->clip_x0), x1 = _min((int16_t)(x + side), handle->clip_x1);
+    int16_t y0 = _max(y, handle->clip_y0), y1 = _min((int16_t)(y + side), handle->clip_y1);
+    if (x0 >= x1 || y0 >= y1)
+    {
+        qr->render_us = (uint32_t)(esp_timer_get_time() - t0);
+        return ESP_OK;
+    }
+
+    const int16_t width = handle->config.screen_width;
+    const int16_t origin = quiet * scale; // Offset of module 0 from the edge of the quiet zone.
+    for (int16_t page = y0 >> 3; page <= (y1 - 1) >> 3; page++)
+    {
+        int16_t top = page * 8;
+        uint8_t from = (y0 > top) ? (y0 - top) : 0;
+        uint8_t to = (y1 < top + 8) ? (y1 - top) : 8;
+        uint8_t mask = (uint8_t)((0xFF << from) & (0xFF >> (8 - to)));
+
+        // Module row of each pixel row in this page (-1 in the quiet zone).
+        int16_t row[8];
+        for (uint8_t b = 0; b < 8; b++)
+        {
+            int16_t r = top + b - y - origin;
+            row[b] = (r >= 0 && r / scale < qr->size) ? r / scale : -1;
+        }
+
+        uint8_t *dst = &handle->buffer[page * width];
+        for (int16_t col = x0; col < x1;)
+        {
+            int16_t c = col - x - origin;
+            int16_t module = (c >= 0 && c / scale < qr->size) ? c / scale : -1;
+            int16_t run_end = (c < 0) ? col - c : (module < 0 ? x1 : col + scale - c % scale);
+            run_end = _min(run_end, x1);
+
+            // Light modules are lit pixels, so readers see dark modules on a light field.
+            uint8_t bits = mask;
+            for (uint8_t b = from; module >= 0 && b < to; b++)
+            {
+                if (row[b] < 0)
+                    continue;
+                uint16_t i = row[b] * qr->size + module;
+                if ((qr->modules[i >> 3] >> (i & 7)) & 1)
+                    bits &= ~(1 << b);
+            }
+            for (; col < run_end; col++)
+                dst[col] = (dst[col] & ~mask) | bits;
+        }
+    }
+    _ssd1306_mark_dirty(handle, x0, y0, x1 - x0, y1 - y0);
+    qr->render_us = (uint32_t)(esp_timer_get_time() - t0);
+    return ESP_OK;
+}
+
+/**
+ * @brief Reverses the bit order of a byte.
+ *
+ * @param b Byte.
+ * @return uint8_t Reversed byte.
+ */
+static uint8_t _ssd1306_rev8(uint8_t b)
+{
+    b = (uint8_t)((b & 0xF0) >> 4 | (b & 0x0F) << 4);
+    b = (uint8_t)((b & 0xCC) >> 2 | (b & 0x33) << 2);
+    return (uint8_t)((b & 0xAA) >> 1 | (b & 0x55) << 1);
+}
+
+/**
+ * @brief Reads 8 pixels of a GFX glyph row, most significant bit first.
+ * Columns outside the glyph read as 0.
+ *
+ * @param bitmap Glyph bitmap (rows packed back to back).
+ * @param gw Glyph width.
+ * @param row Glyph row.
+ * @param col Glyph column of the most significant bit (may be negative).
+ * @return uint8_t Pixels `col` to `col + 7`.
+ */
+static uint8_t _ssd1306_glyph_bits(const uint8_t *bitmap, uint8_t gw, uint8_t row, int16_t col)
+{
+    int16_t c0 = _max(col, (int16_t)0), c1 = _min((int16_t)(col + 8), (int16_t)gw);
+    if (c0 >= c1)
+        return 0;
+    uint32_t pos = (uint32_t)row * gw + c0;
+    uint8_t n = c1 - c0, shift = pos & 7;
+    // The second byte is read only when the run crosses into it, never past the bitmap.
+    uint16_t win = (uint16_t)(bitmap[pos >> 3] << 8);
+    if (shift + n > 8)
+        win |= bitmap[(pos >> 3) + 1];
+    uint8_t bits = (uint8_t)(((win << shift) >> 8) & (0xFF << (8 - n)));
+    return bits >> (c0 - col);
+}
+
+/**
+ * @brief Renders a GFX glyph rotated clockwise into a page-format bitmap.
+ * At 90 and 270 degrees a glyph row becomes a screen column, so each page byte is 8
+ * adjacent row pixels. At 0 and 180 degrees a page byte takes one pixel from 8 rows,
+ * so blocks of 8x8 pixels go through the bit-matrix transpose.
+ *
+ * @param font GFX font.
+ * @param g Glyph.
+ * @param angle 0, 90, 180 or 270.
+ * @param out Bitmap of `w` columns by `pages` pages.
+ * @param w Width of the rotated glyph.
+ * @param pages Pages of the rotated glyph.
+ */
+static void _ssd1306_rotate_glyph(const GFXfont *font, const GFXglyph *g, uint16_t angle, uint8_t *out, int16_t w, int16_t pages)
+{
+    const uint8_t *bitmap = font->bitmap + g->bitmapOffset;
+    const uint8_t gw = g->width, gh = g->height;
+    for (int16_t p = 0; p < pages; p++)
+    {
+        uint8_t *dst = &out[p * w];
+        if (angle == 90 || angle == 270)
+        {
+            // 90: column x is glyph row gh - 1 - x, read left to right from the top.
+            // 270: column x is glyph row x, read right to left from the top.
+            for (int16_t col = 0; col < w; col++)
+                dst[col] = (angle == 90) ? _ssd1306_rev8(_ssd1306_glyph_bits(bitmap, gw, gh - 1 - col, p * 8))
+                                         : _ssd1306_glyph_bits(bitmap, gw, col, gw - 8 - p * 8);
+            continue;
+        }
+        for (int16_t c0 = 0; c0 < w; c0 += 8)
+        {
+            // 180: rows come bottom up and each row is read right to left.
+            uint8_t rows[8], cols[8];
+            for (int i = 0; i < 8; i++)
+            {
+                int16_t r = p * 8 + i;
+                if (r >= gh)
+                    rows[i] = 0;
+                else if (angle == 0)
+                    rows[i] = _ssd1306_glyph_bits(bitmap, gw, r, c0);
+                else
+                    rows[i] = _ssd1306_rev8(_ssd1306_glyph_bits(bitmap, gw, gh - 1 - r, gw - 8 - c0));
+            }
+            _ssd1306_transpose8(rows, cols, false);
+            for (int16_t j = 0; j < 8 && c0 + j < w; j++)
+                dst[c0 + j] = cols[j];
+        }
+    }
+}
+
+/**
+ * @brief Returns the rotated page-format bitmap of a glyph, from the raster cache when
+ * it is enabled, otherwise rendered into the scratch buffer.
+ *
+ * @param handle SSD1306 device handle.
+ * @param font GFX font.
+ * @param c Character.
+ * @param angle 0, 90, 180 or 270.
+ * @param scratch Buffer of SSD1306_GLYPH_SCRATCH bytes.
+ * @param w Width of the rotated glyph.
+ * @param pages Pages of the rotated glyph.
+ * @return const uint8_t* Bitmap, or NULL if the glyph is too large.
+ */
+static const uint8_t *_ssd1306_rotated_glyph(ssd1306_handle_t handle, const GFXfont *font, uint8_t c, uint16_t angle,
+                                             uint8_t *scratch, int16_t w, int16_t pages)
+{
+    const GFXglyph *g = &font->glyph[c - font->first];
+    uint32_t len = (uint32_t)w * pages;
+    ssd1306_rcache_t *rc = handle->rcache;
+    if (rc && !rc->busy)
+    {
+        ssd1306_rcache_key_t key = {.font = handle->gfxFont, .p = {c, (int16_t)angle}, .kind = SSD1306_RCACHE_GLYPH};
+        for (int i = 0; i < SSD1306_RCACHE_ENTRIES; i++)
+        {
+            ssd1306_rcache_entry_t *e = &rc->entries[i];
+            if (!e->valid || memcmp(&e->key, &key, sizeof(key)) != 0)
+                continue;
+            rc->hits++;
+            e->last_use = ++rc->clock;
+            return &rc->pool[e->offset];
+        }
+        rc->misses++;
+        if (len <= rc->pool_size)
+        {
+            ssd1306_rcache_entry_t *e = _ssd1306_rcache_alloc(rc, len);
+            e->key = key;
+            e->w = w;
+            e->pages = pages;
+            e->last_use = ++rc->clock;
+            _ssd1306_rotate_glyph(font, g, angle, &rc->pool[e->offset], w, pages);
+            return &rc->pool[e->offset];
+        }
+    }
+    if (len > SSD1306_GLYPH_SCRATCH)
+        return NULL;
+    _ssd1306_rotate_glyph(font, g, angle, scratch, w, pages);
+    return scratch;
+}
+
+/**
+ * @brief Prints a string rotated clockwise around its baseline origin.
+ * Glyphs are rendered straight into page bytes and blitted, background included when
+ * the text background color differs from the text color.
+ *
+ * @param handle SSD1306 device handle.
+ * @param x Baseline origin x.
+ * @param y Baseline origin y.
+ * @param str Null-terminated string; '\n' starts a new line below the current one in text direction.
+ * @param angle Rotation in degrees: 0, 90, 180 or 270.
+ * @return esp_err_t ESP_OK on success, or an error code.
+ */
+esp_err_t ssd1306_print_rotated(ssd1306_handle_t handle, int16_t x, int16_t y, const char *str, uint16_t angle)
+{
+    ESP_RETURN_ON_FALSE(handle && str, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(!handle->config.no_framebuffer, ESP_ERR_NOT_SUPPORTED, TAG, "No framebuffer to draw into");
+    ESP_RETURN_ON_FALSE(angle == 0 || angle == 90 || angle == 180 || angle == 270, ESP_ERR_INVALID_ARG, TAG, "Invalid angle");
+    ESP_RETURN_ON_FALSE(handle->gfxFont && handle->gfxFont->type == FONT_TYPE_GFX, ESP_ERR_NOT_SUPPORTED, TAG, "Unsupported font");
+    ESP_RETURN_ON_FALSE(_ssd1306_buffer_ready(handle), ESP_ERR_NO_MEM, TAG, "Framebuffer unavailable");
+    const GFXfont *font = (const GFXfont *)handle->gfxFont->font_data;
+    uint8_t scratch[SSD1306_GLYPH_SCRATCH];
+
+    // The pen moves in text coordinates; each glyph box is rotated around the origin.
+    int16_t px = 0, py = 0;
+    for (; *str; str++)
+    {
+        uint8_t c = (uint8_t)*str;
+        if (c == '\n')
+        {
+            px = 0;
+            py += font->yAdvance;
+            continue;
+        }
+        if (c < font->first || c > font->last)
+            continue;
+        const GFXglyph *g = &font->glyph[c - font->first];
+        if (g->width && g->height)
+        {
+            int16_t bx = px + g->xOffset, by = py + g->yOffset, bw = g->width, bh = g->height;
+            int16_t left = bx, top = by, w = bw, h = bh;
+            if (angle == 90)
+            {
+                left = -(by + bh - 1);
+                top = bx;
+                w = bh;
+                h = bw;
+            }
+            else if (angle == 180)
+            {
+                left = -(bx + bw - 1);
+                top = -(by + bh - 1);
+            }
+            else if (angle == 270)
+            {
+                left = by;
+                top = -(bx + bw - 1);
+                w = bh;
+                h = bw;
+            }
+            const uint8_t *bits = _ssd1306_rotated_glyph(handle, font, c, angle, scratch, w, (h + 7) >> 3);
+            ESP_RETURN_ON_FALSE(bits, ESP_ERR_NOT_SUPPORTED, TAG, "Glyph too large");
+            _ssd1306_blit_pages(handle, bits, w, h, x + left, y + top, handle->textcolor, handle->textbgcolor);
+        }
+        px += g->xAdvance;
+    }
+    return ESP_OK;
+}
+
 /**
  * @brief Sets the hardware scan orientation (flip and remap).
  *
@@ -1898,8 +5261,23 @@ void ssd1306_set_orientation(ssd1306_handle_t handle, uint8_t rotation)
     // rotation & 2: if bit 1 is set (value 2 or 3), enable reverse scan.
     uint8_t com_cmd = (rotation & 2) ? OLED_CMD_SET_COM_SCAN_MODE | 0x08 : OLED_CMD_SET_COM_SCAN_MODE | 0x00;
 
-    _ssd1306_send_cmd_list(handle, &seg_cmd, 1);
-    _ssd1306_send_cmd_list(handle, &com_cmd, 1);
+    handle->seg_remap = (rotation & 1);
+    if (handle->defer_cmds)
+    {
+        handle->pending_seg_cmd = seg_cmd;
+        handle->pending_com_cmd = com_cmd;
+        handle->pending_cmds |= SSD1306_PENDING_ORIENTATION;
+    }
+    else
+    {
+        esp_err_t ret = _ssd1306_send_cmd_list(handle, (uint8_t[]){seg_cmd, com_cmd}, 2);
+        if (ret == ESP_OK)
+        {
+            handle->shadow_seg_cmd = seg_cmd;
+            handle->shadow_com_cmd = com_cmd;
+        }
+        _ssd1306_report_cmd_error(handle, ret);
+    }
     
     // This function currently does not fully adjust the internal coordinate system
     // for `draw_` functions. The cursor adjustment below is an initial step
@@ -1924,9 +5302,11 @@ void ssd1306_set_orientation(ssd1306_handle_t handle, uint8_t rotation)
     }
     
     // Clear buffer and update screen to ensure the new orientation is visible
-    // and there are no artifacts from the previous orientation.
+    // and there are no artifacts from the previous orientation. In deferred mode the
+    // cleared frame goes out together with the queued orientation on the next flush.
     ssd1306_clear_buffer(handle);
-    ESP_ERROR_CHECK(ssd1306_update_screen(handle));
+    if (!handle->defer_cmds)
+        _ssd1306_report_cmd_error(handle, ssd1306_update_screen(handle));
 }
 
 /**
@@ -1940,9 +5320,23 @@ void ssd1306_set_display_start_line(ssd1306_handle_t handle, uint8_t line)
 {
     if (!handle || line > 63)
         return;
+    if (handle->page_flip)
+    {
+        ESP_LOGW(TAG, "Start line is managed by page flipping");
+        return;
+    }
 
+    if (handle->defer_cmds)
+    {
+        handle->pending_start_line = line;
+        handle->pending_cmds |= SSD1306_PENDING_START_LINE;
+        return;
+    }
     uint8_t cmd = OLED_CMD_SET_DISPLAY_START_LINE | line;
-    _ssd1306_send_cmd_list(handle, &cmd, 1);
+    esp_err_t ret = _ssd1306_send_cmd_list(handle, &cmd, 1);
+    if (ret == ESP_OK)
+        handle->shadow_start_line = line;
+    _ssd1306_report_cmd_error(handle, ret);
 }
 
 /**
@@ -0,0 +1,205 @@
+/**
+ * @file      ssd1306_arena.c
+ * @brief     Fixed-block arena for the driver's buffers.
+ * @version   1.0
+ *
+ * A bitmap marks the blocks in use, one bit per block, and the first block of each
+ * allocation records the length of its run so a free needs only the pointer. Fully
+ * used and fully free bitmap words are stepped over 32 blocks at a time.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+#include "esp_check.h"
+
+#include "ssd1306_arena.h"
+
+static const char *TAG = "SSD1306_ARENA";
+
+/**
+ * @struct ssd1306_arena_t
+ * @brief Arena state, followed in the same allocation by the bitmap and the run table.
+ */
+struct ssd1306_arena_t
+{
+    uint8_t *base;         /**< First block. */
+    bool own_base;         /**< The region was allocated at creation. */
+    uint16_t block_size;   /**< Block size in bytes. */
+    uint16_t blocks;       /**< Number of blocks. */
+    uint16_t used;         /**< Blocks in use. */
+    uint16_t high_water;   /**< Most blocks in use at once. */
+    uint32_t allocs;       /**< Successful allocations. */
+    uint32_t failures;     /**< Failed allocations. */
+    portMUX_TYPE lock;     /**< Guards the bitmap and the counters. */
+    uint16_t *run;         /**< Run length at the first block of each allocation, 0 elsewhere. */
+    uint32_t bitmap[];     /**< One bit per block, set while in use. */
+};
+
+/**
+ * @brief Sets or clears the bits of a run of blocks.
+ *
+ * @param a Arena.
+ * @param start First block.
+ * @param n Number of blocks.
+ * @param used New state.
+ */
+static void _arena_mark(struct ssd1306_arena_t *a, uint16_t start, uint16_t n, bool used)
+{
+    for (uint16_t i = start; i < start + n; i++)
+    {
+        if (used)
+            a->bitmap[i >> 5] |= 1u << (i & 31);
+        else
+            a->bitmap[i >> 5] &= ~(1u << (i & 31));
+    }
+}
+
+/**
+ * @brief Finds the first run of `n` free blocks, or the longest free run.
+ *
+ * @param a Arena.
+ * @param n Blocks needed (0 to only measure the longest free run).
+ * @param longest Longest free run seen, or NULL.
+ * @return int32_t First block of the run, or -1.
+ */
+static int32_t _arena_find(const struct ssd1306_arena_t *a, uint16_t n, uint16_t *longest)
+{
+    uint32_t run = 0, best = 0;
+    for (uint32_t i = 0; i < a->blocks;)
+    {
+        uint32_t word = a->bitmap[i >> 5];
+        if ((i & 31) == 0 && i + 32 <= a->blocks && (word == 0 || word == UINT32_MAX))
+        {
+            run = (word == 0) ? run + 32 : 0;
+            i += 32;
+        }
+        else
+        {
+            run = ((word >> (i & 31)) & 1) ? 0 : run + 1;
+            i++;
+        }
+        best = (run > best) ? run : best;
+        if (n && run >= n)
+            return (int32_t)(i - run); // The run may have been entered mid-word; it starts `run` blocks back.
+    }
+    if (longest)
+        *longest = (uint16_t)best;
+    return -1;
+}
+
+esp_err_t ssd1306_arena_create(const ssd1306_arena_config_t *cfg, ssd1306_arena_handle_t *out)
+{
+    ESP_RETURN_ON_FALSE(cfg && out, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    uint16_t bs = cfg->block_size ? cfg->block_size : SSD1306_ARENA_DEFAULT_BLOCK;
+    ESP_RETURN_ON_FALSE(bs % 4 == 0 && ((uintptr_t)cfg->backing & 3) == 0, ESP_ERR_INVALID_ARG, TAG, "Blocks must be 4-byte aligned");
+    size_t blocks = cfg->size / bs;
+    ESP_RETURN_ON_FALSE(blocks > 0 && blocks <= UINT16_MAX, ESP_ERR_INVALID_ARG, TAG, "Invalid arena size");
+
+    size_t words = (blocks + 31) / 32;
+    struct ssd1306_arena_t *a = calloc(1, sizeof(*a) + words * sizeof(uint32_t) + blocks * sizeof(uint16_t));
+    ESP_RETURN_ON_FALSE(a, ESP_ERR_NO_MEM, TAG, "Failed to allocate block table");
+    a->run = (uint16_t *)&a->bitmap[words];
+    a->base = cfg->backing;
+    if (!a->base)
+    {
+        a->base = malloc(blocks * bs);
+        a->own_base = true;
+        if (!a->base)
+        {
+            free(a);
+            ESP_LOGE(TAG, "Failed to allocate %u blocks", (unsigned)blocks);
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    a->block_size = bs;
+    a->blocks = (uint16_t)blocks;
+    portMUX_INITIALIZE(&a->lock);
+    *out = a;
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_arena_delete(ssd1306_arena_handle_t arena)
+{
+    ESP_RETURN_ON_FALSE(arena, ESP_ERR_INVALID_ARG, TAG, "Invalid arena");
+    if (arena->used)
+        ESP_LOGW(TAG, "Deleting arena with %u blocks in use", arena->used);
+    if (arena->own_base)
+        free(arena->base);
+    free(arena);
+    return ESP_OK;
+}
+
+void *ssd1306_arena_alloc(ssd1306_arena_handle_t arena, size_t bytes)
+{
+    if (!arena)
+        return NULL;
+    size_t n = (bytes + arena->block_size - 1) / arena->block_size;
+    n = n ? n : 1;
+    void *p = NULL;
+    portENTER_CRITICAL(&arena->lock);
+    int32_t start = (n <= arena->blocks) ? _arena_find(arena, (uint16_t)n, NULL) : -1;
+    if (start >= 0)
+    {
+        _arena_mark(arena, (uint16_t)start, (uint16_t)n, true);
+        arena->run[start] = (uint16_t)n;
+        arena->used += n;
+        arena->high_water = (arena->used > arena->high_water) ? arena->used : arena->high_water;
+        arena->allocs++;
+        p = &arena->base[(size_t)start * arena->block_size];
+    }
+    else
+    {
+        arena->failures++;
+    }
+    portEXIT_CRITICAL(&arena->lock);
+    return p;
+}
+
+void ssd1306_arena_free(ssd1306_arena_handle_t arena, void *ptr)
+{
+    if (!arena || !ptr)
+        return;
+    size_t offset = (size_t)((uint8_t *)ptr - arena->base);
+    uint16_t start = (uint16_t)(offset / arena->block_size);
+    // The run table is checked under the same lock as the release, so two tasks freeing
+    // one pointer cannot both see it allocated. The error is logged after leaving the
+    // critical section.
+    bool valid = false;
+    portENTER_CRITICAL(&arena->lock);
+    if (ssd1306_arena_owns(arena, ptr) && offset % arena->block_size == 0 && arena->run[start] != 0)
+    {
+        _arena_mark(arena, start, arena->run[start], false);
+        arena->used -= arena->run[start];
+        arena->run[start] = 0;
+        valid = true;
+    }
+    portEXIT_CRITICAL(&arena->lock);
+    if (!valid)
+        ESP_LOGE(TAG, "Free of %p, which is not an arena allocation", ptr);
+}
+
+bool ssd1306_arena_owns(ssd1306_arena_handle_t arena, const void *ptr)
+{
+    return arena && (const uint8_t *)ptr >= arena->base && (const uint8_t *)ptr < arena->base + (size_t)arena->blocks * arena->block_size;
+}
+
+esp_err_t ssd1306_arena_get_stats(ssd1306_arena_handle_t arena, ssd1306_arena_stats_t *out)
+{
+    ESP_RETURN_ON_FALSE(arena && out, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    portENTER_CRITICAL(&arena->lock);
+    *out = (ssd1306_arena_stats_t){
+        .block_size = arena->block_size,
+        .blocks = arena->blocks,
+        .used = arena->used,
+        .high_water = arena->high_water,
+        .allocs = arena->allocs,
+        .failures = arena->failures,
+    };
+    _arena_find(arena, 0, &out->largest_free);
+    portEXIT_CRITICAL(&arena->lock);
+    return ESP_OK;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file      ssd1306_bargraph.c
+ * @brief     Incremental bar graph / spectrum widget with peak hold.
+ * @version   1.0
+ *
+ * Heights are counted in pixels from the bottom edge; height row `k` is screen row
+ * `y + h - 1 - k`. A peak of height `p` is drawn as a one-pixel marker on row `p - 1`
+ * when it is above the bar.
+ *
+ */
+
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_check.h"
+
+#include "ssd1306_bargraph.h"
+
+static const char *TAG = "SSD1306_BAR";
+
+/**
+ * @brief Fills the height rows [from, to) of one bar.
+ *
+ * @param bg Bar graph.
+ * @param i Bar index.
+ * @param from First height row.
+ * @param to End height row (exclusive).
+ * @param color Fill color.
+ */
+static void _bar_fill(ssd1306_bargraph_t *bg, uint16_t i, int16_t from, int16_t to, ssd1306_color_t color)
+{
+    int16_t x = bg->cfg.x + i * (bg->cfg.bar_w + bg->cfg.gap);
+    ssd1306_fill_rect(bg->disp, x, bg->cfg.y + bg->cfg.h - to, bg->cfg.bar_w, to - from, color);
+    bg->last_rows += to - from;
+}
+
+/**
+ * @brief Paints the transition of one bar from its stored state to a new one.
+ *
+ * @param bg Bar graph.
+ * @param i Bar index.
+ * @param level New bar height.
+ * @param peak New peak height.
+ * @return bool True if anything was painted.
+ */
+static bool _bar_paint(ssd1306_bargraph_t *bg, uint16_t i, uint8_t level, uint8_t peak)
+{
+    ssd1306_bar_t *bar = &bg->cfg.bars[i];
+    bool old_marker = bar->peak > bar->level;
+    bool new_marker = peak > level;
+    bool painted = false;
+
+    // An old marker that moves or disappears is erased first; the bar body may repaint its row.
+    if (old_marker && !(new_marker && peak == bar->peak))
+    {
+        _bar_fill(bg, i, bar->peak - 1, bar->peak, OLED_COLOR_BLACK);
+        painted = true;
+    }
+    // Only the rows between the old and the new level change.
+    if (level != bar->level)
+    {
+        bool grow = level > bar->level;
+        _bar_fill(bg, i, grow ? bar->level : level, grow ? level : bar->level, grow ? OLED_COLOR_WHITE : OLED_COLOR_BLACK);
+        painted = true;
+    }
+    if (new_marker && !(old_marker && peak == bar->peak))
+    {
+        _bar_fill(bg, i, peak - 1, peak, OLED_COLOR_WHITE);
+        painted = true;
+    }
+    bar->level = level;
+    bar->peak = peak;
+    return painted;
+}
+
+esp_err_t ssd1306_bargraph_init(ssd1306_bargraph_t *bg, ssd1306_handle_t disp, const ssd1306_bargraph_config_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(bg && disp && cfg && cfg->bars && cfg->count > 0 && cfg->bar_w > 0, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(cfg->h > 0 && cfg->h <= UINT8_MAX && cfg->max > 0, ESP_ERR_INVALID_ARG, TAG, "Invalid height or range");
+    ESP_RETURN_ON_FALSE(!cfg->peak_hold || cfg->peak_fall > 0, ESP_ERR_INVALID_ARG, TAG, "Peaks need a fall rate");
+    memset(bg, 0, sizeof(*bg));
+    bg->disp = disp;
+    bg->cfg = *cfg;
+    memset(cfg->bars, 0, cfg->count * sizeof(ssd1306_bar_t));
+    ssd1306_bargraph_redraw(bg);
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_bargraph_set(ssd1306_bargraph_t *bg, const uint16_t *values, bool flush)
+{
+    ESP_RETURN_ON_FALSE(bg && values, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    esp_err_t ret = ESP_OK;
+    bool in_run = false;
+    bg->last_runs = 0;
+    bg->last_rows = 0;
+
+    for (uint16_t i = 0; i < bg->cfg.count; i++)
+    {
+        const ssd1306_bar_t *bar = &bg->cfg.bars[i];
+        uint16_t value = values[i] < bg->cfg.max ? values[i] : bg->cfg.max;
+        uint8_t level = (uint8_t)((uint32_t)value * bg->cfg.h / bg->cfg.max);
+        uint8_t peak = 0, hold = 0;
+        if (bg->cfg.peak_hold)
+        {
+            // A new high resets the hold time; afterwards the peak falls towards the bar.
+            peak = bar->peak;
+            hold = bar->hold;
+            if (level >= peak)
+            {
+                peak = level;
+                hold = bg->cfg.peak_hold_frames;
+            }
+            else if (hold > 0)
+                hold--;
+            else
+                peak = (peak - level > bg->cfg.peak_fall) ? peak - bg->cfg.peak_fall : level;
+        }
+
+        bool painted = _bar_paint(bg, i, level, peak);
+        bg->cfg.bars[i].hold = hold;
+        if (painted && !in_run)
+            bg->last_runs++;
+        // An unchanged bar ends the run; send it before its damage merges with the next one.
+        if (flush && in_run && !painted)
+        {
+            esp_err_t err = ssd1306_update_screen(bg->disp);
+            ret = (ret == ESP_OK) ? err : ret;
+        }
+        in_run = painted;
+    }
+    if (flush && in_run)
+    {
+        esp_err_t err = ssd1306_update_screen(bg->disp);
+        ret = (ret == ESP_OK) ? err : ret;
+    }
+    return ret;
+}
+
+void ssd1306_bargraph_redraw(ssd1306_bargraph_t *bg)
+{
+    if (!bg)
+        return;
+    int16_t w = bg->cfg.count * (bg->cfg.bar_w + bg->cfg.gap) - bg->cfg.gap;
+    ssd1306_fill_rect(bg->disp, bg->cfg.x, bg->cfg.y, w, bg->cfg.h, OLED_COLOR_BLACK);
+    for (uint16_t i = 0; i < bg->cfg.count; i++)
+    {
+        const ssd1306_bar_t *bar = &bg->cfg.bars[i];
+        if (bar->level > 0)
+            _bar_fill(bg, i, 0, bar->level, OLED_COLOR_WHITE);
+        if (bar->peak > bar->level)
+            _bar_fill(bg, i, bar->peak - 1, bar->peak, OLED_COLOR_WHITE);
+    }
+}
@@ -0,0 +1,41 @@
+/**
+ * @file      ssd1306_bits.h
+ * @brief     Bit manipulation helpers shared by the driver's translation units.
+ * @version   1.0
+ *
+ * @details
+ * Internal header; it is not part of the public API and is not installed.
+ */
+
+#ifndef SSD1306_BITS_H
+#define SSD1306_BITS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Transposes an 8x8 bit matrix (Hacker's Delight, transpose8).
+ * Turns 8 bitmap rows into 8 page bytes (bit 0 on top).
+ *
+ * @param rows Row bytes, top to bottom.
+ * @param cols Column bytes, left to right.
+ * @param lsb_left True if bit 0 of a row byte is its leftmost pixel (XBM), false for
+ *                 the most significant bit (GFX fonts, PBM).
+ */
+static inline void _ssd1306_transpose8(const uint8_t rows[8], uint8_t cols[8], bool lsb_left)
+{
+    uint64_t x = 0, t;
+    for (int i = 0; i < 8; i++)
+        x |= (uint64_t)rows[i] << (8 * i);
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x ^= t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x ^= t ^ (t << 28);
+    // Byte k now holds bit k of every row.
+    for (int j = 0; j < 8; j++)
+        cols[j] = (uint8_t)(x >> (8 * (lsb_left ? j : 7 - j)));
+}
+
+#endif // SSD1306_BITS_H
@@ -0,0 +1,209 @@
+/**
+ * @file      ssd1306_chart.c
+ * @brief     Incremental strip chart for sensor trends.
+ * @version   1.0
+ *
+ * Every ring slot holds a (min, max) pair per trace; in line mode both are the sample.
+ * Column `n` of the plot (0 = oldest) lives in slot `(head + n) % w`.
+ *
+ */
+
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_check.h"
+
+#include "ssd1306_chart.h"
+
+static const char *TAG = "SSD1306_CHART";
+
+/**
+ * @brief Returns the (min, max) pair of a trace in a ring slot.
+ *
+ * @param chart Chart.
+ * @param slot Ring slot.
+ * @param trace Trace index.
+ * @return int16_t* Pointer to min, followed by max.
+ */
+static int16_t *_chart_entry(const ssd1306_chart_t *chart, uint16_t slot, uint8_t trace)
+{
+    return &chart->cfg.buffer[(slot * chart->cfg.traces + trace) * 2];
+}
+
+/**
+ * @brief Maps a value to a screen row of the plot.
+ *
+ * @param chart Chart.
+ * @param value Value.
+ * @return int16_t Screen row (values outside the range are clamped to the edges).
+ */
+static int16_t _chart_row(const ssd1306_chart_t *chart, int16_t value)
+{
+    if (value < chart->min)
+        value = chart->min;
+    if (value > chart->max)
+        value = chart->max;
+    int32_t span = (int32_t)chart->max - chart->min;
+    return chart->cfg.y + chart->cfg.h - 1 - (int16_t)(((int32_t)value - chart->min) * (chart->cfg.h - 1) / span);
+}
+
+/**
+ * @brief Draws one plot column.
+ * Each trace is a vertical segment from its min to its max, stretched to touch the
+ * previous column so that lines stay connected.
+ *
+ * @param chart Chart.
+ * @param n Column index (0 = oldest).
+ */
+static void _chart_draw_column(const ssd1306_chart_t *chart, uint16_t n)
+{
+    uint16_t slot = (chart->head + n) % chart->cfg.w;
+    uint16_t prev = (slot + chart->cfg.w - 1) % chart->cfg.w;
+    for (uint8_t t = 0; t < chart->cfg.traces; t++)
+    {
+        const int16_t *cur = _chart_entry(chart, slot, t);
+        int16_t top = _chart_row(chart, cur[1]);
+        int16_t bottom = _chart_row(chart, cur[0]);
+        if (n > 0)
+        {
+            const int16_t *before = _chart_entry(chart, prev, t);
+            int16_t prev_top = _chart_row(chart, before[1]);
+            int16_t prev_bottom = _chart_row(chart, before[0]);
+            top = (prev_bottom < top) ? prev_bottom : top;
+            bottom = (prev_top > bottom) ? prev_top : bottom;
+        }
+        ssd1306_draw_fast_vline(chart->disp, chart->cfg.x + n, top, bottom - top + 1, OLED_COLOR_WHITE);
+    }
+}
+
+/**
+ * @brief Computes the range of the samples in the ring buffer.
+ * A full scan of at most w * traces pairs, which is small next to the cost of a redraw.
+ *
+ * @param chart Chart.
+ * @param min Output minimum.
+ * @param max Output maximum (always greater than the minimum).
+ */
+static void _chart_fit_range(const ssd1306_chart_t *chart, int16_t *min, int16_t *max)
+{
+    int16_t lo = INT16_MAX, hi = INT16_MIN;
+    for (uint16_t n = 0; n < chart->columns; n++)
+    {
+        for (uint8_t t = 0; t < chart->cfg.traces; t++)
+        {
+            const int16_t *e = _chart_entry(chart, n, t);
+            lo = (e[0] < lo) ? e[0] : lo;
+            hi = (e[1] > hi) ? e[1] : hi;
+        }
+    }
+    if (hi <= lo)
+    {
+        if (lo == INT16_MAX)
+            lo--;
+        hi = lo + 1;
+    }
+    *min = lo;
+    *max = hi;
+}
+
+esp_err_t ssd1306_chart_init(ssd1306_chart_t *chart, ssd1306_handle_t disp, const ssd1306_chart_config_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(chart && disp && cfg && cfg->buffer && cfg->w > 0 && cfg->h > 1, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(cfg->traces > 0 && cfg->traces <= SSD1306_CHART_MAX_TRACES, ESP_ERR_INVALID_ARG, TAG, "Invalid trace count");
+    ESP_RETURN_ON_FALSE(cfg->mode != SSD1306_CHART_ENVELOPE || cfg->samples_per_column > 0, ESP_ERR_INVALID_ARG, TAG,
+                        "Envelope mode needs samples per column");
+    ESP_RETURN_ON_FALSE(cfg->autoscale || cfg->max > cfg->min, ESP_ERR_INVALID_ARG, TAG, "Invalid range");
+    memset(chart, 0, sizeof(*chart));
+    chart->disp = disp;
+    chart->cfg = *cfg;
+    chart->min = cfg->min;
+    chart->max = (cfg->max > cfg->min) ? cfg->max : cfg->min + 1;
+    ssd1306_fill_rect(disp, cfg->x, cfg->y, cfg->w, cfg->h, OLED_COLOR_BLACK);
+    return ESP_OK;
+}
+
+bool ssd1306_chart_push(ssd1306_chart_t *chart, const int16_t *values)
+{
+    if (!chart || !values)
+        return false;
+
+    for (uint8_t t = 0; t < chart->cfg.traces; t++)
+    {
+        if (chart->pending == 0 || values[t] < chart->acc_lo[t])
+            chart->acc_lo[t] = values[t];
+        if (chart->pending == 0 || values[t] > chart->acc_hi[t])
+            chart->acc_hi[t] = values[t];
+    }
+    chart->pending++;
+    if (chart->cfg.mode == SSD1306_CHART_ENVELOPE && chart->pending < chart->cfg.samples_per_column)
+        return false;
+    chart->pending = 0;
+
+    // Append the column, overwriting the oldest one once the plot is full.
+    bool full = (chart->columns == chart->cfg.w);
+    uint16_t slot = (chart->head + chart->columns) % chart->cfg.w;
+    for (uint8_t t = 0; t < chart->cfg.traces; t++)
+    {
+        int16_t *e = _chart_entry(chart, slot, t);
+        e[0] = chart->acc_lo[t];
+        e[1] = chart->acc_hi[t];
+    }
+    if (full)
+        chart->head = (chart->head + 1) % chart->cfg.w;
+    else
+        chart->columns++;
+
+    if (chart->cfg.autoscale)
+    {
+        int16_t min, max;
+        _chart_fit_range(chart, &min, &max);
+        if (min != chart->min || max != chart->max)
+        {
+            // Every column moves vertically, so nothing can be reused.
+            chart->min = min;
+            chart->max = max;
+            chart->redraws++;
+            ssd1306_chart_redraw(chart);
+            return true;
+        }
+    }
+
+    if (full)
+    {
+        ssd1306_shift_rect(chart->disp, chart->cfg.x, chart->cfg.y, chart->cfg.w, chart->cfg.h, -1);
+        // The new oldest column still joins the evicted one; redraw it unjoined.
+        ssd1306_fill_rect(chart->disp, chart->cfg.x, chart->cfg.y, 1, chart->cfg.h, OLED_COLOR_BLACK);
+        _chart_draw_column(chart, 0);
+    }
+    _chart_draw_column(chart, chart->columns - 1);
+    return true;
+}
+
+void ssd1306_chart_set_range(ssd1306_chart_t *chart, int16_t min, int16_t max)
+{
+    if (!chart || max <= min)
+        return;
+    chart->cfg.autoscale = false;
+    chart->min = min;
+    chart->max = max;
+    ssd1306_chart_redraw(chart);
+}
+
+void ssd1306_chart_redraw(ssd1306_chart_t *chart)
+{
+    if (!chart)
+        return;
+    ssd1306_fill_rect(chart->disp, chart->cfg.x, chart->cfg.y, chart->cfg.w, chart->cfg.h, OLED_COLOR_BLACK);
+    for (uint16_t n = 0; n < chart->columns; n++)
+        _chart_draw_column(chart, n);
+}
+
+void ssd1306_chart_clear(ssd1306_chart_t *chart)
+{
+    if (!chart)
+        return;
+    chart->head = 0;
+    chart->columns = 0;
+    chart->pending = 0;
+    ssd1306_fill_rect(chart->disp, chart->cfg.x, chart->cfg.y, chart->cfg.w, chart->cfg.h, OLED_COLOR_BLACK);
+}
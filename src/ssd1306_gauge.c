@@ -0,0 +1,245 @@
+/**
+ * @file      ssd1306_gauge.c
+ * @brief     Analog gauge widget with a cached dial and fixed-point needle geometry.
+ * @version   1.0
+ *
+ * The canvas covers the dial's bounding square of side `2 * radius + 1` in page format:
+ * the pixel at offset (dx, dy) from the square's corner is bit `dy % 8` of byte
+ * `dx + (dy / 8) * side`.
+ *
+ */
+
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_check.h"
+
+#include "ssd1306_gauge.h"
+
+static const char *TAG = "SSD1306_GAUGE";
+
+/**
+ * @brief sin(0..90 degrees) in Q14 fixed point.
+ */
+static const int16_t gauge_sin_q14[91] = {
+    0, 286, 572, 857, 1143, 1428, 1713, 1997, 2280, 2563,
+    2845, 3126, 3406, 3686, 3964, 4240, 4516, 4790, 5063, 5334,
+    5604, 5872, 6138, 6402, 6664, 6924, 7182, 7438, 7692, 7943,
+    8192, 8438, 8682, 8923, 9162, 9397, 9630, 9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384,
+};
+
+/**
+ * @brief Fixed-point sine of an angle in whole degrees.
+ *
+ * @param deg Angle in degrees (any value).
+ * @return int32_t sin(deg) in Q14.
+ */
+static int32_t _gauge_sin(int32_t deg)
+{
+    deg %= 360;
+    if (deg < 0)
+        deg += 360;
+    if (deg <= 90)
+        return gauge_sin_q14[deg];
+    if (deg <= 180)
+        return gauge_sin_q14[180 - deg];
+    if (deg <= 270)
+        return -gauge_sin_q14[deg - 180];
+    return -gauge_sin_q14[360 - deg];
+}
+
+/**
+ * @brief Computes the point at a distance and angle from the dial center.
+ *
+ * @param cfg Gauge configuration.
+ * @param deg Angle in degrees.
+ * @param dist Distance from the center.
+ * @param x Output x-coordinate.
+ * @param y Output y-coordinate.
+ */
+static void _gauge_point(const ssd1306_gauge_config_t *cfg, int32_t deg, int32_t dist, int16_t *x, int16_t *y)
+{
+    // Add half an LSB before the arithmetic shift to round to the nearest pixel.
+    *x = cfg->cx + (int16_t)((dist * _gauge_sin(deg + 90) + (1 << 13)) >> 14);
+    *y = cfg->cy + (int16_t)((dist * _gauge_sin(deg) + (1 << 13)) >> 14);
+}
+
+/**
+ * @brief Maps a value to a needle angle.
+ *
+ * @param cfg Gauge configuration.
+ * @param value Value (already clamped).
+ * @return int16_t Angle in degrees.
+ */
+static int16_t _gauge_angle(const ssd1306_gauge_config_t *cfg, int32_t value)
+{
+    return cfg->start_angle + (int16_t)((int64_t)(value - cfg->min) * cfg->sweep / (cfg->max - cfg->min));
+}
+
+/**
+ * @brief Draws a radial line between two distances from the center.
+ *
+ * @param gauge Gauge.
+ * @param deg Angle in degrees.
+ * @param from Inner distance.
+ * @param to Outer distance.
+ */
+static void _gauge_radial(ssd1306_gauge_t *gauge, int32_t deg, int32_t from, int32_t to)
+{
+    int16_t x0, y0, x1, y1;
+    _gauge_point(&gauge->cfg, deg, from, &x0, &y0);
+    _gauge_point(&gauge->cfg, deg, to, &x1, &y1);
+    ssd1306_draw_line(gauge->disp, x0, y0, x1, y1, OLED_COLOR_WHITE);
+}
+
+/**
+ * @brief Draws the needle, or restores the dial pixels under it.
+ * Both walk exactly the same pixels, so restoring removes every trace of the needle.
+ *
+ * @param gauge Gauge.
+ * @param deg Needle angle.
+ * @param draw True to draw the needle, false to restore the dial from the canvas.
+ */
+static void _gauge_needle(ssd1306_gauge_t *gauge, int16_t deg, bool draw)
+{
+    const ssd1306_gauge_config_t *cfg = &gauge->cfg;
+    int16_t ax, ay, bx, by;
+    _gauge_point(cfg, deg, cfg->needle_start, &ax, &ay);
+    _gauge_point(cfg, deg, cfg->needle_len, &bx, &by);
+
+    // Thicker needles are parallel copies shifted along the minor axis.
+    bool steep = (by > ay ? by - ay : ay - by) > (bx > ax ? bx - ax : ax - bx);
+    int16_t side = 2 * cfg->radius + 1;
+    int16_t left = cfg->cx - cfg->radius, top = cfg->cy - cfg->radius;
+    for (int8_t off = -(int8_t)((cfg->needle_width - 1) / 2); off <= cfg->needle_width / 2; off++)
+    {
+        int16_t x0 = ax + (steep ? off : 0), y0 = ay + (steep ? 0 : off);
+        int16_t x1 = bx + (steep ? off : 0), y1 = by + (steep ? 0 : off);
+        int16_t dx = x1 > x0 ? x1 - x0 : x0 - x1, sx = x0 < x1 ? 1 : -1;
+        int16_t dy = -(y1 > y0 ? y1 - y0 : y0 - y1), sy = y0 < y1 ? 1 : -1;
+        int16_t err = dx + dy;
+        for (;;)
+        {
+            // Pixels of a wide needle that stick out of the dial square are skipped.
+            int16_t cx = x0 - left, cy = y0 - top;
+            if (cx >= 0 && cx < side && cy >= 0 && cy < side)
+            {
+                bool set = draw || ((cfg->canvas[cx + (cy >> 3) * side] >> (cy & 0x07)) & 1);
+                ssd1306_draw_pixel(gauge->disp, x0, y0, set ? OLED_COLOR_WHITE : OLED_COLOR_BLACK);
+                gauge->last_pixels++;
+            }
+            if (x0 == x1 && y0 == y1)
+                break;
+            int16_t e2 = 2 * err;
+            if (e2 >= dy)
+            {
+                err += dy;
+                x0 += sx;
+            }
+            if (e2 <= dx)
+            {
+                err += dx;
+                y0 += sy;
+            }
+        }
+    }
+}
+
+esp_err_t ssd1306_gauge_init(ssd1306_gauge_t *gauge, ssd1306_handle_t disp, const ssd1306_gauge_config_t *cfg, int32_t value)
+{
+    ESP_RETURN_ON_FALSE(gauge && disp && cfg && cfg->canvas && cfg->radius > 0, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(cfg->max > cfg->min && cfg->sweep > 0 && cfg->sweep <= 360, ESP_ERR_INVALID_ARG, TAG, "Invalid range");
+    ESP_RETURN_ON_FALSE(cfg->major_ticks != 1 && cfg->major_len <= cfg->radius && cfg->minor_len <= cfg->radius &&
+                        cfg->hub_radius <= cfg->radius, ESP_ERR_INVALID_ARG, TAG, "Invalid dial");
+    ESP_RETURN_ON_FALSE(cfg->needle_len <= cfg->radius && cfg->needle_start <= cfg->needle_len &&
+                        cfg->needle_width >= 1 && cfg->needle_width <= 3, ESP_ERR_INVALID_ARG, TAG, "Invalid needle");
+    memset(gauge, 0, sizeof(*gauge));
+    gauge->disp = disp;
+    gauge->cfg = *cfg;
+
+    // Rasterize the dial once.
+    int16_t side = 2 * cfg->radius + 1;
+    int16_t left = cfg->cx - cfg->radius, top = cfg->cy - cfg->radius;
+    ssd1306_fill_rect(disp, left, top, side, side, OLED_COLOR_BLACK);
+    if (cfg->arc)
+    {
+        int16_t px, py, x, y;
+        _gauge_point(cfg, cfg->start_angle, cfg->radius, &px, &py);
+        for (int16_t deg = 1; deg <= cfg->sweep; deg++)
+        {
+            _gauge_point(cfg, cfg->start_angle + deg, cfg->radius, &x, &y);
+            ssd1306_draw_line(disp, px, py, x, y, OLED_COLOR_WHITE);
+            px = x;
+            py = y;
+        }
+    }
+    for (uint8_t i = 0; i < cfg->major_ticks; i++)
+    {
+        int32_t deg = cfg->start_angle + (int32_t)cfg->sweep * i / (cfg->major_ticks - 1);
+        _gauge_radial(gauge, deg, cfg->radius - cfg->major_len, cfg->radius);
+        for (uint8_t k = 1; i + 1 < cfg->major_ticks && k <= cfg->minor_ticks; k++)
+        {
+            int32_t minor = deg + (int32_t)cfg->sweep * k / ((cfg->major_ticks - 1) * (cfg->minor_ticks + 1));
+            _gauge_radial(gauge, minor, cfg->radius - cfg->minor_len, cfg->radius);
+        }
+    }
+    if (cfg->hub_radius > 0)
+        ssd1306_fill_circle(disp, cfg->cx, cfg->cy, cfg->hub_radius, OLED_COLOR_WHITE);
+
+    // Cache it, so needle moves can restore the pixels underneath.
+    memset(cfg->canvas, 0, SSD1306_GAUGE_CANVAS_LEN(cfg->radius));
+    for (int16_t dy = 0; dy < side; dy++)
+    {
+        for (int16_t dx = 0; dx < side; dx++)
+        {
+            if (ssd1306_get_pixel(disp, left + dx, top + dy))
+                cfg->canvas[dx + (dy >> 3) * side] |= 1 << (dy & 0x07);
+        }
+    }
+
+    gauge->value = value < cfg->min ? cfg->min : (value > cfg->max ? cfg->max : value);
+    gauge->angle = _gauge_angle(cfg, gauge->value);
+    _gauge_needle(gauge, gauge->angle, true);
+    return ESP_OK;
+}
+
+bool ssd1306_gauge_set(ssd1306_gauge_t *gauge, int32_t value)
+{
+    if (!gauge)
+        return false;
+    value = value < gauge->cfg.min ? gauge->cfg.min : (value > gauge->cfg.max ? gauge->cfg.max : value);
+    gauge->value = value;
+    int16_t angle = _gauge_angle(&gauge->cfg, value);
+    gauge->last_pixels = 0;
+    if (angle == gauge->angle)
+        return false;
+
+    _gauge_needle(gauge, gauge->angle, false);
+    gauge->angle = angle;
+    _gauge_needle(gauge, angle, true);
+    return true;
+}
+
+void ssd1306_gauge_redraw(ssd1306_gauge_t *gauge)
+{
+    if (!gauge)
+        return;
+    const ssd1306_gauge_config_t *cfg = &gauge->cfg;
+    int16_t side = 2 * cfg->radius + 1;
+    for (int16_t dy = 0; dy < side; dy++)
+    {
+        for (int16_t dx = 0; dx < side; dx++)
+        {
+            bool set = (cfg->canvas[dx + (dy >> 3) * side] >> (dy & 0x07)) & 1;
+            ssd1306_draw_pixel(gauge->disp, cfg->cx - cfg->radius + dx, cfg->cy - cfg->radius + dy,
+                               set ? OLED_COLOR_WHITE : OLED_COLOR_BLACK);
+        }
+    }
+    _gauge_needle(gauge, gauge->angle, true);
+}
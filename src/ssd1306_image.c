@@ -0,0 +1,358 @@
+/**
+ * @file      ssd1306_image.c
+ * @brief     Streaming 1bpp image loader (PBM P4 and XBM) from files.
+ * @version   1.0
+ *
+ * Target page `p` holds image rows `8p - y` to `8p - y + 7`. The loader reads those rows
+ * into a strip, turns each 8x8 block of the strip into 8 page bytes with a bit-matrix
+ * transpose, and writes the page with a row mask, so partial first and last pages keep
+ * the pixels around the image.
+ *
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+
+#include "ssd1306_image.h"
+#include "ssd1306_bits.h"
+
+static const char *TAG = "SSD1306_IMAGE";
+
+#define IMAGE_READ_CHUNK 128 /**< Read buffer for headers and XBM text. */
+#define IMAGE_TOKEN_MAX 48   /**< Longest XBM token kept; longer ones are truncated. */
+
+/**
+ * @brief Buffered file reader.
+ */
+typedef struct {
+    FILE *f;                       /**< Open file. */
+    uint8_t buf[IMAGE_READ_CHUNK]; /**< Read buffer. */
+    uint16_t len;                  /**< Valid bytes in the buffer. */
+    uint16_t pos;                  /**< Next byte in the buffer. */
+    uint32_t bytes;                /**< Bytes read from the file. */
+} image_reader_t;
+
+/**
+ * @brief Returns the next byte of the file, or -1 at the end.
+ *
+ * @param r Reader.
+ * @return int Byte value or -1.
+ */
+static int _img_getc(image_reader_t *r)
+{
+    if (r->pos == r->len)
+    {
+        r->len = (uint16_t)fread(r->buf, 1, sizeof(r->buf), r->f);
+        r->pos = 0;
+        r->bytes += r->len;
+        if (r->len == 0)
+            return -1;
+    }
+    return r->buf[r->pos++];
+}
+
+/**
+ * @brief Reads raw bytes, first from the buffer, then straight from the file.
+ *
+ * @param r Reader.
+ * @param dst Destination, or NULL to skip the bytes.
+ * @param n Number of bytes.
+ * @return true if all bytes were available.
+ */
+static bool _img_read(image_reader_t *r, uint8_t *dst, uint32_t n)
+{
+    uint32_t k = r->len - r->pos;
+    k = (k < n) ? k : n;
+    if (dst)
+        memcpy(dst, &r->buf[r->pos], k);
+    r->pos += k;
+    n -= k;
+    if (n == 0)
+        return true;
+    if (!dst)
+        return fseek(r->f, (long)n, SEEK_CUR) == 0;
+    size_t got = fread(dst + k, 1, n, r->f);
+    r->bytes += got;
+    return got == n;
+}
+
+/**
+ * @brief Reads a decimal field of a PBM header, skipping whitespace and comments.
+ * The single whitespace character that ends the field is consumed.
+ *
+ * @param r Reader.
+ * @param out Value.
+ * @return true if a valid field was read.
+ */
+static bool _img_pbm_field(image_reader_t *r, uint32_t *out)
+{
+    int c = _img_getc(r);
+    while (c == '#' || (c >= 0 && isspace(c)))
+    {
+        if (c == '#')
+        {
+            // A comment runs to the end of the line.
+            while (c >= 0 && c != '\n' && c != '\r')
+                c = _img_getc(r);
+        }
+        else
+        {
+            c = _img_getc(r);
+        }
+    }
+    if (c < 0 || !isdigit(c))
+        return false;
+    uint32_t v = 0;
+    for (; c >= 0 && isdigit(c); c = _img_getc(r))
+    {
+        v = v * 10 + (c - '0');
+        if (v > SSD1306_IMAGE_MAX_SIDE)
+            return false;
+    }
+    *out = v;
+    return c >= 0 && isspace(c);
+}
+
+/**
+ * @brief Returns the next XBM token: an identifier or number, or a single punctuation
+ * character. Whitespace and C comments are skipped.
+ *
+ * @param r Reader.
+ * @param tok Token text (NUL-terminated, possibly truncated).
+ * @return bool false at the end of the file.
+ */
+static bool _img_xbm_token(image_reader_t *r, char tok[IMAGE_TOKEN_MAX])
+{
+    int c = _img_getc(r);
+    while (true)
+    {
+        while (c >= 0 && isspace(c))
+            c = _img_getc(r);
+        if (c != '/')
+            break;
+        c = _img_getc(r);
+        if (c != '*')
+            break; // A lone slash; treat it as punctuation below.
+        int prev = 0;
+        for (c = _img_getc(r); c >= 0 && !(prev == '*' && c == '/'); c = _img_getc(r))
+            prev = c;
+        c = _img_getc(r);
+    }
+    if (c < 0)
+        return false;
+    int n = 0;
+    tok[n++] = (char)c;
+    if (isalnum(c) || c == '_')
+    {
+        for (c = _img_getc(r); c >= 0 && (isalnum(c) || c == '_'); c = _img_getc(r))
+        {
+            if (n < IMAGE_TOKEN_MAX - 1)
+                tok[n++] = (char)c;
+        }
+        if (c >= 0)
+            r->pos--; // Push back the character after the token; it is still in the buffer.
+    }
+    tok[n] = '\0';
+    return true;
+}
+
+/**
+ * @brief Returns true if a string ends with a suffix.
+ *
+ * @param s String.
+ * @param suffix Suffix.
+ * @return bool Result.
+ */
+static bool _img_ends_with(const char *s, const char *suffix)
+{
+    size_t n = strlen(s), k = strlen(suffix);
+    return n >= k && strcmp(s + n - k, suffix) == 0;
+}
+
+/**
+ * @brief Parses an XBM header up to the opening brace of the data array.
+ *
+ * @param r Reader.
+ * @param w Width.
+ * @param h Height.
+ * @return bool true if both dimensions were found.
+ */
+static bool _img_xbm_header(image_reader_t *r, uint32_t *w, uint32_t *h)
+{
+    char tok[IMAGE_TOKEN_MAX], name[IMAGE_TOKEN_MAX];
+    *w = *h = 0;
+    while (_img_xbm_token(r, tok))
+    {
+        if (tok[0] == '{')
+            return *w > 0 && *h > 0;
+        if (strcmp(tok, "define") != 0 || !_img_xbm_token(r, name) || !_img_xbm_token(r, tok))
+            continue;
+        uint32_t v = (uint32_t)strtoul(tok, NULL, 0);
+        if (_img_ends_with(name, "_width"))
+            *w = v;
+        else if (_img_ends_with(name, "_height"))
+            *h = v;
+    }
+    return false;
+}
+
+/**
+ * @brief Reads one image row of `n` bytes.
+ *
+ * @param r Reader.
+ * @param format File format.
+ * @param dst Row bytes, or NULL to skip the row.
+ * @param n Bytes per row.
+ * @return bool false if the file ends early or holds something other than data.
+ */
+static bool _img_row(image_reader_t *r, ssd1306_image_format_t format, uint8_t *dst, uint16_t n)
+{
+    if (format == SSD1306_IMAGE_PBM)
+        return _img_read(r, dst, n);
+    char tok[IMAGE_TOKEN_MAX];
+    for (uint16_t i = 0; i < n; i++)
+    {
+        do
+        {
+            if (!_img_xbm_token(r, tok))
+                return false;
+        } while (tok[0] == ',');
+        if (!isdigit((unsigned char)tok[0]))
+            return false;
+        if (dst)
+            dst[i] = (uint8_t)strtoul(tok, NULL, 0);
+    }
+    return true;
+}
+
+/**
+ * @brief Parses the header and streams the visible rows into the target.
+ *
+ * @param r Reader.
+ * @param disp Display (framebuffer target).
+ * @param o Placement.
+ * @param info Result.
+ * @return esp_err_t Operation status.
+ */
+static esp_err_t _img_load(image_reader_t *r, ssd1306_handle_t disp, const ssd1306_image_opts_t *o, ssd1306_image_info_t *info)
+{
+    uint32_t w = 0, h = 0;
+    int c = _img_getc(r);
+    if (c == 'P')
+    {
+        ESP_RETURN_ON_FALSE(_img_getc(r) == '4', ESP_ERR_NOT_SUPPORTED, TAG, "Only binary PBM (P4) is supported");
+        ESP_RETURN_ON_FALSE(_img_pbm_field(r, &w) && _img_pbm_field(r, &h), ESP_ERR_INVALID_RESPONSE, TAG, "Malformed PBM header");
+        info->format = SSD1306_IMAGE_PBM;
+    }
+    else
+    {
+        if (c >= 0)
+            r->pos--;
+        ESP_RETURN_ON_FALSE(_img_xbm_header(r, &w, &h), ESP_ERR_NOT_SUPPORTED, TAG, "Not a PBM or XBM image");
+        info->format = SSD1306_IMAGE_XBM;
+    }
+    ESP_RETURN_ON_FALSE(w > 0 && h > 0 && w <= SSD1306_IMAGE_MAX_SIDE && h <= SSD1306_IMAGE_MAX_SIDE, ESP_ERR_INVALID_RESPONSE, TAG, "Invalid image size");
+    info->width = (uint16_t)w;
+    info->height = (uint16_t)h;
+
+    // Visible part of the image, in image coordinates.
+    const int32_t tw = o->canvas ? o->canvas_w : ssd1306_get_screen_width(disp);
+    const int32_t th = o->canvas ? o->canvas_h : ssd1306_get_screen_height(disp);
+    int32_t c_lo = (o->x < 0) ? -o->x : 0, c_hi = ((int32_t)w < tw - o->x) ? (int32_t)w : tw - o->x;
+    int32_t r_lo = (o->y < 0) ? -o->y : 0, r_hi = ((int32_t)h < th - o->y) ? (int32_t)h : th - o->y;
+    if (c_lo >= c_hi || r_lo >= r_hi)
+        return ESP_OK;
+
+    const uint16_t row_bytes = (uint16_t)((w + 7) / 8);
+    const bool lsb_left = (info->format == SSD1306_IMAGE_XBM);
+    uint8_t *strip = ssd1306_alloc_buffer(disp, 8 * row_bytes + (c_hi - c_lo));
+    ESP_RETURN_ON_FALSE(strip, ESP_ERR_NO_MEM, TAG, "No memory for the row strip");
+    uint8_t *out = &strip[8 * row_bytes];
+    esp_err_t ret = ESP_OK;
+
+    int32_t next = 0; // Next image row in the file.
+    for (int32_t page = (o->y + r_lo) >> 3; page <= (o->y + r_hi - 1) >> 3; page++)
+    {
+        int32_t first = page * 8 - o->y; // Image row on bit 0 of this page.
+        int32_t ra = (first > r_lo) ? first : r_lo, rb = (first + 8 < r_hi) ? first + 8 : r_hi;
+        for (; next < ra; next++)
+            ESP_GOTO_ON_FALSE(_img_row(r, info->format, NULL, row_bytes), ESP_ERR_INVALID_RESPONSE, done, TAG, "Truncated image");
+
+        uint8_t mask = 0;
+        memset(strip, 0, 8 * row_bytes);
+        for (; next < rb; next++)
+        {
+            uint8_t *row = &strip[(next - first) * row_bytes];
+            ESP_GOTO_ON_FALSE(_img_row(r, info->format, row, row_bytes), ESP_ERR_INVALID_RESPONSE, done, TAG, "Truncated image");
+            if (o->invert)
+                for (uint16_t i = 0; i < row_bytes; i++)
+                    row[i] = ~row[i];
+            mask |= 1 << (next - first);
+        }
+
+        // Transpose the 8-column blocks that overlap the visible columns.
+        for (int32_t b = c_lo >> 3; b <= (c_hi - 1) >> 3; b++)
+        {
+            uint8_t rows[8], cols[8];
+            for (int i = 0; i < 8; i++)
+                rows[i] = strip[i * row_bytes + b];
+            _ssd1306_transpose8(rows, cols, lsb_left);
+            for (int j = 0; j < 8; j++)
+            {
+                int32_t col = b * 8 + j;
+                if (col >= c_lo && col < c_hi)
+                    out[col - c_lo] = cols[j];
+            }
+        }
+        if (o->canvas)
+        {
+            uint8_t *dst = &o->canvas[page * tw + o->x + c_lo];
+            for (int32_t i = 0; i < c_hi - c_lo; i++)
+                dst[i] = (dst[i] & ~mask) | (out[i] & mask);
+        }
+        else
+        {
+            ssd1306_write_page(disp, (int16_t)(o->x + c_lo), (uint8_t)page, out, (int16_t)(c_hi - c_lo), mask);
+        }
+        info->pages++;
+    }
+
+done:
+    ssd1306_free_buffer(disp, strip);
+    return ret;
+}
+
+esp_err_t ssd1306_image_load(ssd1306_handle_t disp, const char *path, const ssd1306_image_opts_t *opts, ssd1306_image_info_t *info)
+{
+    static const ssd1306_image_opts_t defaults = {0};
+    const ssd1306_image_opts_t *o = opts ? opts : &defaults;
+    ESP_RETURN_ON_FALSE(path && (o->canvas || disp), ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(!o->canvas || (o->canvas_w > 0 && o->canvas_h > 0 && o->canvas_h % 8 == 0), ESP_ERR_INVALID_ARG, TAG, "Invalid canvas");
+    int64_t t0 = esp_timer_get_time();
+    image_reader_t *r = ssd1306_alloc_buffer(disp, sizeof(*r));
+    ESP_RETURN_ON_FALSE(r, ESP_ERR_NO_MEM, TAG, "No memory for the reader");
+    memset(r, 0, sizeof(*r));
+    r->f = fopen(path, "rb");
+    if (!r->f)
+    {
+        ssd1306_free_buffer(disp, r);
+        ESP_LOGE(TAG, "Cannot open %s", path);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    ssd1306_image_info_t result = {0};
+    esp_err_t ret = _img_load(r, disp, o, &result);
+    result.file_bytes = r->bytes;
+    result.load_us = (uint32_t)(esp_timer_get_time() - t0);
+    fclose(r->f);
+    ssd1306_free_buffer(disp, r);
+    if (info)
+        *info = result;
+    return ret;
+}
@@ -0,0 +1,235 @@
+/**
+ * @file      ssd1306_marquee.c
+ * @brief     Marquee text animated by the controller's horizontal scroll.
+ * @version   1.0
+ *
+ * Field column `j` shows column `(offset + j) % period` of the repeating text, where
+ * column 0 is the text's left edge. A scroll step moves the text one column left, so
+ * it advances `offset` by one.
+ *
+ */
+
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+
+#include "ssd1306_marquee.h"
+
+static const char *TAG = "SSD1306_MARQUEE";
+
+#define MARQUEE_DEFAULT_CHUNK 8 /**< Refill chunk used when the configuration leaves it at 0. */
+
+/**
+ * @brief Returns the number of bytes sent to the panel so far.
+ *
+ * @param m Marquee.
+ * @return uint32_t Byte counter.
+ */
+static uint32_t _marquee_bus_bytes(const ssd1306_marquee_t *m)
+{
+    ssd1306_stats_t st;
+    return ssd1306_get_stats(m->disp, &st) == ESP_OK ? st.bytes : 0;
+}
+
+/**
+ * @brief Repaints a column range of the field.
+ *
+ * @param m Marquee.
+ * @param x0 First field column.
+ * @param x1 End field column (exclusive).
+ * @param text False to only blank the range.
+ */
+static void _marquee_paint(ssd1306_marquee_t *m, int16_t x0, int16_t x1, bool text)
+{
+    ssd1306_handle_t disp = m->disp;
+    int16_t left = m->cfg.x, top = m->cfg.page * 8;
+    ssd1306_fill_rect(disp, left + x0, top, x1 - x0, m->cfg.pages * 8, OLED_COLOR_BLACK);
+    if (!text)
+        return;
+
+    // Copies of the text start at field columns that map to text column 0.
+    const GFXfont *font = (const GFXfont *)m->font->font_data;
+    // The font and clip rect belong to the application; put them back when done.
+    const ssd1306_font_handle_t *prev_font = ssd1306_get_font(disp);
+    int16_t clip_x, clip_y, clip_w, clip_h;
+    ssd1306_get_clip_rect(disp, &clip_x, &clip_y, &clip_w, &clip_h);
+    ssd1306_set_font(disp, m->font);
+    ssd1306_set_clip_rect(disp, left + x0, top, x1 - x0, m->cfg.pages * 8);
+    int16_t first = (int16_t)((m->period - m->offset % m->period) % m->period) - m->period;
+    for (int16_t start = first; start < x1; start += m->period)
+    {
+        int16_t x = start;
+        for (const char *c = m->text; *c && x < x1; c++)
+        {
+            if ((uint8_t)*c < font->first || (uint8_t)*c > font->last)
+                continue;
+            const GFXglyph *glyph = &font->glyph[(uint8_t)*c - font->first];
+            // Glyphs outside the range are skipped, so they do not widen the dirty area.
+            if (x + glyph->xOffset + glyph->width > x0 && x + glyph->xOffset < x1)
+                ssd1306_draw_char(disp, left + x, top + m->ascent, *c, OLED_COLOR_WHITE, OLED_COLOR_WHITE, 1, 1);
+            x += glyph->xAdvance;
+        }
+    }
+    ssd1306_set_clip_rect(disp, clip_x, clip_y, clip_w, clip_h);
+    ssd1306_set_font(disp, prev_font);
+}
+
+/**
+ * @brief Starts a scroll run over the field.
+ *
+ * @param m Marquee.
+ * @return esp_err_t ESP_OK if sent or parked, or the error of the transfer.
+ */
+static esp_err_t _marquee_run(ssd1306_marquee_t *m)
+{
+    ssd1306_scroll_config_t sc = {
+        .direction = ssd1306_scroll_get_screen_dir(m->disp, true),
+        .start_page = m->cfg.page,
+        .end_page = m->cfg.page + m->cfg.pages - 1,
+        .start_col = m->cfg.x,
+        .end_col = m->cfg.x + m->cfg.w - 1,
+        .speed = m->cfg.speed,
+    };
+    esp_err_t ret = ssd1306_scroll_start(m->disp, &sc);
+    if (ret != ESP_OK && ret != ESP_ERR_NOT_FINISHED)
+        return ret;
+    m->running = true;
+    m->run_since_us = (ssd1306_scroll_get_state(m->disp, NULL) == SSD1306_SCROLL_STATE_ACTIVE) ? esp_timer_get_time() : 0;
+    return ESP_OK;
+}
+
+/**
+ * @brief Ends the current scroll run and accounts for the steps it made.
+ * The driver rotates the framebuffer by the same steps, so it matches the panel again.
+ *
+ * @param m Marquee.
+ * @return uint32_t Steps of the run.
+ */
+static uint32_t _marquee_halt(ssd1306_marquee_t *m)
+{
+    bool active = ssd1306_scroll_get_state(m->disp, NULL) == SSD1306_SCROLL_STATE_ACTIVE;
+    ssd1306_stop_scroll(m->disp);
+    // With deferred commands the stop waits for a flush; send it now.
+    if (ssd1306_scroll_get_state(m->disp, NULL) != SSD1306_SCROLL_STATE_STOPPED)
+        ssd1306_update_screen(m->disp);
+    m->running = false;
+    if (!active)
+        return 0;
+    uint32_t steps = ssd1306_scroll_get_elapsed_steps(m->disp);
+    m->offset = (m->offset + steps) % m->period;
+    m->stats.steps += steps;
+    return steps;
+}
+
+esp_err_t ssd1306_marquee_start(ssd1306_marquee_t *m, ssd1306_handle_t disp, const ssd1306_marquee_config_t *cfg,
+                                const ssd1306_font_handle_t *font, const char *text)
+{
+    ESP_RETURN_ON_FALSE(m && disp && cfg && font && font->type == FONT_TYPE_GFX && text, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(cfg->w >= 2 && cfg->x + cfg->w <= ssd1306_get_screen_width(disp) && cfg->pages > 0 &&
+                        (cfg->page + cfg->pages) * 8 <= ssd1306_get_screen_height(disp), ESP_ERR_INVALID_ARG, TAG, "Invalid field");
+    ESP_RETURN_ON_FALSE(cfg->chunk < cfg->w, ESP_ERR_INVALID_ARG, TAG, "Chunk must be narrower than the field");
+    int64_t t0 = esp_timer_get_time();
+    memset(m, 0, sizeof(*m));
+    m->disp = disp;
+    m->cfg = *cfg;
+    if (m->cfg.chunk == 0)
+        m->cfg.chunk = (MARQUEE_DEFAULT_CHUNK < cfg->w) ? MARQUEE_DEFAULT_CHUNK : cfg->w / 2;
+    m->font = font;
+    m->text = text;
+
+    const GFXfont *gfx = (const GFXfont *)font->font_data;
+    uint16_t width = 0;
+    for (const char *c = text; *c; c++)
+    {
+        if ((uint8_t)*c >= gfx->first && (uint8_t)*c <= gfx->last)
+            width += gfx->glyph[(uint8_t)*c - gfx->first].xAdvance;
+    }
+    for (uint16_t c = 0; c <= gfx->last - gfx->first; c++)
+    {
+        if (-gfx->glyph[c].yOffset > m->ascent)
+            m->ascent = -gfx->glyph[c].yOffset;
+    }
+
+    // A text that fits is padded to exactly one field, so the rotation is seamless.
+    m->period = width + cfg->gap;
+    m->looping = (m->period <= cfg->w);
+    if (m->looping)
+        m->period = cfg->w;
+    else
+        m->offset = m->period - m->cfg.chunk; // The text starts right after the blank margin.
+
+    uint32_t bytes0 = _marquee_bus_bytes(m);
+    _marquee_paint(m, 0, cfg->w, true);
+    if (!m->looping)
+        _marquee_paint(m, 0, m->cfg.chunk, false);
+    esp_err_t ret = ssd1306_update_screen(disp);
+    if (ret == ESP_OK)
+        ret = _marquee_run(m);
+    m->stats.bus_bytes += _marquee_bus_bytes(m) - bytes0;
+    m->stats.cpu_us += esp_timer_get_time() - t0;
+    return ret;
+}
+
+esp_err_t ssd1306_marquee_poll(ssd1306_marquee_t *m)
+{
+    ESP_RETURN_ON_FALSE(m && m->disp, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    if (!m->running)
+        return ESP_OK;
+    int64_t t0 = esp_timer_get_time();
+    uint32_t bytes0 = _marquee_bus_bytes(m);
+    esp_err_t ret = ESP_OK;
+
+    if (m->run_since_us == 0)
+    {
+        // The start was parked for the settle time.
+        ret = ssd1306_scroll_poll(m->disp);
+        if (ssd1306_scroll_get_state(m->disp, NULL) == SSD1306_SCROLL_STATE_ACTIVE)
+            m->run_since_us = esp_timer_get_time();
+        ret = (ret == ESP_ERR_NOT_FINISHED) ? ESP_OK : ret;
+    }
+    else if (!m->looping && t0 - m->run_since_us >= (int64_t)m->cfg.chunk * ssd1306_scroll_get_step_period(m->disp, m->cfg.speed))
+    {
+        // The blank margin has wrapped around. Fill the wrapped-in columns with the next
+        // part of the text and blank a new margin; two updates keep the two ranges apart.
+        uint32_t steps = _marquee_halt(m);
+        int16_t w = m->cfg.w;
+        int16_t refill = (steps < (uint32_t)w) ? (int16_t)steps : w;
+        if (refill > 0)
+        {
+            _marquee_paint(m, w - refill, w, true);
+            ret = ssd1306_update_screen(m->disp);
+        }
+        _marquee_paint(m, 0, m->cfg.chunk, false);
+        esp_err_t err = ssd1306_update_screen(m->disp);
+        ret = (ret == ESP_OK) ? err : ret;
+        if (ret == ESP_OK)
+            ret = _marquee_run(m);
+        m->stats.refills++;
+    }
+
+    m->stats.bus_bytes += _marquee_bus_bytes(m) - bytes0;
+    m->stats.cpu_us += esp_timer_get_time() - t0;
+    return ret;
+}
+
+esp_err_t ssd1306_marquee_stop(ssd1306_marquee_t *m)
+{
+    ESP_RETURN_ON_FALSE(m && m->disp, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    if (!m->running)
+        return ESP_OK;
+    int64_t t0 = esp_timer_get_time();
+    uint32_t bytes0 = _marquee_bus_bytes(m);
+    _marquee_halt(m);
+    m->stats.bus_bytes += _marquee_bus_bytes(m) - bytes0;
+    m->stats.cpu_us += esp_timer_get_time() - t0;
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_marquee_get_stats(const ssd1306_marquee_t *m, ssd1306_marquee_stats_t *out)
+{
+    ESP_RETURN_ON_FALSE(m && out, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    *out = m->stats;
+    return ESP_OK;
+}
@@ -0,0 +1,446 @@
+/**
+ * @file      ssd1306_qr.c
+ * @brief     QR code encoder (versions 1 to 6) with fixed working buffers.
+ * @version   1.0
+ *
+ * Follows ISO/IEC 18004 for byte mode. Versions 1 to 6 need no version information
+ * blocks and have at most one alignment pattern, whose position is fixed relative to
+ * the bottom-right corner, so function modules are recognized geometrically instead of
+ * through a separate function-module map.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+
+#include "ssd1306_qr.h"
+
+static const char *TAG = "SSD1306_QR";
+
+/**
+ * @brief Error correction codewords per block, by level and version.
+ */
+static const uint8_t qr_ecc_per_block[4][SSD1306_QR_MAX_VERSION] = {
+    {7, 10, 15, 20, 26, 18},  // L
+    {10, 16, 26, 18, 24, 16}, // M
+    {13, 22, 18, 26, 18, 24}, // Q
+    {17, 28, 22, 16, 22, 28}, // H
+};
+
+/**
+ * @brief Error correction blocks, by level and version.
+ */
+static const uint8_t qr_blocks[4][SSD1306_QR_MAX_VERSION] = {
+    {1, 1, 1, 1, 1, 2}, // L
+    {1, 1, 1, 2, 2, 4}, // M
+    {1, 1, 2, 2, 4, 4}, // Q
+    {1, 1, 2, 4, 4, 4}, // H
+};
+
+/**
+ * @brief Total codewords, by version.
+ */
+static const uint8_t qr_codewords[SSD1306_QR_MAX_VERSION] = {26, 44, 70, 100, 134, 172};
+
+/**
+ * @brief Error correction level bits of the format information, by level.
+ */
+static const uint8_t qr_format_ecc[4] = {1, 0, 3, 2};
+
+/**
+ * @brief Returns the number of data codewords of a version and level.
+ *
+ * @param version Version (1 to 6).
+ * @param ecc Error correction level.
+ * @return uint16_t Data codewords.
+ */
+static uint16_t _qr_data_codewords(uint8_t version, ssd1306_qr_ecc_t ecc)
+{
+    return qr_codewords[version - 1] - qr_ecc_per_block[ecc][version - 1] * qr_blocks[ecc][version - 1];
+}
+
+/**
+ * @brief Multiplies two elements of GF(256) modulo x^8 + x^4 + x^3 + x^2 + 1.
+ *
+ * @param a Factor.
+ * @param b Factor.
+ * @return uint8_t Product.
+ */
+static uint8_t _qr_gf_mul(uint8_t a, uint8_t b)
+{
+    uint8_t r = 0;
+    while (b)
+    {
+        if (b & 1)
+            r ^= a;
+        a = (a << 1) ^ ((a & 0x80) ? 0x1D : 0);
+        b >>= 1;
+    }
+    return r;
+}
+
+/**
+ * @brief Computes the Reed-Solomon remainder of a block.
+ *
+ * @param data Data codewords.
+ * @param len Number of data codewords.
+ * @param divisor Generator polynomial without its leading term.
+ * @param degree Number of error correction codewords.
+ * @param out Output of `degree` codewords.
+ */
+static void _qr_rs_remainder(const uint8_t *data, uint16_t len, const uint8_t *divisor, uint8_t degree, uint8_t *out)
+{
+    memset(out, 0, degree);
+    for (uint16_t i = 0; i < len; i++)
+    {
+        uint8_t factor = data[i] ^ out[0];
+        memmove(out, out + 1, degree - 1);
+        out[degree - 1] = 0;
+        for (uint8_t j = 0; j < degree; j++)
+            out[j] ^= _qr_gf_mul(divisor[j], factor);
+    }
+}
+
+/**
+ * @brief Tells whether a module belongs to a function pattern (finders, separators,
+ * format information, timing or alignment pattern).
+ *
+ * @param qr Code object (version and size set).
+ * @param x Module column.
+ * @param y Module row.
+ * @return bool True for function modules.
+ */
+static bool _qr_is_function(const ssd1306_qr_t *qr, int16_t x, int16_t y)
+{
+    int16_t n = qr->size;
+    if ((x < 9 && y < 9) || (x >= n - 8 && y < 9) || (x < 9 && y >= n - 8))
+        return true;
+    if (x == 6 || y == 6)
+        return true;
+    return qr->version >= 2 && abs(x - (n - 7)) <= 2 && abs(y - (n - 7)) <= 2;
+}
+
+/**
+ * @brief Sets one module.
+ *
+ * @param qr Code object.
+ * @param x Module column.
+ * @param y Module row.
+ * @param dark True for a dark module.
+ */
+static void _qr_set(ssd1306_qr_t *qr, int16_t x, int16_t y, bool dark)
+{
+    uint16_t i = y * qr->size + x;
+    if (dark)
+        qr->modules[i >> 3] |= 1 << (i & 7);
+    else
+        qr->modules[i >> 3] &= ~(1 << (i & 7));
+}
+
+/**
+ * @brief Draws the format information for a mask (both copies) and the dark module.
+ *
+ * @param qr Code object.
+ * @param mask Mask pattern.
+ */
+static void _qr_draw_format(ssd1306_qr_t *qr, uint8_t mask)
+{
+    uint16_t data = (qr_format_ecc[qr->ecc] << 3) | mask;
+    uint16_t rem = data;
+    for (uint8_t i = 0; i < 10; i++)
+        rem = (rem << 1) ^ ((rem >> 9) * 0x537);
+    uint16_t bits = ((data << 10) | rem) ^ 0x5412;
+    int16_t n = qr->size;
+
+    for (uint8_t i = 0; i <= 5; i++)
+        _qr_set(qr, 8, i, (bits >> i) & 1);
+    _qr_set(qr, 8, 7, (bits >> 6) & 1);
+    _qr_set(qr, 8, 8, (bits >> 7) & 1);
+    _qr_set(qr, 7, 8, (bits >> 8) & 1);
+    for (uint8_t i = 9; i < 15; i++)
+        _qr_set(qr, 14 - i, 8, (bits >> i) & 1);
+    for (uint8_t i = 0; i < 8; i++)
+        _qr_set(qr, n - 1 - i, 8, (bits >> i) & 1);
+    for (uint8_t i = 8; i < 15; i++)
+        _qr_set(qr, 8, n - 15 + i, (bits >> i) & 1);
+    _qr_set(qr, 8, n - 8, true);
+}
+
+/**
+ * @brief Draws the finder, timing and alignment patterns.
+ *
+ * @param qr Code object.
+ */
+static void _qr_draw_patterns(ssd1306_qr_t *qr)
+{
+    int16_t n = qr->size;
+    for (int16_t i = 0; i < n; i++)
+    {
+        _qr_set(qr, 6, i, (i & 1) == 0);
+        _qr_set(qr, i, 6, (i & 1) == 0);
+    }
+    // Finders with their separators; the center is 3 modules in from the corner.
+    const int16_t centers[3][2] = {{3, 3}, {n - 4, 3}, {3, n - 4}};
+    for (uint8_t f = 0; f < 3; f++)
+    {
+        for (int16_t dy = -4; dy <= 4; dy++)
+        {
+            for (int16_t dx = -4; dx <= 4; dx++)
+            {
+                int16_t x = centers[f][0] + dx, y = centers[f][1] + dy;
+                int16_t dist = abs(dx) > abs(dy) ? abs(dx) : abs(dy);
+                if (x >= 0 && x < n && y >= 0 && y < n)
+                    _qr_set(qr, x, y, dist != 2 && dist != 4);
+            }
+        }
+    }
+    if (qr->version >= 2)
+    {
+        for (int16_t dy = -2; dy <= 2; dy++)
+        {
+            for (int16_t dx = -2; dx <= 2; dx++)
+                _qr_set(qr, n - 7 + dx, n - 7 + dy, (abs(dx) > abs(dy) ? abs(dx) : abs(dy)) != 1);
+        }
+    }
+}
+
+/**
+ * @brief Evaluates a mask pattern at a module.
+ *
+ * @param mask Mask pattern.
+ * @param x Module column.
+ * @param y Module row.
+ * @return bool True if the module is inverted.
+ */
+static bool _qr_mask_bit(uint8_t mask, int16_t x, int16_t y)
+{
+    switch (mask)
+    {
+    case 0: return (x + y) % 2 == 0;
+    case 1: return y % 2 == 0;
+    case 2: return x % 3 == 0;
+    case 3: return (x + y) % 3 == 0;
+    case 4: return (x / 3 + y / 2) % 2 == 0;
+    case 5: return x * y % 2 + x * y % 3 == 0;
+    case 6: return (x * y % 2 + x * y % 3) % 2 == 0;
+    default: return ((x + y) % 2 + x * y % 3) % 2 == 0;
+    }
+}
+
+/**
+ * @brief Applies (or, applied twice, removes) a mask to the data modules.
+ *
+ * @param qr Code object.
+ * @param mask Mask pattern.
+ */
+static void _qr_apply_mask(ssd1306_qr_t *qr, uint8_t mask)
+{
+    for (int16_t y = 0; y < qr->size; y++)
+    {
+        for (int16_t x = 0; x < qr->size; x++)
+        {
+            if (!_qr_is_function(qr, x, y) && _qr_mask_bit(mask, x, y))
+            {
+                uint16_t i = y * qr->size + x;
+                qr->modules[i >> 3] ^= 1 << (i & 7);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Computes the penalty score of the current symbol.
+ *
+ * @param qr Code object.
+ * @return uint32_t Penalty (lower is better).
+ */
+static uint32_t _qr_penalty(const ssd1306_qr_t *qr)
+{
+    int16_t n = qr->size;
+    uint32_t penalty = 0;
+    uint16_t dark = 0;
+
+    // Runs of five or more same-colored modules and finder-like patterns, in rows
+    // (pass 0) and columns (pass 1). Modules outside the symbol count as light.
+    for (uint8_t pass = 0; pass < 2; pass++)
+    {
+        for (int16_t a = 0; a < n; a++)
+        {
+            int16_t run = 0;
+            bool color = false;
+            uint16_t history = 0; // Last modules of the line, newest in bit 0.
+            for (int16_t b = 0; b < n + 4; b++)
+            {
+                bool m = b < n && ssd1306_qr_get_module(qr, pass ? a : b, pass ? b : a);
+                if (b < n)
+                {
+                    if (b > 0 && m == color)
+                        run++;
+                    else
+                    {
+                        if (run >= 5)
+                            penalty += run - 2;
+                        color = m;
+                        run = 1;
+                    }
+                }
+                history = ((history << 1) | m) & 0x7FF;
+                // 1:1:3:1:1 dark-light ratio with four light modules on either side.
+                if (b >= 6 && (history == 0x05D || (history == 0x5D0 && b >= 10)))
+                    penalty += 40;
+            }
+            if (run >= 5)
+                penalty += run - 2;
+        }
+    }
+    for (int16_t y = 0; y < n; y++)
+    {
+        for (int16_t x = 0; x < n; x++)
+        {
+            bool m = ssd1306_qr_get_module(qr, x, y);
+            dark += m;
+            if (x + 1 < n && y + 1 < n && m == ssd1306_qr_get_module(qr, x + 1, y) &&
+                m == ssd1306_qr_get_module(qr, x, y + 1) && m == ssd1306_qr_get_module(qr, x + 1, y + 1))
+                penalty += 3;
+        }
+    }
+    // 10 points per 5% the dark share deviates from 50%.
+    uint32_t total = (uint32_t)n * n;
+    uint32_t dev = dark * 20 > total * 10 ? dark * 20 - total * 10 : total * 10 - dark * 20;
+    penalty += ((dev + total - 1) / total - 1) * 10;
+    return penalty;
+}
+
+esp_err_t ssd1306_qr_encode(ssd1306_qr_t *qr, const void *data, size_t len, ssd1306_qr_ecc_t ecc, uint8_t min_version)
+{
+    ESP_RETURN_ON_FALSE(qr && (data || len == 0) && ecc <= SSD1306_QR_ECC_H, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(min_version <= SSD1306_QR_MAX_VERSION, ESP_ERR_INVALID_ARG, TAG, "Invalid version");
+    int64_t t0 = esp_timer_get_time();
+
+    // Smallest version that holds mode (4 bits), count (8 bits) and payload.
+    uint8_t version = min_version ? min_version : 1;
+    while (version <= SSD1306_QR_MAX_VERSION && 12 + 8 * len > 8u * _qr_data_codewords(version, ecc))
+        version++;
+    ESP_RETURN_ON_FALSE(version <= SSD1306_QR_MAX_VERSION, ESP_ERR_INVALID_SIZE, TAG, "Data too long for version %d", SSD1306_QR_MAX_VERSION);
+    while (ecc < SSD1306_QR_ECC_H && 12 + 8 * len <= 8u * _qr_data_codewords(version, ecc + 1))
+        ecc++;
+    qr->version = version;
+    qr->size = 4 * version + 17;
+    qr->ecc = ecc;
+
+    // Data codewords: mode 0100, count, payload, terminator and 0xEC/0x11 padding. The
+    // 4-bit mode shifts everything after it by half a byte.
+    const uint8_t *src = data;
+    uint16_t data_len = _qr_data_codewords(version, ecc);
+    uint8_t prev = (uint8_t)len;
+    qr->data[0] = 0x40 | (prev >> 4);
+    for (size_t i = 0; i < len; i++)
+    {
+        qr->data[1 + i] = (uint8_t)((prev & 0x0F) << 4 | src[i] >> 4);
+        prev = src[i];
+    }
+    qr->data[1 + len] = (uint8_t)((prev & 0x0F) << 4);
+    for (uint16_t i = len + 2; i < data_len; i++)
+        qr->data[i] = ((i - len) & 1) ? 0x11 : 0xEC;
+
+    // Error correction per block, then interleave the blocks.
+    uint8_t blocks = qr_blocks[ecc][version - 1];
+    uint8_t ecc_len = qr_ecc_per_block[ecc][version - 1];
+    uint16_t raw = qr_codewords[version - 1];
+    uint8_t short_blocks = blocks - raw % blocks;
+    uint8_t short_len = raw / blocks - ecc_len; // Data codewords of a short block.
+
+    uint8_t divisor[30] = {0};
+    divisor[ecc_len - 1] = 1;
+    uint8_t root = 1;
+    for (uint8_t i = 0; i < ecc_len; i++)
+    {
+        for (uint8_t j = 0; j < ecc_len; j++)
+        {
+            divisor[j] = _qr_gf_mul(divisor[j], root);
+            if (j + 1 < ecc_len)
+                divisor[j] ^= divisor[j + 1];
+        }
+        root = _qr_gf_mul(root, 0x02);
+    }
+
+    uint8_t ecc_buf[30];
+    uint16_t offset = 0;
+    for (uint8_t b = 0; b < blocks; b++)
+    {
+        uint8_t dlen = short_len + (b >= short_blocks);
+        for (uint8_t i = 0; i < dlen; i++)
+        {
+            // Long blocks have one more data codeword; short ones skip that column.
+            uint16_t pos = (i < short_len) ? (uint16_t)i * blocks + b : (uint16_t)short_len * blocks + (b - short_blocks);
+            qr->codewords[pos] = qr->data[offset + i];
+        }
+        _qr_rs_remainder(&qr->data[offset], dlen, divisor, ecc_len, ecc_buf);
+        for (uint8_t i = 0; i < ecc_len; i++)
+            qr->codewords[data_len + (uint16_t)i * blocks + b] = ecc_buf[i];
+        offset += dlen;
+    }
+
+    // Function patterns, then the codewords in the two-column zigzag from the bottom right.
+    memset(qr->modules, 0, sizeof(qr->modules));
+    _qr_draw_patterns(qr);
+    _qr_draw_format(qr, 0);
+    uint16_t bit = 0;
+    for (int16_t right = qr->size - 1; right >= 1; right -= 2)
+    {
+        if (right == 6)
+            right = 5;
+        bool upward = ((right + 1) & 2) == 0;
+        for (int16_t vert = 0; vert < qr->size; vert++)
+        {
+            for (int16_t j = 0; j < 2; j++)
+            {
+                int16_t x = right - j;
+                int16_t y = upward ? qr->size - 1 - vert : vert;
+                if (!_qr_is_function(qr, x, y) && bit < raw * 8)
+                {
+                    _qr_set(qr, x, y, (qr->codewords[bit >> 3] >> (7 - (bit & 7))) & 1);
+                    bit++;
+                }
+            }
+        }
+    }
+
+    // Keep the mask with the lowest penalty.
+    uint32_t best_penalty = UINT32_MAX;
+    for (uint8_t mask = 0; mask < 8; mask++)
+    {
+        _qr_apply_mask(qr, mask);
+        _qr_draw_format(qr, mask);
+        uint32_t penalty = _qr_penalty(qr);
+        if (penalty < best_penalty)
+        {
+            best_penalty = penalty;
+            qr->mask = mask;
+        }
+        _qr_apply_mask(qr, mask);
+    }
+    _qr_apply_mask(qr, qr->mask);
+    _qr_draw_format(qr, qr->mask);
+
+    qr->encode_us = (uint32_t)(esp_timer_get_time() - t0);
+    qr->render_us = 0;
+    return ESP_OK;
+}
+
+bool ssd1306_qr_get_module(const ssd1306_qr_t *qr, int16_t x, int16_t y)
+{
+    if (!qr || x < 0 || y < 0 || x >= qr->size || y >= qr->size)
+        return false;
+    uint16_t i = y * qr->size + x;
+    return (qr->modules[i >> 3] >> (i & 7)) & 1;
+}
+
+int16_t ssd1306_qr_get_pixel_size(const ssd1306_qr_t *qr, uint8_t scale, uint8_t quiet)
+{
+    return qr ? (int16_t)(qr->size + 2 * quiet) * scale : 0;
+}
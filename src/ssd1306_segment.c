@@ -0,0 +1,317 @@
+/**
+ * @file      ssd1306_segment.c
+ * @brief     Large seven- and fourteen-segment numeric display widget.
+ * @version   1.0
+ *
+ * Segment geometry inside a cell uses the centre lines of the outer bars (left, right,
+ * top, middle, bottom) and the half thickness `t`. Bars taper to a point at both ends
+ * and the inner segments keep a gap of one pixel to everything else, so no two segments
+ * ever share a pixel.
+ *
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_check.h"
+
+#include "ssd1306_segment.h"
+
+static const char *TAG = "SSD1306_SEG";
+
+#define SEG_DP (1 << 14) /**< Decimal point bit. */
+
+/**
+ * @brief Seven-segment patterns for ' ' to 'Z' (lower case maps to upper case).
+ */
+static const uint8_t seg7_font[] = {
+    [' ' - ' '] = 0x00, ['-' - ' '] = 0x40, ['_' - ' '] = 0x08, ['=' - ' '] = 0x48,
+    ['0' - ' '] = 0x3F, ['1' - ' '] = 0x06, ['2' - ' '] = 0x5B, ['3' - ' '] = 0x4F, ['4' - ' '] = 0x66,
+    ['5' - ' '] = 0x6D, ['6' - ' '] = 0x7D, ['7' - ' '] = 0x07, ['8' - ' '] = 0x7F, ['9' - ' '] = 0x6F,
+    ['A' - ' '] = 0x77, ['B' - ' '] = 0x7C, ['C' - ' '] = 0x39, ['D' - ' '] = 0x5E, ['E' - ' '] = 0x79,
+    ['F' - ' '] = 0x71, ['H' - ' '] = 0x76, ['L' - ' '] = 0x38, ['N' - ' '] = 0x54, ['O' - ' '] = 0x5C,
+    ['P' - ' '] = 0x73, ['R' - ' '] = 0x50, ['T' - ' '] = 0x78, ['U' - ' '] = 0x3E, ['Y' - ' '] = 0x6E,
+};
+
+/**
+ * @brief Fourteen-segment patterns for ' ' to 'Z' (lower case maps to upper case).
+ */
+static const uint16_t seg14_font[] = {
+    [' ' - ' '] = 0x0000, ['*' - ' '] = 0x3FC0, ['+' - ' '] = 0x12C0, ['-' - ' '] = 0x00C0,
+    ['/' - ' '] = 0x0C00, ['\\' - ' '] = 0x2100, ['_' - ' '] = 0x0008, ['=' - ' '] = 0x00C8,
+    ['0' - ' '] = 0x0C3F, ['1' - ' '] = 0x0406, ['2' - ' '] = 0x00DB, ['3' - ' '] = 0x008F, ['4' - ' '] = 0x00E6,
+    ['5' - ' '] = 0x00ED, ['6' - ' '] = 0x00FD, ['7' - ' '] = 0x0007, ['8' - ' '] = 0x00FF, ['9' - ' '] = 0x00EF,
+    ['A' - ' '] = 0x00F7, ['B' - ' '] = 0x128F, ['C' - ' '] = 0x0039, ['D' - ' '] = 0x120F, ['E' - ' '] = 0x0079,
+    ['F' - ' '] = 0x0071, ['G' - ' '] = 0x00BD, ['H' - ' '] = 0x00F6, ['I' - ' '] = 0x1209, ['J' - ' '] = 0x001E,
+    ['K' - ' '] = 0x2470, ['L' - ' '] = 0x0038, ['M' - ' '] = 0x0536, ['N' - ' '] = 0x2136, ['O' - ' '] = 0x003F,
+    ['P' - ' '] = 0x00F3, ['Q' - ' '] = 0x203F, ['R' - ' '] = 0x20F3, ['S' - ' '] = 0x00ED, ['T' - ' '] = 0x1201,
+    ['U' - ' '] = 0x003E, ['V' - ' '] = 0x0C30, ['W' - ' '] = 0x2836, ['X' - ' '] = 0x2D00, ['Y' - ' '] = 0x1500,
+    ['Z' - ' '] = 0x0C09,
+};
+
+/**
+ * @brief Draws a horizontal bar tapered to a point at both ends.
+ *
+ * @param disp Display.
+ * @param x0 First column.
+ * @param x1 Last column.
+ * @param yc Centre row.
+ * @param t Half thickness.
+ * @param color Color.
+ */
+static void _seg_hbar(ssd1306_handle_t disp, int16_t x0, int16_t x1, int16_t yc, int16_t t, ssd1306_color_t color)
+{
+    for (int16_t x = x0; x <= x1; x++)
+    {
+        int16_t d = (x - x0 < x1 - x) ? x - x0 : x1 - x;
+        int16_t hh = (d < t) ? d : t;
+        ssd1306_draw_fast_vline(disp, x, yc - hh, 2 * hh + 1, color);
+    }
+}
+
+/**
+ * @brief Draws a vertical bar tapered to a point at both ends.
+ *
+ * @param disp Display.
+ * @param xc Centre column.
+ * @param y0 First row.
+ * @param y1 Last row.
+ * @param t Half thickness.
+ * @param color Color.
+ */
+static void _seg_vbar(ssd1306_handle_t disp, int16_t xc, int16_t y0, int16_t y1, int16_t t, ssd1306_color_t color)
+{
+    for (int16_t j = -t; j <= t; j++)
+    {
+        int16_t a = (j < 0) ? -j : j;
+        if (y1 - y0 + 1 - 2 * a > 0)
+            ssd1306_draw_fast_vline(disp, xc + j, y0 + a, y1 - y0 + 1 - 2 * a, color);
+    }
+}
+
+/**
+ * @brief Draws a diagonal bar as one vertical span per column.
+ *
+ * @param disp Display.
+ * @param x0 Start column (must be left of `x1`).
+ * @param y0 Start row.
+ * @param x1 End column.
+ * @param y1 End row.
+ * @param t Half thickness.
+ * @param color Color.
+ */
+static void _seg_diag(ssd1306_handle_t disp, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t t, ssd1306_color_t color)
+{
+    if (x1 <= x0)
+        return;
+    int16_t dx = x1 - x0, dy = y1 - y0;
+    for (int16_t x = x0; x <= x1; x++)
+    {
+        // Each column spans from its own row to the next column's row, so steep
+        // diagonals stay connected.
+        int16_t y = y0 + (dy * (x - x0) * 2 + dx) / (2 * dx);
+        int16_t y_next = (x < x1) ? y0 + (dy * (x + 1 - x0) * 2 + dx) / (2 * dx) : y;
+        int16_t top = (y < y_next ? y : y_next) - t;
+        int16_t bottom = (y > y_next ? y : y_next) + t;
+        ssd1306_draw_fast_vline(disp, x, top, bottom - top + 1, color);
+    }
+}
+
+/**
+ * @brief Returns the width of a cell.
+ *
+ * @param seg Segment display.
+ * @param colon True for a colon cell.
+ * @return int16_t Width in pixels, without spacing.
+ */
+static int16_t _seg_cell_w(const ssd1306_seg_display_t *seg, bool colon)
+{
+    return colon ? 2 * (seg->cfg.thickness / 2) + 1 : seg->cfg.digit_w;
+}
+
+/**
+ * @brief Draws or erases one segment of a cell.
+ *
+ * @param seg Segment display.
+ * @param x Left edge of the cell.
+ * @param colon True for a colon cell.
+ * @param bit Segment bit.
+ * @param color OLED_COLOR_WHITE to draw, OLED_COLOR_BLACK to erase.
+ */
+static void _seg_draw(const ssd1306_seg_display_t *seg, int16_t x, bool colon, uint8_t bit, ssd1306_color_t color)
+{
+    ssd1306_handle_t disp = seg->disp;
+    const ssd1306_seg_config_t *cfg = &seg->cfg;
+    int16_t t = cfg->thickness / 2;
+    int16_t size = 2 * t + 1;
+    int16_t lx = x + t, rx = x + cfg->digit_w - 1 - t, cx = x + (cfg->digit_w - 1) / 2;
+    int16_t ty = cfg->y + t, my = cfg->y + (cfg->digit_h - 1) / 2, by = cfg->y + cfg->digit_h - 1 - t;
+
+    if (colon)
+    {
+        ssd1306_fill_rect(disp, x, cfg->y + cfg->digit_h / 3 - t, size, size, color);
+        ssd1306_fill_rect(disp, x, cfg->y + (2 * cfg->digit_h) / 3 - t, size, size, color);
+        return;
+    }
+    bool split = (cfg->style == SSD1306_SEG_14);
+    if (!split && bit >= 7 && bit <= 13)
+        return;
+    switch (bit)
+    {
+    case 0: _seg_hbar(disp, lx + 1, rx - 1, ty, t, color); break;
+    case 1: _seg_vbar(disp, rx, ty + 1, my - 1, t, color); break;
+    case 2: _seg_vbar(disp, rx, my + 1, by - 1, t, color); break;
+    case 3: _seg_hbar(disp, lx + 1, rx - 1, by, t, color); break;
+    case 4: _seg_vbar(disp, lx, my + 1, by - 1, t, color); break;
+    case 5: _seg_vbar(disp, lx, ty + 1, my - 1, t, color); break;
+    case 6: _seg_hbar(disp, lx + 1, split ? cx - 1 : rx - 1, my, t, color); break;
+    case 7: _seg_hbar(disp, cx + 1, rx - 1, my, t, color); break;
+    case 8: _seg_diag(disp, lx + t + 2, ty + 2 * t + 2, cx - t - 2, my - 2 * t - 2, t, color); break;
+    case 9: _seg_vbar(disp, cx, ty + t + 2, my - t - 2, t, color); break;
+    case 10: _seg_diag(disp, cx + t + 2, my - 2 * t - 2, rx - t - 2, ty + 2 * t + 2, t, color); break;
+    case 11: _seg_diag(disp, lx + t + 2, by - 2 * t - 2, cx - t - 2, my + 2 * t + 2, t, color); break;
+    case 12: _seg_vbar(disp, cx, my + t + 2, by - t - 2, t, color); break;
+    case 13: _seg_diag(disp, cx + t + 2, my + 2 * t + 2, rx - t - 2, by - 2 * t - 2, t, color); break;
+    case 14:
+        if (cfg->spacing >= size)
+            ssd1306_fill_rect(disp, x + cfg->digit_w + (cfg->spacing - size) / 2, by - t, size, size, color);
+        break;
+    }
+}
+
+/**
+ * @brief Looks up the segment pattern of a character.
+ *
+ * @param seg Segment display.
+ * @param c Character.
+ * @return uint16_t Segment bits (0 for unsupported characters).
+ */
+static uint16_t _seg_glyph(const ssd1306_seg_display_t *seg, char c)
+{
+    unsigned idx = (unsigned)toupper((unsigned char)c) - ' ';
+    if (seg->cfg.style == SSD1306_SEG_14)
+        return idx < sizeof(seg14_font) / sizeof(seg14_font[0]) ? seg14_font[idx] : 0;
+    return idx < sizeof(seg7_font) ? seg7_font[idx] : 0;
+}
+
+esp_err_t ssd1306_seg_init(ssd1306_seg_display_t *seg, ssd1306_handle_t disp, const ssd1306_seg_config_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(seg && disp && cfg && cfg->thickness > 0, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    int16_t size = 2 * (cfg->thickness / 2) + 1;
+    ESP_RETURN_ON_FALSE(cfg->digit_w >= 2 * size + 3 && cfg->digit_h >= 2 * size + 5, ESP_ERR_INVALID_ARG, TAG,
+                        "Digit too small for the segment thickness");
+    memset(seg, 0, sizeof(*seg));
+    seg->disp = disp;
+    seg->cfg = *cfg;
+    return ESP_OK;
+}
+
+uint16_t ssd1306_seg_set_text(ssd1306_seg_display_t *seg, const char *text)
+{
+    if (!seg || !text)
+        return 0;
+
+    // Parse the text into cells.
+    uint8_t cells = 0;
+    bool colon[SSD1306_SEG_MAX_CELLS] = {0};
+    uint16_t mask[SSD1306_SEG_MAX_CELLS] = {0};
+    for (; *text; text++)
+    {
+        if (*text == '.' && cells > 0 && !colon[cells - 1])
+        {
+            mask[cells - 1] |= SEG_DP;
+            continue;
+        }
+        if (cells == SSD1306_SEG_MAX_CELLS)
+            break;
+        colon[cells] = (*text == ':' || *text == ';');
+        mask[cells] = colon[cells] ? (*text == ':') : _seg_glyph(seg, *text);
+        cells++;
+    }
+
+    bool same_layout = (cells == seg->cells) && memcmp(colon, seg->colon, sizeof(colon)) == 0;
+    uint16_t toggled = 0;
+    if (!same_layout)
+    {
+        // The cells move; clear the old and the new extent and start from blank cells.
+        int16_t old_w = 0, new_w = 0;
+        for (uint8_t i = 0; i < seg->cells; i++)
+            old_w += _seg_cell_w(seg, seg->colon[i]) + seg->cfg.spacing;
+        for (uint8_t i = 0; i < cells; i++)
+            new_w += _seg_cell_w(seg, colon[i]) + seg->cfg.spacing;
+        ssd1306_fill_rect(seg->disp, seg->cfg.x, seg->cfg.y, old_w > new_w ? old_w : new_w, seg->cfg.digit_h, OLED_COLOR_BLACK);
+        memset(seg->mask, 0, sizeof(seg->mask));
+        memcpy(seg->colon, colon, sizeof(colon));
+        seg->cells = cells;
+    }
+
+    int16_t x = seg->cfg.x;
+    for (uint8_t i = 0; i < cells; i++)
+    {
+        uint16_t diff = seg->mask[i] ^ mask[i];
+        for (uint8_t bit = 0; diff; bit++, diff >>= 1)
+        {
+            if (diff & 1)
+            {
+                _seg_draw(seg, x, colon[i], bit, (mask[i] >> bit) & 1 ? OLED_COLOR_WHITE : OLED_COLOR_BLACK);
+                toggled++;
+            }
+        }
+        seg->mask[i] = mask[i];
+        x += _seg_cell_w(seg, colon[i]) + seg->cfg.spacing;
+    }
+    seg->last_toggled = toggled;
+    return toggled;
+}
+
+uint16_t ssd1306_seg_set_number(ssd1306_seg_display_t *seg, int32_t value, uint8_t decimals, uint8_t cells)
+{
+    if (!seg || cells == 0 || cells > SSD1306_SEG_MAX_CELLS || decimals >= cells)
+        return 0;
+    char digits[16];
+    char text[SSD1306_SEG_MAX_CELLS + 2];
+    int64_t mag = value < 0 ? -(int64_t)value : value;
+    int len = snprintf(digits, sizeof(digits), "%0*lld", decimals + 1, (long long)mag);
+    int used = len + (value < 0);
+    if (used > cells)
+    {
+        // Does not fit: show dashes.
+        memset(text, '-', cells);
+        text[cells] = '\0';
+        return ssd1306_seg_set_text(seg, text);
+    }
+
+    int n = 0;
+    for (int i = used; i < cells; i++)
+        text[n++] = ' ';
+    if (value < 0)
+        text[n++] = '-';
+    for (int i = 0; i < len; i++)
+    {
+        text[n++] = digits[i];
+        if (decimals && i == len - 1 - decimals)
+            text[n++] = '.';
+    }
+    text[n] = '\0';
+    return ssd1306_seg_set_text(seg, text);
+}
+
+void ssd1306_seg_redraw(ssd1306_seg_display_t *seg)
+{
+    if (!seg)
+        return;
+    int16_t x = seg->cfg.x;
+    for (uint8_t i = 0; i < seg->cells; i++)
+    {
+        int16_t w = _seg_cell_w(seg, seg->colon[i]) + seg->cfg.spacing;
+        ssd1306_fill_rect(seg->disp, x, seg->cfg.y, w, seg->cfg.digit_h, OLED_COLOR_BLACK);
+        for (uint8_t bit = 0; bit < 15; bit++)
+        {
+            if ((seg->mask[i] >> bit) & 1)
+                _seg_draw(seg, x, seg->colon[i], bit, OLED_COLOR_WHITE);
+        }
+        x += w;
+    }
+}
@@ -0,0 +1,267 @@
+/**
+ * @file      ssd1306_textbox.c
+ * @brief     Word-wrapped text box with cached line breaks.
+ * @version   1.0
+ *
+ * The layout walks the text once, keeping the last word boundary of the current line,
+ * and records each line as a (start, length, width) entry. Drawing only reads the
+ * line table.
+ *
+ */
+
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_check.h"
+
+#include "ssd1306_textbox.h"
+
+static const char *TAG = "SSD1306_TEXTBOX";
+
+/**
+ * @brief Returns the advance of a character, 0 if the font does not have it.
+ *
+ * @param font GFX font.
+ * @param c Character.
+ * @return uint16_t Advance in pixels.
+ */
+static uint16_t _tb_advance(const GFXfont *font, uint8_t c)
+{
+    return (c >= font->first && c <= font->last) ? font->glyph[c - font->first].xAdvance : 0;
+}
+
+/**
+ * @brief Returns the FNV-1a hash of a text.
+ *
+ * @param text Text.
+ * @param len Length.
+ * @return uint32_t Hash.
+ */
+static uint32_t _tb_hash(const char *text, uint16_t len)
+{
+    uint32_t hash = 2166136261u;
+    for (uint16_t i = 0; i < len; i++)
+        hash = (hash ^ (uint8_t)text[i]) * 16777619u;
+    return hash;
+}
+
+/**
+ * @brief Returns the line table: the caller's, or the built-in one.
+ *
+ * @param tb Text box.
+ * @return ssd1306_textbox_line_t* Line table.
+ */
+static ssd1306_textbox_line_t *_tb_lines(ssd1306_textbox_t *tb)
+{
+    return tb->cfg.lines ? tb->cfg.lines : tb->line_buf;
+}
+
+/**
+ * @brief Returns the number of entries in the line table.
+ *
+ * @param tb Text box.
+ * @return uint16_t Table size.
+ */
+static uint16_t _tb_table_size(const ssd1306_textbox_t *tb)
+{
+    return tb->cfg.lines ? tb->cfg.max_lines : SSD1306_TEXTBOX_MAX_LINES;
+}
+
+/**
+ * @brief Tells whether the text was cut off because the line table is full.
+ *
+ * @param tb Text box.
+ * @return bool true if text did not fit in the table.
+ */
+static bool _tb_table_full(const ssd1306_textbox_t *tb)
+{
+    if (!tb->truncated || tb->line_count < _tb_table_size(tb))
+        return false;
+    // With ellipsis, a box with no more rows than the table would have cut the text anyway.
+    uint16_t rows = tb->cfg.h / tb->line_h;
+    return !tb->cfg.ellipsis || rows > tb->line_count;
+}
+
+/**
+ * @brief Breaks the text into lines and fills the line table.
+ *
+ * @param tb Text box.
+ */
+static void _tb_layout(ssd1306_textbox_t *tb)
+{
+    const GFXfont *font = (const GFXfont *)tb->font->font_data;
+    ssd1306_textbox_line_t *lines = _tb_lines(tb);
+    const char *t = tb->text;
+    const uint16_t n = tb->text_len, w = tb->cfg.w, space = _tb_advance(font, ' ');
+    uint16_t max_lines = _tb_table_size(tb);
+    if (tb->cfg.ellipsis)
+    {
+        uint16_t rows = tb->cfg.h / tb->line_h;
+        max_lines = (rows < 1) ? 1 : (rows < max_lines ? rows : max_lines);
+    }
+    tb->layouts++;
+    tb->line_count = 0;
+    tb->truncated = false;
+
+    uint16_t i = 0;
+    while (i < n)
+    {
+        if (tb->line_count == max_lines)
+        {
+            tb->truncated = true;
+            break;
+        }
+        uint16_t start = i, width = 0, end, next;
+        uint16_t brk_end = 0, brk_next = 0, brk_width = 0;
+        bool brk = false, wrapped = false;
+        while (true)
+        {
+            if (i == n || t[i] == '\n')
+            {
+                end = i;
+                next = (i == n) ? n : i + 1;
+                break;
+            }
+            uint16_t a = _tb_advance(font, (uint8_t)t[i]);
+            if (width + a > w && i > start)
+            {
+                // Break after the last space, or inside a word wider than the box.
+                end = brk ? brk_end : i;
+                next = brk ? brk_next : i;
+                width = brk ? brk_width : width;
+                wrapped = true;
+                break;
+            }
+            if (t[i] == ' ')
+            {
+                brk = true;
+                brk_end = i;
+                brk_next = i + 1;
+                brk_width = width;
+            }
+            width += a;
+            i++;
+        }
+        while (end > start && t[end - 1] == ' ')
+        {
+            end--;
+            width -= space;
+        }
+        if (wrapped)
+        {
+            while (next < n && t[next] == ' ')
+                next++; // Spaces at a wrap belong to neither line.
+        }
+        lines[tb->line_count++] = (ssd1306_textbox_line_t){.start = start, .len = end - start, .width = width};
+        i = next;
+    }
+
+    // Text cut off by a full table is marked even without ellipsis, so it does not go unnoticed.
+    if (tb->truncated && (tb->cfg.ellipsis || _tb_table_full(tb)))
+    {
+        ssd1306_textbox_line_t *line = &lines[tb->line_count - 1];
+        uint16_t dots = 3 * _tb_advance(font, '.');
+        while (line->len > 0 && (line->width + dots > w || t[line->start + line->len - 1] == ' '))
+        {
+            line->len--;
+            line->width -= _tb_advance(font, (uint8_t)t[line->start + line->len]);
+        }
+        line->width += dots;
+        line->ellipsis = true;
+    }
+}
+
+esp_err_t ssd1306_textbox_init(ssd1306_textbox_t *tb, ssd1306_handle_t disp, const ssd1306_textbox_config_t *cfg, const ssd1306_font_handle_t *font)
+{
+    ESP_RETURN_ON_FALSE(tb && disp && cfg && font && font->type == FONT_TYPE_GFX, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(cfg->w > 0 && cfg->h > 0 && cfg->align <= SSD1306_TEXT_ALIGN_RIGHT, ESP_ERR_INVALID_ARG, TAG, "Invalid box");
+    ESP_RETURN_ON_FALSE(!cfg->lines || cfg->max_lines > 0, ESP_ERR_INVALID_ARG, TAG, "Empty line table");
+    memset(tb, 0, sizeof(*tb));
+    tb->disp = disp;
+    tb->cfg = *cfg;
+    tb->font = font;
+
+    // Lines are positioned by their top edge; the baseline offset is the tallest glyph's ascent.
+    const GFXfont *gfx = (const GFXfont *)font->font_data;
+    for (uint16_t c = 0; c <= gfx->last - gfx->first; c++)
+    {
+        if (-gfx->glyph[c].yOffset > tb->ascent)
+            tb->ascent = -gfx->glyph[c].yOffset;
+    }
+    tb->line_h = gfx->yAdvance;
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_textbox_set_text(ssd1306_textbox_t *tb, const char *text)
+{
+    ESP_RETURN_ON_FALSE(tb && tb->font && text, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    size_t len = strlen(text);
+    ESP_RETURN_ON_FALSE(len <= UINT16_MAX, ESP_ERR_INVALID_ARG, TAG, "Text too long");
+    uint32_t hash = _tb_hash(text, (uint16_t)len);
+    if (!tb->layouts || text != tb->text || len != tb->text_len || hash != tb->text_hash)
+    {
+        tb->text = text;
+        tb->text_len = (uint16_t)len;
+        tb->text_hash = hash;
+        tb->scroll = 0;
+        _tb_layout(tb);
+    }
+    ESP_RETURN_ON_FALSE(!_tb_table_full(tb), ESP_ERR_INVALID_SIZE, TAG, "Text cut off after %u lines", tb->line_count);
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_textbox_set_scroll(ssd1306_textbox_t *tb, int16_t offset)
+{
+    ESP_RETURN_ON_FALSE(tb && tb->font, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    int16_t max = ssd1306_textbox_get_content_height(tb) - tb->cfg.h;
+    offset = (offset > max) ? max : offset;
+    tb->scroll = (offset < 0) ? 0 : offset;
+    return ESP_OK;
+}
+
+int16_t ssd1306_textbox_get_content_height(const ssd1306_textbox_t *tb)
+{
+    return (tb && tb->font) ? (int16_t)(tb->line_count * tb->line_h) : 0;
+}
+
+esp_err_t ssd1306_textbox_draw(ssd1306_textbox_t *tb)
+{
+    ESP_RETURN_ON_FALSE(tb && tb->disp && tb->font, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ssd1306_handle_t disp = tb->disp;
+    const GFXfont *font = (const GFXfont *)tb->font->font_data;
+    const ssd1306_textbox_config_t *cfg = &tb->cfg;
+    ssd1306_fill_rect(disp, cfg->x, cfg->y, cfg->w, cfg->h, OLED_COLOR_BLACK);
+    // Draw with the box's font and clip, then hand the caller's back.
+    const ssd1306_font_handle_t *prev_font = ssd1306_get_font(disp);
+    int16_t clip_x, clip_y, clip_w, clip_h;
+    ssd1306_get_clip_rect(disp, &clip_x, &clip_y, &clip_w, &clip_h);
+    ssd1306_set_font(disp, tb->font);
+    ssd1306_set_clip_rect(disp, cfg->x, cfg->y, cfg->w, cfg->h);
+
+    for (uint16_t k = tb->scroll / tb->line_h; k < tb->line_count; k++)
+    {
+        int16_t top = cfg->y + k * tb->line_h - tb->scroll;
+        if (top >= cfg->y + cfg->h)
+            break;
+        const ssd1306_textbox_line_t *line = &_tb_lines(tb)[k];
+        int16_t x = cfg->x;
+        if (cfg->align == SSD1306_TEXT_ALIGN_CENTER)
+            x += (cfg->w - line->width) / 2;
+        else if (cfg->align == SSD1306_TEXT_ALIGN_RIGHT)
+            x += cfg->w - line->width;
+        for (uint16_t j = 0; j < line->len; j++)
+        {
+            uint8_t c = (uint8_t)tb->text[line->start + j];
+            ssd1306_draw_char(disp, x, top + tb->ascent, c, OLED_COLOR_WHITE, OLED_COLOR_WHITE, 1, 1);
+            x += _tb_advance(font, c);
+        }
+        for (uint8_t j = 0; line->ellipsis && j < 3; j++)
+        {
+            ssd1306_draw_char(disp, x, top + tb->ascent, '.', OLED_COLOR_WHITE, OLED_COLOR_WHITE, 1, 1);
+            x += _tb_advance(font, '.');
+        }
+    }
+    ssd1306_set_clip_rect(disp, clip_x, clip_y, clip_w, clip_h);
+    ssd1306_set_font(disp, prev_font);
+    return ESP_OK;
+}
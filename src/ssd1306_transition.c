@@ -0,0 +1,331 @@
+/**
+ * @file      ssd1306_transition.c
+ * @brief     Screen transitions between two canvases with per-frame budgets.
+ * @version   1.0
+ *
+ * Frames are composed one page row at a time into a row buffer. Horizontal effects are
+ * block copies of canvas rows; vertical effects merge two rows through a row mask,
+ * shifting canvas bytes across page boundaries where content moves vertically.
+ *
+ */
+
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+
+#include "ssd1306_transition.h"
+
+static const char *TAG = "SSD1306_TRANSITION";
+
+#define TRANSITION_MAX_WIDTH 128 /**< Widest supported display (size of the row buffer). */
+#define TRANSITION_START_LINE_ROWS 64 /**< GDDRAM rows the display start line wraps around. */
+#define TRANSITION_FLUSH_OVERHEAD 16  /**< Command bytes reserved per flush when sizing a budgeted step. */
+
+/**
+ * @brief 4x4 ordered dither (Bayer) thresholds, indexed [y % 4][x % 4].
+ */
+static const uint8_t tr_bayer[4][4] = {
+    {0, 8, 2, 10},
+    {12, 4, 14, 6},
+    {3, 11, 1, 9},
+    {15, 7, 13, 5},
+};
+
+/**
+ * @brief Returns the rows [8 * page + shift, 8 * page + shift + 8) of a canvas column
+ * as one page byte. Rows outside the canvas read as 0.
+ *
+ * @param img Canvas.
+ * @param w Canvas width.
+ * @param pages Canvas height in pages.
+ * @param x Column.
+ * @param page Page.
+ * @param shift Row offset (may be negative).
+ * @return uint8_t Page byte.
+ */
+static uint8_t _tr_byte(const uint8_t *img, int16_t w, int16_t pages, int16_t x, int16_t page, int16_t shift)
+{
+    int16_t top = page * 8 + shift;
+    int16_t q = top >> 3; // Floor division, also for negative rows.
+    uint8_t b = top & 7;
+    uint8_t lo = (q >= 0 && q < pages) ? img[q * w + x] : 0;
+    if (b == 0)
+        return lo;
+    uint8_t hi = (q + 1 >= 0 && q + 1 < pages) ? img[(q + 1) * w + x] : 0;
+    return (uint8_t)((lo >> b) | (hi << (8 - b)));
+}
+
+/**
+ * @brief Returns the mask of the rows [r0, r1) that fall into a page.
+ *
+ * @param page Page.
+ * @param r0 First row.
+ * @param r1 End row (exclusive).
+ * @return uint8_t Row mask.
+ */
+static uint8_t _tr_row_mask(int16_t page, int16_t r0, int16_t r1)
+{
+    int16_t from = r0 - page * 8, to = r1 - page * 8;
+    from = from < 0 ? 0 : from;
+    to = to > 8 ? 8 : to;
+    return (from >= to) ? 0 : (uint8_t)((0xFF << from) & (0xFF >> (8 - to)));
+}
+
+/**
+ * @brief Composes one page row of the frame at a progress.
+ *
+ * @param tr Transition.
+ * @param page Page.
+ * @param pos Progress (0 to `extent`).
+ * @param out Row buffer of screen width bytes.
+ */
+static void _tr_compose_row(const ssd1306_transition_t *tr, int16_t page, int16_t pos, uint8_t *out)
+{
+    const int16_t w = ssd1306_get_screen_width(tr->disp);
+    const int16_t h = ssd1306_get_screen_height(tr->disp);
+    const int16_t pages = h / 8;
+    const uint8_t *old_row = tr->cfg.from + page * w;
+    const uint8_t *new_row = tr->cfg.to + page * w;
+    ssd1306_transition_effect_t fx = tr->cfg.effect;
+    ssd1306_transition_dir_t dir = tr->cfg.dir;
+
+    if (fx == SSD1306_TRANSITION_DISSOLVE)
+    {
+        // Pixels whose threshold is below the level show the new screen. The pattern
+        // repeats every 4 rows, so one mask per column phase covers every page.
+        uint8_t mask[4] = {0};
+        for (uint8_t cx = 0; cx < 4; cx++)
+        {
+            for (uint8_t y = 0; y < 8; y++)
+                mask[cx] |= (tr_bayer[y & 3][cx] < pos) << y;
+        }
+        for (int16_t x = 0; x < w; x++)
+            out[x] = (old_row[x] & ~mask[x & 3]) | (new_row[x] & mask[x & 3]);
+        return;
+    }
+    if (fx == SSD1306_TRANSITION_CURTAIN)
+    {
+        if (dir <= SSD1306_TRANSITION_RIGHT)
+        {
+            int16_t x0 = w / 2 - pos, x1 = w / 2 + pos;
+            x0 = x0 < 0 ? 0 : x0;
+            x1 = x1 > w ? w : x1;
+            memcpy(out, old_row, w);
+            memcpy(out + x0, new_row + x0, x1 - x0);
+        }
+        else
+        {
+            uint8_t mask = _tr_row_mask(page, h / 2 - pos, h / 2 + pos);
+            for (int16_t x = 0; x < w; x++)
+                out[x] = (old_row[x] & ~mask) | (new_row[x] & mask);
+        }
+        return;
+    }
+
+    bool push = (fx == SSD1306_TRANSITION_PUSH), wipe = (fx == SSD1306_TRANSITION_WIPE);
+    switch (dir)
+    {
+    case SSD1306_TRANSITION_LEFT:
+    {
+        // The new screen occupies the columns from `split` to the right edge.
+        int16_t split = w - pos;
+        memcpy(out, push ? old_row + pos : old_row, split);
+        memcpy(out + split, wipe ? new_row + split : new_row, pos);
+        break;
+    }
+    case SSD1306_TRANSITION_RIGHT:
+        memcpy(out, wipe ? new_row : new_row + w - pos, pos);
+        memcpy(out + pos, push ? old_row : old_row + pos, w - pos);
+        break;
+    case SSD1306_TRANSITION_UP:
+    case SSD1306_TRANSITION_DOWN:
+    {
+        // The new screen occupies rows [h - pos, h) moving up, or [0, pos) moving down.
+        bool up = (dir == SSD1306_TRANSITION_UP);
+        uint8_t mask = up ? _tr_row_mask(page, h - pos, h) : _tr_row_mask(page, 0, pos);
+        int16_t old_shift = push ? (up ? pos : -pos) : 0;
+        int16_t new_shift = wipe ? 0 : (up ? pos - h : h - pos);
+        for (int16_t x = 0; x < w; x++)
+        {
+            uint8_t o = (mask == 0xFF) ? 0 : _tr_byte(tr->cfg.from, w, pages, x, page, old_shift);
+            uint8_t n = (mask == 0) ? 0 : _tr_byte(tr->cfg.to, w, pages, x, page, new_shift);
+            out[x] = (o & ~mask) | (n & mask);
+        }
+        break;
+    }
+    }
+}
+
+/**
+ * @brief Writes a frame and sends it.
+ * Curtains are sent as two halves so the unchanged middle never joins the damage.
+ *
+ * @param tr Transition.
+ * @param pos Progress.
+ * @return esp_err_t Result of the flush.
+ */
+static esp_err_t _tr_draw_frame(ssd1306_transition_t *tr, int16_t pos)
+{
+    const int16_t w = ssd1306_get_screen_width(tr->disp);
+    const int16_t pages = ssd1306_get_screen_height(tr->disp) / 8;
+    uint8_t row[TRANSITION_MAX_WIDTH];
+    bool split = (tr->cfg.effect == SSD1306_TRANSITION_CURTAIN);
+    bool vertical = (tr->cfg.dir >= SSD1306_TRANSITION_UP);
+    esp_err_t ret = ESP_OK;
+
+    for (uint8_t half = 0; half < (split ? 2 : 1); half++)
+    {
+        int16_t x0 = 0, x1 = w, p0 = 0, p1 = pages;
+        if (split && vertical)
+        {
+            p0 = half ? pages / 2 : 0;
+            p1 = half ? pages : pages / 2;
+        }
+        else if (split)
+        {
+            x0 = half ? w / 2 : 0;
+            x1 = half ? w : w / 2;
+        }
+        for (int16_t page = p0; page < p1; page++)
+        {
+            _tr_compose_row(tr, page, pos, row);
+            ssd1306_write_page(tr->disp, x0, page, row + x0, x1 - x0, 0xFF);
+        }
+        esp_err_t err = ssd1306_update_screen(tr->disp);
+        ret = (ret == ESP_OK) ? err : ret;
+    }
+    return ret;
+}
+
+/**
+ * @brief Advances a vertical push with the display start line.
+ * GDDRAM rows [0, pos) (up) or [h - pos, h) (down) receive the new screen at their
+ * final place, and the start line rotates the view so they appear at the moving edge.
+ *
+ * @param tr Transition.
+ * @param pos New progress in rows.
+ * @return esp_err_t Result of the transfers.
+ */
+static esp_err_t _tr_push_start_line(ssd1306_transition_t *tr, int16_t pos)
+{
+    const int16_t w = ssd1306_get_screen_width(tr->disp);
+    const int16_t h = ssd1306_get_screen_height(tr->disp);
+    bool up = (tr->cfg.dir == SSD1306_TRANSITION_UP);
+    int16_t r0 = up ? tr->pos : h - pos;
+    int16_t r1 = up ? pos : h - tr->pos;
+    for (int16_t page = r0 / 8; page <= (r1 - 1) / 8; page++)
+        ssd1306_write_page(tr->disp, 0, page, tr->cfg.to + page * w, w, _tr_row_mask(page, r0, r1));
+
+    // Rows first, then the start line that reveals them.
+    esp_err_t ret = ssd1306_update_screen(tr->disp);
+    if (ret != ESP_OK)
+        return ret;
+    ssd1306_set_display_start_line(tr->disp, (uint8_t)((up ? pos : h - pos) % h));
+    return ssd1306_update_screen(tr->disp);
+}
+
+esp_err_t ssd1306_transition_begin(ssd1306_transition_t *tr, ssd1306_handle_t disp, const ssd1306_transition_config_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(tr && disp && cfg && cfg->from && cfg->to && cfg->steps > 0, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(cfg->effect <= SSD1306_TRANSITION_CURTAIN && cfg->dir <= SSD1306_TRANSITION_DOWN, ESP_ERR_INVALID_ARG, TAG, "Invalid effect");
+    const int16_t w = ssd1306_get_screen_width(disp);
+    const int16_t h = ssd1306_get_screen_height(disp);
+    ESP_RETURN_ON_FALSE(w > 0 && w <= TRANSITION_MAX_WIDTH, ESP_ERR_INVALID_ARG, TAG, "Unsupported display width");
+
+    memset(tr, 0, sizeof(*tr));
+    tr->disp = disp;
+    tr->cfg = *cfg;
+    bool vertical = (cfg->dir >= SSD1306_TRANSITION_UP);
+    switch (cfg->effect)
+    {
+    case SSD1306_TRANSITION_DISSOLVE:
+        tr->extent = 16;
+        break;
+    case SSD1306_TRANSITION_CURTAIN:
+        tr->extent = vertical ? (h + 1) / 2 : (w + 1) / 2;
+        break;
+    default:
+        tr->extent = vertical ? h : w;
+        break;
+    }
+    // The start line wraps around all 64 GDDRAM rows, so only a full-height plain panel
+    // can push by moving it.
+    tr->start_line = (cfg->effect == SSD1306_TRANSITION_PUSH && vertical && h == TRANSITION_START_LINE_ROWS &&
+                      ssd1306_get_panel_count(disp) == 1);
+
+    // Bring the framebuffer back to the old screen; only bytes that were drawn over change.
+    for (int16_t page = 0; page < h / 8; page++)
+        ssd1306_write_page(disp, 0, page, cfg->from + page * w, w, 0xFF);
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_transition_step(ssd1306_transition_t *tr)
+{
+    ESP_RETURN_ON_FALSE(tr && tr->disp, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    if (tr->pos >= tr->extent)
+        return ESP_OK;
+    if (tr->tick < tr->cfg.steps)
+        tr->tick++;
+    if (tr->skip > 0)
+    {
+        // Pay back the budget overrun of the previous frame, unless time is up.
+        tr->skip--;
+        if (tr->tick < tr->cfg.steps)
+            return ESP_ERR_NOT_FINISHED;
+    }
+
+    const int16_t w = ssd1306_get_screen_width(tr->disp);
+    const int16_t pages = ssd1306_get_screen_height(tr->disp) / 8;
+    int16_t target = (int16_t)((uint32_t)tr->extent * tr->tick / tr->cfg.steps);
+    ssd1306_transition_effect_t fx = tr->cfg.effect;
+    bool vertical = (tr->cfg.dir >= SSD1306_TRANSITION_UP);
+    bool progressive = (fx == SSD1306_TRANSITION_WIPE || fx == SSD1306_TRANSITION_CURTAIN || tr->start_line);
+
+    // Effects that only send what they uncover advance as far as the byte budget allows.
+    if (progressive && tr->cfg.frame_bytes)
+    {
+        uint32_t sides = (fx == SSD1306_TRANSITION_CURTAIN) ? 2 : 1;
+        uint32_t avail = tr->cfg.frame_bytes / sides;
+        avail = avail > TRANSITION_FLUSH_OVERHEAD ? avail - TRANSITION_FLUSH_OVERHEAD : 0;
+        uint32_t limit;
+        if (vertical)
+        {
+            // A run of rows can straddle one page more than its height in pages.
+            uint32_t rows_pages = avail / w;
+            limit = rows_pages > 1 ? (rows_pages - 1) * 8 : 1;
+        }
+        else
+        {
+            limit = avail / pages;
+            limit = limit ? limit : 1;
+        }
+        if ((uint32_t)(target - tr->pos) > limit)
+            target = tr->pos + limit;
+    }
+    if (target <= tr->pos)
+        return ESP_ERR_NOT_FINISHED;
+
+    ssd1306_stats_t st;
+    uint32_t bytes0 = (ssd1306_get_stats(tr->disp, &st) == ESP_OK) ? st.bytes : 0;
+    int64_t t0 = esp_timer_get_time();
+    esp_err_t ret = tr->start_line ? _tr_push_start_line(tr, target) : _tr_draw_frame(tr, target);
+    tr->last_us = (uint32_t)(esp_timer_get_time() - t0);
+    tr->last_bytes = ((ssd1306_get_stats(tr->disp, &st) == ESP_OK) ? st.bytes : bytes0) - bytes0;
+    tr->total_bytes += tr->last_bytes;
+    tr->frames++;
+    if (ret != ESP_OK)
+        return ret;
+    tr->pos = target;
+
+    // Full-area effects keep their timing and drop frames after an expensive one.
+    if (!progressive || !tr->cfg.frame_bytes)
+    {
+        uint32_t over_bytes = tr->cfg.frame_bytes ? (tr->last_bytes + tr->cfg.frame_bytes - 1) / tr->cfg.frame_bytes : 1;
+        uint32_t over_us = tr->cfg.frame_us ? (tr->last_us + tr->cfg.frame_us - 1) / tr->cfg.frame_us : 1;
+        uint32_t over = over_bytes > over_us ? over_bytes : over_us;
+        tr->skip = (over > 1) ? (uint16_t)(over - 1) : 0;
+    }
+    return (tr->pos >= tr->extent) ? ESP_OK : ESP_ERR_NOT_FINISHED;
+}
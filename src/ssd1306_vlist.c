@@ -0,0 +1,260 @@
+/**
+ * @file      ssd1306_vlist.c
+ * @brief     Virtualized, pixel-smooth scrolling list for long menus.
+ * @version   1.0
+ *
+ * List rows are addressed in "list coordinates": row 0 is the first row of item 0.
+ * With hardware scrolling the framebuffer is a ring of display RAM rows: list row `v`
+ * lives in framebuffer row `v % height` and the display start line is `scroll % height`,
+ * so revealing rows never moves the rows that are already on screen.
+ *
+ */
+
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_check.h"
+
+#include "ssd1306_vlist.h"
+
+#define SSD1306_VLIST_RAM_ROWS 64 /**< Rows of display RAM the start line wraps around. */
+
+static const char *TAG = "SSD1306_VLIST";
+
+/**
+ * @brief Returns the (cached) height of an item.
+ *
+ * @param list List.
+ * @param index Item index.
+ * @return int32_t Height in pixels.
+ */
+static int32_t _vlist_height(ssd1306_vlist_t *list, uint16_t index)
+{
+    if (!list->cfg.height_cb)
+        return list->cfg.row_height;
+    uint8_t *cached = &list->cfg.height_cache[index];
+    if (*cached == 0)
+    {
+        *cached = list->cfg.height_cb(index, list->cfg.user_ctx);
+        if (*cached == 0)
+            *cached = 1; // Zero marks an empty cache entry.
+    }
+    return *cached;
+}
+
+/**
+ * @brief Moves an item cursor forward to the item containing a list row (or the last item).
+ *
+ * @param list List.
+ * @param index Cursor item.
+ * @param y Cursor item's first row.
+ * @param row Target list row.
+ */
+static void _vlist_walk_down(ssd1306_vlist_t *list, uint16_t *index, int32_t *y, int32_t row)
+{
+    while (*index + 1 < list->cfg.count && *y + _vlist_height(list, *index) <= row)
+    {
+        *y += _vlist_height(list, *index);
+        (*index)++;
+    }
+}
+
+/**
+ * @brief Moves an item cursor back to the item containing a list row (or item 0).
+ *
+ * @param list List.
+ * @param index Cursor item.
+ * @param y Cursor item's first row.
+ * @param row Target list row.
+ */
+static void _vlist_walk_up(ssd1306_vlist_t *list, uint16_t *index, int32_t *y, int32_t row)
+{
+    while (*index > 0 && *y > row)
+    {
+        (*index)--;
+        *y -= _vlist_height(list, *index);
+    }
+}
+
+/**
+ * @brief Rasterizes the list rows [v0, v1) into the framebuffer.
+ *
+ * @param list List.
+ * @param v0 First list row (must be on screen).
+ * @param v1 End list row (exclusive, must be on screen).
+ * @param index Cursor item at or before `v0`.
+ * @param y Cursor item's first row.
+ */
+static void _vlist_paint(ssd1306_vlist_t *list, int32_t v0, int32_t v1, uint16_t index, int32_t y)
+{
+    ssd1306_handle_t disp = list->disp;
+    while (v0 < v1)
+    {
+        // In ring mode a range that wraps around the end of display RAM is painted in two pieces.
+        int32_t offset = list->ring ? v0 - v0 % list->height : list->scroll;
+        int32_t end = list->ring && v1 > offset + list->height ? offset + list->height : v1;
+
+        ssd1306_set_clip_rect(disp, 0, v0 - offset, list->width, end - v0);
+        ssd1306_fill_rect(disp, 0, v0 - offset, list->width, end - v0, OLED_COLOR_BLACK);
+        _vlist_walk_down(list, &index, &y, v0);
+        uint16_t i = index;
+        for (int32_t item_y = y; i < list->cfg.count && item_y < end; i++)
+        {
+            int32_t h = _vlist_height(list, i);
+            list->cfg.draw_cb(disp, i, item_y - offset, list->width, h, i == list->selected, list->cfg.user_ctx);
+            item_y += h;
+        }
+        list->last_rows += end - v0;
+        v0 = end;
+    }
+    ssd1306_reset_clip_rect(disp);
+}
+
+/**
+ * @brief Repaints the visible part of one item.
+ *
+ * @param list List.
+ * @param index Item index.
+ * @param y Item's first row.
+ */
+static void _vlist_paint_item(ssd1306_vlist_t *list, uint16_t index, int32_t y)
+{
+    int32_t v0 = y > list->scroll ? y : list->scroll;
+    int32_t v1 = y + _vlist_height(list, index);
+    if (v1 > list->scroll + list->height)
+        v1 = list->scroll + list->height;
+    if (v0 < v1)
+        _vlist_paint(list, v0, v1, index, y);
+}
+
+esp_err_t ssd1306_vlist_init(ssd1306_vlist_t *list, ssd1306_handle_t disp, const ssd1306_vlist_config_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(list && disp && cfg && cfg->draw_cb, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(cfg->height_cb ? cfg->height_cache != NULL : cfg->row_height > 0, ESP_ERR_INVALID_ARG, TAG,
+                        "Item heights need a height cache or a fixed row height");
+    memset(list, 0, sizeof(*list));
+    list->disp = disp;
+    list->cfg = *cfg;
+    if (cfg->height_cb)
+        memset(cfg->height_cache, 0, cfg->count);
+    list->width = ssd1306_get_screen_width(disp);
+    list->height = ssd1306_get_screen_height(disp);
+    // The start line wraps at the end of display RAM, so the ring must span all of it.
+    list->ring = (list->height == SSD1306_VLIST_RAM_ROWS && ssd1306_get_panel_count(disp) == 1);
+
+    _vlist_walk_down(list, &list->bottom, &list->bottom_y, list->height - 1);
+    _vlist_paint(list, 0, list->height, 0, 0);
+    if (list->ring)
+        ssd1306_set_display_start_line(disp, 0);
+    return ssd1306_update_screen(disp);
+}
+
+int16_t ssd1306_vlist_scroll(ssd1306_vlist_t *list, int16_t dy)
+{
+    if (!list || dy == 0)
+        return 0;
+    list->last_rows = 0;
+    int32_t old = list->scroll;
+    int32_t v0, v1;
+    if (dy > 0)
+    {
+        // The old bottom cursor is at or before the first revealed row.
+        uint16_t from = list->bottom;
+        int32_t from_y = list->bottom_y;
+        _vlist_walk_down(list, &list->bottom, &list->bottom_y, old + list->height - 1 + dy);
+        int32_t room = list->cfg.count ? list->bottom_y + _vlist_height(list, list->bottom) - (old + list->height) : 0;
+        if (room < dy)
+            dy = room > 0 ? room : 0;
+        if (dy == 0)
+            return 0;
+        list->scroll += dy;
+        _vlist_walk_down(list, &list->top, &list->top_y, list->scroll);
+        v0 = old + list->height > list->scroll ? old + list->height : list->scroll;
+        v1 = list->scroll + list->height;
+        if (!list->ring)
+            ssd1306_shift_framebuffer(list->disp, 0, -dy, false);
+        _vlist_paint(list, v0, v1, from, from_y);
+    }
+    else
+    {
+        if (-dy > old)
+            dy = -old;
+        if (dy == 0)
+            return 0;
+        list->scroll += dy;
+        _vlist_walk_up(list, &list->top, &list->top_y, list->scroll);
+        _vlist_walk_up(list, &list->bottom, &list->bottom_y, list->scroll + list->height - 1);
+        v0 = list->scroll;
+        v1 = old < list->scroll + list->height ? old : list->scroll + list->height;
+        if (!list->ring)
+            ssd1306_shift_framebuffer(list->disp, 0, -dy, false);
+        _vlist_paint(list, v0, v1, list->top, list->top_y);
+    }
+
+    esp_err_t ret = ssd1306_update_screen(list->disp);
+    if (ret == ESP_OK && list->ring)
+    {
+        // Move the picture only after the revealed rows reached display RAM. With deferred
+        // commands the start line is queued, and the second update sends it.
+        ssd1306_set_display_start_line(list->disp, list->scroll % list->height);
+        ret = ssd1306_update_screen(list->disp);
+    }
+    if (ret != ESP_OK)
+        ESP_LOGW(TAG, "Screen update failed: %s", esp_err_to_name(ret));
+    return dy;
+}
+
+esp_err_t ssd1306_vlist_select(ssd1306_vlist_t *list, uint16_t index)
+{
+    ESP_RETURN_ON_FALSE(list, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    if (list->cfg.count == 0)
+        return ESP_OK;
+    if (index >= list->cfg.count)
+        index = list->cfg.count - 1;
+    if (index == list->selected)
+        return ESP_OK;
+
+    list->last_rows = 0;
+    uint16_t old = list->selected;
+    int32_t old_y = list->selected_y;
+    while (list->selected < index)
+        list->selected_y += _vlist_height(list, list->selected++);
+    while (list->selected > index)
+        list->selected_y -= _vlist_height(list, --list->selected);
+
+    _vlist_paint_item(list, old, old_y);
+    _vlist_paint_item(list, list->selected, list->selected_y);
+    return ssd1306_update_screen(list->disp);
+}
+
+int16_t ssd1306_vlist_follow(ssd1306_vlist_t *list, int16_t max_step)
+{
+    if (!list || max_step <= 0 || list->cfg.count == 0)
+        return 0;
+    int32_t y = list->selected_y;
+    int32_t h = _vlist_height(list, list->selected);
+    int32_t d = 0;
+    if (y < list->scroll || h > list->height)
+        d = y - list->scroll; // Items taller than the screen are aligned at their top.
+    else if (y + h > list->scroll + list->height)
+        d = y + h - (list->scroll + list->height);
+    if (d > max_step)
+        d = max_step;
+    if (d < -max_step)
+        d = -max_step;
+    return ssd1306_vlist_scroll(list, (int16_t)d);
+}
+
+esp_err_t ssd1306_vlist_refresh_item(ssd1306_vlist_t *list, uint16_t index)
+{
+    ESP_RETURN_ON_FALSE(list, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    if (index < list->top || index > list->bottom)
+        return ESP_OK; // Not on screen; it is drawn when scrolled into view.
+
+    list->last_rows = 0;
+    int32_t y = list->top_y;
+    for (uint16_t i = list->top; i < index; i++)
+        y += _vlist_height(list, i);
+    _vlist_paint_item(list, index, y);
+    return ssd1306_update_screen(list->disp);
+}
@@ -0,0 +1,403 @@
+/**
+ * @file      ssd1306_widgets.c
+ * @brief     Retained widget toolkit on top of the SSD1306 framebuffer API.
+ * @version   1.0
+ *
+ * Widgets record the area that needs repainting instead of redrawing themselves
+ * immediately. Rendering clears exactly that area and redraws only the parts of the
+ * widget that intersect it, so the driver's dirty area (and the next flush) stays small.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_check.h"
+
+#include "ssd1306_widgets.h"
+
+static const char *TAG = "SSD1306_UI";
+
+/**
+ * @brief Adds an area to the widget's invalid area.
+ *
+ * @param w Widget.
+ * @param x0 Left edge.
+ * @param y0 Top edge.
+ * @param x1 Right edge (inclusive).
+ * @param y1 Bottom edge (inclusive).
+ */
+static void _ui_invalidate(ssd1306_widget_t *w, int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    if (x0 > x1 || y0 > y1)
+        return;
+    if (w->inv_x0 > w->inv_x1)
+    {
+        w->inv_x0 = x0;
+        w->inv_y0 = y0;
+        w->inv_x1 = x1;
+        w->inv_y1 = y1;
+        return;
+    }
+    w->inv_x0 = x0 < w->inv_x0 ? x0 : w->inv_x0;
+    w->inv_y0 = y0 < w->inv_y0 ? y0 : w->inv_y0;
+    w->inv_x1 = x1 > w->inv_x1 ? x1 : w->inv_x1;
+    w->inv_y1 = y1 > w->inv_y1 ? y1 : w->inv_y1;
+}
+
+/**
+ * @brief Measures the advance width of a string in the UI font.
+ *
+ * @param ui UI.
+ * @param text String.
+ * @return int16_t Width in pixels.
+ */
+static int16_t _ui_text_width(const ssd1306_ui_t *ui, const char *text)
+{
+    const GFXfont *font = (const GFXfont *)ui->font->font_data;
+    int16_t width = 0;
+    for (; *text; text++)
+    {
+        if ((uint8_t)*text >= font->first && (uint8_t)*text <= font->last)
+            width += font->glyph[(uint8_t)*text - font->first].xAdvance;
+    }
+    return width;
+}
+
+/**
+ * @brief Draws a string without background, skipping glyphs that would cross `max_x`.
+ *
+ * @param ui UI.
+ * @param x Left edge.
+ * @param y Top edge of the text line.
+ * @param max_x Last usable column.
+ * @param text String.
+ * @param color Text color.
+ */
+static void _ui_draw_text(const ssd1306_ui_t *ui, int16_t x, int16_t y, int16_t max_x, const char *text, ssd1306_color_t color)
+{
+    const GFXfont *font = (const GFXfont *)ui->font->font_data;
+    for (; *text; text++)
+    {
+        if ((uint8_t)*text < font->first || (uint8_t)*text > font->last)
+            continue;
+        const GFXglyph *glyph = &font->glyph[(uint8_t)*text - font->first];
+        if (x + glyph->xOffset + glyph->width - 1 > max_x)
+            break;
+        ssd1306_draw_char(ui->disp, x, y + ui->ascent, *text, color, color, 1, 1);
+        x += glyph->xAdvance;
+    }
+}
+
+/**
+ * @brief Links a widget into a UI and marks it for a full paint.
+ *
+ * @param ui UI.
+ * @param w Widget.
+ * @param type Widget kind.
+ * @param x Left edge.
+ * @param y Top edge.
+ * @param width Width.
+ * @param height Height.
+ */
+static void _ui_attach(ssd1306_ui_t *ui, ssd1306_widget_t *w, ssd1306_widget_type_t type, int16_t x, int16_t y, int16_t width, int16_t height)
+{
+    memset(w, 0, sizeof(*w));
+    w->type = type;
+    w->x = x;
+    w->y = y;
+    w->w = width;
+    w->h = height;
+    w->visible = true;
+    w->ui = ui;
+    w->inv_x0 = 1; // Empty invalid area.
+    ssd1306_widget_invalidate(w);
+    if (ui->last)
+        ui->last->next = w;
+    else
+        ui->first = w;
+    ui->last = w;
+}
+
+esp_err_t ssd1306_ui_init(ssd1306_ui_t *ui, ssd1306_handle_t disp, const ssd1306_font_handle_t *font)
+{
+    ESP_RETURN_ON_FALSE(ui && disp && font && font->type == FONT_TYPE_GFX, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    memset(ui, 0, sizeof(*ui));
+    ui->disp = disp;
+    ui->font = font;
+
+    // Text is positioned by its top edge; the baseline offset is the tallest glyph's ascent.
+    const GFXfont *gfx = (const GFXfont *)font->font_data;
+    for (uint16_t c = 0; c <= gfx->last - gfx->first; c++)
+    {
+        if (-gfx->glyph[c].yOffset > ui->ascent)
+            ui->ascent = -gfx->glyph[c].yOffset;
+    }
+    ui->line_h = gfx->yAdvance;
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_ui_add_label(ssd1306_ui_t *ui, ssd1306_widget_t *w, int16_t x, int16_t y, int16_t width, const char *text)
+{
+    ESP_RETURN_ON_FALSE(ui && w && text, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    _ui_attach(ui, w, SSD1306_WIDGET_LABEL, x, y, width, ui->line_h);
+    snprintf(w->u.text.text, sizeof(w->u.text.text), "%s", text);
+    if (width <= 0)
+    {
+        w->u.text.auto_width = true;
+        w->w = _ui_text_width(ui, w->u.text.text);
+    }
+    ssd1306_widget_invalidate(w);
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_ui_add_value(ssd1306_ui_t *ui, ssd1306_widget_t *w, int16_t x, int16_t y, int16_t width, const char *fmt, int32_t value)
+{
+    ESP_RETURN_ON_FALSE(ui && w && fmt && width > 0, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    _ui_attach(ui, w, SSD1306_WIDGET_VALUE, x, y, width, ui->line_h);
+    w->u.text.fmt = fmt;
+    w->u.text.value = value;
+    snprintf(w->u.text.text, sizeof(w->u.text.text), fmt, value);
+    return ESP_OK;
+}
+
+/**
+ * @brief Computes the filled width of a progress bar.
+ *
+ * @param w Progress widget.
+ * @return int16_t Filled width in pixels (inside the outline).
+ */
+static int16_t _ui_progress_fill(const ssd1306_widget_t *w)
+{
+    int64_t inner = w->w - 2;
+    return (int16_t)(inner * (w->u.progress.value - w->u.progress.min) / (w->u.progress.max - w->u.progress.min));
+}
+
+esp_err_t ssd1306_ui_add_progress(ssd1306_ui_t *ui, ssd1306_widget_t *w, int16_t x, int16_t y, int16_t width, int16_t height,
+                                  int32_t min, int32_t max, int32_t value)
+{
+    ESP_RETURN_ON_FALSE(ui && w && width >= 3 && height >= 3 && max > min, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    _ui_attach(ui, w, SSD1306_WIDGET_PROGRESS, x, y, width, height);
+    w->u.progress.min = min;
+    w->u.progress.max = max;
+    w->u.progress.value = value < min ? min : (value > max ? max : value);
+    w->u.progress.fill = _ui_progress_fill(w);
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_ui_add_list(ssd1306_ui_t *ui, ssd1306_widget_t *w, int16_t x, int16_t y, int16_t width, uint8_t rows,
+                              const char *const *items, uint16_t count)
+{
+    ESP_RETURN_ON_FALSE(ui && w && items && rows > 0 && width > 0, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    uint8_t row_h = ui->line_h + 2; // One pixel of padding above and below the text.
+    _ui_attach(ui, w, SSD1306_WIDGET_LIST, x, y, width, rows * row_h);
+    w->u.list.items = items;
+    w->u.list.count = count;
+    w->u.list.rows = rows;
+    w->u.list.row_h = row_h;
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_ui_add_icon(ssd1306_ui_t *ui, ssd1306_widget_t *w, int16_t x, int16_t y, const uint8_t *bitmap, int16_t width, int16_t height)
+{
+    ESP_RETURN_ON_FALSE(ui && w && bitmap && width > 0 && height > 0, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    _ui_attach(ui, w, SSD1306_WIDGET_ICON, x, y, width, height);
+    w->u.icon.bitmap = bitmap;
+    return ESP_OK;
+}
+
+void ssd1306_label_set_text(ssd1306_widget_t *w, const char *text)
+{
+    if (!w || !text || (w->type != SSD1306_WIDGET_LABEL && w->type != SSD1306_WIDGET_VALUE))
+        return;
+    if (strncmp(w->u.text.text, text, sizeof(w->u.text.text) - 1) == 0)
+        return;
+    snprintf(w->u.text.text, sizeof(w->u.text.text), "%s", text);
+    ssd1306_widget_invalidate(w);
+    if (w->u.text.auto_width)
+    {
+        // The old bounds stay invalid, so a shorter text clears what the longer one left.
+        w->w = _ui_text_width(w->ui, w->u.text.text);
+        ssd1306_widget_invalidate(w);
+    }
+}
+
+void ssd1306_value_set(ssd1306_widget_t *w, int32_t value)
+{
+    if (!w || w->type != SSD1306_WIDGET_VALUE || value == w->u.text.value)
+        return;
+    char text[SSD1306_WIDGET_TEXT_MAX];
+    w->u.text.value = value;
+    snprintf(text, sizeof(text), w->u.text.fmt, value);
+    ssd1306_label_set_text(w, text);
+}
+
+void ssd1306_progress_set(ssd1306_widget_t *w, int32_t value)
+{
+    if (!w || w->type != SSD1306_WIDGET_PROGRESS)
+        return;
+    w->u.progress.value = value < w->u.progress.min ? w->u.progress.min : (value > w->u.progress.max ? w->u.progress.max : value);
+    int16_t fill = _ui_progress_fill(w);
+    if (fill == w->u.progress.fill)
+        return;
+    // Only the columns between the old and the new fill edge change.
+    int16_t from = fill < w->u.progress.fill ? fill : w->u.progress.fill;
+    int16_t to = fill > w->u.progress.fill ? fill : w->u.progress.fill;
+    w->u.progress.fill = fill;
+    _ui_invalidate(w, w->x + 1 + from, w->y + 1, w->x + to, w->y + w->h - 2);
+}
+
+/**
+ * @brief Invalidates one visible list row.
+ *
+ * @param w List widget.
+ * @param index Item index (ignored if not visible).
+ */
+static void _ui_invalidate_row(ssd1306_widget_t *w, uint16_t index)
+{
+    if (index < w->u.list.top || index >= w->u.list.top + w->u.list.rows)
+        return;
+    int16_t row_y = w->y + (index - w->u.list.top) * w->u.list.row_h;
+    _ui_invalidate(w, w->x, row_y, w->x + w->w - 1, row_y + w->u.list.row_h - 1);
+}
+
+void ssd1306_list_select(ssd1306_widget_t *w, uint16_t index)
+{
+    if (!w || w->type != SSD1306_WIDGET_LIST || w->u.list.count == 0)
+        return;
+    if (index >= w->u.list.count)
+        index = w->u.list.count - 1;
+    if (index == w->u.list.selected)
+        return;
+
+    uint16_t old = w->u.list.selected;
+    w->u.list.selected = index;
+    if (index >= w->u.list.top && index < w->u.list.top + w->u.list.rows)
+    {
+        _ui_invalidate_row(w, old);
+        _ui_invalidate_row(w, index);
+        return;
+    }
+    // Scroll just far enough to bring the selection into view.
+    w->u.list.top = (index < w->u.list.top) ? index : index - w->u.list.rows + 1;
+    ssd1306_widget_invalidate(w);
+}
+
+void ssd1306_list_move(ssd1306_widget_t *w, int16_t delta)
+{
+    if (!w || w->type != SSD1306_WIDGET_LIST || w->u.list.count == 0)
+        return;
+    int32_t index = ((int32_t)w->u.list.selected + delta) % w->u.list.count;
+    if (index < 0)
+        index += w->u.list.count;
+    ssd1306_list_select(w, (uint16_t)index);
+}
+
+void ssd1306_widget_set_visible(ssd1306_widget_t *w, bool visible)
+{
+    if (!w || w->visible == visible)
+        return;
+    w->visible = visible;
+    ssd1306_widget_invalidate(w);
+}
+
+void ssd1306_widget_invalidate(ssd1306_widget_t *w)
+{
+    if (w)
+        _ui_invalidate(w, w->x, w->y, w->x + w->w - 1, w->y + w->h - 1);
+}
+
+/**
+ * @brief Paints the part of a progress bar inside the invalid area.
+ *
+ * @param w Progress widget.
+ */
+static void _ui_paint_progress(const ssd1306_widget_t *w)
+{
+    ssd1306_handle_t disp = w->ui->disp;
+    int16_t x0 = w->inv_x0, x1 = w->inv_x1;
+    int16_t right = w->x + w->w - 1, bottom = w->y + w->h - 1;
+
+    // Outline, limited to the invalid columns.
+    if (w->inv_y0 <= w->y)
+        ssd1306_draw_fast_hline(disp, x0, w->y, x1 - x0 + 1, OLED_COLOR_WHITE);
+    if (w->inv_y1 >= bottom)
+        ssd1306_draw_fast_hline(disp, x0, bottom, x1 - x0 + 1, OLED_COLOR_WHITE);
+    if (x0 <= w->x)
+        ssd1306_draw_fast_vline(disp, w->x, w->y, w->h, OLED_COLOR_WHITE);
+    if (x1 >= right)
+        ssd1306_draw_fast_vline(disp, right, w->y, w->h, OLED_COLOR_WHITE);
+
+    // Filled part, limited to the invalid columns.
+    int16_t fill_x0 = x0 > w->x + 1 ? x0 : w->x + 1;
+    int16_t fill_x1 = x1 < w->x + w->u.progress.fill ? x1 : w->x + w->u.progress.fill;
+    if (fill_x1 >= fill_x0)
+        ssd1306_fill_rect(disp, fill_x0, w->y + 1, fill_x1 - fill_x0 + 1, w->h - 2, OLED_COLOR_WHITE);
+}
+
+/**
+ * @brief Paints the list rows that intersect the invalid area.
+ *
+ * @param w List widget.
+ */
+static void _ui_paint_list(const ssd1306_widget_t *w)
+{
+    const ssd1306_ui_t *ui = w->ui;
+    int16_t first = (w->inv_y0 - w->y) / w->u.list.row_h;
+    int16_t last = (w->inv_y1 - w->y) / w->u.list.row_h;
+    for (int16_t r = first; r <= last; r++)
+    {
+        uint16_t index = w->u.list.top + r;
+        if (index >= w->u.list.count)
+            break;
+        int16_t row_y = w->y + r * w->u.list.row_h;
+        ssd1306_color_t color = OLED_COLOR_WHITE;
+        if (index == w->u.list.selected)
+        {
+            ssd1306_fill_rect(ui->disp, w->x, row_y, w->w, w->u.list.row_h, OLED_COLOR_WHITE);
+            color = OLED_COLOR_BLACK;
+        }
+        _ui_draw_text(ui, w->x + 2, row_y + 1, w->x + w->w - 1, w->u.list.items[index], color);
+    }
+}
+
+uint16_t ssd1306_ui_render(ssd1306_ui_t *ui)
+{
+    if (!ui)
+        return 0;
+    uint16_t painted = 0;
+    // Render with the UI font without changing the one the application draws with.
+    const ssd1306_font_handle_t *prev_font = ssd1306_get_font(ui->disp);
+    ssd1306_set_font(ui->disp, ui->font);
+    for (ssd1306_widget_t *w = ui->first; w; w = w->next)
+    {
+        if (w->inv_x0 > w->inv_x1)
+            continue;
+        ssd1306_fill_rect(ui->disp, w->inv_x0, w->inv_y0, w->inv_x1 - w->inv_x0 + 1, w->inv_y1 - w->inv_y0 + 1, OLED_COLOR_BLACK);
+        if (w->visible)
+        {
+            switch (w->type)
+            {
+            case SSD1306_WIDGET_LABEL:
+            case SSD1306_WIDGET_VALUE:
+                _ui_draw_text(ui, w->x, w->y, w->x + w->w - 1, w->u.text.text, OLED_COLOR_WHITE);
+                break;
+            case SSD1306_WIDGET_PROGRESS:
+                _ui_paint_progress(w);
+                break;
+            case SSD1306_WIDGET_LIST:
+                _ui_paint_list(w);
+                break;
+            case SSD1306_WIDGET_ICON:
+                ssd1306_draw_bitmap(ui->disp, w->x, w->y, w->u.icon.bitmap, w->w, w->h, OLED_COLOR_WHITE);
+                break;
+            }
+        }
+        w->inv_x0 = 1;
+        w->inv_x1 = 0;
+        painted++;
+    }
+    ssd1306_set_font(ui->disp, prev_font);
+    return painted;
+}
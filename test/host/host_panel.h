@@ -0,0 +1,83 @@
+/**
+ * @file      host_panel.h
+ * @brief     Simulated SSD1306 panels and clock behind the host stand-ins of ESP-IDF.
+ *
+ * Every I2C transaction the driver sends is decoded and applied to a model of the
+ * addressed panel: GDDRAM, address window, start line and the hardware scroll, which
+ * rotates GDDRAM by the steps elapsed between activation and deactivation (datasheet
+ * step intervals). Time only advances when a test or a delay moves it, so scroll and
+ * timing figures are exact.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "driver/i2c.h"
+
+#define HOST_PANEL_MAX 4          ///< Panels the simulation can hold.
+#define HOST_I2C_TRANSACTION_US 25 ///< Simulated duration of one I2C transaction.
+
+/**
+ * @brief Model of one panel on the bus.
+ */
+typedef struct {
+    bool used;                  ///< Slot holds a panel.
+    i2c_port_t port;            ///< Bus of the panel.
+    uint8_t addr;               ///< 7-bit address.
+    uint8_t gddram[8][128];     ///< Display RAM, page by page.
+    uint8_t col_start, col_end; ///< Column window.
+    uint8_t page_start, page_end; ///< Page window.
+    uint8_t col, page;          ///< Write pointer.
+    uint8_t start_line;         ///< Display start line.
+    uint8_t contrast;           ///< Contrast register.
+    bool inverted;              ///< Inverse display.
+    bool display_on;            ///< Display switched on.
+    bool seg_remap;             ///< Segment remap (column 0 on the right).
+    uint8_t scroll_setup[7];    ///< Last horizontal or diagonal scroll setup.
+    bool scroll_active;         ///< Scroll running.
+    int64_t scroll_since_us;    ///< Activation time of the running scroll.
+    uint32_t frame_us;          ///< Frame period used to time scroll steps.
+    uint32_t transactions;      ///< Transactions received.
+    uint32_t data_bytes;        ///< GDDRAM bytes written.
+} host_panel_t;
+
+/**
+ * @brief Forgets all panels and resets the clock and the failure injection.
+ */
+void host_reset(void);
+
+/**
+ * @brief Returns the panel at an address, creating it on first use.
+ */
+host_panel_t *host_panel(i2c_port_t port, uint8_t addr);
+
+/**
+ * @brief Current simulated time in microseconds.
+ */
+int64_t host_time_us(void);
+
+/**
+ * @brief Advances the simulated clock.
+ */
+void host_advance_us(int64_t us);
+
+/**
+ * @brief Lets `n` more I2C transactions succeed, then fails all of them (-1 = never fail).
+ */
+void host_i2c_fail_after(int n);
+
+/**
+ * @brief Number of I2C ports with an installed driver.
+ */
+int host_i2c_drivers(void);
+
+/**
+ * @brief Number of tasks started and not yet deleted.
+ */
+int host_live_tasks(void);
+
+/**
+ * @brief Number of semaphores created and not yet deleted.
+ */
+int host_live_semaphores(void);
@@ -0,0 +1,16 @@
+// Host stand-in for the ESP-IDF header of the same name.
+#pragma once
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef int gpio_num_t;
+typedef enum {
+    GPIO_MODE_OUTPUT = 2,
+} gpio_mode_t;
+
+#define GPIO_PULLUP_ENABLE 1
+
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode);
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level);
+esp_err_t gpio_hold_en(gpio_num_t gpio_num);
+esp_err_t gpio_hold_dis(gpio_num_t gpio_num);
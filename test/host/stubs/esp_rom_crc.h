@@ -0,0 +1,5 @@
+// Host stand-in for the ESP-IDF header of the same name.
+#pragma once
+#include <stdint.h>
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len);
@@ -0,0 +1,5 @@
+// Host stand-in for the ESP-IDF header of the same name.
+#pragma once
+#include <stdint.h>
+
+void esp_rom_delay_us(uint32_t us);
@@ -0,0 +1,5 @@
+// Host stand-in for the ESP-IDF header of the same name. Time is simulated, see host_panel.h.
+#pragma once
+#include <stdint.h>
+
+int64_t esp_timer_get_time(void);
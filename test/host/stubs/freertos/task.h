@@ -0,0 +1,10 @@
+// Host stand-in for the FreeRTOS header of the same name. Tasks are POSIX threads.
+#pragma once
+#include "freertos/FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+void vTaskDelay(TickType_t ticks);
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg, UBaseType_t priority, TaskHandle_t *out);
+void vTaskDelete(TaskHandle_t task);
@@ -0,0 +1,534 @@
+/**
+ * @file      host_stubs.c
+ * @brief     Host implementations of the ESP-IDF and FreeRTOS calls the driver makes.
+ *
+ * I2C transactions are recorded into command links and played into the simulated
+ * panels of host_panel.h. Tasks are POSIX threads; a global lock serializes the clock
+ * and the panels, since the flush workers of tiled displays run in parallel.
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_err.h"
+#include "esp_timer.h"
+#include "esp_rom_sys.h"
+#include "esp_rom_crc.h"
+#include "driver/gpio.h"
+#include "driver/i2c.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "host_panel.h"
+
+#define HOST_LINK_START 0x100 /**< Start condition in a command link. */
+#define HOST_LINK_STOP 0x101  /**< Stop condition in a command link. */
+
+/**
+ * @brief Recorded I2C command link: bytes and start/stop conditions.
+ */
+typedef struct {
+    uint16_t *items; /**< Bytes, HOST_LINK_START or HOST_LINK_STOP. */
+    size_t len;      /**< Items recorded. */
+    size_t cap;      /**< Capacity of `items`. */
+} host_link_t;
+
+/**
+ * @brief Counting semaphore.
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    unsigned count;
+} host_sem_t;
+
+/**
+ * @brief Start arguments of a task thread.
+ */
+typedef struct {
+    TaskFunction_t fn;
+    void *arg;
+} host_task_start_t;
+
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER; /**< Guards everything below. */
+static host_panel_t s_panels[HOST_PANEL_MAX];
+static int64_t s_now_us;
+static int s_fail_after = -1;
+static int s_live_tasks;
+static int s_live_sems;
+static bool s_i2c_installed[I2C_NUM_MAX];
+
+// ---------------------------------------------------------------------------
+// Simulation control
+// ---------------------------------------------------------------------------
+
+void host_reset(void)
+{
+    pthread_mutex_lock(&s_lock);
+    memset(s_panels, 0, sizeof(s_panels));
+    s_now_us = 1000000; // Start away from 0, so timestamps of 0 stand out.
+    s_fail_after = -1;
+    pthread_mutex_unlock(&s_lock);
+}
+
+/**
+ * @brief Finds or creates a panel. The caller holds `s_lock`.
+ */
+static host_panel_t *_host_panel_locked(i2c_port_t port, uint8_t addr)
+{
+    host_panel_t *free_slot = NULL;
+    for (int i = 0; i < HOST_PANEL_MAX; i++)
+    {
+        if (s_panels[i].used && s_panels[i].port == port && s_panels[i].addr == addr)
+            return &s_panels[i];
+        if (!s_panels[i].used && !free_slot)
+            free_slot = &s_panels[i];
+    }
+    if (!free_slot)
+    {
+        fprintf(stderr, "host_panel: more than %d panels\n", HOST_PANEL_MAX);
+        abort();
+    }
+    memset(free_slot, 0, sizeof(*free_slot));
+    free_slot->used = true;
+    free_slot->port = port;
+    free_slot->addr = addr;
+    free_slot->col_end = 127;
+    free_slot->page_end = 7;
+    free_slot->frame_us = 11416; // 64-row panel at the driver's init clock settings.
+    return free_slot;
+}
+
+host_panel_t *host_panel(i2c_port_t port, uint8_t addr)
+{
+    pthread_mutex_lock(&s_lock);
+    host_panel_t *panel = _host_panel_locked(port, addr);
+    pthread_mutex_unlock(&s_lock);
+    return panel;
+}
+
+int64_t host_time_us(void)
+{
+    pthread_mutex_lock(&s_lock);
+    int64_t now = s_now_us;
+    pthread_mutex_unlock(&s_lock);
+    return now;
+}
+
+void host_advance_us(int64_t us)
+{
+    pthread_mutex_lock(&s_lock);
+    s_now_us += us;
+    pthread_mutex_unlock(&s_lock);
+}
+
+void host_i2c_fail_after(int n)
+{
+    pthread_mutex_lock(&s_lock);
+    s_fail_after = n;
+    pthread_mutex_unlock(&s_lock);
+}
+
+int host_live_tasks(void)
+{
+    pthread_mutex_lock(&s_lock);
+    int n = s_live_tasks;
+    pthread_mutex_unlock(&s_lock);
+    return n;
+}
+
+int host_i2c_drivers(void)
+{
+    pthread_mutex_lock(&s_lock);
+    int n = 0;
+    for (int i = 0; i < I2C_NUM_MAX; i++)
+        n += s_i2c_installed[i];
+    pthread_mutex_unlock(&s_lock);
+    return n;
+}
+
+int host_live_semaphores(void)
+{
+    pthread_mutex_lock(&s_lock);
+    int n = s_live_sems;
+    pthread_mutex_unlock(&s_lock);
+    return n;
+}
+
+// ---------------------------------------------------------------------------
+// Panel model
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Returns the number of argument bytes that follow a command byte.
+ */
+static int _host_cmd_args(uint8_t cmd)
+{
+    switch (cmd)
+    {
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+    case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+    case 0x21: case 0x22: case 0xA3:
+        return 2;
+    case 0x29: case 0x2A:
+        return 5;
+    case 0x26: case 0x27:
+        return 6;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Applies the steps of a scroll run that is being deactivated to GDDRAM.
+ * As in the driver, directions are defined for the default segment remap.
+ */
+static void _host_scroll_stop(host_panel_t *p)
+{
+    static const uint16_t frames_per_step[8] = {5, 64, 128, 256, 3, 4, 25, 2};
+    const uint8_t *s = p->scroll_setup;
+    p->scroll_active = false;
+    uint64_t step_us = (uint64_t)frames_per_step[s[3] & 7] * p->frame_us;
+    int64_t steps = (s_now_us - p->scroll_since_us) / (int64_t)step_us;
+    bool horizontal = (s[0] == 0x26 || s[0] == 0x27);
+    bool right = (s[0] == 0x26 || s[0] == 0x29) == p->seg_remap;
+    int c0 = horizontal ? s[5] : 0, c1 = horizontal ? (s[6] > 127 ? 127 : s[6]) : 127;
+    int len = c1 - c0 + 1;
+    int shift = (int)(steps % len);
+    if (!right)
+        shift = (len - shift) % len;
+    for (int page = s[2]; page <= s[4] && page < 8; page++)
+    {
+        uint8_t row[128];
+        for (int i = 0; i < len; i++)
+            row[(i + shift) % len] = p->gddram[page][c0 + i];
+        memcpy(&p->gddram[page][c0], row, len);
+    }
+}
+
+/**
+ * @brief Executes one command with its arguments.
+ */
+static void _host_panel_cmd(host_panel_t *p, const uint8_t *c)
+{
+    switch (c[0])
+    {
+    case 0x21:
+        p->col_start = p->col = c[1];
+        p->col_end = c[2];
+        break;
+    case 0x22:
+        p->page_start = p->page = c[1];
+        p->page_end = c[2];
+        break;
+    case 0x81:
+        p->contrast = c[1];
+        break;
+    case 0xA0: case 0xA1:
+        p->seg_remap = c[0] & 1;
+        break;
+    case 0xA6: case 0xA7:
+        p->inverted = c[0] & 1;
+        break;
+    case 0xAE: case 0xAF:
+        p->display_on = c[0] & 1;
+        break;
+    case 0x26: case 0x27: case 0x29: case 0x2A:
+        memcpy(p->scroll_setup, c, 1 + _host_cmd_args(c[0]));
+        break;
+    case 0x2E:
+        if (p->scroll_active)
+            _host_scroll_stop(p);
+        break;
+    case 0x2F:
+        p->scroll_active = true;
+        p->scroll_since_us = s_now_us;
+        break;
+    default:
+        if (c[0] >= 0x40 && c[0] <= 0x7F)
+            p->start_line = c[0] & 0x3F;
+        break;
+    }
+}
+
+/**
+ * @brief Writes one byte at the GDDRAM pointer (horizontal addressing).
+ */
+static void _host_panel_data(host_panel_t *p, uint8_t byte)
+{
+    p->gddram[p->page & 7][p->col & 127] = byte;
+    p->data_bytes++;
+    if (p->col++ >= p->col_end)
+    {
+        p->col = p->col_start;
+        if (p->page++ >= p->page_end)
+            p->page = p->page_start;
+    }
+}
+
+/**
+ * @brief Plays a command link into the addressed panels. The caller holds `s_lock`.
+ */
+static void _host_play(i2c_port_t port, const host_link_t *link)
+{
+    size_t i = 0;
+    while (i < link->len)
+    {
+        if (link->items[i++] != HOST_LINK_START || i + 1 >= link->len)
+            continue;
+        host_panel_t *p = _host_panel_locked(port, (uint8_t)(link->items[i++] >> 1));
+        uint16_t control = link->items[i++];
+        p->transactions++;
+        while (i < link->len && link->items[i] <= 0xFF)
+        {
+            if (control == 0x40)
+            {
+                _host_panel_data(p, (uint8_t)link->items[i++]);
+                continue;
+            }
+            uint8_t cmd[8] = {0};
+            int n = 1 + _host_cmd_args((uint8_t)link->items[i]);
+            for (int k = 0; k < n && i < link->len && link->items[i] <= 0xFF; k++)
+                cmd[k] = (uint8_t)link->items[i++];
+            _host_panel_cmd(p, cmd);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// ESP-IDF
+// ---------------------------------------------------------------------------
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    static __thread char name[16];
+    snprintf(name, sizeof(name), "0x%x", code);
+    return name;
+}
+
+int64_t esp_timer_get_time(void)
+{
+    return host_time_us();
+}
+
+void esp_rom_delay_us(uint32_t us)
+{
+    host_advance_us(us);
+}
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len)
+{
+    crc = ~crc;
+    while (len--)
+    {
+        crc ^= *buf++;
+        for (int k = 0; k < 8; k++)
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+    }
+    return ~crc;
+}
+
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode) { return ESP_OK; }
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level) { return ESP_OK; }
+esp_err_t gpio_hold_en(gpio_num_t gpio_num) { return ESP_OK; }
+esp_err_t gpio_hold_dis(gpio_num_t gpio_num) { return ESP_OK; }
+
+esp_err_t i2c_param_config(i2c_port_t port, const i2c_config_t *conf) { return ESP_OK; }
+
+esp_err_t i2c_driver_install(i2c_port_t port, i2c_mode_t mode, size_t slv_rx_buf_len, size_t slv_tx_buf_len, int intr_alloc_flags)
+{
+    pthread_mutex_lock(&s_lock);
+    esp_err_t ret = s_i2c_installed[port] ? ESP_FAIL : ESP_OK; // ESP-IDF refuses a second install.
+    s_i2c_installed[port] = true;
+    pthread_mutex_unlock(&s_lock);
+    return ret;
+}
+
+esp_err_t i2c_driver_delete(i2c_port_t port)
+{
+    pthread_mutex_lock(&s_lock);
+    esp_err_t ret = s_i2c_installed[port] ? ESP_OK : ESP_ERR_INVALID_STATE;
+    s_i2c_installed[port] = false;
+    pthread_mutex_unlock(&s_lock);
+    return ret;
+}
+
+i2c_cmd_handle_t i2c_cmd_link_create(void)
+{
+    return calloc(1, sizeof(host_link_t));
+}
+
+i2c_cmd_handle_t i2c_cmd_link_create_static(uint8_t *buffer, uint32_t size)
+{
+    // The recording grows as needed, so the caller's buffer is not used.
+    return i2c_cmd_link_create();
+}
+
+void i2c_cmd_link_delete(i2c_cmd_handle_t cmd)
+{
+    host_link_t *link = cmd;
+    if (link)
+        free(link->items);
+    free(link);
+}
+
+void i2c_cmd_link_delete_static(i2c_cmd_handle_t cmd)
+{
+    i2c_cmd_link_delete(cmd);
+}
+
+static esp_err_t _host_link_put(i2c_cmd_handle_t cmd, uint16_t item)
+{
+    host_link_t *link = cmd;
+    if (link->len == link->cap)
+    {
+        size_t cap = link->cap ? link->cap * 2 : 64;
+        uint16_t *items = realloc(link->items, cap * sizeof(uint16_t));
+        if (!items)
+            return ESP_ERR_NO_MEM;
+        link->items = items;
+        link->cap = cap;
+    }
+    link->items[link->len++] = item;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd) { return _host_link_put(cmd, HOST_LINK_START); }
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd) { return _host_link_put(cmd, HOST_LINK_STOP); }
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd, uint8_t data, bool ack_en) { return _host_link_put(cmd, data); }
+
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd, const uint8_t *data, size_t data_len, bool ack_en)
+{
+    for (size_t i = 0; i < data_len; i++)
+        ESP_ERROR_CHECK(_host_link_put(cmd, data[i]));
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_cmd_begin(i2c_port_t port, i2c_cmd_handle_t cmd, TickType_t ticks_to_wait)
+{
+    pthread_mutex_lock(&s_lock);
+    esp_err_t ret = ESP_OK;
+    if (s_fail_after == 0)
+        ret = ESP_FAIL;
+    else
+    {
+        if (s_fail_after > 0)
+            s_fail_after--;
+        _host_play(port, cmd);
+    }
+    s_now_us += HOST_I2C_TRANSACTION_US;
+    pthread_mutex_unlock(&s_lock);
+    return ret;
+}
+
+// ---------------------------------------------------------------------------
+// FreeRTOS
+// ---------------------------------------------------------------------------
+
+void vTaskDelay(TickType_t ticks)
+{
+    host_advance_us((int64_t)ticks * 1000);
+}
+
+static void *_host_task_main(void *arg)
+{
+    host_task_start_t start = *(host_task_start_t *)arg;
+    free(arg);
+    start.fn(start.arg);
+    return NULL;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg, UBaseType_t priority, TaskHandle_t *out)
+{
+    host_task_start_t *start = malloc(sizeof(*start));
+    if (!start)
+        return pdFALSE;
+    start->fn = fn;
+    start->arg = arg;
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, _host_task_main, start) != 0)
+    {
+        free(start);
+        return pdFALSE;
+    }
+    pthread_detach(thread);
+    pthread_mutex_lock(&s_lock);
+    s_live_tasks++;
+    pthread_mutex_unlock(&s_lock);
+    if (out)
+        *out = (TaskHandle_t)(uintptr_t)thread;
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    // Only self-deletion is used by the driver.
+    pthread_mutex_lock(&s_lock);
+    s_live_tasks--;
+    pthread_mutex_unlock(&s_lock);
+    if (!task)
+        pthread_exit(NULL);
+}
+
+static SemaphoreHandle_t _host_sem_create(unsigned count)
+{
+    host_sem_t *sem = calloc(1, sizeof(*sem));
+    if (!sem)
+        return NULL;
+    pthread_mutex_init(&sem->lock, NULL);
+    pthread_cond_init(&sem->cond, NULL);
+    sem->count = count;
+    pthread_mutex_lock(&s_lock);
+    s_live_sems++;
+    pthread_mutex_unlock(&s_lock);
+    return sem;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return _host_sem_create(0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max_count, UBaseType_t initial_count)
+{
+    return _host_sem_create(initial_count);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t handle, TickType_t ticks_to_wait)
+{
+    host_sem_t *sem = handle;
+    pthread_mutex_lock(&sem->lock);
+    while (sem->count == 0 && ticks_to_wait)
+        pthread_cond_wait(&sem->cond, &sem->lock);
+    BaseType_t taken = sem->count ? pdTRUE : pdFALSE;
+    if (taken)
+        sem->count--;
+    pthread_mutex_unlock(&sem->lock);
+    return taken;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t handle)
+{
+    host_sem_t *sem = handle;
+    pthread_mutex_lock(&sem->lock);
+    sem->count++;
+    pthread_cond_signal(&sem->cond);
+    pthread_mutex_unlock(&sem->lock);
+    return pdTRUE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t handle)
+{
+    host_sem_t *sem = handle;
+    pthread_mutex_destroy(&sem->lock);
+    pthread_cond_destroy(&sem->cond);
+    free(sem);
+    pthread_mutex_lock(&s_lock);
+    s_live_sems--;
+    pthread_mutex_unlock(&s_lock);
+}
@@ -0,0 +1,173 @@
+/**
+ * @file      test_arena.c
+ * @brief     Fixed-block arena: first-fit allocation, statistics, and its use as the
+ *            allocator of a display.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "ssd1306.h"
+#include "ssd1306_arena.h"
+#include "ssd1306_image.h"
+#include "host_panel.h"
+#include "test_util.h"
+
+static ssd1306_arena_stats_t _stats(ssd1306_arena_handle_t arena)
+{
+    ssd1306_arena_stats_t stats;
+    CHECK_EQ(ssd1306_arena_get_stats(arena, &stats), ESP_OK);
+    return stats;
+}
+
+static void test_first_fit_and_stats(void)
+{
+    static uint32_t backing[8 * 16 / 4];
+    ssd1306_arena_handle_t arena = NULL;
+    ssd1306_arena_config_t cfg = {.size = sizeof(backing), .block_size = 16, .backing = backing};
+    CHECK_EQ(ssd1306_arena_create(&cfg, &arena), ESP_OK);
+    CHECK_EQ(_stats(arena).blocks, 8);
+
+    uint8_t *a = ssd1306_arena_alloc(arena, 1);   // 1 block
+    uint8_t *b = ssd1306_arena_alloc(arena, 40);  // 3 blocks
+    uint8_t *c = ssd1306_arena_alloc(arena, 32);  // 2 blocks
+    CHECK(a == (uint8_t *)backing && b == a + 16 && c == b + 48);
+    CHECK(ssd1306_arena_owns(arena, c + 31) && !ssd1306_arena_owns(arena, (uint8_t *)backing + sizeof(backing)));
+    CHECK_EQ(_stats(arena).used, 6);
+    CHECK_EQ(_stats(arena).largest_free, 2);
+
+    // A freed run is reused by the first request that fits in it.
+    ssd1306_arena_free(arena, b);
+    CHECK_EQ(_stats(arena).largest_free, 3);
+    CHECK(ssd1306_arena_alloc(arena, 16) == b);
+    CHECK(ssd1306_arena_alloc(arena, 48) == NULL); // 2 + 2 free blocks, not adjacent
+    uint8_t *d = ssd1306_arena_alloc(arena, 32);
+    CHECK(d == b + 16);
+
+    ssd1306_arena_stats_t stats = _stats(arena);
+    CHECK_EQ(stats.used, 6);
+    CHECK_EQ(stats.high_water, 6);
+    CHECK_EQ(stats.allocs, 5);
+    CHECK_EQ(stats.failures, 1);
+
+    ssd1306_arena_free(arena, a);
+    ssd1306_arena_free(arena, b);
+    ssd1306_arena_free(arena, c);
+    ssd1306_arena_free(arena, d);
+    stats = _stats(arena);
+    CHECK_EQ(stats.used, 0);
+    CHECK_EQ(stats.high_water, 6);
+    CHECK_EQ(stats.largest_free, 8);
+    CHECK_EQ(ssd1306_arena_delete(arena), ESP_OK);
+}
+
+static void test_invalid_free_is_ignored(void)
+{
+    static uint32_t backing[4 * 16 / 4];
+    ssd1306_arena_handle_t arena = NULL;
+    ssd1306_arena_config_t cfg = {.size = sizeof(backing), .block_size = 16, .backing = backing};
+    CHECK_EQ(ssd1306_arena_create(&cfg, &arena), ESP_OK);
+    uint8_t *a = ssd1306_arena_alloc(arena, 32);
+    uint8_t *b = ssd1306_arena_alloc(arena, 16);
+    CHECK(a && b);
+
+    // Not the start of a run, inside a run, and outside the arena: all rejected.
+    ssd1306_arena_free(arena, a + 1);
+    ssd1306_arena_free(arena, a + 16);
+    ssd1306_arena_free(arena, &cfg);
+    CHECK_EQ(_stats(arena).used, 3);
+
+    // A second free of the same pointer must not release a later allocation's blocks.
+    ssd1306_arena_free(arena, a);
+    ssd1306_arena_free(arena, a);
+    CHECK_EQ(_stats(arena).used, 1);
+    CHECK(ssd1306_arena_alloc(arena, 32) == a);
+    CHECK_EQ(_stats(arena).used, 3);
+    CHECK_EQ(ssd1306_arena_delete(arena), ESP_OK);
+}
+
+static void test_framebuffer_from_config_arena(void)
+{
+    host_reset();
+    ssd1306_arena_handle_t arena = NULL;
+    ssd1306_arena_config_t cfg = {.size = 16 * 128};
+    CHECK_EQ(ssd1306_arena_create(&cfg, &arena), ESP_OK);
+    ssd1306_config_t config = test_display_config();
+    config.arena = arena;
+    ssd1306_handle_t handle = NULL;
+    CHECK_EQ(ssd1306_create(&config, &handle), ESP_OK);
+    CHECK_EQ(_stats(arena).used, 8); // One block per page, no heap framebuffer.
+    CHECK_EQ(ssd1306_delete(&handle), ESP_OK);
+    CHECK_EQ(_stats(arena).used, 0);
+    CHECK_EQ(ssd1306_arena_delete(arena), ESP_OK);
+}
+
+static void test_switch_rejected_with_canvases(void)
+{
+    host_reset();
+    ssd1306_arena_handle_t a = NULL, b = NULL;
+    ssd1306_arena_config_t cfg = {.size = 32 * 128};
+    CHECK_EQ(ssd1306_arena_create(&cfg, &a), ESP_OK);
+    CHECK_EQ(ssd1306_arena_create(&cfg, &b), ESP_OK);
+    ssd1306_config_t config = test_display_config();
+    config.arena = a;
+    ssd1306_handle_t handle = NULL;
+    CHECK_EQ(ssd1306_create(&config, &handle), ESP_OK);
+
+    uint8_t *canvas = ssd1306_alloc_canvas(handle);
+    CHECK(ssd1306_arena_owns(a, canvas));
+    CHECK_EQ(ssd1306_set_arena(handle, b, true), ESP_ERR_INVALID_STATE);
+    CHECK_EQ(ssd1306_set_arena(handle, NULL, false), ESP_ERR_INVALID_STATE);
+    CHECK_EQ(_stats(a).used, 16);
+    ssd1306_free_canvas(handle, canvas);
+    CHECK_EQ(_stats(a).used, 8);
+
+    // Without canvases the framebuffer moves and the old arena is left empty.
+    CHECK_EQ(ssd1306_set_arena(handle, b, true), ESP_OK);
+    CHECK_EQ(_stats(a).used, 0);
+    CHECK_EQ(_stats(b).used, 8);
+    canvas = ssd1306_alloc_canvas(handle);
+    CHECK(ssd1306_arena_owns(b, canvas));
+    ssd1306_free_canvas(handle, canvas);
+    CHECK_EQ(ssd1306_delete(&handle), ESP_OK); // Deletes b.
+    CHECK_EQ(ssd1306_arena_delete(a), ESP_OK);
+}
+
+static void test_image_loader_buffers_from_arena(void)
+{
+    host_reset();
+    char path[] = "/tmp/ssd1306_arena_XXXXXX";
+    int fd = mkstemp(path);
+    CHECK(fd >= 0);
+    FILE *f = fdopen(fd, "wb");
+    fputs("P4\n16 8\n", f);
+    for (int i = 0; i < 16; i++)
+        fputc(0xF0, f);
+    fclose(f);
+
+    ssd1306_arena_handle_t arena = NULL;
+    ssd1306_arena_config_t cfg = {.size = 32 * 128};
+    CHECK_EQ(ssd1306_arena_create(&cfg, &arena), ESP_OK);
+    ssd1306_config_t config = test_display_config();
+    config.arena = arena;
+    ssd1306_handle_t handle = NULL;
+    CHECK_EQ(ssd1306_create(&config, &handle), ESP_OK);
+    uint32_t allocs = _stats(arena).allocs;
+    CHECK_EQ(ssd1306_image_load(handle, path, NULL, NULL), ESP_OK);
+    CHECK_EQ(_stats(arena).allocs, allocs + 2); // Reader and row strip.
+    CHECK_EQ(_stats(arena).used, 8);
+    CHECK(ssd1306_get_pixel(handle, 0, 0) && !ssd1306_get_pixel(handle, 4, 0));
+    CHECK_EQ(ssd1306_delete(&handle), ESP_OK);
+    CHECK_EQ(ssd1306_arena_delete(arena), ESP_OK);
+    unlink(path);
+}
+
+int main(void)
+{
+    RUN_TEST(test_first_fit_and_stats);
+    RUN_TEST(test_invalid_free_is_ignored);
+    RUN_TEST(test_framebuffer_from_config_arena);
+    RUN_TEST(test_switch_rejected_with_canvases);
+    RUN_TEST(test_image_loader_buffers_from_arena);
+    return TEST_RESULT();
+}
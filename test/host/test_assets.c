@@ -0,0 +1,88 @@
+/**
+ * @file      test_assets.c
+ * @brief     Asset compiler end to end: images compiled at build time by
+ *            tools/asset_compiler (see assets/assets.txt) draw the expected pixels, and
+ *            a run that fails leaves no output behind.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "ssd1306.h"
+#include "host_panel.h"
+#include "test_util.h"
+#include "test_assets.h"
+
+typedef bool (*pixel_fn_t)(int x, int y);
+
+static bool _box(int x, int y) { return x == 0 || x == 7 || y == 0 || y == 7; }
+static bool _cross(int x, int y) { return x == y || x == 7 - y; }
+static bool _block(int x, int y) { return x >= 4 && x <= 27 && y >= 3 && y <= 12; }
+static bool _ramp(int x, int y) { return x * 32 >= 128; }
+static bool _ramp_inv(int x, int y) { return !_ramp(x, y); }
+
+/** Draws a frame at (x0, y0) on a cleared screen and compares the whole screen. */
+static void _check_frame(ssd1306_handle_t disp, const ssd1306_asset_t *asset, uint16_t frame, int x0, int y0, pixel_fn_t expected)
+{
+    ssd1306_fill_rect(disp, 0, 0, 128, 64, OLED_COLOR_BLACK);
+    CHECK_EQ(ssd1306_draw_asset(disp, x0, y0, asset, frame, OLED_COLOR_WHITE, OLED_COLOR_BLACK), ESP_OK);
+    int wrong = 0;
+    for (int y = 0; y < 64; y++)
+        for (int x = 0; x < 128; x++)
+        {
+            int ax = x - x0, ay = y - y0;
+            bool inside = ax >= 0 && ax < asset->width && ay >= 0 && ay < asset->height;
+            wrong += ssd1306_get_pixel(disp, x, y) != (inside && expected(ax, ay));
+        }
+    CHECK_EQ(wrong, 0);
+}
+
+static void test_compiled_assets(void)
+{
+    host_reset();
+    ssd1306_config_t config = test_display_config();
+    ssd1306_handle_t disp = NULL;
+    CHECK_EQ(ssd1306_create(&config, &disp), ESP_OK);
+
+    CHECK_EQ(SHEET_FRAMES, 2);
+    CHECK(SHEET_WIDTH == 8 && SHEET_HEIGHT == 8 && !sheet.rle);
+    _check_frame(disp, &sheet, 0, 10, 3, _box);
+    _check_frame(disp, &sheet, 1, 10, 3, _cross);
+
+    CHECK(block.rle);
+    CHECK(block.offsets[1] < 32 * 16 / 8); // Smaller than the raw frame.
+    _check_frame(disp, &block, 0, 0, 0, _block);
+    _check_frame(disp, &block, 0, 50, 21, _block);
+
+    _check_frame(disp, &ramp, 0, 3, 9, _ramp);
+    _check_frame(disp, &ramp_inv, 0, 3, 9, _ramp_inv);
+    CHECK_EQ(ssd1306_delete(&disp), ESP_OK);
+}
+
+static void test_failed_run_leaves_no_files(void)
+{
+    char dir[] = "/tmp/ssd1306_assets_XXXXXX";
+    CHECK(mkdtemp(dir) != NULL);
+    char manifest[64], out[64], tmp[64], cmd[256];
+    snprintf(manifest, sizeof(manifest), "%s/bad.txt", dir);
+    snprintf(out, sizeof(out), "%s/out.h", dir);
+    snprintf(tmp, sizeof(tmp), "%s/out.h.tmp", dir);
+    FILE *f = fopen(manifest, "w");
+    CHECK(f != NULL);
+    fputs("bad-name missing.pbm\n", f);
+    fclose(f);
+
+    snprintf(cmd, sizeof(cmd), "\"%s\" %s %s 2>/dev/null", SSD1306_ASSETS_TOOL, manifest, out);
+    CHECK(system(cmd) != 0);
+    CHECK(access(out, F_OK) != 0);
+    CHECK(access(tmp, F_OK) != 0);
+    remove(manifest);
+    rmdir(dir);
+}
+
+int main(void)
+{
+    RUN_TEST(test_compiled_assets);
+    RUN_TEST(test_failed_run_leaves_no_files);
+    return TEST_RESULT();
+}
@@ -0,0 +1,95 @@
+/**
+ * @file      test_create.c
+ * @brief     Display creation: a failure at any bus transaction must release everything
+ *            acquired so far. Leaked memory is reported by LeakSanitizer at exit. Tiles
+ *            must be distinct devices.
+ */
+
+#include <unistd.h>
+#include "ssd1306.h"
+#include "host_panel.h"
+#include "test_util.h"
+
+#define MAX_TRANSACTIONS 64 /**< More than creation needs, so the last attempts succeed. */
+
+/** Waits briefly for worker threads that are still on their way out. */
+static int _live_tasks(void)
+{
+    for (int i = 0; i < 1000 && host_live_tasks(); i++)
+        usleep(1000);
+    return host_live_tasks();
+}
+
+static void test_create_failures_release_resources(void)
+{
+    ssd1306_config_t config = test_display_config();
+    int created = 0;
+    for (int n = 0; n < MAX_TRANSACTIONS; n++)
+    {
+        host_reset();
+        host_i2c_fail_after(n);
+        ssd1306_handle_t handle = NULL;
+        esp_err_t ret = ssd1306_create(&config, &handle);
+        if (ret == ESP_OK)
+        {
+            created++;
+            CHECK_EQ(ssd1306_delete(&handle), ESP_OK);
+        }
+        else
+            CHECK(handle == NULL);
+        CHECK_EQ(host_i2c_drivers(), 0);
+    }
+    CHECK(created > 0);
+}
+
+static void test_tiled_create_failures_release_resources(void)
+{
+    ssd1306_config_t panels[2] = {test_display_config(), test_display_config()};
+    panels[1].i2c_port = I2C_NUM_1; // Two ports: one flush worker each.
+    ssd1306_tiled_config_t config = {.panels = panels, .cols = 2, .rows = 1};
+    int created = 0;
+    for (int n = 0; n < MAX_TRANSACTIONS; n++)
+    {
+        host_reset();
+        host_i2c_fail_after(n);
+        ssd1306_handle_t handle = NULL;
+        esp_err_t ret = ssd1306_create_tiled(&config, &handle);
+        if (ret == ESP_OK)
+        {
+            created++;
+            CHECK_EQ(ssd1306_delete(&handle), ESP_OK);
+        }
+        else
+            CHECK(handle == NULL);
+        CHECK_EQ(_live_tasks(), 0);
+        CHECK_EQ(host_live_semaphores(), 0);
+        CHECK_EQ(host_i2c_drivers(), 0);
+    }
+    CHECK(created > 0);
+}
+
+static void test_tiled_rejects_duplicate_panels(void)
+{
+    host_reset();
+    ssd1306_config_t panels[3] = {test_display_config(), test_display_config(), test_display_config()};
+    panels[1].i2c_addr = 0x3D;
+    ssd1306_tiled_config_t config = {.panels = panels, .cols = 3, .rows = 1};
+    ssd1306_handle_t handle = NULL;
+    // The third tile repeats the first one's port and address.
+    CHECK_EQ(ssd1306_create_tiled(&config, &handle), ESP_ERR_INVALID_ARG);
+    CHECK(handle == NULL);
+    CHECK_EQ(host_i2c_drivers(), 0);
+
+    // The same address on another port is a different device.
+    panels[2].i2c_port = I2C_NUM_1;
+    CHECK_EQ(ssd1306_create_tiled(&config, &handle), ESP_OK);
+    CHECK_EQ(ssd1306_delete(&handle), ESP_OK);
+}
+
+int main(void)
+{
+    RUN_TEST(test_create_failures_release_resources);
+    RUN_TEST(test_tiled_create_failures_release_resources);
+    RUN_TEST(test_tiled_rejects_duplicate_panels);
+    return TEST_RESULT();
+}
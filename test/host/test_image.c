@@ -0,0 +1,187 @@
+/**
+ * @file      test_image.c
+ * @brief     PBM and XBM loading: header parsing, bit order, placement and clipping
+ *            (framebuffer and canvas), and the errors for damaged files.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "ssd1306.h"
+#include "ssd1306_image.h"
+#include "host_panel.h"
+#include "test_util.h"
+
+#define IMG_W 21
+#define IMG_H 13
+
+static char s_path[64];
+
+/** Test image: an irregular pattern, so bit order and row offsets matter. */
+static bool _img_pixel(int x, int y)
+{
+    return (x * 7 + y * 3) % 5 == 0 || x == y;
+}
+
+/** Writes `text` to a fresh temporary file and returns its path. */
+static const char *_write_file(const void *text, size_t len)
+{
+    strcpy(s_path, "/tmp/ssd1306_image_XXXXXX");
+    int fd = mkstemp(s_path);
+    CHECK(fd >= 0);
+    FILE *f = fdopen(fd, "wb");
+    fwrite(text, 1, len, f);
+    fclose(f);
+    return s_path;
+}
+
+static const char *_write_pbm(void)
+{
+    static uint8_t buf[256];
+    int n = snprintf((char *)buf, sizeof(buf), "P4\n# made by a test\n%d  # width\n%d\n", IMG_W, IMG_H);
+    for (int y = 0; y < IMG_H; y++)
+        for (int bx = 0; bx < (IMG_W + 7) / 8; bx++)
+        {
+            uint8_t byte = 0;
+            for (int b = 0; b < 8; b++)
+                if (bx * 8 + b < IMG_W && _img_pixel(bx * 8 + b, y))
+                    byte |= 0x80 >> b;
+            buf[n++] = byte;
+        }
+    return _write_file(buf, n);
+}
+
+static const char *_write_xbm(void)
+{
+    static char buf[2048];
+    int n = snprintf(buf, sizeof(buf), "/* test */\n#define t_width %d\n#define t_height %d\nstatic unsigned char t_bits[] = {\n", IMG_W, IMG_H);
+    for (int y = 0; y < IMG_H; y++)
+        for (int bx = 0; bx < (IMG_W + 7) / 8; bx++)
+        {
+            uint8_t byte = 0;
+            for (int b = 0; b < 8; b++)
+                if (bx * 8 + b < IMG_W && _img_pixel(bx * 8 + b, y))
+                    byte |= 1 << b;
+            n += snprintf(buf + n, sizeof(buf) - n, "0x%02x, ", byte);
+        }
+    n += snprintf(buf + n, sizeof(buf) - n, "};\n");
+    return _write_file(buf, n);
+}
+
+static ssd1306_handle_t _create(void)
+{
+    host_reset();
+    ssd1306_config_t config = test_display_config();
+    ssd1306_handle_t handle = NULL;
+    CHECK_EQ(ssd1306_create(&config, &handle), ESP_OK);
+    return handle;
+}
+
+/** Checks the framebuffer against the image placed at (x0, y0), white outside it. */
+static void _check_placed(ssd1306_handle_t disp, int x0, int y0, bool invert)
+{
+    int wrong = 0;
+    for (int y = 0; y < 64; y++)
+        for (int x = 0; x < 128; x++)
+        {
+            int ix = x - x0, iy = y - y0;
+            bool inside = ix >= 0 && ix < IMG_W && iy >= 0 && iy < IMG_H;
+            bool expected = inside ? _img_pixel(ix, iy) != invert : true;
+            wrong += ssd1306_get_pixel(disp, x, y) != expected;
+        }
+    CHECK_EQ(wrong, 0);
+}
+
+static void _load_placed(const char *path, ssd1306_image_format_t format, int16_t x, int16_t y, bool invert)
+{
+    ssd1306_handle_t disp = _create();
+    ssd1306_fill_rect(disp, 0, 0, 128, 64, OLED_COLOR_WHITE); // The image replaces what is under it.
+    ssd1306_image_opts_t opts = {.x = x, .y = y, .invert = invert};
+    ssd1306_image_info_t info;
+    CHECK_EQ(ssd1306_image_load(disp, path, &opts, &info), ESP_OK);
+    CHECK_EQ(info.format, format);
+    CHECK_EQ(info.width, IMG_W);
+    CHECK_EQ(info.height, IMG_H);
+    _check_placed(disp, x, y, invert);
+    CHECK_EQ(ssd1306_delete(&disp), ESP_OK);
+}
+
+static void test_pbm(void)
+{
+    const char *path = _write_pbm();
+    _load_placed(path, SSD1306_IMAGE_PBM, 0, 0, false);
+    _load_placed(path, SSD1306_IMAGE_PBM, 37, 5, false);   // Off the page grid.
+    _load_placed(path, SSD1306_IMAGE_PBM, -6, -3, false);  // Clipped top-left.
+    _load_placed(path, SSD1306_IMAGE_PBM, 120, 58, true);  // Clipped bottom-right, inverted.
+    unlink(path);
+}
+
+static void test_xbm(void)
+{
+    const char *path = _write_xbm();
+    _load_placed(path, SSD1306_IMAGE_XBM, 0, 0, false);
+    _load_placed(path, SSD1306_IMAGE_XBM, 37, 5, false);
+    _load_placed(path, SSD1306_IMAGE_XBM, -6, -3, true);
+    unlink(path);
+}
+
+static void test_canvas_target(void)
+{
+    const char *path = _write_pbm();
+    static uint8_t canvas[32 * 16 / 8];
+    ssd1306_image_opts_t opts = {.x = 5, .y = 2, .canvas = canvas, .canvas_w = 32, .canvas_h = 16};
+    CHECK_EQ(ssd1306_image_load(NULL, path, &opts, NULL), ESP_OK);
+    int wrong = 0;
+    for (int y = 0; y < 16; y++)
+        for (int x = 0; x < 32; x++)
+        {
+            int ix = x - 5, iy = y - 2;
+            bool expected = ix >= 0 && ix < IMG_W && iy >= 0 && iy < IMG_H && _img_pixel(ix, iy);
+            wrong += ((canvas[(y / 8) * 32 + x] >> (y % 8)) & 1) != expected;
+        }
+    CHECK_EQ(wrong, 0);
+    opts.canvas_h = 12; // Not a whole number of pages.
+    CHECK_EQ(ssd1306_image_load(NULL, path, &opts, NULL), ESP_ERR_INVALID_ARG);
+    unlink(path);
+}
+
+static void _expect_error(const char *text, size_t len, esp_err_t expected)
+{
+    ssd1306_handle_t disp = _create();
+    const char *path = _write_file(text, len);
+    CHECK_EQ(ssd1306_image_load(disp, path, NULL, NULL), expected);
+    unlink(path);
+    CHECK_EQ(ssd1306_delete(&disp), ESP_OK);
+}
+
+static void test_errors(void)
+{
+    ssd1306_handle_t disp = _create();
+    CHECK_EQ(ssd1306_image_load(disp, "/nonexistent/image.pbm", NULL, NULL), ESP_ERR_NOT_FOUND);
+    CHECK_EQ(ssd1306_delete(&disp), ESP_OK);
+
+    static const char ascii_pbm[] = "P1\n2 2\n0 1\n1 0\n";
+    _expect_error(ascii_pbm, sizeof(ascii_pbm) - 1, ESP_ERR_NOT_SUPPORTED);
+    static const char truncated[] = "P4\n16 4\n\xff\xff\xff";
+    _expect_error(truncated, sizeof(truncated) - 1, ESP_ERR_INVALID_RESPONSE);
+    static const char bad_size[] = "P4\n0 4\n";
+    _expect_error(bad_size, sizeof(bad_size) - 1, ESP_ERR_INVALID_RESPONSE);
+    static const char huge[] = "P4\n99999 4\n";
+    _expect_error(huge, sizeof(huge) - 1, ESP_ERR_INVALID_RESPONSE);
+    static const char no_height[] = "#define t_width 8\nstatic char t_bits[] = { 0x01 };\n";
+    _expect_error(no_height, sizeof(no_height) - 1, ESP_ERR_NOT_SUPPORTED);
+    static const char bad_data[] = "#define t_width 8\n#define t_height 2\nstatic char t_bits[] = { 0x01, oops };\n";
+    _expect_error(bad_data, sizeof(bad_data) - 1, ESP_ERR_INVALID_RESPONSE);
+    static const char png[] = "\x89PNG\r\n\x1a\n";
+    _expect_error(png, sizeof(png) - 1, ESP_ERR_NOT_SUPPORTED);
+}
+
+int main(void)
+{
+    RUN_TEST(test_pbm);
+    RUN_TEST(test_xbm);
+    RUN_TEST(test_canvas_target);
+    RUN_TEST(test_errors);
+    return TEST_RESULT();
+}
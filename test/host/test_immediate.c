@@ -0,0 +1,64 @@
+/**
+ * @file      test_immediate.c
+ * @brief     Immediate mode: framebuffer functions refuse a handle without framebuffer,
+ *            and queued commands ride along with the direct writes.
+ */
+
+#include "ssd1306.h"
+#include "ssd1306_qr.h"
+#include "host_panel.h"
+#include "test_util.h"
+
+static ssd1306_handle_t _create_immediate(void)
+{
+    host_reset();
+    ssd1306_config_t config = test_display_config();
+    config.no_framebuffer = true;
+    ssd1306_handle_t handle = NULL;
+    CHECK_EQ(ssd1306_create(&config, &handle), ESP_OK);
+    return handle;
+}
+
+static void test_framebuffer_functions_not_supported(void)
+{
+    ssd1306_handle_t handle = _create_immediate();
+    uint8_t buf[1200];
+    CHECK_EQ(ssd1306_update_screen(handle), ESP_ERR_NOT_SUPPORTED);
+    CHECK_EQ(ssd1306_save_snapshot(handle, buf, sizeof(buf), NULL), ESP_ERR_NOT_SUPPORTED);
+    ssd1306_scroll_config_t scroll = {.direction = SSD1306_SCROLL_LEFT, .end_page = 7, .end_col = 127};
+    CHECK_EQ(ssd1306_scroll_start(handle, &scroll), ESP_ERR_NOT_SUPPORTED);
+    CHECK_EQ(ssd1306_scroll_resync(handle, 0), ESP_ERR_NOT_SUPPORTED);
+
+    static const uint8_t frame[8] = {0xFF, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0xFF};
+    static const uint32_t offsets[2] = {0, sizeof(frame)};
+    ssd1306_asset_t asset = {.width = 8, .height = 8, .frames = 1, .data = frame, .offsets = offsets};
+    CHECK_EQ(ssd1306_draw_asset(handle, 0, 0, &asset, 0, OLED_COLOR_WHITE, OLED_COLOR_BLACK), ESP_ERR_NOT_SUPPORTED);
+
+    static ssd1306_qr_t qr;
+    CHECK_EQ(ssd1306_qr_encode(&qr, "ssd1306", 7, SSD1306_QR_ECC_L, 1), ESP_OK);
+    CHECK_EQ(ssd1306_draw_qr(handle, 0, 0, &qr, 1, 2), ESP_ERR_NOT_SUPPORTED);
+    CHECK_EQ(ssd1306_print_rotated(handle, 0, 10, "A", 90), ESP_ERR_NOT_SUPPORTED);
+    CHECK_EQ(ssd1306_delete(&handle), ESP_OK);
+}
+
+static void test_queued_commands_ride_with_direct_writes(void)
+{
+    ssd1306_handle_t handle = _create_immediate();
+    host_panel_t *panel = host_panel(I2C_NUM_0, 0x3C);
+    CHECK_EQ(ssd1306_set_deferred_commands(handle, true), ESP_OK);
+    ssd1306_set_contrast(handle, 0x42);
+    CHECK(panel->contrast != 0x42);
+    CHECK_EQ(ssd1306_direct_fill(handle, 8, 2, 16, 1, 0xA5), ESP_OK);
+    CHECK_EQ(panel->contrast, 0x42);
+    CHECK_EQ(panel->gddram[2][8], 0xA5);
+    CHECK_EQ(panel->gddram[2][23], 0xA5);
+    CHECK_EQ(panel->gddram[2][24], 0x00);
+    CHECK_EQ(ssd1306_delete(&handle), ESP_OK);
+}
+
+int main(void)
+{
+    RUN_TEST(test_framebuffer_functions_not_supported);
+    RUN_TEST(test_queued_commands_ride_with_direct_writes);
+    return TEST_RESULT();
+}
@@ -0,0 +1,52 @@
+/**
+ * @file      test_marquee.c
+ * @brief     Marquee: painting the field leaves the application's font and clip
+ *            rectangle as they were.
+ */
+
+#include "ssd1306.h"
+#include "ssd1306_marquee.h"
+#include "fonts/FreeSans9pt7b.h"
+#include "fonts/font5x7.h"
+#include "host_panel.h"
+#include "test_util.h"
+
+static void test_paint_keeps_text_state(void)
+{
+    host_reset();
+    ssd1306_config_t config = test_display_config();
+    ssd1306_handle_t disp = NULL;
+    CHECK_EQ(ssd1306_create(&config, &disp), ESP_OK);
+    ssd1306_set_font(disp, &FONT_5x7);
+    ssd1306_set_clip_rect(disp, 4, 8, 60, 40);
+
+    // A text longer than the field, so polling refills it as well.
+    ssd1306_marquee_config_t cfg = {
+        .x = 0,
+        .w = 64,
+        .page = 2,
+        .pages = 3,
+        .gap = 8,
+        .speed = SSD1306_SCROLL_FRAMES_2,
+    };
+    ssd1306_marquee_t m;
+    CHECK_EQ(ssd1306_marquee_start(&m, disp, &cfg, &FONT_GFX_FreeSans9pt7b, "A marquee wider than its field"), ESP_OK);
+    host_advance_us(ssd1306_scroll_get_step_period(disp, cfg.speed) * 20);
+    CHECK_EQ(ssd1306_marquee_poll(&m), ESP_OK);
+    CHECK_EQ(ssd1306_marquee_stop(&m), ESP_OK);
+
+    int16_t x, y, w, h;
+    CHECK_EQ(ssd1306_get_clip_rect(disp, &x, &y, &w, &h), ESP_OK);
+    CHECK_EQ(x, 4);
+    CHECK_EQ(y, 8);
+    CHECK_EQ(w, 60);
+    CHECK_EQ(h, 40);
+    CHECK(ssd1306_get_font(disp) == &FONT_5x7);
+    CHECK_EQ(ssd1306_delete(&disp), ESP_OK);
+}
+
+int main(void)
+{
+    RUN_TEST(test_paint_keeps_text_state);
+    return TEST_RESULT();
+}
@@ -0,0 +1,83 @@
+/**
+ * @file      test_page_flip.c
+ * @brief     GDDRAM page flipping on a 32-row panel, including the return to single buffering.
+ */
+
+#include <string.h>
+#include "ssd1306.h"
+#include "host_panel.h"
+#include "test_util.h"
+
+/** True if GDDRAM pages `base` to `base + 3` hold the framebuffer. */
+static bool _half_matches(ssd1306_handle_t handle, const host_panel_t *panel, int base)
+{
+    for (uint8_t page = 0; page < 4; page++)
+    {
+        uint8_t row[128];
+        ssd1306_read_page(handle, 0, page, row, 128);
+        if (memcmp(row, panel->gddram[base + page], sizeof(row)) != 0)
+            return false;
+    }
+    return true;
+}
+
+static void test_flip_alternates_halves(void)
+{
+    host_reset();
+    ssd1306_config_t config = test_display_config();
+    config.screen_height = 32;
+    ssd1306_handle_t handle = NULL;
+    CHECK_EQ(ssd1306_create(&config, &handle), ESP_OK);
+    host_panel_t *panel = host_panel(config.i2c_port, config.i2c_addr);
+
+    CHECK_EQ(ssd1306_set_page_flip(handle, true), ESP_OK);
+    for (int frame = 0; frame < 4; frame++)
+    {
+        ssd1306_fill_rect(handle, frame * 20, frame * 4, 12, 10, OLED_COLOR_WHITE);
+        CHECK_EQ(ssd1306_update_screen(handle), ESP_OK);
+        int shown = (frame & 1) ? 0 : 4;
+        CHECK_EQ(panel->start_line, shown * 8);
+        CHECK(_half_matches(handle, panel, shown));
+    }
+    ssd1306_delete(&handle);
+}
+
+static void test_disable_keeps_current_frame(void)
+{
+    host_reset();
+    ssd1306_config_t config = test_display_config();
+    config.screen_height = 32;
+    ssd1306_handle_t handle = NULL;
+    CHECK_EQ(ssd1306_create(&config, &handle), ESP_OK);
+    host_panel_t *panel = host_panel(config.i2c_port, config.i2c_addr);
+
+    CHECK_EQ(ssd1306_set_page_flip(handle, true), ESP_OK);
+    ssd1306_draw_line(handle, 0, 0, 127, 31, OLED_COLOR_WHITE);
+    CHECK_EQ(ssd1306_update_screen(handle), ESP_OK);
+    CHECK_EQ(panel->start_line, 32);
+
+    // The lower half is a frame behind; disabling must not show it before it is rewritten.
+    uint32_t transactions = panel->transactions;
+    CHECK_EQ(ssd1306_set_page_flip(handle, false), ESP_OK);
+    CHECK_EQ(panel->transactions, transactions);
+    CHECK_EQ(panel->start_line, 32);
+
+    ssd1306_draw_circle(handle, 64, 16, 10, OLED_COLOR_WHITE);
+    CHECK_EQ(ssd1306_update_screen(handle), ESP_OK);
+    CHECK_EQ(panel->start_line, 0);
+    CHECK(_half_matches(handle, panel, 0));
+
+    // Single buffering from here on: later updates stay in the lower half.
+    ssd1306_draw_pixel(handle, 100, 2, OLED_COLOR_WHITE);
+    CHECK_EQ(ssd1306_update_screen(handle), ESP_OK);
+    CHECK_EQ(panel->start_line, 0);
+    CHECK(_half_matches(handle, panel, 0));
+    ssd1306_delete(&handle);
+}
+
+int main(void)
+{
+    RUN_TEST(test_flip_alternates_halves);
+    RUN_TEST(test_disable_keeps_current_frame);
+    return TEST_RESULT();
+}
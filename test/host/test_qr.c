@@ -0,0 +1,207 @@
+/**
+ * @file      test_qr.c
+ * @brief     QR encoder checked by an independent reader: format information against
+ *            the ISO/IEC 18004 table, Reed-Solomon syndromes of every block, and the
+ *            byte-mode payload read back through the mask and the codeword placement.
+ */
+
+#include <string.h>
+#include "ssd1306_qr.h"
+#include "test_util.h"
+
+/** Format information by level (L, M, Q, H) and mask, from ISO/IEC 18004 Table C.1. */
+static const uint16_t format_table[4][8] = {
+    {0x77C4, 0x72F3, 0x7DAA, 0x789D, 0x662F, 0x6318, 0x6C41, 0x6976},
+    {0x5412, 0x5125, 0x5E7C, 0x5B4B, 0x45F9, 0x40CE, 0x4F97, 0x4AA0},
+    {0x355F, 0x3068, 0x3F31, 0x3A06, 0x24B4, 0x2183, 0x2EDA, 0x2BED},
+    {0x1689, 0x13BE, 0x1CE7, 0x19D0, 0x0762, 0x0255, 0x0D0C, 0x083B},
+};
+
+/** Error correction codewords per block and blocks, by level and version (Table 9). */
+static const uint8_t ecc_per_block[4][6] = {{7, 10, 15, 20, 26, 18}, {10, 16, 26, 18, 24, 16}, {13, 22, 18, 26, 18, 24}, {17, 28, 22, 16, 22, 28}};
+static const uint8_t blocks[4][6] = {{1, 1, 1, 1, 1, 2}, {1, 1, 1, 2, 2, 4}, {1, 1, 2, 2, 4, 4}, {1, 1, 2, 4, 4, 4}};
+static const uint8_t total_codewords[6] = {26, 44, 70, 100, 134, 172};
+
+static bool _module(const ssd1306_qr_t *qr, int x, int y)
+{
+    return ssd1306_qr_get_module(qr, (int16_t)x, (int16_t)y);
+}
+
+/** Finder patterns with separators and format areas, timing patterns, alignment pattern. */
+static bool _is_function(int size, int version, int x, int y)
+{
+    if ((x < 9 && y < 9) || (x >= size - 8 && y < 9) || (x < 9 && y >= size - 8))
+        return true;
+    if (x == 6 || y == 6)
+        return true;
+    return version >= 2 && x >= size - 9 && x <= size - 5 && y >= size - 9 && y <= size - 5;
+}
+
+static bool _mask(int mask, int x, int y)
+{
+    switch (mask)
+    {
+    case 0: return (x + y) % 2 == 0;
+    case 1: return y % 2 == 0;
+    case 2: return x % 3 == 0;
+    case 3: return (x + y) % 3 == 0;
+    case 4: return (y / 2 + x / 3) % 2 == 0;
+    case 5: return x * y % 2 + x * y % 3 == 0;
+    case 6: return (x * y % 2 + x * y % 3) % 2 == 0;
+    default: return ((x + y) % 2 + x * y % 3) % 2 == 0;
+    }
+}
+
+static uint8_t _gf_mul(uint8_t a, uint8_t b)
+{
+    uint8_t r = 0;
+    for (; b; b >>= 1)
+    {
+        if (b & 1)
+            r ^= a;
+        a = (uint8_t)((a << 1) ^ ((a & 0x80) ? 0x1D : 0));
+    }
+    return r;
+}
+
+/** True if c(alpha^i) == 0 for i < ecc, i.e. the block is a Reed-Solomon codeword. */
+static bool _rs_valid(const uint8_t *block, int len, int ecc)
+{
+    uint8_t alpha_i = 1;
+    for (int i = 0; i < ecc; i++)
+    {
+        uint8_t sum = 0;
+        for (int k = 0; k < len; k++)
+            sum = _gf_mul(sum, alpha_i) ^ block[k]; // Horner's rule.
+        if (sum)
+            return false;
+        alpha_i = _gf_mul(alpha_i, 2);
+    }
+    return true;
+}
+
+/** Reads the code back and compares it with `data`. */
+static void _check_code(const ssd1306_qr_t *qr, const char *data)
+{
+    const int size = qr->size, version = qr->version, ecc = qr->ecc;
+    CHECK_EQ(size, 4 * version + 17);
+
+    // Finder pattern centers and a timing pattern module.
+    CHECK(_module(qr, 3, 3) && _module(qr, size - 4, 3) && _module(qr, 3, size - 4));
+    CHECK(!_module(qr, 1, 1) && !_module(qr, 7, 7));
+    CHECK(_module(qr, 8, 6) && !_module(qr, 9, 6));
+    CHECK(_module(qr, 8, size - 8)); // Dark module.
+
+    // Both copies of the format information.
+    uint16_t copy1 = 0, copy2 = 0;
+    for (int i = 0; i < 6; i++)
+        copy1 |= _module(qr, 8, i) << i;
+    copy1 |= _module(qr, 8, 7) << 6 | _module(qr, 8, 8) << 7 | _module(qr, 7, 8) << 8;
+    for (int i = 9; i < 15; i++)
+        copy1 |= _module(qr, 14 - i, 8) << i;
+    for (int i = 0; i < 8; i++)
+        copy2 |= _module(qr, size - 1 - i, 8) << i;
+    for (int i = 8; i < 15; i++)
+        copy2 |= _module(qr, 8, size - 15 + i) << i;
+    CHECK_EQ(copy1, format_table[ecc][qr->mask]);
+    CHECK_EQ(copy2, copy1);
+
+    // Codewords in placement order: two-column strips from the right, alternating direction.
+    uint8_t cw[172] = {0};
+    int bit = 0, total = total_codewords[version - 1];
+    for (int right = size - 1, up = 1; right >= 1; right -= 2, up ^= 1)
+    {
+        if (right == 6)
+            right = 5;
+        for (int i = 0; i < size; i++)
+        {
+            int y = up ? size - 1 - i : i;
+            for (int x = right; x >= right - 1; x--)
+            {
+                if (_is_function(size, version, x, y))
+                    continue;
+                if (bit < total * 8 && (_module(qr, x, y) ^ _mask(qr->mask, x, y)))
+                    cw[bit / 8] |= 0x80 >> (bit % 8);
+                bit++;
+            }
+        }
+    }
+    CHECK(bit >= total * 8);
+
+    // De-interleave into blocks; the long blocks come last.
+    const int nb = blocks[ecc][version - 1], ec = ecc_per_block[ecc][version - 1];
+    const int short_len = total / nb, n_short = nb - total % nb;
+    uint8_t block[4][172], data_out[172];
+    int k = 0, data_len = 0;
+    for (int i = 0; i < short_len - ec + 1; i++)
+        for (int b = 0; b < nb; b++)
+            if (i < short_len - ec || b >= n_short)
+                block[b][i] = cw[k++];
+    for (int i = 0; i < ec; i++)
+        for (int b = 0; b < nb; b++)
+            block[b][short_len - ec + (b >= n_short) + i] = cw[k++];
+    CHECK_EQ(k, total);
+    for (int b = 0; b < nb; b++)
+    {
+        int len = short_len + (b >= n_short);
+        CHECK(_rs_valid(block[b], len, ec));
+        memcpy(&data_out[data_len], block[b], len - ec);
+        data_len += len - ec;
+    }
+
+    // Byte mode segment: mode 0100, 8-bit count, then the bytes.
+    size_t len = strlen(data);
+    CHECK_EQ(data_out[0] >> 4, 0x4);
+    CHECK_EQ(((data_out[0] & 0x0F) << 4) | (data_out[1] >> 4), len);
+    bool same = true;
+    for (size_t i = 0; i < len; i++)
+        same &= (uint8_t)(((data_out[1 + i] & 0x0F) << 4) | (data_out[2 + i] >> 4)) == (uint8_t)data[i];
+    CHECK(same);
+}
+
+static void test_levels_and_versions(void)
+{
+    static const char *payloads[] = {
+        "A",
+        "01234567890123456",                                    // 17 bytes: the capacity of 1-L
+        "012345678901234567",                                   // one more: version 2
+        "https://example.com/device?id=0042",
+        "WIFI:T:WPA;S:workshop-sensors;P:correct horse battery staple;;",
+        "The quick brown fox jumps over the lazy dog. 0123456789 The quick brown fox!", // version 5 or 6
+    };
+    static ssd1306_qr_t qr;
+    for (size_t p = 0; p < sizeof(payloads) / sizeof(payloads[0]); p++)
+    {
+        for (int ecc = SSD1306_QR_ECC_L; ecc <= SSD1306_QR_ECC_H; ecc++)
+        {
+            esp_err_t ret = ssd1306_qr_encode(&qr, payloads[p], strlen(payloads[p]), (ssd1306_qr_ecc_t)ecc, 1);
+            if (ret == ESP_ERR_INVALID_SIZE)
+                continue; // Too long for version 6 at this level.
+            CHECK_EQ(ret, ESP_OK);
+            CHECK(qr.ecc >= ecc);
+            _check_code(&qr, payloads[p]);
+        }
+    }
+}
+
+static void test_version_selection(void)
+{
+    static ssd1306_qr_t qr;
+    CHECK_EQ(ssd1306_qr_encode(&qr, "01234567890123456", 17, SSD1306_QR_ECC_L, 1), ESP_OK);
+    CHECK_EQ(qr.version, 1);
+    CHECK_EQ(ssd1306_qr_encode(&qr, "012345678901234567", 18, SSD1306_QR_ECC_L, 1), ESP_OK);
+    CHECK_EQ(qr.version, 2);
+    CHECK_EQ(ssd1306_qr_encode(&qr, "A", 1, SSD1306_QR_ECC_L, 4), ESP_OK);
+    CHECK_EQ(qr.version, 4);
+    _check_code(&qr, "A");
+    static char big[200];
+    memset(big, 'x', sizeof(big));
+    CHECK_EQ(ssd1306_qr_encode(&qr, big, sizeof(big), SSD1306_QR_ECC_L, 1), ESP_ERR_INVALID_SIZE);
+}
+
+int main(void)
+{
+    RUN_TEST(test_levels_and_versions);
+    RUN_TEST(test_version_selection);
+    return TEST_RESULT();
+}
@@ -0,0 +1,198 @@
+/**
+ * @file      test_scroll.c
+ * @brief     Hardware scroll accounting: the framebuffer has to follow the rotation the
+ *            panel applies to GDDRAM, including when a scroll is restarted while active.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "ssd1306.h"
+#include "host_panel.h"
+#include "test_util.h"
+
+static ssd1306_config_t s_config;
+static uint32_t s_step_us; // One step at SSD1306_SCROLL_FRAMES_2.
+
+/**
+ * @brief Creates a display showing a pseudo-random pattern.
+ */
+static ssd1306_handle_t _open(void)
+{
+    host_reset();
+    s_config = test_display_config();
+    ssd1306_handle_t handle = NULL;
+    CHECK_EQ(ssd1306_create(&s_config, &handle), ESP_OK);
+    srand(1306);
+    for (int i = 0; i < 600; i++)
+        ssd1306_draw_pixel(handle, rand() % 128, rand() % 64, OLED_COLOR_WHITE);
+    CHECK_EQ(ssd1306_update_screen(handle), ESP_OK);
+    s_step_us = ssd1306_scroll_get_step_period(handle, SSD1306_SCROLL_FRAMES_2);
+    // Time the simulated controller with the same frame period as the driver's estimate.
+    host_panel(s_config.i2c_port, s_config.i2c_addr)->frame_us = s_step_us / 2;
+    return handle;
+}
+
+static ssd1306_scroll_config_t _scroll(ssd1306_scroll_dir_t dir, uint8_t start_page, uint8_t end_page, uint8_t start_col, uint8_t end_col)
+{
+    ssd1306_scroll_config_t cfg = {
+        .direction = dir,
+        .start_page = start_page,
+        .end_page = end_page,
+        .start_col = start_col,
+        .end_col = end_col,
+        .speed = SSD1306_SCROLL_FRAMES_2,
+    };
+    return cfg;
+}
+
+static void test_stop_applies_elapsed_steps(void)
+{
+    ssd1306_handle_t handle = _open();
+    ssd1306_scroll_config_t cfg = _scroll(SSD1306_SCROLL_RIGHT, 0, 3, 0, 127);
+    CHECK_EQ(ssd1306_scroll_start(handle, &cfg), ESP_OK);
+    CHECK_EQ(ssd1306_scroll_get_state(handle, NULL), SSD1306_SCROLL_STATE_ACTIVE);
+    host_advance_us(s_step_us * 10 + s_step_us / 2);
+    ssd1306_stop_scroll(handle);
+    CHECK_EQ(ssd1306_scroll_get_state(handle, NULL), SSD1306_SCROLL_STATE_STOPPED);
+    CHECK_EQ(ssd1306_scroll_get_elapsed_steps(handle), 10);
+    CHECK(test_matches_panel(handle, &s_config));
+    ssd1306_delete(&handle);
+}
+
+static void test_restart_while_active(void)
+{
+    ssd1306_handle_t handle = _open();
+    ssd1306_scroll_config_t right = _scroll(SSD1306_SCROLL_RIGHT, 0, 7, 0, 127);
+    ssd1306_scroll_config_t left = _scroll(SSD1306_SCROLL_LEFT, 2, 5, 16, 95);
+    CHECK_EQ(ssd1306_scroll_start(handle, &right), ESP_OK);
+    host_advance_us(s_step_us * 18 + s_step_us / 2);
+
+    // The restart's stop ends the first run, which must be applied before the new one starts.
+    CHECK_EQ(ssd1306_scroll_start(handle, &left), ESP_OK);
+    CHECK_EQ(ssd1306_scroll_get_state(handle, NULL), SSD1306_SCROLL_STATE_ACTIVE);
+    CHECK_EQ(ssd1306_scroll_get_elapsed_steps(handle), 18);
+    CHECK(test_matches_panel(handle, &s_config));
+
+    host_advance_us(s_step_us * 7 + s_step_us / 2);
+    ssd1306_stop_scroll(handle);
+    CHECK_EQ(ssd1306_scroll_get_elapsed_steps(handle), 7);
+    CHECK(test_matches_panel(handle, &s_config));
+    ssd1306_delete(&handle);
+}
+
+static void test_restart_parked_until_settled(void)
+{
+    ssd1306_handle_t handle = _open();
+    ssd1306_scroll_config_t right = _scroll(SSD1306_SCROLL_RIGHT, 0, 7, 0, 127);
+    ssd1306_scroll_config_t left = _scroll(SSD1306_SCROLL_LEFT, 0, 7, 0, 127);
+    CHECK_EQ(ssd1306_scroll_start(handle, &right), ESP_OK);
+
+    // Too soon after the start: the stop goes out at once and only the new setup waits.
+    host_advance_us(1000);
+    CHECK_EQ(ssd1306_scroll_start(handle, &left), ESP_ERR_NOT_FINISHED);
+    CHECK_EQ(ssd1306_scroll_get_state(handle, NULL), SSD1306_SCROLL_STATE_PENDING);
+    CHECK(!host_panel(s_config.i2c_port, s_config.i2c_addr)->scroll_active);
+    CHECK_EQ(ssd1306_scroll_get_elapsed_steps(handle), 1000 / s_step_us);
+    CHECK(test_matches_panel(handle, &s_config));
+    CHECK_EQ(ssd1306_scroll_poll(handle), ESP_ERR_NOT_FINISHED);
+
+    host_advance_us(10000);
+    CHECK_EQ(ssd1306_scroll_poll(handle), ESP_OK);
+    CHECK_EQ(ssd1306_scroll_get_state(handle, NULL), SSD1306_SCROLL_STATE_ACTIVE);
+    CHECK(host_panel(s_config.i2c_port, s_config.i2c_addr)->scroll_active);
+
+    host_advance_us(s_step_us * 3 + s_step_us / 2);
+    ssd1306_stop_scroll(handle);
+    CHECK(test_matches_panel(handle, &s_config));
+    ssd1306_delete(&handle);
+}
+
+static void test_legacy_start_after_stop(void)
+{
+    ssd1306_handle_t handle = _open();
+    ssd1306_scroll_config_t right = _scroll(SSD1306_SCROLL_RIGHT, 0, 7, 0, 127);
+    CHECK_EQ(ssd1306_scroll_start(handle, &right), ESP_OK);
+    host_advance_us(s_step_us * 4 + s_step_us / 2);
+
+    // The void wrappers cannot report a parked start, so they must not leave one behind.
+    ssd1306_stop_scroll(handle);
+    CHECK_EQ(ssd1306_update_screen(handle), ESP_OK);
+    ssd1306_start_scroll_diag_left_up(handle, 0, 7, 1, SSD1306_SCROLL_FRAMES_2);
+    CHECK_EQ(ssd1306_scroll_get_state(handle, NULL), SSD1306_SCROLL_STATE_ACTIVE);
+    CHECK(host_panel(s_config.i2c_port, s_config.i2c_addr)->scroll_active);
+
+    // Only a stop that ends a run starts a settle time; a redundant one does not.
+    ssd1306_stop_scroll(handle);
+    host_advance_us(10000);
+    ssd1306_stop_scroll(handle);
+    int64_t before = host_time_us();
+    ssd1306_start_scroll_left(handle, 0, 7);
+    CHECK(host_panel(s_config.i2c_port, s_config.i2c_addr)->scroll_active);
+    CHECK(host_time_us() - before < 1000);
+    ssd1306_stop_scroll(handle);
+    CHECK(test_matches_panel(handle, &s_config));
+    ssd1306_delete(&handle);
+}
+
+static void test_restart_deferred(void)
+{
+    ssd1306_handle_t handle = _open();
+    CHECK_EQ(ssd1306_set_deferred_commands(handle, true), ESP_OK);
+    ssd1306_scroll_config_t right = _scroll(SSD1306_SCROLL_RIGHT, 1, 6, 8, 119);
+    ssd1306_scroll_config_t diag = _scroll(SSD1306_SCROLL_VERTICAL_LEFT, 0, 7, 0, 127);
+    diag.vertical_offset = 1;
+
+    CHECK_EQ(ssd1306_scroll_start(handle, &right), ESP_OK);
+    CHECK_EQ(ssd1306_update_screen(handle), ESP_OK);
+    host_advance_us(s_step_us * 12 + s_step_us / 2);
+
+    // The restart travels with the next flush, together with new pixels outside the scroll window.
+    CHECK_EQ(ssd1306_scroll_start(handle, &diag), ESP_OK);
+    ssd1306_draw_pixel(handle, 3, 3, OLED_COLOR_WHITE);
+    CHECK_EQ(ssd1306_update_screen(handle), ESP_OK);
+    CHECK_EQ(ssd1306_scroll_get_elapsed_steps(handle), 12);
+    CHECK(test_matches_panel(handle, &s_config));
+
+    host_advance_us(s_step_us * 4 + s_step_us / 2);
+    ssd1306_stop_scroll(handle);
+    CHECK_EQ(ssd1306_update_screen(handle), ESP_OK);
+    CHECK_EQ(ssd1306_scroll_get_state(handle, NULL), SSD1306_SCROLL_STATE_STOPPED);
+    CHECK(test_matches_panel(handle, &s_config));
+    ssd1306_delete(&handle);
+}
+
+static void test_resync_replaces_estimate(void)
+{
+    ssd1306_handle_t handle = _open();
+    ssd1306_scroll_config_t cfg = _scroll(SSD1306_SCROLL_LEFT, 0, 7, 0, 127);
+    CHECK_EQ(ssd1306_scroll_resync(handle, 1), ESP_ERR_INVALID_STATE);
+    CHECK_EQ(ssd1306_scroll_start(handle, &cfg), ESP_OK);
+    host_advance_us(s_step_us * 6 + s_step_us / 2);
+    ssd1306_stop_scroll(handle);
+    CHECK_EQ(ssd1306_scroll_get_elapsed_steps(handle), 6);
+
+    // Rotate the panel by three more steps than the estimate and report the true count.
+    host_panel_t *panel = host_panel(s_config.i2c_port, s_config.i2c_addr);
+    for (int page = 0; page < 8; page++)
+    {
+        uint8_t row[128];
+        for (int x = 0; x < 128; x++)
+            row[x] = panel->gddram[page][(x + 3) % 128];
+        memcpy(panel->gddram[page], row, sizeof(row));
+    }
+    CHECK_EQ(ssd1306_scroll_resync(handle, 9), ESP_OK);
+    CHECK_EQ(ssd1306_scroll_get_elapsed_steps(handle), 9);
+    CHECK(test_matches_panel(handle, &s_config));
+    ssd1306_delete(&handle);
+}
+
+int main(void)
+{
+    RUN_TEST(test_stop_applies_elapsed_steps);
+    RUN_TEST(test_restart_while_active);
+    RUN_TEST(test_restart_parked_until_settled);
+    RUN_TEST(test_legacy_start_after_stop);
+    RUN_TEST(test_restart_deferred);
+    RUN_TEST(test_resync_replaces_estimate);
+    return TEST_RESULT();
+}
@@ -0,0 +1,119 @@
+/**
+ * @file      test_snapshot.c
+ * @brief     Snapshots and warm attach: the run-length coded framebuffer round-trips,
+ *            attaching sends nothing, and damaged snapshots are refused.
+ */
+
+#include <string.h>
+#include "ssd1306.h"
+#include "host_panel.h"
+#include "test_util.h"
+
+/**
+ * Fills the framebuffer with long runs, short runs and literal stretches, the cases
+ * the run-length coder distinguishes. `noise` makes every byte random (worst case).
+ */
+static void _draw_pattern(ssd1306_handle_t handle, bool noise)
+{
+    uint32_t seed = 12345;
+    for (uint8_t page = 0; page < 8; page++)
+    {
+        uint8_t row[128];
+        for (int x = 0; x < 128; x++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            uint8_t rnd = (uint8_t)(seed >> 16);
+            if (noise || (page % 3 == 2 && x >= 64))
+                row[x] = rnd;
+            else if (page % 3 == 1)
+                row[x] = (x / 3) & 1 ? 0xAA : 0x55;
+            else
+                row[x] = page < 4 ? 0x00 : 0xFF;
+        }
+        ssd1306_write_page(handle, 0, page, row, 128, 0xFF);
+    }
+}
+
+static void _round_trip(bool noise)
+{
+    host_reset();
+    ssd1306_config_t config = test_display_config();
+    ssd1306_handle_t handle = NULL;
+    CHECK_EQ(ssd1306_create(&config, &handle), ESP_OK);
+    _draw_pattern(handle, noise);
+    CHECK_EQ(ssd1306_update_screen(handle), ESP_OK);
+    ssd1306_set_contrast(handle, 0x30);
+
+    // One more change that is drawn but not sent: the attached handle still owes it.
+    ssd1306_draw_pixel(handle, 5, 5, OLED_COLOR_INVERT);
+    uint8_t expected[8][128];
+    for (uint8_t page = 0; page < 8; page++)
+        ssd1306_read_page(handle, 0, page, expected[page], 128);
+
+    static uint8_t snapshot[2048];
+    size_t max = ssd1306_snapshot_max_size(handle), len = 0;
+    CHECK(max <= sizeof(snapshot));
+    CHECK_EQ(ssd1306_save_snapshot(handle, snapshot, max, &len), ESP_OK);
+    CHECK(len <= max);
+    if (!noise)
+        CHECK(len < 1024 / 2);
+    CHECK_EQ(ssd1306_delete(&handle), ESP_OK);
+
+    host_panel_t *panel = host_panel(I2C_NUM_0, 0x3C);
+    uint32_t transactions = panel->transactions;
+    CHECK_EQ(ssd1306_attach(&config, snapshot, len, &handle), ESP_OK);
+    CHECK_EQ(panel->transactions, transactions);
+    for (uint8_t page = 0; page < 8; page++)
+    {
+        uint8_t row[128];
+        ssd1306_read_page(handle, 0, page, row, 128);
+        CHECK(memcmp(row, expected[page], 128) == 0);
+    }
+    CHECK_EQ(ssd1306_update_screen(handle), ESP_OK);
+    CHECK(test_matches_panel(handle, &config));
+    CHECK_EQ(panel->contrast, 0x30);
+    CHECK_EQ(ssd1306_delete(&handle), ESP_OK);
+}
+
+static void test_round_trip(void)
+{
+    _round_trip(false);
+}
+
+static void test_round_trip_incompressible(void)
+{
+    _round_trip(true);
+}
+
+static void test_damaged_snapshot_refused(void)
+{
+    host_reset();
+    ssd1306_config_t config = test_display_config();
+    ssd1306_handle_t handle = NULL;
+    CHECK_EQ(ssd1306_create(&config, &handle), ESP_OK);
+    _draw_pattern(handle, false);
+    static uint8_t snapshot[2048];
+    size_t len = 0;
+    CHECK_EQ(ssd1306_save_snapshot(handle, snapshot, sizeof(snapshot), &len), ESP_OK);
+    CHECK_EQ(ssd1306_save_snapshot(handle, snapshot, 8, &len), ESP_ERR_INVALID_SIZE);
+    CHECK_EQ(ssd1306_save_snapshot(handle, snapshot, sizeof(snapshot), &len), ESP_OK);
+    CHECK_EQ(ssd1306_delete(&handle), ESP_OK);
+
+    snapshot[len - 1] ^= 0x01;
+    CHECK(ssd1306_attach(&config, snapshot, len, &handle) != ESP_OK);
+    CHECK(handle == NULL);
+    snapshot[len - 1] ^= 0x01;
+    CHECK(ssd1306_attach(&config, snapshot, len - 1, &handle) != ESP_OK);
+    config.screen_height = 32; // Another panel geometry.
+    CHECK(ssd1306_attach(&config, snapshot, len, &handle) != ESP_OK);
+    CHECK(handle == NULL);
+    CHECK_EQ(host_i2c_drivers(), 0);
+}
+
+int main(void)
+{
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_round_trip_incompressible);
+    RUN_TEST(test_damaged_snapshot_refused);
+    return TEST_RESULT();
+}
@@ -0,0 +1,116 @@
+/**
+ * @file      test_suspend.c
+ * @brief     Framebuffer suspend while the display is off: the compressed copy restores
+ *            the exact content, a discarded one rewrites the whole panel. An arena makes
+ *            the memory held in each state visible.
+ */
+
+#include <string.h>
+#include "ssd1306.h"
+#include "ssd1306_arena.h"
+#include "host_panel.h"
+#include "test_util.h"
+
+typedef struct {
+    ssd1306_config_t config;
+    ssd1306_arena_handle_t arena;
+    ssd1306_handle_t handle;
+} fixture_t;
+
+static void _setup(fixture_t *f, ssd1306_suspend_mode_t mode)
+{
+    host_reset();
+    ssd1306_arena_config_t cfg = {.size = 16 * 128};
+    f->arena = NULL;
+    f->handle = NULL;
+    CHECK_EQ(ssd1306_arena_create(&cfg, &f->arena), ESP_OK);
+    f->config = test_display_config();
+    f->config.arena = f->arena;
+    CHECK_EQ(ssd1306_create(&f->config, &f->handle), ESP_OK);
+    CHECK_EQ(ssd1306_set_suspend_mode(f->handle, mode), ESP_OK);
+}
+
+static void _teardown(fixture_t *f)
+{
+    CHECK_EQ(ssd1306_delete(&f->handle), ESP_OK);
+    CHECK_EQ(ssd1306_arena_delete(f->arena), ESP_OK);
+}
+
+static uint16_t _blocks_used(const fixture_t *f)
+{
+    ssd1306_arena_stats_t stats;
+    ssd1306_arena_get_stats(f->arena, &stats);
+    return stats.used;
+}
+
+static void test_compress_restores_exact_content(void)
+{
+    fixture_t f;
+    _setup(&f, SSD1306_SUSPEND_COMPRESS);
+    ssd1306_draw_rect(f.handle, 10, 10, 50, 30, OLED_COLOR_WHITE);
+    ssd1306_fill_circle(f.handle, 90, 32, 20, OLED_COLOR_WHITE);
+    CHECK_EQ(ssd1306_update_screen(f.handle), ESP_OK);
+    CHECK_EQ(_blocks_used(&f), 8);
+
+    CHECK_EQ(ssd1306_display_off(f.handle), ESP_OK);
+    uint16_t held = _blocks_used(&f);
+    CHECK(held > 0 && held < 8);
+
+    // The first drawing call rebuilds the framebuffer, which still matches the panel.
+    host_panel_t *panel = host_panel(I2C_NUM_0, 0x3C);
+    uint32_t data_bytes = panel->data_bytes;
+    ssd1306_draw_pixel(f.handle, 0, 0, OLED_COLOR_WHITE);
+    CHECK_EQ(_blocks_used(&f), 8);
+    CHECK_EQ(ssd1306_display_on(f.handle), ESP_OK);
+    CHECK_EQ(ssd1306_update_screen(f.handle), ESP_OK);
+    CHECK(test_matches_panel(f.handle, &f.config));
+    CHECK(panel->data_bytes - data_bytes < 128); // Only the changed pixel went out.
+    _teardown(&f);
+}
+
+static void test_incompressible_frame_is_kept(void)
+{
+    fixture_t f;
+    _setup(&f, SSD1306_SUSPEND_COMPRESS);
+    uint32_t seed = 1;
+    for (uint8_t page = 0; page < 8; page++)
+    {
+        uint8_t row[128];
+        for (int x = 0; x < 128; x++)
+            row[x] = (uint8_t)((seed = seed * 1103515245u + 12345u) >> 16);
+        ssd1306_write_page(f.handle, 0, page, row, 128, 0xFF);
+    }
+    CHECK_EQ(ssd1306_update_screen(f.handle), ESP_OK);
+    CHECK_EQ(ssd1306_display_off(f.handle), ESP_OK);
+    CHECK_EQ(_blocks_used(&f), 8);
+    CHECK_EQ(ssd1306_display_on(f.handle), ESP_OK);
+    CHECK(test_matches_panel(f.handle, &f.config));
+    _teardown(&f);
+}
+
+static void test_discard_rewrites_panel(void)
+{
+    fixture_t f;
+    _setup(&f, SSD1306_SUSPEND_DISCARD);
+    ssd1306_fill_rect(f.handle, 0, 0, 128, 64, OLED_COLOR_WHITE);
+    CHECK_EQ(ssd1306_update_screen(f.handle), ESP_OK);
+    CHECK_EQ(ssd1306_display_off(f.handle), ESP_OK);
+    CHECK_EQ(_blocks_used(&f), 0);
+
+    ssd1306_draw_pixel(f.handle, 3, 3, OLED_COLOR_WHITE);
+    CHECK_EQ(ssd1306_display_on(f.handle), ESP_OK);
+    CHECK_EQ(ssd1306_update_screen(f.handle), ESP_OK);
+    host_panel_t *panel = host_panel(I2C_NUM_0, 0x3C);
+    CHECK_EQ(panel->gddram[0][3], 0x08);
+    CHECK_EQ(panel->gddram[7][127], 0x00);
+    CHECK(test_matches_panel(f.handle, &f.config));
+    _teardown(&f);
+}
+
+int main(void)
+{
+    RUN_TEST(test_compress_restores_exact_content);
+    RUN_TEST(test_incompressible_frame_is_kept);
+    RUN_TEST(test_discard_rewrites_panel);
+    return TEST_RESULT();
+}
@@ -0,0 +1,115 @@
+/**
+ * @file      test_textbox.c
+ * @brief     Text box layout: caller-sized line tables and text that does not fit them,
+ *            and drawing that leaves the application's font and clip rectangle alone.
+ */
+
+#include <string.h>
+#include "ssd1306.h"
+#include "ssd1306_textbox.h"
+#include "fonts/FreeSans9pt7b.h"
+#include "fonts/font5x7.h"
+#include "host_panel.h"
+#include "test_util.h"
+
+static ssd1306_handle_t _create(void)
+{
+    host_reset();
+    ssd1306_config_t config = test_display_config();
+    ssd1306_handle_t handle = NULL;
+    CHECK_EQ(ssd1306_create(&config, &handle), ESP_OK);
+    return handle;
+}
+
+/** Builds "0\n1\n...\n" with `n` single-character lines. */
+static const char *_numbered_lines(char *buf, int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        buf[2 * i] = (char)('0' + i % 10);
+        buf[2 * i + 1] = '\n';
+    }
+    buf[2 * n - 1] = '\0';
+    return buf;
+}
+
+static void test_builtin_table_reports_overflow(void)
+{
+    ssd1306_handle_t disp = _create();
+    ssd1306_textbox_t tb;
+    ssd1306_textbox_config_t cfg = {.x = 0, .y = 0, .w = 128, .h = 64};
+    CHECK_EQ(ssd1306_textbox_init(&tb, disp, &cfg, &FONT_GFX_FreeSans9pt7b), ESP_OK);
+    static char text[2 * 40];
+    CHECK_EQ(ssd1306_textbox_set_text(&tb, _numbered_lines(text, 40)), ESP_ERR_INVALID_SIZE);
+    CHECK_EQ(tb.line_count, SSD1306_TEXTBOX_MAX_LINES);
+    CHECK(tb.truncated && tb.line_buf[SSD1306_TEXTBOX_MAX_LINES - 1].ellipsis);
+    // The cached layout keeps reporting it.
+    CHECK_EQ(ssd1306_textbox_set_text(&tb, text), ESP_ERR_INVALID_SIZE);
+    CHECK_EQ(tb.layouts, 1);
+    CHECK_EQ(ssd1306_textbox_draw(&tb), ESP_OK);
+    CHECK_EQ(ssd1306_delete(&disp), ESP_OK);
+}
+
+static void test_caller_table_holds_long_text(void)
+{
+    ssd1306_handle_t disp = _create();
+    static ssd1306_textbox_line_t lines[64];
+    ssd1306_textbox_t tb;
+    ssd1306_textbox_config_t cfg = {.x = 0, .y = 0, .w = 128, .h = 64, .lines = lines, .max_lines = 64};
+    CHECK_EQ(ssd1306_textbox_init(&tb, disp, &cfg, &FONT_GFX_FreeSans9pt7b), ESP_OK);
+    static char text[2 * 40];
+    CHECK_EQ(ssd1306_textbox_set_text(&tb, _numbered_lines(text, 40)), ESP_OK);
+    CHECK_EQ(tb.line_count, 40);
+    CHECK(!tb.truncated);
+    CHECK_EQ(lines[39].start, 78);
+    CHECK_EQ(ssd1306_textbox_get_content_height(&tb), 40 * tb.line_h);
+    CHECK_EQ(ssd1306_textbox_set_scroll(&tb, 10000), ESP_OK);
+    CHECK_EQ(tb.scroll, 40 * tb.line_h - 64);
+    CHECK_EQ(ssd1306_textbox_draw(&tb), ESP_OK);
+    CHECK_EQ(ssd1306_delete(&disp), ESP_OK);
+}
+
+static void test_ellipsis_box_limit_is_not_an_error(void)
+{
+    ssd1306_handle_t disp = _create();
+    static ssd1306_textbox_line_t lines[2];
+    ssd1306_textbox_t tb;
+    ssd1306_textbox_config_t cfg = {.x = 0, .y = 0, .w = 128, .h = 64, .ellipsis = true, .lines = lines, .max_lines = 2};
+    CHECK_EQ(ssd1306_textbox_init(&tb, disp, &cfg, &FONT_GFX_FreeSans9pt7b), ESP_OK);
+    static char text[2 * 10];
+    // 64 rows hold 2 lines of this font: the box, not the table, cuts the text.
+    CHECK_EQ(64 / tb.line_h, 2);
+    CHECK_EQ(ssd1306_textbox_set_text(&tb, _numbered_lines(text, 10)), ESP_OK);
+    CHECK(tb.truncated && lines[1].ellipsis);
+    CHECK_EQ(ssd1306_delete(&disp), ESP_OK);
+}
+
+static void test_draw_keeps_text_state(void)
+{
+    ssd1306_handle_t disp = _create();
+    ssd1306_textbox_t tb;
+    ssd1306_textbox_config_t cfg = {.x = 8, .y = 16, .w = 96, .h = 40};
+    CHECK_EQ(ssd1306_textbox_init(&tb, disp, &cfg, &FONT_GFX_FreeSans9pt7b), ESP_OK);
+    CHECK_EQ(ssd1306_textbox_set_text(&tb, "Some text"), ESP_OK);
+    ssd1306_set_font(disp, &FONT_5x7);
+    ssd1306_set_clip_rect(disp, 0, 8, 120, 48);
+    CHECK_EQ(ssd1306_textbox_draw(&tb), ESP_OK);
+
+    int16_t x, y, w, h;
+    CHECK_EQ(ssd1306_get_clip_rect(disp, &x, &y, &w, &h), ESP_OK);
+    CHECK_EQ(x, 0);
+    CHECK_EQ(y, 8);
+    CHECK_EQ(w, 120);
+    CHECK_EQ(h, 48);
+    CHECK(ssd1306_get_font(disp) == &FONT_5x7);
+    CHECK_EQ(ssd1306_delete(&disp), ESP_OK);
+}
+
+int main(void)
+{
+    RUN_TEST(test_builtin_table_reports_overflow);
+    RUN_TEST(test_caller_table_holds_long_text);
+    RUN_TEST(test_ellipsis_box_limit_is_not_an_error);
+    RUN_TEST(test_draw_keeps_text_state);
+    return TEST_RESULT();
+}
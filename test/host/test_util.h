@@ -0,0 +1,83 @@
+/**
+ * @file      test_util.h
+ * @brief     Minimal checks and display helpers for the host tests.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdio.h>
+#include "ssd1306.h"
+#include "host_panel.h"
+
+static int s_test_failures;
+
+/** Records a failed check and carries on, so one run reports every broken expectation. */
+#define CHECK(cond)                                                              \
+    do                                                                           \
+    {                                                                            \
+        if (!(cond))                                                             \
+        {                                                                        \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            s_test_failures++;                                                   \
+        }                                                                        \
+    } while (0)
+
+/** Like CHECK, printing both integer values on failure. */
+#define CHECK_EQ(a, b)                                                                                  \
+    do                                                                                                  \
+    {                                                                                                   \
+        long long a_ = (long long)(a), b_ = (long long)(b);                                             \
+        if (a_ != b_)                                                                                   \
+        {                                                                                               \
+            fprintf(stderr, "%s:%d: CHECK_EQ failed: %s == %s (%lld != %lld)\n", __FILE__, __LINE__, #a, \
+                    #b, a_, b_);                                                                        \
+            s_test_failures++;                                                                          \
+        }                                                                                               \
+    } while (0)
+
+/** Runs one test case. */
+#define RUN_TEST(fn)                        \
+    do                                      \
+    {                                       \
+        int before_ = s_test_failures;      \
+        fn();                               \
+        printf("%s %s\n", s_test_failures == before_ ? "PASS" : "FAIL", #fn); \
+    } while (0)
+
+/** Exit status of the test program. */
+#define TEST_RESULT() (s_test_failures ? 1 : 0)
+
+/** Configuration of a 128x64 panel at 0x3C on port 0. */
+static inline ssd1306_config_t test_display_config(void)
+{
+    ssd1306_config_t config = {
+        .i2c_port = I2C_NUM_0,
+        .i2c_addr = 0x3C,
+        .screen_width = 128,
+        .screen_height = 64,
+        .rst_pin = -1,
+        .i2c_clk_speed_hz = 400000,
+    };
+    return config;
+}
+
+/** True if the framebuffer matches the GDDRAM of the simulated panel. */
+static inline bool test_matches_panel(ssd1306_handle_t handle, const ssd1306_config_t *config)
+{
+    const host_panel_t *panel = host_panel(config->i2c_port, config->i2c_addr);
+    for (uint8_t page = 0; page < config->screen_height / 8; page++)
+    {
+        uint8_t row[128];
+        ssd1306_read_page(handle, 0, page, row, config->screen_width);
+        for (int x = 0; x < config->screen_width; x++)
+        {
+            if (row[x] != panel->gddram[page][x])
+            {
+                fprintf(stderr, "page %u column %d: framebuffer %02x, panel %02x\n", page, x, row[x], panel->gddram[page][x]);
+                return false;
+            }
+        }
+    }
+    return true;
+}
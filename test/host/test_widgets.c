@@ -0,0 +1,81 @@
+/**
+ * @file      test_widgets.c
+ * @brief     Retained widgets: auto-width labels follow their text, and a render pass
+ *            leaves the application's text state alone.
+ */
+
+#include "ssd1306.h"
+#include "ssd1306_widgets.h"
+#include "fonts/FreeSans9pt7b.h"
+#include "fonts/font5x7.h"
+#include "host_panel.h"
+#include "test_util.h"
+
+/** Returns the rightmost lit column in rows [y0, y1), or -1. */
+static int _rightmost_pixel(ssd1306_handle_t disp, int16_t y0, int16_t y1)
+{
+    for (int16_t x = 127; x >= 0; x--)
+        for (int16_t y = y0; y < y1; y++)
+            if (ssd1306_get_pixel(disp, x, y))
+                return x;
+    return -1;
+}
+
+static void test_auto_width_label_follows_text(void)
+{
+    host_reset();
+    ssd1306_config_t config = test_display_config();
+    ssd1306_handle_t disp = NULL;
+    CHECK_EQ(ssd1306_create(&config, &disp), ESP_OK);
+    ssd1306_ui_t ui;
+    ssd1306_widget_t label;
+    CHECK_EQ(ssd1306_ui_init(&ui, disp, &FONT_GFX_FreeSans9pt7b), ESP_OK);
+    CHECK_EQ(ssd1306_ui_add_label(&ui, &label, 0, 0, 0, "Hi"), ESP_OK);
+    int16_t short_w = label.w;
+    ssd1306_ui_render(&ui);
+    CHECK(_rightmost_pixel(disp, 0, ui.line_h) < short_w);
+
+    // Growing: the whole new text is drawn, not clipped to the initial width.
+    ssd1306_label_set_text(&label, "Hello world");
+    CHECK(label.w > short_w);
+    ssd1306_ui_render(&ui);
+    int right = _rightmost_pixel(disp, 0, ui.line_h);
+    CHECK(right >= short_w && right < label.w);
+
+    // Shrinking: the tail of the longer text is cleared.
+    ssd1306_label_set_text(&label, "Hi");
+    CHECK_EQ(label.w, short_w);
+    ssd1306_ui_render(&ui);
+    CHECK(_rightmost_pixel(disp, 0, ui.line_h) < short_w);
+
+    // A fixed-width label keeps its width.
+    ssd1306_widget_t fixed;
+    CHECK_EQ(ssd1306_ui_add_label(&ui, &fixed, 0, 32, 40, "Hi"), ESP_OK);
+    ssd1306_label_set_text(&fixed, "Hello world");
+    CHECK_EQ(fixed.w, 40);
+    CHECK_EQ(ssd1306_delete(&disp), ESP_OK);
+}
+
+static void test_render_keeps_display_font(void)
+{
+    host_reset();
+    ssd1306_config_t config = test_display_config();
+    ssd1306_handle_t disp = NULL;
+    CHECK_EQ(ssd1306_create(&config, &disp), ESP_OK);
+    ssd1306_ui_t ui;
+    ssd1306_widget_t label;
+    CHECK_EQ(ssd1306_ui_init(&ui, disp, &FONT_GFX_FreeSans9pt7b), ESP_OK);
+    CHECK_EQ(ssd1306_ui_add_label(&ui, &label, 0, 0, 0, "Hi"), ESP_OK);
+
+    ssd1306_set_font(disp, &FONT_5x7);
+    CHECK_EQ(ssd1306_ui_render(&ui), 1);
+    CHECK(ssd1306_get_font(disp) == &FONT_5x7);
+    CHECK_EQ(ssd1306_delete(&disp), ESP_OK);
+}
+
+int main(void)
+{
+    RUN_TEST(test_auto_width_label_follows_text);
+    RUN_TEST(test_render_keeps_display_font);
+    return TEST_RESULT();
+}
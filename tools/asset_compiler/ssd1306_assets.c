@@ -0,0 +1,517 @@
+/**
+ * @file      ssd1306_assets.c
+ * @brief     Host tool that compiles PBM/PGM images into page-format C arrays.
+ * @version   1.0
+ *
+ * Usage: ssd1306_assets <manifest> <output.h>
+ *
+ * Each manifest line declares one asset:
+ *
+ *     <name> <image> [frame=<w>x<h>] [dither=none|ordered|floyd] [threshold=<0-255>] [rle] [invert]
+ *
+ * - `image` is a PBM (P1/P4) or PGM (P2/P5) file, relative to the manifest.
+ * - `frame` slices a sprite sheet into frames of that size, left to right, then top to
+ *   bottom; the sheet size must be a multiple of it. Without it the image is one frame.
+ * - PBM set bits (black) become lit pixels, as with `ssd1306_image_load`. PGM pixels
+ *   are lit where they are bright: above `threshold` (default 128), or dithered with a
+ *   4x4 ordered matrix or Floyd-Steinberg error diffusion.
+ * - `rle` compresses each frame with the driver's run-length code; it is dropped for
+ *   assets it would not make smaller.
+ * - `invert` swaps lit and dark pixels.
+ *
+ * Text after `#` is a comment. The generated header defines, per asset, `<NAME>_WIDTH`,
+ * `<NAME>_HEIGHT` and `<NAME>_FRAMES`, the data and offset arrays, and an
+ * `ssd1306_asset_t` named `<name>` for `ssd1306_draw_asset()`.
+ */
+
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ASSET_LINE_MAX 1024   /**< Longest manifest line. */
+#define ASSET_PATH_MAX 1024   /**< Longest image path. */
+#define ASSET_MAX_SIDE 4096   /**< Largest image width or height accepted. */
+
+/**
+ * @brief Dithering of grayscale images.
+ */
+typedef enum {
+    DITHER_NONE = 0, /**< Plain threshold. */
+    DITHER_ORDERED,  /**< 4x4 Bayer matrix. */
+    DITHER_FLOYD,    /**< Floyd-Steinberg error diffusion. */
+} dither_t;
+
+/**
+ * @brief One manifest entry.
+ */
+typedef struct {
+    char name[64];             /**< C identifier of the asset. */
+    char path[ASSET_PATH_MAX]; /**< Image path. */
+    int frame_w, frame_h;      /**< Frame size (0 = whole image). */
+    dither_t dither;           /**< Dithering of grayscale images. */
+    int threshold;             /**< Threshold of grayscale images. */
+    bool rle;                  /**< Compress the frames. */
+    bool invert;               /**< Swap lit and dark pixels. */
+} asset_t;
+
+/**
+ * @brief Decoded image.
+ */
+typedef struct {
+    int w, h;       /**< Size. */
+    bool bitmap;    /**< PBM: `pix` holds 1 for set bits; PGM: gray levels 0-255. */
+    uint8_t *pix;   /**< Row-major pixels. */
+} image_t;
+
+static const char *s_manifest;         /**< Manifest path, for messages. */
+static int s_line;                     /**< Current manifest line, for messages. */
+static FILE *s_out;                    /**< Temporary output while it is being written. */
+static char s_tmp[ASSET_PATH_MAX + 8]; /**< Path of the temporary output. */
+
+/**
+ * @brief Closes and deletes the temporary output, if one is open.
+ */
+static void _discard_output(void)
+{
+    if (!s_out)
+        return;
+    fclose(s_out);
+    s_out = NULL;
+    remove(s_tmp);
+}
+
+/**
+ * @brief Prints an error located in the manifest and exits.
+ * The temporary output is deleted first, so a failed run leaves no files behind.
+ *
+ * @param msg Message.
+ * @param arg Detail, or NULL.
+ */
+static void _fail(const char *msg, const char *arg)
+{
+    fprintf(stderr, "%s:%d: error: %s%s%s\n", s_manifest, s_line, msg, arg ? ": " : "", arg ? arg : "");
+    _discard_output();
+    exit(1);
+}
+
+/**
+ * @brief Reads the next header field of a PNM file, skipping whitespace and comments.
+ *
+ * @param f File.
+ * @return int Value, or -1 if the header is malformed.
+ */
+static int _pnm_field(FILE *f)
+{
+    int c = fgetc(f);
+    while (c == '#' || (c != EOF && isspace(c)))
+    {
+        if (c == '#')
+        {
+            while (c != EOF && c != '\n' && c != '\r')
+                c = fgetc(f);
+        }
+        else
+        {
+            c = fgetc(f);
+        }
+    }
+    if (c == EOF || !isdigit(c))
+        return -1;
+    long v = 0;
+    for (; c != EOF && isdigit(c); c = fgetc(f))
+    {
+        v = v * 10 + (c - '0');
+        if (v > 65535)
+            return -1;
+    }
+    // Binary rasters start right after the single whitespace character ending the header.
+    return (c != EOF && isspace(c)) ? (int)v : -1;
+}
+
+/**
+ * @brief Loads a PBM (P1/P4) or PGM (P2/P5) image.
+ *
+ * @param path File path.
+ * @param img Decoded image.
+ * @return const char* NULL on success, or an error message.
+ */
+static const char *_load_pnm(const char *path, image_t *img)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return "cannot open image";
+    const char *err = NULL;
+    int kind = (fgetc(f) == 'P') ? fgetc(f) - '0' : 0;
+    int w = 0, h = 0, maxval = 1;
+    if (kind != 1 && kind != 2 && kind != 4 && kind != 5)
+        err = "not a PBM (P1/P4) or PGM (P2/P5) file";
+    else if ((w = _pnm_field(f)) <= 0 || (h = _pnm_field(f)) <= 0 || w > ASSET_MAX_SIDE || h > ASSET_MAX_SIDE)
+        err = "invalid image size";
+    else if ((kind == 2 || kind == 5) && ((maxval = _pnm_field(f)) <= 0))
+        err = "invalid maximum gray value";
+    if (err)
+    {
+        fclose(f);
+        return err;
+    }
+
+    img->w = w;
+    img->h = h;
+    img->bitmap = (kind == 1 || kind == 4);
+    img->pix = malloc((size_t)w * h);
+    if (!img->pix)
+    {
+        fclose(f);
+        return "out of memory";
+    }
+    for (int y = 0; y < h && !err; y++)
+    {
+        int byte = 0;
+        for (int x = 0; x < w && !err; x++)
+        {
+            int v = 0;
+            if (kind == 4)
+            {
+                // Rows are padded to whole bytes, most significant bit first.
+                if ((x & 7) == 0 && (byte = fgetc(f)) == EOF)
+                    err = "truncated image";
+                v = (byte >> (7 - (x & 7))) & 1;
+            }
+            else if (kind == 5)
+            {
+                int hi = fgetc(f), lo = (maxval > 255) ? fgetc(f) : 0;
+                if (hi == EOF || lo == EOF)
+                    err = "truncated image";
+                v = (maxval > 255) ? ((hi << 8) | lo) : hi;
+            }
+            else if (fscanf(f, kind == 1 ? " %1d" : " %d", &v) != 1)
+            {
+                err = "truncated image";
+            }
+            if (!img->bitmap)
+                v = (int)((long)v * 255 / maxval);
+            img->pix[(size_t)y * w + x] = (uint8_t)(v > 255 ? 255 : v);
+        }
+    }
+    fclose(f);
+    return err;
+}
+
+/**
+ * @brief Turns an image into lit (1) and dark (0) pixels.
+ *
+ * @param img Image; its pixels are replaced.
+ * @param a Asset options.
+ */
+static void _binarize(image_t *img, const asset_t *a)
+{
+    static const uint8_t bayer[4][4] = {{0, 8, 2, 10}, {12, 4, 14, 6}, {3, 11, 1, 9}, {15, 7, 13, 5}};
+    const int w = img->w, h = img->h;
+    int *err = NULL;
+    if (!img->bitmap && a->dither == DITHER_FLOYD)
+    {
+        // Two rows of accumulated error, with a column of margin on both sides.
+        err = calloc((size_t)2 * (w + 2), sizeof(int));
+        if (!err)
+            _fail("out of memory", NULL);
+    }
+    for (int y = 0; y < h; y++)
+    {
+        int *cur = err ? &err[(y & 1) * (w + 2) + 1] : NULL, *next = err ? &err[((y + 1) & 1) * (w + 2) + 1] : NULL;
+        if (next)
+            memset(next - 1, 0, (size_t)(w + 2) * sizeof(int));
+        for (int x = 0; x < w; x++)
+        {
+            uint8_t *p = &img->pix[(size_t)y * w + x];
+            int lit;
+            if (img->bitmap)
+                lit = *p;
+            else if (a->dither == DITHER_ORDERED)
+                lit = *p * 16 > bayer[y & 3][x & 3] * 255 + 127;
+            else if (a->dither == DITHER_FLOYD)
+            {
+                int v = *p + cur[x] / 16;
+                lit = v >= a->threshold;
+                int e = v - (lit ? 255 : 0);
+                cur[x + 1] += e * 7;
+                next[x - 1] += e * 3;
+                next[x] += e * 5;
+                next[x + 1] += e;
+            }
+            else
+                lit = *p >= a->threshold;
+            *p = (uint8_t)(lit ^ a->invert);
+        }
+    }
+    free(err);
+}
+
+/**
+ * @brief Compresses a frame with the driver's PackBits-style run-length code.
+ * A control byte below 0x80 is followed by (control + 1) literal bytes; a control
+ * byte of 0x80 or more repeats the next byte (control - 0x80 + 2) times. Must stay in
+ * step with `_ssd1306_rle_encode` in src/ssd1306.c.
+ *
+ * @param src Data.
+ * @param len Length of `src`.
+ * @param dst Output of at least `len + len / 128 + 1` bytes.
+ * @return size_t Compressed length.
+ */
+static size_t _rle_encode(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    size_t in = 0, out = 0;
+    while (in < len)
+    {
+        size_t run = 1;
+        while (in + run < len && run < 129 && src[in + run] == src[in])
+            run++;
+        if (run >= 3)
+        {
+            dst[out++] = 0x80 | (uint8_t)(run - 2);
+            dst[out++] = src[in];
+            in += run;
+            continue;
+        }
+        size_t lit = run;
+        while (in + lit < len && lit < 128 &&
+               !(in + lit + 2 < len && src[in + lit] == src[in + lit + 1] && src[in + lit] == src[in + lit + 2]))
+            lit++;
+        dst[out++] = (uint8_t)(lit - 1);
+        memcpy(&dst[out], &src[in], lit);
+        out += lit;
+        in += lit;
+    }
+    return out;
+}
+
+/**
+ * @brief Parses a manifest line.
+ *
+ * @param line Line (modified).
+ * @param dir Directory of the manifest, with a trailing separator.
+ * @param a Entry.
+ * @return bool false for blank and comment lines.
+ */
+static bool _parse_line(char *line, const char *dir, asset_t *a)
+{
+    char *hash = strchr(line, '#');
+    if (hash)
+        *hash = '\0';
+    char *tok = strtok(line, " \t\r\n");
+    if (!tok)
+        return false;
+    memset(a, 0, sizeof(*a));
+    a->threshold = 128;
+    if (strlen(tok) >= sizeof(a->name) || !(isalpha((unsigned char)tok[0]) || tok[0] == '_'))
+        _fail("invalid asset name", tok);
+    for (const char *c = tok; *c; c++)
+    {
+        if (!isalnum((unsigned char)*c) && *c != '_')
+            _fail("invalid asset name", tok);
+    }
+    strcpy(a->name, tok);
+
+    tok = strtok(NULL, " \t\r\n");
+    if (!tok)
+        _fail("missing image path for", a->name);
+    bool absolute = (tok[0] == '/' || tok[0] == '\\' || (tok[0] && tok[1] == ':'));
+    if (snprintf(a->path, sizeof(a->path), "%s%s", absolute ? "" : dir, tok) >= (int)sizeof(a->path))
+        _fail("image path too long", tok);
+
+    while ((tok = strtok(NULL, " \t\r\n")) != NULL)
+    {
+        if (strcmp(tok, "rle") == 0)
+            a->rle = true;
+        else if (strcmp(tok, "invert") == 0)
+            a->invert = true;
+        else if (strncmp(tok, "frame=", 6) == 0)
+        {
+            if (sscanf(tok + 6, "%dx%d", &a->frame_w, &a->frame_h) != 2 || a->frame_w <= 0 || a->frame_h <= 0)
+                _fail("invalid frame size", tok);
+        }
+        else if (strncmp(tok, "threshold=", 10) == 0)
+        {
+            a->threshold = atoi(tok + 10);
+            if (a->threshold < 0 || a->threshold > 255)
+                _fail("threshold must be 0-255", tok);
+        }
+        else if (strcmp(tok, "dither=none") == 0)
+            a->dither = DITHER_NONE;
+        else if (strcmp(tok, "dither=ordered") == 0)
+            a->dither = DITHER_ORDERED;
+        else if (strcmp(tok, "dither=floyd") == 0)
+            a->dither = DITHER_FLOYD;
+        else
+            _fail("unknown option", tok);
+    }
+    return true;
+}
+
+/**
+ * @brief Writes a byte array definition.
+ *
+ * @param out Output file.
+ * @param name Array name.
+ * @param data Bytes.
+ * @param len Length.
+ */
+static void _emit_bytes(FILE *out, const char *name, const uint8_t *data, size_t len)
+{
+    fprintf(out, "static const uint8_t %s_data[] = {", name);
+    for (size_t i = 0; i < len; i++)
+        fprintf(out, "%s0x%02X,", (i % 16) ? " " : "\n    ", data[i]);
+    fprintf(out, "\n};\n");
+}
+
+/**
+ * @brief Converts one asset and appends it to the header.
+ *
+ * @param out Output file.
+ * @param a Asset.
+ */
+static void _compile(FILE *out, const asset_t *a)
+{
+    image_t img = {0};
+    const char *err = _load_pnm(a->path, &img);
+    if (err)
+        _fail(err, a->path);
+    _binarize(&img, a);
+
+    int fw = a->frame_w ? a->frame_w : img.w, fh = a->frame_h ? a->frame_h : img.h;
+    if (img.w % fw || img.h % fh)
+        _fail("image size is not a multiple of the frame size", a->path);
+    int cols = img.w / fw, frames = cols * (img.h / fh), pages = (fh + 7) / 8;
+    if (frames > 65535)
+        _fail("too many frames", a->path);
+    size_t frame_len = (size_t)fw * pages, raw_len = frame_len * frames;
+
+    // Page-format frames, each column byte holding 8 rows with bit 0 on top.
+    uint8_t *raw = calloc(raw_len, 1), *packed = malloc(raw_len + raw_len / 128 + frames + 1);
+    uint32_t *offsets = malloc(sizeof(uint32_t) * (frames + 1));
+    if (!raw || !packed || !offsets)
+        _fail("out of memory", NULL);
+    for (int f = 0; f < frames; f++)
+    {
+        int ox = (f % cols) * fw, oy = (f / cols) * fh;
+        for (int y = 0; y < fh; y++)
+        {
+            for (int x = 0; x < fw; x++)
+            {
+                if (img.pix[(size_t)(oy + y) * img.w + ox + x])
+                    raw[f * frame_len + (size_t)(y / 8) * fw + x] |= (uint8_t)(1 << (y & 7));
+            }
+        }
+    }
+
+    size_t packed_len = 0;
+    bool rle = a->rle;
+    if (rle)
+    {
+        for (int f = 0; f < frames; f++)
+        {
+            offsets[f] = (uint32_t)packed_len;
+            packed_len += _rle_encode(&raw[f * frame_len], frame_len, &packed[packed_len]);
+        }
+        offsets[frames] = (uint32_t)packed_len;
+        if (packed_len >= raw_len)
+        {
+            fprintf(stderr, "%s:%d: note: %s does not compress, stored raw\n", s_manifest, s_line, a->name);
+            rle = false;
+        }
+    }
+    if (!rle)
+    {
+        for (int f = 0; f <= frames; f++)
+            offsets[f] = (uint32_t)(f * frame_len);
+    }
+
+    char upper[sizeof(a->name)];
+    for (size_t i = 0; i <= strlen(a->name); i++)
+        upper[i] = (char)toupper((unsigned char)a->name[i]);
+    fprintf(out, "\n/* %s: %dx%d, %d frame%s, %zu bytes%s */\n", a->name, fw, fh, frames, frames == 1 ? "" : "s",
+            rle ? packed_len : raw_len, rle ? " run-length compressed" : "");
+    fprintf(out, "#define %s_WIDTH %d\n#define %s_HEIGHT %d\n#define %s_FRAMES %d\n", upper, fw, upper, fh, upper, frames);
+    _emit_bytes(out, a->name, rle ? packed : raw, rle ? packed_len : raw_len);
+    fprintf(out, "static const uint32_t %s_offsets[] = {", a->name);
+    for (int f = 0; f <= frames; f++)
+        fprintf(out, "%s%u,", (f % 8) ? " " : "\n    ", (unsigned)offsets[f]);
+    fprintf(out, "\n};\n");
+    fprintf(out, "static const ssd1306_asset_t %s = {\n    .width = %d,\n    .height = %d,\n    .frames = %d,\n"
+                 "    .rle = %s,\n    .data = %s_data,\n    .offsets = %s_offsets,\n};\n",
+            a->name, fw, fh, frames, rle ? "true" : "false", a->name, a->name);
+
+    free(img.pix);
+    free(raw);
+    free(packed);
+    free(offsets);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: %s <manifest> <output.h>\n", argv[0]);
+        return 2;
+    }
+    s_manifest = argv[1];
+    FILE *in = fopen(s_manifest, "r");
+    if (!in)
+    {
+        fprintf(stderr, "error: cannot open %s\n", s_manifest);
+        return 1;
+    }
+
+    // Image paths are relative to the manifest.
+    char dir[ASSET_PATH_MAX] = "";
+    const char *slash = strrchr(s_manifest, '/'), *bslash = strrchr(s_manifest, '\\');
+    slash = (bslash > slash) ? bslash : slash;
+    if (slash && (size_t)(slash - s_manifest + 1) < sizeof(dir))
+        memcpy(dir, s_manifest, slash - s_manifest + 1);
+
+    // Write to a temporary file first, so a failed run never leaves a partial header.
+    snprintf(s_tmp, sizeof(s_tmp), "%s.tmp", argv[2]);
+    FILE *out = fopen(s_tmp, "w");
+    if (!out)
+    {
+        fprintf(stderr, "error: cannot write %s\n", s_tmp);
+        return 1;
+    }
+    s_out = out;
+    const char *base = strrchr(argv[2], '/');
+    base = base ? base + 1 : argv[2];
+    char guard[128];
+    size_t n = 0;
+    for (const char *c = base; *c && n < sizeof(guard) - 1; c++)
+        guard[n++] = isalnum((unsigned char)*c) ? (char)toupper((unsigned char)*c) : '_';
+    guard[n] = '\0';
+    fprintf(out, "/* Generated by ssd1306_assets from %s. Do not edit. */\n\n#ifndef %s\n#define %s\n\n#include \"ssd1306.h\"\n",
+            s_manifest, guard, guard);
+
+    char line[ASSET_LINE_MAX];
+    asset_t a;
+    while (fgets(line, sizeof(line), in))
+    {
+        s_line++;
+        if (_parse_line(line, dir, &a))
+            _compile(out, &a);
+    }
+    fclose(in);
+    fprintf(out, "\n#endif // %s\n", guard);
+    s_out = NULL;
+    bool ok = (fclose(out) == 0);
+    if (ok)
+    {
+        remove(argv[2]); // rename() does not replace an existing file on Windows.
+        ok = (rename(s_tmp, argv[2]) == 0);
+    }
+    if (!ok)
+    {
+        fprintf(stderr, "error: cannot write %s\n", argv[2]);
+        remove(s_tmp);
+        return 1;
+    }
+    return 0;
+}